@@ -0,0 +1,658 @@
+///////////////////////////////////////////////////////////////////////////////
+// ShapeMeshesABHarness.cpp
+// ========================
+// A/B harness comparing original/3D Shapes/ShapeMeshes.cpp against
+// enhanced/3DShapes/ShapeMeshes.cpp.
+//
+// Both implementations are compiled into this one translation unit, each
+// inside its own namespace (original:: and enhanced::), and driven through
+// identical workloads:
+//   - Load workload: construct a ShapeMeshes and load every shared mesh.
+//   - Draw workload: submit every shared Draw* call once per frame,
+//     including the dynamic meshes that regenerate geometry per draw, and
+//     a few non-contiguous parts of the loaded meshes (see DrawSubsets).
+//
+// OpenGL entry points used by ShapeMeshes are redirected to counting hooks,
+// so no GL context or GPU is needed. The hooks hand out fake object names,
+// count calls per entry point, and tally uploaded bytes and submitted
+// indices/vertices. Heap allocations are counted by replacing global
+// operator new/delete.
+//
+// The harness reports, for each version and the delta between them:
+//   - best/mean wall time per load run and per frame
+//   - heap allocations and bytes per load run and per frame
+//   - GL calls per entry point, bytes uploaded, primitives submitted
+// and then checks that every shared shape uploads equivalent geometry
+// (same buffers, same index data, vertex data within a float tolerance).
+//
+// Build (example, run from artifact-two/):
+//   g++ -O2 -std=c++17 ShapeMeshesABHarness.cpp -lGLEW -lGL
+//
+// Both ShapeMeshes.cpp files include "shapemeshes.h" in lowercase. On
+// case-sensitive file systems add a lowercase link next to each header
+// (ln -s ShapeMeshes.h shapemeshes.h) before building.
+//
+// Usage:
+//   ShapeMeshesABHarness [--load-runs N] [--frames N]
+///////////////////////////////////////////////////////////////////////////////
+
+// Every header the two implementations pull in must be included here, at
+// global scope, before either file is included inside a namespace. Their
+// include guards then keep them from being re-included in the namespaces.
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+/******************************************
+ * Allocation Tracking
+ * ---------------------------------------
+ * Global operator new/delete are replaced so
+ * heap traffic during each workload can be
+ * counted.
+ ******************************************/
+
+namespace AllocStats
+{
+	std::atomic<unsigned long long> bytes{ 0 };
+	std::atomic<unsigned long long> count{ 0 };
+
+	void* Allocate(std::size_t size)
+	{
+		void* block = std::malloc(size ? size : 1);
+		if (!block) throw std::bad_alloc();
+		bytes += size;
+		++count;
+		return block;
+	}
+}
+
+void* operator new(std::size_t size) { return AllocStats::Allocate(size); }
+void* operator new[](std::size_t size) { return AllocStats::Allocate(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/******************************************
+ * GL Hooks
+ * ---------------------------------------
+ * Counting replacements for every GL entry
+ * point ShapeMeshes uses. Counters live in
+ * fixed arrays so the hooks themselves never
+ * allocate during timed runs.
+ *
+ * When a capture list is set, glBufferData
+ * also records a copy of each upload so the
+ * geometry of both versions can be compared.
+ ******************************************/
+
+namespace GLHooks
+{
+	enum Entry {
+		GenVertexArrays, DeleteVertexArrays, BindVertexArray,
+		GenBuffers, DeleteBuffers, BindBuffer, BufferData, BufferSubData,
+		MapBufferRange, UnmapBuffer, BufferStorage,
+		FenceSync, ClientWaitSync, DeleteSync,
+		VertexAttribPointer, EnableVertexAttribArray,
+		DrawElements, DrawElementsBaseVertex, MultiDrawElements, DrawArrays,
+		PolygonMode, Enable, Disable,
+		EntryCount
+	};
+
+	const char* const EntryNames[EntryCount] = {
+		"glGenVertexArrays", "glDeleteVertexArrays", "glBindVertexArray",
+		"glGenBuffers", "glDeleteBuffers", "glBindBuffer", "glBufferData", "glBufferSubData",
+		"glMapBufferRange", "glUnmapBuffer", "glBufferStorage",
+		"glFenceSync", "glClientWaitSync", "glDeleteSync",
+		"glVertexAttribPointer", "glEnableVertexAttribArray",
+		"glDrawElements", "glDrawElementsBaseVertex", "glMultiDrawElements", "glDrawArrays",
+		"glPolygonMode", "glEnable", "glDisable"
+	};
+
+	struct Counters {
+		unsigned long long calls[EntryCount] = {};
+		unsigned long long bytesUploaded = 0;
+		unsigned long long indicesDrawn = 0;
+		unsigned long long verticesDrawn = 0;
+
+		unsigned long long TotalCalls() const {
+			unsigned long long total = 0;
+			for (unsigned long long c : calls) total += c;
+			return total;
+		}
+	};
+
+	struct Upload {
+		GLenum target;
+		std::vector<unsigned char> data;
+	};
+
+	Counters counters;
+	std::vector<Upload>* capture = nullptr;
+	GLuint nextName = 1;
+
+	void Reset() { counters = Counters(); }
+
+	void GenNames(GLsizei n, GLuint* names) {
+		for (GLsizei i = 0; i < n; ++i) names[i] = nextName++;
+	}
+
+	void GenVertexArraysHook(GLsizei n, GLuint* arrays) { ++counters.calls[GenVertexArrays]; GenNames(n, arrays); }
+	void DeleteVertexArraysHook(GLsizei, const GLuint*) { ++counters.calls[DeleteVertexArrays]; }
+	void BindVertexArrayHook(GLuint) { ++counters.calls[BindVertexArray]; }
+	void GenBuffersHook(GLsizei n, GLuint* buffers) { ++counters.calls[GenBuffers]; GenNames(n, buffers); }
+	void DeleteBuffersHook(GLsizei, const GLuint*) { ++counters.calls[DeleteBuffers]; }
+	void BindBufferHook(GLenum, GLuint) { ++counters.calls[BindBuffer]; }
+
+	void BufferDataHook(GLenum target, GLsizeiptr size, const void* data, GLenum) {
+		++counters.calls[BufferData];
+		counters.bytesUploaded += static_cast<unsigned long long>(size);
+		if (capture) {
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			capture->push_back({ target, std::vector<unsigned char>(bytes, bytes + (data ? size : 0)) });
+		}
+	}
+
+	// Only reloads update a store in place; the workloads load each mesh once.
+	void BufferSubDataHook(GLenum, GLintptr, GLsizeiptr size, const void*) {
+		++counters.calls[BufferSubData];
+		counters.bytesUploaded += static_cast<unsigned long long>(size);
+	}
+
+	// Nothing is stored, so mapping fails; only ExportMesh maps buffers.
+	void* MapBufferRangeHook(GLenum, GLintptr, GLsizeiptr, GLbitfield) { ++counters.calls[MapBufferRange]; return nullptr; }
+	GLboolean UnmapBufferHook(GLenum) { ++counters.calls[UnmapBuffer]; return GL_TRUE; }
+	void BufferStorageHook(GLenum, GLsizeiptr, const void*, GLbitfield) { ++counters.calls[BufferStorage]; }
+
+	GLsync FenceSyncHook(GLenum, GLbitfield) { ++counters.calls[FenceSync]; return reinterpret_cast<GLsync>(1); }
+	GLenum ClientWaitSyncHook(GLsync, GLbitfield, GLuint64) { ++counters.calls[ClientWaitSync]; return GL_ALREADY_SIGNALED; }
+	void DeleteSyncHook(GLsync) { ++counters.calls[DeleteSync]; }
+
+	void VertexAttribPointerHook(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) { ++counters.calls[VertexAttribPointer]; }
+	void EnableVertexAttribArrayHook(GLuint) { ++counters.calls[EnableVertexAttribArray]; }
+
+	void DrawElementsHook(GLenum, GLsizei count, GLenum, const void*) {
+		++counters.calls[DrawElements];
+		counters.indicesDrawn += static_cast<unsigned long long>(count);
+	}
+
+	void DrawElementsBaseVertexHook(GLenum, GLsizei count, GLenum, const void*, GLint) {
+		++counters.calls[DrawElementsBaseVertex];
+		counters.indicesDrawn += static_cast<unsigned long long>(count);
+	}
+
+	void MultiDrawElementsHook(GLenum, const GLsizei* count, GLenum, const void* const*, GLsizei drawCount) {
+		++counters.calls[MultiDrawElements];
+		for (GLsizei i = 0; i < drawCount; ++i)
+			counters.indicesDrawn += static_cast<unsigned long long>(count[i]);
+	}
+
+	void DrawArraysHook(GLenum, GLint, GLsizei count) {
+		++counters.calls[DrawArrays];
+		counters.verticesDrawn += static_cast<unsigned long long>(count);
+	}
+
+	void PolygonModeHook(GLenum, GLenum) { ++counters.calls[PolygonMode]; }
+	void EnableHook(GLenum) { ++counters.calls[Enable]; }
+	void DisableHook(GLenum) { ++counters.calls[Disable]; }
+}
+
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glBindVertexArray
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glBindBuffer
+#undef glBufferData
+#undef glBufferSubData
+#undef glMapBufferRange
+#undef glUnmapBuffer
+#undef glBufferStorage
+#undef glFenceSync
+#undef glClientWaitSync
+#undef glDeleteSync
+#undef glVertexAttribPointer
+#undef glEnableVertexAttribArray
+#undef glDrawElements
+#undef glDrawElementsBaseVertex
+#undef glMultiDrawElements
+#undef glDrawArrays
+#undef glPolygonMode
+#undef glEnable
+#undef glDisable
+
+#define glGenVertexArrays ::GLHooks::GenVertexArraysHook
+#define glDeleteVertexArrays ::GLHooks::DeleteVertexArraysHook
+#define glBindVertexArray ::GLHooks::BindVertexArrayHook
+#define glGenBuffers ::GLHooks::GenBuffersHook
+#define glDeleteBuffers ::GLHooks::DeleteBuffersHook
+#define glBindBuffer ::GLHooks::BindBufferHook
+#define glBufferData ::GLHooks::BufferDataHook
+#define glBufferSubData ::GLHooks::BufferSubDataHook
+#define glMapBufferRange ::GLHooks::MapBufferRangeHook
+#define glUnmapBuffer ::GLHooks::UnmapBufferHook
+#define glBufferStorage ::GLHooks::BufferStorageHook
+#define glFenceSync ::GLHooks::FenceSyncHook
+#define glClientWaitSync ::GLHooks::ClientWaitSyncHook
+#define glDeleteSync ::GLHooks::DeleteSyncHook
+#define glVertexAttribPointer ::GLHooks::VertexAttribPointerHook
+#define glEnableVertexAttribArray ::GLHooks::EnableVertexAttribArrayHook
+#define glDrawElements ::GLHooks::DrawElementsHook
+#define glDrawElementsBaseVertex ::GLHooks::DrawElementsBaseVertexHook
+#define glMultiDrawElements ::GLHooks::MultiDrawElementsHook
+#define glDrawArrays ::GLHooks::DrawArraysHook
+#define glPolygonMode ::GLHooks::PolygonModeHook
+#define glEnable ::GLHooks::EnableHook
+#define glDisable ::GLHooks::DisableHook
+
+// The geometry comparison captures glBufferData uploads, so keep the
+// enhanced dynamic meshes on that path instead of the persistent-mapped
+// stream ring (which the hooks could not map anyway).
+#undef GLEW_VERSION_4_4
+#undef GLEW_ARB_buffer_storage
+#define GLEW_VERSION_4_4 false
+#define GLEW_ARB_buffer_storage false
+
+/******************************************
+ * Implementations Under Test
+ ******************************************/
+
+namespace original
+{
+#include "original/3D Shapes/ShapeMeshes.cpp"
+}
+
+namespace enhanced
+{
+#include "enhanced/3DShapes/ShapeMeshes.cpp"
+#include "enhanced/3DShapes/MeshCache.cpp"
+#include "enhanced/3DShapes/MeshCodec.cpp"
+#include "enhanced/3DShapes/MeshExport.cpp"
+#include "enhanced/3DShapes/MeshImport.cpp"
+#include "enhanced/3DShapes/MeshStreamRing.cpp"
+#include "enhanced/3DShapes/ProceduralGrid.cpp"
+#include "enhanced/3DShapes/MeshCompute.cpp"
+#include "enhanced/3DShapes/TessellatedSurface.cpp"
+#include "enhanced/3DShapes/MeshSweep.cpp"
+#include "enhanced/3DShapes/MeshLathe.cpp"
+}
+
+/******************************************
+ * Workloads
+ * ---------------------------------------
+ * Written once as templates so both versions
+ * run exactly the same calls. Only meshes
+ * present in both versions are exercised.
+ ******************************************/
+
+template <typename Meshes>
+void LoadAll(Meshes& m)
+{
+	m.LoadBoxMesh();
+	m.LoadConeMesh();
+	m.LoadCylinderMesh();
+	m.LoadPlaneMesh();
+	m.LoadPrismMesh();
+	m.LoadPyramid3Mesh();
+	m.LoadPyramid4Mesh();
+	m.LoadSphereMesh();
+	m.LoadHemisphereMesh();
+	m.LoadTaperedCylinderMesh();
+	m.LoadTorusMesh();
+	m.LoadExtraTorusMesh1();
+	m.LoadExtraTorusMesh2();
+	m.LoadSpringMesh();
+	m.LoadTubeMesh();
+	m.LoadFinMesh();
+	m.LoadCurvedConeMesh(18, 12, 0.5f, 2.0f, 3.0f);
+	m.LoadTaperedTorusMesh();
+	m.LoadSpiralMesh();
+	m.LoadSineConeMesh();
+}
+
+/******************************************
+ * DrawSubsets
+ * ---------------------------------------
+ * Parts of loaded meshes that are not one
+ * contiguous index range. The original draws
+ * the back and top of the box one side at a
+ * time; the enhanced version draws both from
+ * a side mask, and a cone arc across the
+ * 0 / 2 pi seam, with one glMultiDrawElements
+ * each. DrawMeshArc has no counterpart in the
+ * original, so the arc only shows on the
+ * enhanced side.
+ ******************************************/
+
+void DrawSubsets(original::ShapeMeshes& m)
+{
+	using BoxSide = original::ShapeMeshes::BoxSide;
+	m.DrawBoxMeshSide(BoxSide::back);
+	m.DrawBoxMeshSide(BoxSide::top);
+}
+
+void DrawSubsets(enhanced::ShapeMeshes& m)
+{
+	using Meshes = enhanced::ShapeMeshes;
+	m.DrawBoxMeshSides(Meshes::PartMask(Meshes::BoxSide::back) | Meshes::PartMask(Meshes::BoxSide::top));
+	m.DrawMeshArc(Meshes::ArcShape::cone, 5.0f, 7.5f, false);
+}
+
+template <typename Meshes>
+void DrawFrame(Meshes& m)
+{
+	m.DrawBoxMesh();
+	m.DrawConeMesh();
+	m.DrawCylinderMesh();
+	m.DrawPlaneMesh();
+	m.DrawPrismMesh();
+	m.DrawPyramid3Mesh();
+	m.DrawPyramid4Mesh();
+	m.DrawSphereMesh();
+	m.DrawHemisphereMesh();
+	m.DrawHalfSphereMesh();
+	m.DrawTaperedCylinderMesh();
+	m.DrawTorusMesh();
+	m.DrawHalfTorusMesh();
+	m.DrawExtraTorusMesh1();
+	m.DrawExtraTorusMesh2();
+	m.DrawSpringMesh();
+	m.DrawTubeMesh();
+	m.DrawFinMesh(false);
+	m.DrawCurvedConeMesh();
+	m.DrawPartialConeMesh(1.0f, 1.0f, 18, 270.0f, false);
+	m.DrawTaperedTorusMesh(1.0f, 0.3f, 0.05f, 36, 18, 2.0f * 3.14159265f);
+	m.DrawSpiralMesh(0.1f, 0.3f, 0.3f, 3.0f, 18, 72);
+	m.DrawSineConeMesh(0.5f, 2.0f, 0.2f, 0.1f, 2.0f, 0.0f, 18, 18);
+	DrawSubsets(m);
+}
+
+/******************************************
+ * Shape Cases
+ * ---------------------------------------
+ * One entry per shared shape for the geometry
+ * equivalence check. Each case runs on a fresh
+ * ShapeMeshes with upload capture enabled.
+ ******************************************/
+
+const char* const ShapeCaseNames[] = {
+	"box", "cone", "cylinder", "plane", "prism", "pyramid3", "pyramid4",
+	"sphere", "hemisphere", "tapered_cylinder", "torus", "extra_torus1",
+	"extra_torus2", "spring", "tube", "fin", "curved_cone",
+	"partial_cone", "tapered_torus", "spiral", "sine_cone"
+};
+
+constexpr int ShapeCaseCount = static_cast<int>(sizeof(ShapeCaseNames) / sizeof(ShapeCaseNames[0]));
+
+template <typename Meshes>
+void RunShapeCase(Meshes& m, int id)
+{
+	switch (id) {
+	case 0: m.LoadBoxMesh(); break;
+	case 1: m.LoadConeMesh(); break;
+	case 2: m.LoadCylinderMesh(); break;
+	case 3: m.LoadPlaneMesh(); break;
+	case 4: m.LoadPrismMesh(); break;
+	case 5: m.LoadPyramid3Mesh(); break;
+	case 6: m.LoadPyramid4Mesh(); break;
+	case 7: m.LoadSphereMesh(); break;
+	case 8: m.LoadHemisphereMesh(); break;
+	case 9: m.LoadTaperedCylinderMesh(); break;
+	case 10: m.LoadTorusMesh(); break;
+	case 11: m.LoadExtraTorusMesh1(); break;
+	case 12: m.LoadExtraTorusMesh2(); break;
+	case 13: m.LoadSpringMesh(); break;
+	case 14: m.LoadTubeMesh(); break;
+	case 15: m.LoadFinMesh(); break;
+	case 16: m.LoadCurvedConeMesh(18, 12, 0.5f, 2.0f, 3.0f); break;
+	case 17: m.DrawPartialConeMesh(1.0f, 1.0f, 18, 270.0f, false); break;
+	case 18: m.LoadTaperedTorusMesh(); m.DrawTaperedTorusMesh(1.0f, 0.3f, 0.05f, 36, 18, 2.0f * 3.14159265f); break;
+	case 19: m.LoadSpiralMesh(); m.DrawSpiralMesh(0.1f, 0.3f, 0.3f, 3.0f, 18, 72); break;
+	case 20: m.LoadSineConeMesh(); m.DrawSineConeMesh(0.5f, 2.0f, 0.2f, 0.1f, 2.0f, 0.0f, 18, 18); break;
+	}
+}
+
+/******************************************
+ * Measurement
+ ******************************************/
+
+struct WorkloadResult
+{
+	double bestMs = 0.0;
+	double meanMs = 0.0;
+	unsigned long long allocations = 0;   // per run / per frame
+	unsigned long long allocBytes = 0;    // per run / per frame
+	GLHooks::Counters gl;                 // per run / per frame
+};
+
+template <typename Meshes>
+WorkloadResult MeasureLoad(int runs)
+{
+	using Clock = std::chrono::steady_clock;
+	WorkloadResult result;
+	double total = 0.0;
+	double best = 1e300;
+
+	for (int i = 0; i < runs; ++i) {
+		Meshes meshes;
+		GLHooks::Reset();
+		unsigned long long bytesBefore = AllocStats::bytes, countBefore = AllocStats::count;
+
+		auto start = Clock::now();
+		LoadAll(meshes);
+		auto stop = Clock::now();
+
+		double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+		total += ms;
+		best = std::min(best, ms);
+
+		// Counts are identical from run to run; keep the last one.
+		result.allocations = AllocStats::count - countBefore;
+		result.allocBytes = AllocStats::bytes - bytesBefore;
+		result.gl = GLHooks::counters;
+	}
+
+	result.bestMs = best;
+	result.meanMs = total / runs;
+	return result;
+}
+
+template <typename Meshes>
+WorkloadResult MeasureDraw(int frames)
+{
+	using Clock = std::chrono::steady_clock;
+	WorkloadResult result;
+	double total = 0.0;
+	double best = 1e300;
+
+	Meshes meshes;
+	LoadAll(meshes);
+	DrawFrame(meshes);  // warm-up frame
+
+	for (int i = 0; i < frames; ++i) {
+		GLHooks::Reset();
+		unsigned long long bytesBefore = AllocStats::bytes, countBefore = AllocStats::count;
+
+		auto start = Clock::now();
+		DrawFrame(meshes);
+		auto stop = Clock::now();
+
+		double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+		total += ms;
+		best = std::min(best, ms);
+
+		result.allocations = AllocStats::count - countBefore;
+		result.allocBytes = AllocStats::bytes - bytesBefore;
+		result.gl = GLHooks::counters;
+	}
+
+	result.bestMs = best;
+	result.meanMs = total / frames;
+	return result;
+}
+
+/******************************************
+ * Geometry Equivalence
+ * ---------------------------------------
+ * Compares the captured uploads of one shape.
+ * Index buffers must match exactly; vertex
+ * buffers are compared as floats within a
+ * small absolute tolerance.
+ ******************************************/
+
+std::string CompareUploads(const std::vector<GLHooks::Upload>& a, const std::vector<GLHooks::Upload>& b)
+{
+	const float tolerance = 1e-4f;
+
+	if (a.size() != b.size())
+		return "upload count " + std::to_string(a.size()) + " vs " + std::to_string(b.size());
+
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (a[i].target != b[i].target)
+			return "upload " + std::to_string(i) + " target differs";
+		if (a[i].data.size() != b[i].data.size())
+			return "upload " + std::to_string(i) + " size " + std::to_string(a[i].data.size()) + " vs " + std::to_string(b[i].data.size());
+
+		if (a[i].target == GL_ARRAY_BUFFER) {
+			size_t count = a[i].data.size() / sizeof(GLfloat);
+			float maxError = 0.0f;
+			for (size_t k = 0; k < count; ++k) {
+				float fa, fb;
+				std::memcpy(&fa, &a[i].data[k * sizeof(GLfloat)], sizeof(GLfloat));
+				std::memcpy(&fb, &b[i].data[k * sizeof(GLfloat)], sizeof(GLfloat));
+				maxError = std::max(maxError, std::fabs(fa - fb));
+			}
+			if (!(maxError <= tolerance))
+				return "vertex data differs (max error " + std::to_string(maxError) + ")";
+		}
+		else if (a[i].data != b[i].data) {
+			return "index data differs";
+		}
+	}
+	return "";
+}
+
+/******************************************
+ * Reporting
+ ******************************************/
+
+void PrintRow(const char* label, double a, double b, int decimals = 0)
+{
+	double delta = b - a;
+	double pct = a != 0.0 ? 100.0 * delta / a : 0.0;
+	std::printf("  %-28s %14.*f %14.*f %+14.*f %+8.1f%%\n", label, decimals, a, decimals, b, decimals, delta, pct);
+}
+
+void PrintWorkload(const char* title, const WorkloadResult& a, const WorkloadResult& b)
+{
+	std::printf("\n%s\n", title);
+	std::printf("  %-28s %14s %14s %14s %9s\n", "", "original", "enhanced", "delta", "delta%");
+	PrintRow("best time (ms)", a.bestMs, b.bestMs, 3);
+	PrintRow("mean time (ms)", a.meanMs, b.meanMs, 3);
+	PrintRow("heap allocations", double(a.allocations), double(b.allocations));
+	PrintRow("heap bytes", double(a.allocBytes), double(b.allocBytes));
+	PrintRow("GL calls (total)", double(a.gl.TotalCalls()), double(b.gl.TotalCalls()));
+	for (int e = 0; e < GLHooks::EntryCount; ++e) {
+		if (a.gl.calls[e] || b.gl.calls[e])
+			PrintRow(GLHooks::EntryNames[e], double(a.gl.calls[e]), double(b.gl.calls[e]));
+	}
+	PrintRow("bytes uploaded", double(a.gl.bytesUploaded), double(b.gl.bytesUploaded));
+	PrintRow("indices drawn", double(a.gl.indicesDrawn), double(b.gl.indicesDrawn));
+	PrintRow("vertices drawn (arrays)", double(a.gl.verticesDrawn), double(b.gl.verticesDrawn));
+}
+
+int main(int argc, char** argv)
+{
+	int loadRuns = 50;
+	int frames = 200;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!std::strcmp(argv[i], "--load-runs") && i + 1 < argc) loadRuns = std::atoi(argv[++i]);
+		else if (!std::strcmp(argv[i], "--frames") && i + 1 < argc) frames = std::atoi(argv[++i]);
+		else {
+			std::fprintf(stderr, "Usage: %s [--load-runs N] [--frames N]\n", argv[0]);
+			return 2;
+		}
+	}
+	loadRuns = std::max(1, loadRuns);
+	frames = std::max(1, frames);
+
+	std::printf("ShapeMeshes A/B harness: original vs enhanced\n");
+	std::printf("load runs: %d, frames: %d\n", loadRuns, frames);
+
+	// Alternate the order so neither version always runs on a cold cache.
+	WorkloadResult loadA = MeasureLoad<original::ShapeMeshes>(loadRuns);
+	WorkloadResult loadB = MeasureLoad<enhanced::ShapeMeshes>(loadRuns);
+	WorkloadResult drawB = MeasureDraw<enhanced::ShapeMeshes>(frames);
+	WorkloadResult drawA = MeasureDraw<original::ShapeMeshes>(frames);
+
+	PrintWorkload("Load workload (per run)", loadA, loadB);
+	PrintWorkload("Draw workload (per frame)", drawA, drawB);
+
+	std::printf("\nGeometry equivalence\n");
+	int mismatches = 0;
+	for (int id = 0; id < ShapeCaseCount; ++id) {
+		std::vector<GLHooks::Upload> uploadsA, uploadsB;
+
+		{
+			original::ShapeMeshes meshes;
+			GLHooks::capture = &uploadsA;
+			RunShapeCase(meshes, id);
+		}
+		{
+			enhanced::ShapeMeshes meshes;
+			GLHooks::capture = &uploadsB;
+			RunShapeCase(meshes, id);
+		}
+		GLHooks::capture = nullptr;
+
+		std::string diff = CompareUploads(uploadsA, uploadsB);
+		if (!diff.empty()) ++mismatches;
+		std::printf("  %-20s %s\n", ShapeCaseNames[id], diff.empty() ? "match" : ("MISMATCH: " + diff).c_str());
+	}
+
+	std::printf("\n%d of %d shared shapes match\n", ShapeCaseCount - mismatches, ShapeCaseCount);
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/******************************************
+ * HeadlessContext
+ * ---------------------------------------
+ * A core-profile OpenGL context with no
+ * surface, for the ShapeMeshesCheck cases
+ * that need a GPU (Mesa llvmpipe works, with
+ * LIBGL_ALWAYS_SOFTWARE=1). Prefers the Mesa
+ * surfaceless platform and falls back to the
+ * default display. The context is current
+ * from a successful Create() until the
+ * object is destroyed.
+ *
+ * Each case creates its own, at the version
+ * it needs.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstdio>
+
+struct HeadlessContext {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    HeadlessContext() = default;
+    HeadlessContext(const HeadlessContext&) = delete;
+    HeadlessContext& operator=(const HeadlessContext&) = delete;
+
+    /******************************************
+     * Create
+     * ---------------------------------------
+     * Makes a major.minor core context current
+     * and initializes GLEW. Prints the reason
+     * and returns false on failure.
+     ******************************************/
+
+    bool Create(int major, int minor)
+    {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay)
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY)
+            display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            std::fprintf(stderr, "Error: no EGL display.\n");
+            return false;
+        }
+
+        const EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, 0, EGL_NONE };
+        EGLConfig config = nullptr;
+        EGLint configCount = 0;
+        if (!eglBindAPI(EGL_OPENGL_API) || !eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            std::fprintf(stderr, "Error: no EGL config for desktop OpenGL.\n");
+            return false;
+        }
+
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, major,
+            EGL_CONTEXT_MINOR_VERSION, minor,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            std::fprintf(stderr, "Error: cannot create a surfaceless OpenGL %d.%d context.\n", major, minor);
+            return false;
+        }
+
+        glewExperimental = GL_TRUE;
+        GLenum status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        // GLX builds of GLEW report this under EGL but load the core entry points.
+        if (status == GLEW_ERROR_NO_GLX_DISPLAY) status = GLEW_OK;
+#endif
+        if (status != GLEW_OK) {
+            std::fprintf(stderr, "Error: glewInit failed: %s\n", reinterpret_cast<const char*>(glewGetErrorString(status)));
+            return false;
+        }
+        return true;
+    }
+
+    ~HeadlessContext()
+    {
+        if (display == EGL_NO_DISPLAY) return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) eglDestroyContext(display, context);
+        eglTerminate(display);
+    }
+};
@@ -0,0 +1,422 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshBaker.cpp
+// =============
+// Build-time tool that runs ShapeMeshes generators from a manifest and
+// writes a single packed mesh bundle (see MeshBundle.h). At runtime,
+// ShapeMeshes::LoadMeshBundle() uploads the whole bundle in one call, so
+// no mesh generation happens at startup.
+//
+// Build (example):
+//   g++ -O2 -std=c++17 MeshBaker.cpp ShapeMeshes.cpp MeshCompute.cpp TessellatedSurface.cpp MeshSweep.cpp MeshLathe.cpp ProceduralGrid.cpp MeshCache.cpp MeshCodec.cpp MeshExport.cpp MeshImport.cpp MeshStreamRing.cpp -lGLEW -lGL
+//
+// Usage:
+//   MeshBaker <manifest> <output bundle>
+//
+// Manifest format (one directive or mesh per line, '#' starts a comment):
+//
+//   format float|half
+//   <name> <shape> <lods> [parameter=value ...]
+//
+//   - name: Mesh name in the bundle. Names of built-in meshes (sphere,
+//     cylinder, tapered_cylinder, extra_torus1, ...) are bound to those
+//     meshes by LoadMeshBundle.
+//   - shape: Generator to run (see ShapeRecipes below).
+//   - lods: Comma-separated resolutions, one bundle entry per level, or
+//     '-' for a single level at the shape's own parameters. Each level
+//     sets the shape's resolution parameters (slices, segments, ...).
+//   - parameters: Override the shape's defaults, e.g. radius=0.5.
+//
+// Example:
+//   format float
+//   sphere    sphere    12,24,48    radius=1
+//   cylinder  cylinder  16,36       height=2
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeMeshes.h"
+#include "MeshBundle.h"
+#include "MeshCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using ParamMap = std::map<std::string, float>;
+
+	int Int(const ParamMap& p, const char* name) { return static_cast<int>(p.at(name)); }
+
+	/******************************************
+	 * ShapeRecipe
+	 * ---------------------------------------
+	 * How to bake one generator.
+	 *
+	 * - defaults: Parameter names and values,
+	 *   matching the Load function defaults.
+	 * - lodParams: Parameters each LOD level sets.
+	 * - slicesParam / curveStepsParam: Parameters
+	 *   copied into the entry for the Draw code.
+	 ******************************************/
+
+	struct ShapeRecipe
+	{
+		const char* shape;
+		MeshGeneratorId generator;
+		ParamMap defaults;
+		std::vector<std::string> lodParams;
+		const char* slicesParam;
+		const char* curveStepsParam;
+		std::function<void(MeshData&, const ParamMap&)> generate;
+	};
+
+	const std::vector<ShapeRecipe>& ShapeRecipes()
+	{
+		static const std::vector<ShapeRecipe> recipes = {
+			{ "cone", MeshGeneratorId::Cone,
+				{ { "radius", 1.0f }, { "height", 1.0f }, { "slices", 18 } },
+				{ "slices" }, "slices", nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateConeMesh(m, p.at("radius"), p.at("height"), Int(p, "slices")); } },
+			{ "cylinder", MeshGeneratorId::Cylinder,
+				{ { "radius", 1.0f }, { "height", 1.0f }, { "slices", 36 } },
+				{ "slices" }, "slices", nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateCylinderMesh(m, p.at("radius"), p.at("height"), Int(p, "slices")); } },
+			{ "tapered_cylinder", MeshGeneratorId::TaperedCylinder,
+				{ { "bottom_radius", 1.0f }, { "top_radius", 0.5f }, { "height", 1.0f }, { "slices", 18 } },
+				{ "slices" }, "slices", nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateTaperedCylinderMesh(m, p.at("bottom_radius"), p.at("top_radius"), p.at("height"), Int(p, "slices")); } },
+			{ "sphere", MeshGeneratorId::Sphere,
+				{ { "latitude_segments", 18 }, { "longitude_segments", 18 }, { "radius", 1.0f } },
+				{ "latitude_segments", "longitude_segments" }, nullptr, nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateSphereMesh(m, Int(p, "latitude_segments"), Int(p, "longitude_segments"), p.at("radius")); } },
+			{ "hemisphere", MeshGeneratorId::Hemisphere,
+				{ { "latitude_segments", 18 }, { "longitude_segments", 18 }, { "radius", 1.0f } },
+				{ "latitude_segments", "longitude_segments" }, nullptr, nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateHemisphereMesh(m, Int(p, "latitude_segments"), Int(p, "longitude_segments"), p.at("radius")); } },
+			{ "torus", MeshGeneratorId::Torus,
+				{ { "main_radius", 1.0f }, { "tube_radius", 0.25f }, { "main_segments", 18 }, { "tube_segments", 18 } },
+				{ "main_segments", "tube_segments" }, nullptr, nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateTorusMesh(m, p.at("main_radius"), p.at("tube_radius"), Int(p, "main_segments"), Int(p, "tube_segments")); } },
+			{ "extra_torus", MeshGeneratorId::ExtraTorus,
+				{ { "thickness", 0.4f } },
+				{}, nullptr, nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateExtraTorusMesh(m, p.at("thickness")); } },
+			{ "spring", MeshGeneratorId::Spring,
+				{ { "main_radius", 1.0f }, { "tube_radius", 0.1f }, { "main_segments", 6 }, { "tube_segments", 18 }, { "length", 4.0f } },
+				{ "tube_segments" }, nullptr, nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateSpringMesh(m, p.at("main_radius"), p.at("tube_radius"), Int(p, "main_segments"), Int(p, "tube_segments"), p.at("length")); } },
+			{ "tube", MeshGeneratorId::Tube,
+				{ { "outer_radius", 2.0f }, { "inner_radius", 1.7f }, { "height", 1.0f }, { "slices", 30 } },
+				{ "slices" }, "slices", nullptr,
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateTubeMesh(m, p.at("outer_radius"), p.at("inner_radius"), p.at("height"), Int(p, "slices")); } },
+			{ "curved_cone", MeshGeneratorId::CurvedCone,
+				{ { "slices", 18 }, { "curve_steps", 12 }, { "radius", 0.5f }, { "height", 2.0f }, { "bend_radius", 3.0f } },
+				{ "slices" }, "slices", "curve_steps",
+				[](MeshData& m, const ParamMap& p) { ShapeMeshes::GenerateCurvedConeMesh(m, Int(p, "slices"), Int(p, "curve_steps"), p.at("radius"), p.at("height"), p.at("bend_radius")); } },
+		};
+		return recipes;
+	}
+
+	const ShapeRecipe* FindRecipe(const std::string& shape)
+	{
+		for (const ShapeRecipe& recipe : ShapeRecipes())
+			if (shape == recipe.shape) return &recipe;
+		return nullptr;
+	}
+
+	/******************************************
+	 * ManifestMesh
+	 * ---------------------------------------
+	 * One parsed manifest line.
+	 ******************************************/
+
+	struct ManifestMesh
+	{
+		std::string name;
+		const ShapeRecipe* recipe = nullptr;
+		std::vector<int> lods;      // empty = single level at the given parameters
+		ParamMap params;
+		int line = 0;
+	};
+
+	struct Manifest
+	{
+		BundleVertexFormat format = BundleVertexFormat::Float32;
+		std::vector<ManifestMesh> meshes;
+	};
+
+	bool Fail(const std::string& path, int line, const std::string& message)
+	{
+		std::cerr << path << ":" << line << ": error: " << message << std::endl;
+		return false;
+	}
+
+	bool ParseManifest(const std::string& path, Manifest& manifest)
+	{
+		std::ifstream in(path);
+		if (!in) {
+			std::cerr << "Error: cannot open manifest " << path << std::endl;
+			return false;
+		}
+
+		std::string text;
+		int lineNumber = 0;
+		while (std::getline(in, text)) {
+			++lineNumber;
+			size_t comment = text.find('#');
+			if (comment != std::string::npos) text.erase(comment);
+
+			std::istringstream line(text);
+			std::string first;
+			if (!(line >> first)) continue;
+
+			if (first == "format") {
+				std::string format;
+				line >> format;
+				if (format == "float") manifest.format = BundleVertexFormat::Float32;
+				else if (format == "half") manifest.format = BundleVertexFormat::Half16;
+				else return Fail(path, lineNumber, "unknown vertex format '" + format + "' (expected float or half)");
+				continue;
+			}
+
+			ManifestMesh mesh;
+			mesh.name = first;
+			mesh.line = lineNumber;
+			if (mesh.name.size() >= MeshBundleEntry::MaxNameLength)
+				return Fail(path, lineNumber, "mesh name '" + mesh.name + "' is too long");
+
+			std::string shape, lods;
+			if (!(line >> shape >> lods))
+				return Fail(path, lineNumber, "expected: <name> <shape> <lods> [parameter=value ...]");
+
+			mesh.recipe = FindRecipe(shape);
+			if (!mesh.recipe)
+				return Fail(path, lineNumber, "unknown shape '" + shape + "'");
+			mesh.params = mesh.recipe->defaults;
+
+			if (lods != "-") {
+				std::istringstream list(lods);
+				std::string level;
+				while (std::getline(list, level, ',')) {
+					int value = std::atoi(level.c_str());
+					if (value < 1) return Fail(path, lineNumber, "invalid LOD level '" + level + "'");
+					mesh.lods.push_back(value);
+				}
+				if (mesh.recipe->lodParams.empty() && mesh.lods.size() > 1)
+					return Fail(path, lineNumber, "shape '" + shape + "' has no resolution parameter; use '-' for lods");
+			}
+
+			std::string assignment;
+			while (line >> assignment) {
+				size_t equals = assignment.find('=');
+				std::string key = assignment.substr(0, equals);
+				if (equals == std::string::npos || !mesh.params.count(key))
+					return Fail(path, lineNumber, "unknown parameter '" + assignment + "' for shape '" + shape + "'");
+				mesh.params[key] = static_cast<float>(std::atof(assignment.c_str() + equals + 1));
+			}
+
+			for (const ManifestMesh& other : manifest.meshes)
+				if (other.name == mesh.name)
+					return Fail(path, lineNumber, "duplicate mesh name '" + mesh.name + "'");
+
+			manifest.meshes.push_back(mesh);
+		}
+
+		return true;
+	}
+
+	/******************************************
+	 * FloatToHalf
+	 * ---------------------------------------
+	 * IEEE 754 binary32 to binary16, rounding to
+	 * nearest even. Overflow saturates to
+	 * infinity; NaN stays NaN.
+	 ******************************************/
+
+	uint16_t FloatToHalf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		uint32_t sign = (bits >> 16) & 0x8000u;
+		uint32_t exponent = (bits >> 23) & 0xFFu;
+		uint32_t mantissa = bits & 0x7FFFFFu;
+
+		if (exponent == 0xFFu)
+			return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+		int halfExponent = static_cast<int>(exponent) - 127 + 15;
+		if (halfExponent >= 0x1F)
+			return static_cast<uint16_t>(sign | 0x7C00u);
+
+		if (halfExponent <= 0) {
+			if (halfExponent < -10) return static_cast<uint16_t>(sign);
+			mantissa |= 0x800000u;
+			uint32_t shift = static_cast<uint32_t>(14 - halfExponent);
+			uint32_t half = mantissa >> shift;
+			uint32_t rest = mantissa & ((1u << shift) - 1u);
+			uint32_t halfway = 1u << (shift - 1);
+			if (rest > halfway || (rest == halfway && (half & 1u))) ++half;
+			return static_cast<uint16_t>(sign | half);
+		}
+
+		uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+		uint32_t rest = mantissa & 0x1FFFu;
+		if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;  // may carry into the exponent, which is correct
+		return static_cast<uint16_t>(sign | half);
+	}
+
+	void AppendVertices(std::vector<unsigned char>& out, const std::vector<GLfloat>& vertices, BundleVertexFormat format)
+	{
+		if (format == BundleVertexFormat::Float32) {
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vertices.data());
+			out.insert(out.end(), bytes, bytes + vertices.size() * sizeof(GLfloat));
+			return;
+		}
+
+		size_t start = out.size();
+		out.resize(start + vertices.size() * sizeof(uint16_t));
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			uint16_t half = FloatToHalf(vertices[i]);
+			std::memcpy(&out[start + i * sizeof(uint16_t)], &half, sizeof(half));
+		}
+	}
+
+	uint64_t AlignUp(uint64_t value)
+	{
+		const uint64_t alignment = MeshBundleHeader::SectionAlignment;
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 3) {
+		std::cerr << "Usage: " << argv[0] << " <manifest> <output bundle>" << std::endl;
+		return 2;
+	}
+
+	const std::string manifestPath = argv[1];
+	const std::string outputPath = argv[2];
+
+	Manifest manifest;
+	if (!ParseManifest(manifestPath, manifest)) return 1;
+	if (manifest.meshes.empty()) {
+		std::cerr << "Error: manifest " << manifestPath << " lists no meshes" << std::endl;
+		return 1;
+	}
+
+	// --- Generate every mesh at every LOD level ---
+	std::vector<MeshBundleEntry> entries;
+	std::vector<unsigned char> vertexSection;
+	std::vector<GLuint> indexSection;
+	const size_t floatsPerVertex = sizeof(Vertex) / sizeof(GLfloat);
+
+	MeshData data;
+	for (const ManifestMesh& mesh : manifest.meshes) {
+		std::vector<int> levels = mesh.lods;
+		if (levels.empty()) levels.push_back(0);
+
+		for (size_t lod = 0; lod < levels.size(); ++lod) {
+			ParamMap params = mesh.params;
+			if (levels[lod] > 0)
+				for (const std::string& name : mesh.recipe->lodParams) params[name] = static_cast<float>(levels[lod]);
+
+			mesh.recipe->generate(data, params);
+
+			MeshBundleEntry entry = {};
+			std::strncpy(entry.name, mesh.name.c_str(), MeshBundleEntry::MaxNameLength - 1);
+			entry.generatorId = static_cast<uint32_t>(mesh.recipe->generator);
+			entry.lod = static_cast<uint32_t>(lod);
+			entry.baseVertex = static_cast<uint32_t>(vertexSection.size() / BundleVertexStride(manifest.format));
+			entry.vertexCount = data.VertexCount();
+			entry.firstIndex = static_cast<uint32_t>(indexSection.size());
+			entry.indexCount = data.IndexCount();
+			entry.numSlices = mesh.recipe->slicesParam ? std::max(3, Int(params, mesh.recipe->slicesParam)) : 0;
+			entry.curveSteps = mesh.recipe->curveStepsParam ? std::max(1, Int(params, mesh.recipe->curveStepsParam)) : 0;
+
+			if (data.subRanges.size() <= MeshBundleEntry::MaxParts) {
+				entry.partCount = static_cast<uint32_t>(data.subRanges.size());
+				for (uint32_t part = 0; part < entry.partCount; ++part) {
+					entry.partFirst[part] = data.subRanges[part].first;
+					entry.partIndexCount[part] = data.subRanges[part].count;
+				}
+			}
+			else {
+				std::cerr << "Warning: " << mesh.name << " has " << data.subRanges.size()
+					<< " parts, more than a bundle entry holds; its part table is left out" << std::endl;
+			}
+
+			for (int axis = 0; axis < 3; ++axis) {
+				entry.boundsMin[axis] = entry.vertexCount ? data.vertices[axis] : 0.0f;
+				entry.boundsMax[axis] = entry.boundsMin[axis];
+			}
+			for (size_t v = 0; v < entry.vertexCount; ++v) {
+				for (int axis = 0; axis < 3; ++axis) {
+					float value = data.vertices[v * floatsPerVertex + axis];
+					entry.boundsMin[axis] = std::min(entry.boundsMin[axis], value);
+					entry.boundsMax[axis] = std::max(entry.boundsMax[axis], value);
+				}
+			}
+
+			AppendVertices(vertexSection, data.vertices, manifest.format);
+			indexSection.insert(indexSection.end(), data.indices.begin(), data.indices.end());
+			entries.push_back(entry);
+
+			std::cout << "  " << mesh.name << " lod " << lod << ": "
+				<< entry.vertexCount << " vertices, " << entry.indexCount << " indices" << std::endl;
+		}
+	}
+
+	// --- Layout ---
+	MeshBundleHeader header = {};
+	header.magic = MeshBundleHeader::MagicValue;
+	header.formatVersion = MeshBundleHeader::FormatVersion;
+	header.codeVersion = ShapeMeshes::GeneratorVersion;
+	header.vertexFormat = static_cast<uint32_t>(manifest.format);
+	header.vertexStride = BundleVertexStride(manifest.format);
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.entryOffset = AlignUp(sizeof(MeshBundleHeader));
+	header.vertexOffset = AlignUp(header.entryOffset + entries.size() * sizeof(MeshBundleEntry));
+	header.vertexBytes = vertexSection.size();
+	header.indexOffset = AlignUp(header.vertexOffset + header.vertexBytes);
+	header.indexBytes = indexSection.size() * sizeof(GLuint);
+	header.fileSize = header.indexOffset + header.indexBytes;
+
+	// --- Write ---
+	std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::cerr << "Error: cannot write " << outputPath << std::endl;
+		return 1;
+	}
+
+	const char padding[MeshBundleHeader::SectionAlignment] = {};
+	auto pad = [&](uint64_t target) {
+		uint64_t position = static_cast<uint64_t>(out.tellp());
+		if (target > position) out.write(padding, static_cast<std::streamsize>(target - position));
+	};
+
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	pad(header.entryOffset);
+	out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(MeshBundleEntry)));
+	pad(header.vertexOffset);
+	out.write(reinterpret_cast<const char*>(vertexSection.data()), static_cast<std::streamsize>(vertexSection.size()));
+	pad(header.indexOffset);
+	out.write(reinterpret_cast<const char*>(indexSection.data()), static_cast<std::streamsize>(header.indexBytes));
+
+	if (!out) {
+		std::cerr << "Error: failed while writing " << outputPath << std::endl;
+		return 1;
+	}
+
+	std::cout << "Wrote " << outputPath << ": " << entries.size() << " entries, "
+		<< header.fileSize << " bytes" << std::endl;
+	return 0;
+}
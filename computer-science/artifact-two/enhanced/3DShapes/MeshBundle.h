@@ -0,0 +1,114 @@
+/******************************************
+ * MeshBundle
+ * ---------------------------------------
+ * File format for packed mesh bundles written
+ * by the MeshBaker tool and loaded at runtime
+ * by ShapeMeshes::LoadMeshBundle().
+ *
+ * Layout (all sections 16-byte aligned):
+ * - MeshBundleHeader
+ * - MeshBundleEntry table (one per mesh/LOD)
+ * - Vertex section: every entry's vertices,
+ *   back to back, in the bundle's vertex format.
+ * - Index section: every entry's indices,
+ *   back to back (GLuint, relative to the
+ *   entry's own first vertex).
+ *
+ * The vertex and index sections are adjacent,
+ * so the runtime uploads both into a single
+ * buffer with one glBufferData call.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+/******************************************
+ * BundleVertexFormat
+ * ---------------------------------------
+ * Vertex encodings a bundle can use. Both keep
+ * the position/normal/UV attribute order of
+ * Vertex.
+ *
+ * - Float32: 8 floats, 32 bytes (same as Vertex).
+ * - Half16: 8 half floats, 16 bytes.
+ ******************************************/
+
+enum class BundleVertexFormat : uint32_t {
+    Float32 = 1,
+    Half16 = 2
+};
+
+inline uint32_t BundleVertexStride(BundleVertexFormat format)
+{
+    return format == BundleVertexFormat::Half16 ? 8 * sizeof(uint16_t) : 8 * sizeof(float);
+}
+
+/******************************************
+ * MeshBundleHeader
+ * ---------------------------------------
+ * Fixed-size header at the start of a bundle.
+ * Offsets are bytes from the start of the file.
+ ******************************************/
+
+struct MeshBundleHeader {
+    static constexpr uint32_t MagicValue = 0x4E424D53;   // "SMBN"
+    static constexpr uint32_t FormatVersion = 2;   // 2: entries carry a part table
+    static constexpr uint32_t SectionAlignment = 16;
+
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t codeVersion;       // ShapeMeshes::GeneratorVersion used by the baker
+    uint32_t vertexFormat;      // BundleVertexFormat
+    uint32_t vertexStride;      // Bytes per vertex
+    uint32_t entryCount;
+
+    uint64_t entryOffset;
+    uint64_t vertexOffset;
+    uint64_t vertexBytes;
+    uint64_t indexOffset;
+    uint64_t indexBytes;
+    uint64_t fileSize;
+};
+
+/******************************************
+ * MeshBundleEntry
+ * ---------------------------------------
+ * One generated mesh at one LOD level.
+ *
+ * - name: Manifest name; entries whose name
+ *   matches a built-in mesh (sphere, torus,
+ *   ...) are bound to it at load time.
+ * - baseVertex / firstIndex: Position of the
+ *   entry in the vertex and index sections,
+ *   counted in vertices and indices.
+ * - numSlices / curveSteps: Copied to the
+ *   GLMesh, for Draw functions that split the
+ *   index range by slice count.
+ * - partCount / partFirst / partIndexCount:
+ *   The generator's sub-range table
+ *   (MeshData::subRanges), relative to
+ *   firstIndex, copied to GLMesh::subRanges.
+ ******************************************/
+
+struct MeshBundleEntry {
+    static constexpr uint32_t MaxNameLength = 32;
+    static constexpr uint32_t MaxParts = 6;
+
+    char name[MaxNameLength];
+    uint32_t generatorId;       // MeshGeneratorId
+    uint32_t lod;               // LOD level, 0 = first level in the manifest
+    uint32_t baseVertex;
+    uint32_t vertexCount;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t numSlices;
+    int32_t curveSteps;
+    float boundsMin[3];
+    float boundsMax[3];
+    uint32_t partCount;
+    uint32_t partFirst[MaxParts];
+    uint32_t partIndexCount[MaxParts];
+};
@@ -0,0 +1,384 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshCache.cpp
+// =============
+// Binary mesh cache: writing entries, and memory-mapping them back for
+// direct upload. See MeshCache.h for the file layout.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshCache.h"
+#include "MeshCodec.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr uint64_t SectionAlignment = 16;
+
+	uint64_t AlignUp(uint64_t value)
+	{
+		return (value + SectionAlignment - 1) & ~(SectionAlignment - 1);
+	}
+
+	// FNV-1a, 64-bit
+	uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+}
+
+/******************************************
+ * MeshCacheKey::Make
+ * ---------------------------------------
+ * Builds a key from a generator id and its
+ * arguments. The hash covers the exact bit
+ * patterns of the parameters, so any change
+ * selects a different entry.
+ ******************************************/
+
+MeshCacheKey MeshCacheKey::Make(MeshGeneratorId generator, std::initializer_list<float> params)
+{
+	MeshCacheKey key;
+	key.generator = generator;
+	key.codeVersion = ShapeMeshes::GeneratorVersion;
+	key.paramCount = static_cast<uint32_t>(std::min<size_t>(params.size(), MaxParams));
+	std::copy(params.begin(), params.begin() + key.paramCount, key.params);
+
+	uint64_t hash = 14695981039346656037ull;
+	uint32_t id = static_cast<uint32_t>(generator);
+	hash = HashBytes(hash, &id, sizeof(id));
+	hash = HashBytes(hash, key.params, key.paramCount * sizeof(float));
+	key.paramHash = hash;
+
+	return key;
+}
+
+/******************************************
+ * MappedFile
+ ******************************************/
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other) {
+		Close();
+		m_Data = other.m_Data;
+		m_Size = other.m_Size;
+		other.m_Data = nullptr;
+		other.m_Size = 0;
+#ifdef _WIN32
+		m_File = other.m_File;
+		m_Mapping = other.m_Mapping;
+		other.m_File = nullptr;
+		other.m_Mapping = nullptr;
+#endif
+	}
+	return *this;
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!base) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_File = file;
+	m_Mapping = mapping;
+	m_Data = static_cast<const unsigned char*>(base);
+	m_Size = static_cast<size_t>(size.QuadPart);
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);  // the mapping keeps the file referenced
+	if (base == MAP_FAILED) return false;
+
+	m_Data = static_cast<const unsigned char*>(base);
+	m_Size = static_cast<size_t>(info.st_size);
+#endif
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (!m_Data) return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_Data);
+	CloseHandle(static_cast<HANDLE>(m_Mapping));
+	CloseHandle(static_cast<HANDLE>(m_File));
+	m_File = nullptr;
+	m_Mapping = nullptr;
+#else
+	munmap(const_cast<unsigned char*>(m_Data), m_Size);
+#endif
+
+	m_Data = nullptr;
+	m_Size = 0;
+}
+
+/******************************************
+ * MappedMesh
+ ******************************************/
+
+bool MappedMesh::Open(const std::string& path, const MeshCacheKey& key)
+{
+	if (!m_File.Open(path)) return false;
+
+	if (m_File.Size() < sizeof(MeshCacheHeader)) {
+		Close();
+		return false;
+	}
+
+	// --- Validate header against the file and the key ---
+	const MeshCacheHeader& header = Header();
+	const size_t size = m_File.Size();
+	const uint64_t vertexBytes = static_cast<uint64_t>(header.vertexCount) * sizeof(Vertex);
+	const uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * sizeof(GLuint);
+	const uint64_t subRangeBytes = static_cast<uint64_t>(header.subRangeCount) * sizeof(MeshSubRange);
+	const bool compressed = (header.flags & MeshCacheHeader::CompressedFlag) != 0;
+
+	bool valid =
+		header.magic == MeshCacheHeader::MagicValue &&
+		header.formatVersion == MeshCacheHeader::FormatVersion &&
+		header.fileSize == size &&
+		(compressed ? header.vertexOffset + header.encodedBytes <= size
+			: header.vertexOffset + vertexBytes <= size && header.indexOffset + indexBytes <= size) &&
+		header.subRangeOffset + subRangeBytes <= size &&
+		header.vertexOffset % SectionAlignment == 0 &&
+		header.indexOffset % SectionAlignment == 0 &&
+		header.subRangeOffset % SectionAlignment == 0;
+
+	bool current = valid &&
+		header.generatorId == static_cast<uint32_t>(key.generator) &&
+		header.codeVersion == key.codeVersion &&
+		header.paramHash == key.paramHash &&
+		header.paramCount == key.paramCount &&
+		std::memcmp(header.params, key.params, key.paramCount * sizeof(float)) == 0;
+
+	if (!current) {
+		Close();
+		return false;
+	}
+
+	// --- Decode a compressed entry once, up front ---
+	if (compressed) {
+		const unsigned char* encoded = m_File.Data() + header.vertexOffset;
+		const EncodedMeshHeader* encodedHeader = MeshCodec::ReadHeader(encoded, static_cast<size_t>(header.encodedBytes));
+		if (!encodedHeader || encodedHeader->vertexCount != header.vertexCount || encodedHeader->indexCount != header.indexCount ||
+			!MeshCodec::Decode(encoded, static_cast<size_t>(header.encodedBytes), m_DecodedVertices, m_DecodedIndices)) {
+			Close();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void MappedMesh::Close()
+{
+	m_File.Close();
+	m_DecodedVertices.clear();
+	m_DecodedIndices.clear();
+}
+
+/******************************************
+ * MeshCache
+ ******************************************/
+
+MeshCache::MeshCache(std::string directory, bool compress)
+	: m_Directory(std::move(directory)), m_Compress(compress)
+{
+}
+
+std::string MeshCache::PathFor(const MeshCacheKey& key) const
+{
+	char name[64];
+	std::snprintf(name, sizeof(name), "mesh_%02u_%016llx.smc",
+		static_cast<unsigned>(key.generator), static_cast<unsigned long long>(key.paramHash));
+
+	if (m_Directory.empty()) return name;
+
+	char last = m_Directory.back();
+	return (last == '/' || last == '\\') ? m_Directory + name : m_Directory + "/" + name;
+}
+
+bool MeshCache::Open(const MeshCacheKey& key, MappedMesh& mapped) const
+{
+	return mapped.Open(PathFor(key), key);
+}
+
+/******************************************
+ * MeshCache::Store
+ * ---------------------------------------
+ * Writes the entry to a temporary file and
+ * renames it into place, so a reader never
+ * maps a half-written file.
+ *
+ * A compressed entry keeps the same layout,
+ * with the MeshCodec stream in place of the
+ * vertex and index sections.
+ ******************************************/
+
+bool MeshCache::Store(const MeshCacheKey& key, const MeshData& data) const
+{
+	MeshCacheHeader header = {};
+	header.magic = MeshCacheHeader::MagicValue;
+	header.formatVersion = MeshCacheHeader::FormatVersion;
+	header.generatorId = static_cast<uint32_t>(key.generator);
+	header.codeVersion = key.codeVersion;
+	header.paramHash = key.paramHash;
+	header.paramCount = key.paramCount;
+	std::memcpy(header.params, key.params, sizeof(header.params));
+
+	header.vertexCount = data.VertexCount();
+	header.indexCount = data.IndexCount();
+	header.subRangeCount = static_cast<uint32_t>(data.subRanges.size());
+
+	// --- Bounds ---
+	const size_t stride = sizeof(Vertex) / sizeof(GLfloat);
+	for (int axis = 0; axis < 3; ++axis) {
+		header.boundsMin[axis] = header.vertexCount ? data.vertices[axis] : 0.0f;
+		header.boundsMax[axis] = header.boundsMin[axis];
+	}
+	for (size_t v = 0; v < header.vertexCount; ++v) {
+		for (int axis = 0; axis < 3; ++axis) {
+			float value = data.vertices[v * stride + axis];
+			header.boundsMin[axis] = std::min(header.boundsMin[axis], value);
+			header.boundsMax[axis] = std::max(header.boundsMax[axis], value);
+		}
+	}
+
+	// --- Layout ---
+	const uint64_t vertexBytes = static_cast<uint64_t>(header.vertexCount) * sizeof(Vertex);
+	const uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * sizeof(GLuint);
+	const uint64_t subRangeBytes = static_cast<uint64_t>(header.subRangeCount) * sizeof(MeshSubRange);
+
+	std::vector<unsigned char> encoded;
+	if (m_Compress) {
+		if (!MeshCodec::Encode(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size(), encoded))
+			return false;
+		header.flags |= MeshCacheHeader::CompressedFlag;
+		header.encodedBytes = encoded.size();
+	}
+
+	header.vertexOffset = AlignUp(sizeof(MeshCacheHeader));
+	if (m_Compress) {
+		header.indexOffset = header.vertexOffset;
+		header.subRangeOffset = AlignUp(header.vertexOffset + header.encodedBytes);
+	}
+	else {
+		header.indexOffset = AlignUp(header.vertexOffset + vertexBytes);
+		header.subRangeOffset = AlignUp(header.indexOffset + indexBytes);
+	}
+	header.fileSize = header.subRangeOffset + subRangeBytes;
+
+	// --- Write ---
+	const std::string path = PathFor(key);
+	const std::string tempPath = path + ".tmp";
+
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			std::cerr << "Warning: could not write mesh cache file " << tempPath << std::endl;
+			return false;
+		}
+
+		const char padding[SectionAlignment] = {};
+		auto pad = [&](uint64_t target) {
+			uint64_t position = static_cast<uint64_t>(out.tellp());
+			if (target > position) out.write(padding, static_cast<std::streamsize>(target - position));
+		};
+
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		pad(header.vertexOffset);
+		if (m_Compress) {
+			out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+		}
+		else {
+			out.write(reinterpret_cast<const char*>(data.vertices.data()), static_cast<std::streamsize>(vertexBytes));
+			pad(header.indexOffset);
+			out.write(reinterpret_cast<const char*>(data.indices.data()), static_cast<std::streamsize>(indexBytes));
+		}
+		pad(header.subRangeOffset);
+		out.write(reinterpret_cast<const char*>(data.subRanges.data()), static_cast<std::streamsize>(subRangeBytes));
+
+		if (!out) {
+			std::cerr << "Warning: failed while writing mesh cache file " << tempPath << std::endl;
+			out.close();
+			std::remove(tempPath.c_str());
+			return false;
+		}
+	}
+
+	// std::rename does not replace an existing file on Windows
+	std::remove(path.c_str());
+	if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+		std::cerr << "Warning: could not move mesh cache file into place: " << path << std::endl;
+		std::remove(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
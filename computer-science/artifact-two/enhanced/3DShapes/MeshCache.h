@@ -0,0 +1,225 @@
+/******************************************
+ * MeshCache
+ * ---------------------------------------
+ * On-disk binary cache for generated meshes.
+ *
+ * Each cache entry is a single file holding the
+ * output of one GenerateXMesh call:
+ * - A header identifying the generator, its
+ *   parameters and the generator code version.
+ * - The interleaved Vertex array.
+ * - The index array.
+ * - The sub-range table.
+ * - The position bounds.
+ *
+ * Entries are memory-mapped on load so their
+ * vertex and index arrays can be handed to
+ * glBufferData directly, without regenerating
+ * or copying the mesh.
+ *
+ * A cache can instead store entries compressed
+ * with MeshCodec (quantized, so slightly lossy):
+ * the vertex section then holds the encoded
+ * mesh, which is decoded once on load.
+ ******************************************/
+
+#pragma once
+
+#include "ShapeMeshes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/******************************************
+ * MeshGeneratorId
+ * ---------------------------------------
+ * Stable identifiers for the cached mesh
+ * generators. Values are written to disk, so
+ * existing entries must never be renumbered.
+ ******************************************/
+
+enum class MeshGeneratorId : uint32_t {
+    Cone = 1,
+    Cylinder = 2,
+    TaperedCylinder = 3,
+    Sphere = 4,
+    Hemisphere = 5,
+    Torus = 6,
+    ExtraTorus = 7,
+    Spring = 8,
+    Tube = 9,
+    CurvedCone = 10
+};
+
+/******************************************
+ * MeshCacheKey
+ * ---------------------------------------
+ * Identifies one cache entry.
+ *
+ * - generator: Which GenerateXMesh built it.
+ * - params: The generator's arguments, in
+ *           declaration order (ints as floats).
+ * - paramHash: FNV-1a hash of generator + params,
+ *              used for the file name.
+ * - codeVersion: ShapeMeshes::GeneratorVersion
+ *                at the time the entry was built.
+ ******************************************/
+
+struct MeshCacheKey {
+    static constexpr uint32_t MaxParams = 12;
+
+    MeshGeneratorId generator = MeshGeneratorId::Cone;
+    uint32_t paramCount = 0;
+    float params[MaxParams] = {};
+    uint64_t paramHash = 0;
+    uint32_t codeVersion = 0;
+
+    static MeshCacheKey Make(MeshGeneratorId generator, std::initializer_list<float> params);
+};
+
+/******************************************
+ * MeshCacheHeader
+ * ---------------------------------------
+ * Fixed-size header at the start of every
+ * cache file. All offsets are in bytes from
+ * the start of the file and are 16-byte
+ * aligned.
+ ******************************************/
+
+struct MeshCacheHeader {
+    static constexpr uint32_t MagicValue = 0x48434D53;   // "SMCH"
+    static constexpr uint32_t FormatVersion = 2;
+    static constexpr uint32_t CompressedFlag = 1;   // vertex section holds a MeshCodec stream
+
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t generatorId;
+    uint32_t codeVersion;
+    uint64_t paramHash;
+    uint32_t paramCount;
+    float params[MeshCacheKey::MaxParams];
+
+    uint32_t vertexCount;       // Vertex records (8 floats each)
+    uint32_t indexCount;
+    uint32_t subRangeCount;
+    uint32_t flags;
+
+    float boundsMin[3];
+    float boundsMax[3];
+
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t subRangeOffset;
+    uint64_t encodedBytes;      // Size of the MeshCodec stream (compressed entries only)
+    uint64_t fileSize;
+};
+
+/******************************************
+ * MappedFile
+ * ---------------------------------------
+ * Read-only memory mapping of a whole file
+ * (mmap on POSIX, MapViewOfFile on Windows).
+ * The data pointer stays valid until Close()
+ * or destruction. Move-only.
+ ******************************************/
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return m_Data != nullptr; }
+    const unsigned char* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+
+private:
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
+
+/******************************************
+ * MappedMesh
+ * ---------------------------------------
+ * A mapped cache entry. The pointers stay
+ * valid until Close() or destruction. For a
+ * compressed entry they point at the decoded
+ * copy rather than into the mapping.
+ ******************************************/
+
+class MappedMesh
+{
+public:
+    /******************************************
+     * Open
+     * ---------------------------------------
+     * Maps the file and validates it against the
+     * key. Returns false if the file is missing,
+     * truncated, from another format version, or
+     * was built from different parameters or
+     * generator code (a stale entry).
+     ******************************************/
+
+    bool Open(const std::string& path, const MeshCacheKey& key);
+    void Close();
+
+    bool IsOpen() const { return m_File.IsOpen(); }
+    bool IsCompressed() const { return (Header().flags & MeshCacheHeader::CompressedFlag) != 0; }
+
+    const MeshCacheHeader& Header() const { return *reinterpret_cast<const MeshCacheHeader*>(m_File.Data()); }
+    const GLfloat* Vertices() const { return IsCompressed() ? m_DecodedVertices.data() : reinterpret_cast<const GLfloat*>(m_File.Data() + Header().vertexOffset); }
+    const GLuint* Indices() const { return IsCompressed() ? m_DecodedIndices.data() : reinterpret_cast<const GLuint*>(m_File.Data() + Header().indexOffset); }
+    const MeshSubRange* SubRanges() const { return reinterpret_cast<const MeshSubRange*>(m_File.Data() + Header().subRangeOffset); }
+
+    size_t VertexFloatCount() const { return static_cast<size_t>(Header().vertexCount) * (sizeof(Vertex) / sizeof(GLfloat)); }
+    size_t IndexCount() const { return Header().indexCount; }
+    size_t SubRangeCount() const { return Header().subRangeCount; }
+
+private:
+    MappedFile m_File;
+    std::vector<GLfloat> m_DecodedVertices;
+    std::vector<GLuint> m_DecodedIndices;
+};
+
+/******************************************
+ * MeshCache
+ * ---------------------------------------
+ * Directory of cache entries.
+ *
+ * - Open(key, mapped): Maps the entry for key.
+ *   Returns false on a miss or stale entry.
+ * - Store(key, data): Writes data as the entry
+ *   for key, replacing any stale file. With
+ *   compress set, the entry is written through
+ *   MeshCodec. Open() reads either kind.
+ ******************************************/
+
+class MeshCache
+{
+public:
+    explicit MeshCache(std::string directory, bool compress = false);
+
+    std::string PathFor(const MeshCacheKey& key) const;
+
+    bool Open(const MeshCacheKey& key, MappedMesh& mapped) const;
+    bool Store(const MeshCacheKey& key, const MeshData& data) const;
+
+private:
+    std::string m_Directory;
+    bool m_Compress;
+};
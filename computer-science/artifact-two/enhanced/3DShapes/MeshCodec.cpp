@@ -0,0 +1,499 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshCodec.cpp
+// =============
+// Quantizing, delta-coding, bit-packing mesh codec. See MeshCodec.h for the
+// encoding and EncodedMeshHeader for the layout.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshCodec.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace
+{
+	constexpr uint32_t BlockSize = 32;                 // values per bit-packed block
+	constexpr uint32_t VertexFloats = 8;               // position, normal, UV
+	constexpr uint32_t VertexChannels = 7;             // streams per vertex (normal is 2 oct components)
+	constexpr uint32_t IndexStream = VertexChannels;   // stream number of the index list
+
+	size_t AlignUp4(size_t value)
+	{
+		return (value + 3) & ~static_cast<size_t>(3);
+	}
+
+	uint32_t ZigZag(uint32_t delta)
+	{
+		return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+	}
+
+	uint32_t UnZigZag(uint32_t value)
+	{
+		return (value >> 1) ^ (0u - (value & 1u));
+	}
+
+	uint32_t BitWidth(uint32_t value)
+	{
+		uint32_t width = 0;
+		while (value) {
+			++width;
+			value >>= 1;
+		}
+		return width;
+	}
+
+	uint32_t MaxQuantized(uint32_t bits)
+	{
+		return bits >= 32 ? 0xFFFFFFFFu : (1u << bits) - 1u;
+	}
+
+	/******************************************
+	 * Quantizer
+	 * ---------------------------------------
+	 * Maps one float channel onto [0, 2^bits - 1]
+	 * over the channel's range.
+	 ******************************************/
+
+	struct Quantizer
+	{
+		float min = 0.0f;
+		float step = 0.0f;
+		uint32_t maxValue = 0;
+
+		void Fit(const GLfloat* vertices, size_t vertexCount, uint32_t component, uint32_t bits)
+		{
+			maxValue = MaxQuantized(bits);
+			if (vertexCount == 0) return;
+
+			float lo = vertices[component];
+			float hi = lo;
+			for (size_t v = 1; v < vertexCount; ++v) {
+				float value = vertices[v * VertexFloats + component];
+				lo = std::min(lo, value);
+				hi = std::max(hi, value);
+			}
+
+			min = lo;
+			step = (hi - lo) / static_cast<float>(maxValue);
+			if (!(step > 0.0f) || !std::isfinite(step)) step = 0.0f;
+		}
+
+		uint32_t Quantize(float value) const
+		{
+			if (step == 0.0f) return 0;
+			float q = std::round((value - min) / step);
+			return static_cast<uint32_t>(std::min(std::max(q, 0.0f), static_cast<float>(maxValue)));
+		}
+	};
+
+	/******************************************
+	 * Octahedral Normals
+	 * ---------------------------------------
+	 * Projects a unit vector onto the octahedron
+	 * |x| + |y| + |z| = 1 and unfolds the lower
+	 * half over the upper, giving two components
+	 * in [-1, 1].
+	 ******************************************/
+
+	float SignNotZero(float value)
+	{
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	void OctEncode(float x, float y, float z, float& u, float& v)
+	{
+		float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+		if (!(l1 > 0.0f)) {
+			u = 0.0f;
+			v = 0.0f;
+			return;
+		}
+
+		u = x / l1;
+		v = y / l1;
+		if (z < 0.0f) {
+			float foldedU = (1.0f - std::fabs(v)) * SignNotZero(u);
+			float foldedV = (1.0f - std::fabs(u)) * SignNotZero(v);
+			u = foldedU;
+			v = foldedV;
+		}
+	}
+
+	/******************************************
+	 * EncodeStream
+	 * ---------------------------------------
+	 * Appends one stream: a byte of bit width
+	 * per block (padded to 4 bytes), then each
+	 * block's zigzag deltas packed into exactly
+	 * width 32-bit words, then one zero word of
+	 * padding.
+	 ******************************************/
+
+	void EncodeStream(const std::vector<uint32_t>& values, std::vector<unsigned char>& out)
+	{
+		const size_t count = values.size();
+		const size_t blocks = (count + BlockSize - 1) / BlockSize;
+
+		const size_t widthsAt = out.size();
+		out.resize(widthsAt + AlignUp4(blocks), 0);
+
+		std::vector<uint32_t> words;
+		uint32_t previous = 0;
+		uint32_t deltas[BlockSize];
+
+		for (size_t block = 0; block < blocks; ++block) {
+			const size_t first = block * BlockSize;
+			uint32_t combined = 0;
+
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				uint32_t delta = 0;
+				if (first + i < count) {
+					delta = ZigZag(values[first + i] - previous);
+					previous = values[first + i];
+				}
+				deltas[i] = delta;
+				combined |= delta;
+			}
+
+			const uint32_t width = BitWidth(combined);
+			out[widthsAt + block] = static_cast<unsigned char>(width);
+
+			const size_t base = words.size();
+			words.resize(base + width, 0);
+			for (uint32_t i = 0; i < BlockSize && width > 0; ++i) {
+				const uint32_t bit = i * width;
+				const uint32_t word = bit >> 5;
+				const uint32_t shift = bit & 31;
+				words[base + word] |= deltas[i] << shift;
+				if (shift + width > 32)
+					words[base + word + 1] |= deltas[i] >> (32 - shift);
+			}
+		}
+
+		words.push_back(0);
+
+		const size_t wordsAt = out.size();
+		out.resize(wordsAt + words.size() * sizeof(uint32_t));
+		std::memcpy(&out[wordsAt], words.data(), words.size() * sizeof(uint32_t));
+	}
+
+	/******************************************
+	 * UnpackBlock
+	 * ---------------------------------------
+	 * Extracts 32 values of Width bits. One
+	 * instance per width, fully unrolled through
+	 * an index sequence, so every word index,
+	 * shift and mask is a compile-time constant
+	 * and the compiler can vectorise the block.
+	 ******************************************/
+
+	template <uint32_t Width, uint32_t Index>
+	inline uint32_t ExtractValue(const uint32_t* in)
+	{
+		constexpr uint32_t mask = Width == 32 ? 0xFFFFFFFFu : (1u << Width) - 1u;
+		constexpr uint32_t bit = Index * Width;
+		constexpr uint32_t word = bit >> 5;
+		constexpr uint32_t shift = bit & 31;
+
+		if constexpr (shift + Width <= 32)
+			return (in[word] >> shift) & mask;
+		else
+			return ((in[word] >> shift) | (in[word + 1] << (32 - shift))) & mask;
+	}
+
+	template <uint32_t Width, size_t... Index>
+	inline void UnpackValues(const uint32_t* in, uint32_t* out, std::index_sequence<Index...>)
+	{
+		((out[Index] = ExtractValue<Width, static_cast<uint32_t>(Index)>(in)), ...);
+	}
+
+	template <uint32_t Width>
+	void UnpackBlock(const uint32_t* in, uint32_t* out)
+	{
+		if constexpr (Width == 0)
+			std::fill(out, out + BlockSize, 0u);
+		else
+			UnpackValues<Width>(in, out, std::make_index_sequence<BlockSize>());
+	}
+
+	using UnpackFunction = void (*)(const uint32_t*, uint32_t*);
+
+	template <size_t... Widths>
+	constexpr std::array<UnpackFunction, sizeof...(Widths)> MakeUnpackTable(std::index_sequence<Widths...>)
+	{
+		return { { &UnpackBlock<static_cast<uint32_t>(Widths)>... } };
+	}
+
+	constexpr std::array<UnpackFunction, 33> Unpackers = MakeUnpackTable(std::make_index_sequence<33>());
+
+	/******************************************
+	 * StreamReader
+	 * ---------------------------------------
+	 * Decodes one stream block by block. Bounds
+	 * are checked once by ReadHeader.
+	 ******************************************/
+
+	struct StreamReader
+	{
+		const unsigned char* widths = nullptr;
+		const uint32_t* words = nullptr;
+		uint32_t previous = 0;
+
+		void Open(const unsigned char* data, const EncodedMeshHeader& header, uint32_t stream, size_t count)
+		{
+			widths = data + header.streamOffset[stream];
+			words = reinterpret_cast<const uint32_t*>(widths + AlignUp4((count + BlockSize - 1) / BlockSize));
+			previous = 0;
+		}
+
+		void Next(uint32_t* out)
+		{
+			const uint32_t width = *widths++;
+			Unpackers[width](words, out);
+			words += width;
+
+			for (uint32_t i = 0; i < BlockSize; ++i) out[i] = UnZigZag(out[i]);
+			uint32_t value = previous;
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				value += out[i];
+				out[i] = value;
+			}
+			previous = value;
+		}
+	};
+
+	size_t StreamValueCount(const EncodedMeshHeader& header, uint32_t stream)
+	{
+		return stream == IndexStream ? header.indexCount : header.vertexCount;
+	}
+}
+
+namespace MeshCodec
+{
+	/******************************************
+	 * Encode
+	 ******************************************/
+
+	bool Encode(const GLfloat* vertices, size_t vertexFloatCount, const GLuint* indices, size_t indexCount,
+		std::vector<unsigned char>& out, const Options& options)
+	{
+		if (vertexFloatCount % VertexFloats != 0) {
+			std::cerr << "Error: MeshCodec::Encode expects whole vertices (8 floats each)." << std::endl;
+			return false;
+		}
+		if (options.positionBits < 1 || options.positionBits > 24 ||
+			options.normalBits < 2 || options.normalBits > 24 ||
+			options.uvBits < 1 || options.uvBits > 24) {
+			std::cerr << "Error: MeshCodec::Encode bit counts out of range." << std::endl;
+			return false;
+		}
+
+		const size_t vertexCount = vertexFloatCount / VertexFloats;
+
+		// --- Quantize every channel ---
+		Quantizer position[3], uv[2];
+		for (uint32_t axis = 0; axis < 3; ++axis) position[axis].Fit(vertices, vertexCount, axis, options.positionBits);
+		for (uint32_t axis = 0; axis < 2; ++axis) uv[axis].Fit(vertices, vertexCount, 6 + axis, options.uvBits);
+		const float normalMax = static_cast<float>(MaxQuantized(options.normalBits));
+
+		std::vector<uint32_t> channels[VertexChannels];
+		for (std::vector<uint32_t>& channel : channels) channel.resize(vertexCount);
+
+		for (size_t v = 0; v < vertexCount; ++v) {
+			const GLfloat* vertex = vertices + v * VertexFloats;
+
+			for (uint32_t axis = 0; axis < 3; ++axis)
+				channels[axis][v] = position[axis].Quantize(vertex[axis]);
+
+			float octU, octV;
+			OctEncode(vertex[3], vertex[4], vertex[5], octU, octV);
+			channels[3][v] = static_cast<uint32_t>(std::round((octU * 0.5f + 0.5f) * normalMax));
+			channels[4][v] = static_cast<uint32_t>(std::round((octV * 0.5f + 0.5f) * normalMax));
+
+			for (uint32_t axis = 0; axis < 2; ++axis)
+				channels[5 + axis][v] = uv[axis].Quantize(vertex[6 + axis]);
+		}
+
+		// --- Header ---
+		EncodedMeshHeader header = {};
+		header.magic = EncodedMeshHeader::MagicValue;
+		header.formatVersion = EncodedMeshHeader::FormatVersion;
+		header.vertexCount = static_cast<uint32_t>(vertexCount);
+		header.indexCount = static_cast<uint32_t>(indexCount);
+		header.positionBits = options.positionBits;
+		header.normalBits = options.normalBits;
+		header.uvBits = options.uvBits;
+		for (uint32_t axis = 0; axis < 3; ++axis) {
+			header.positionMin[axis] = position[axis].min;
+			header.positionStep[axis] = position[axis].step;
+		}
+		for (uint32_t axis = 0; axis < 2; ++axis) {
+			header.uvMin[axis] = uv[axis].min;
+			header.uvStep[axis] = uv[axis].step;
+		}
+
+		// --- Streams ---
+		out.clear();
+		out.resize(AlignUp4(sizeof(EncodedMeshHeader)), 0);
+
+		for (uint32_t stream = 0; stream < VertexChannels; ++stream) {
+			header.streamOffset[stream] = out.size();
+			EncodeStream(channels[stream], out);
+		}
+
+		header.streamOffset[IndexStream] = out.size();
+		EncodeStream(std::vector<uint32_t>(indices, indices + indexCount), out);
+
+		header.totalBytes = out.size();
+		std::memcpy(out.data(), &header, sizeof(header));
+		return true;
+	}
+
+	/******************************************
+	 * ReadHeader
+	 ******************************************/
+
+	const EncodedMeshHeader* ReadHeader(const unsigned char* data, size_t size)
+	{
+		if (!data || size < sizeof(EncodedMeshHeader)) return nullptr;
+
+		const EncodedMeshHeader* header = reinterpret_cast<const EncodedMeshHeader*>(data);
+		if (header->magic != EncodedMeshHeader::MagicValue ||
+			header->formatVersion != EncodedMeshHeader::FormatVersion ||
+			header->totalBytes > size)
+			return nullptr;
+
+		// Each stream's widths and words must end (with the padding word)
+		// before the next stream starts.
+		for (uint32_t stream = 0; stream < EncodedMeshHeader::StreamCount; ++stream) {
+			const uint64_t start = header->streamOffset[stream];
+			const uint64_t limit = stream + 1 < EncodedMeshHeader::StreamCount ? header->streamOffset[stream + 1] : header->totalBytes;
+			const uint64_t blocks = (StreamValueCount(*header, stream) + BlockSize - 1) / BlockSize;
+
+			if (start % 4 != 0 || start < sizeof(EncodedMeshHeader) || start > limit || limit > header->totalBytes)
+				return nullptr;
+			if (AlignUp4(blocks) > limit - start)
+				return nullptr;
+
+			uint64_t words = 1;
+			for (uint64_t block = 0; block < blocks; ++block) {
+				const uint32_t width = data[start + block];
+				if (width > 32) return nullptr;
+				words += width;
+			}
+			if (AlignUp4(blocks) + words * sizeof(uint32_t) > limit - start)
+				return nullptr;
+		}
+
+		return header;
+	}
+
+	/******************************************
+	 * Decode
+	 * ---------------------------------------
+	 * Works through the vertex streams 32
+	 * vertices at a time: one block from each of
+	 * the seven channel streams, decoded channel
+	 * by channel into scratch, then interleaved
+	 * into the 32 vertices they describe.
+	 ******************************************/
+
+	bool Decode(const unsigned char* data, size_t size, GLfloat* vertices, GLuint* indices)
+	{
+		const EncodedMeshHeader* header = ReadHeader(data, size);
+		if (!header) return false;
+
+		const uint32_t vertexCount = header->vertexCount;
+		const uint32_t indexCount = header->indexCount;
+
+		StreamReader streams[EncodedMeshHeader::StreamCount];
+		for (uint32_t stream = 0; stream < EncodedMeshHeader::StreamCount; ++stream)
+			streams[stream].Open(data, *header, stream, StreamValueCount(*header, stream));
+
+		// --- Vertices ---
+		const float px = header->positionMin[0], py = header->positionMin[1], pz = header->positionMin[2];
+		const float sx = header->positionStep[0], sy = header->positionStep[1], sz = header->positionStep[2];
+		const float tu = header->uvMin[0], tv = header->uvMin[1];
+		const float su = header->uvStep[0], sv = header->uvStep[1];
+		const float normalScale = 2.0f / static_cast<float>(MaxQuantized(header->normalBits));
+
+		uint32_t channel[VertexChannels][BlockSize];
+		float decoded[VertexFloats][BlockSize];
+
+		for (uint32_t first = 0; first < vertexCount; first += BlockSize) {
+			for (uint32_t stream = 0; stream < VertexChannels; ++stream)
+				streams[stream].Next(channel[stream]);
+
+			// Whole blocks, one channel at a time, so each loop vectorizes.
+			// Quantized values fit in 24 bits, so the signed conversion is exact.
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				decoded[0][i] = px + static_cast<float>(static_cast<int32_t>(channel[0][i])) * sx;
+				decoded[1][i] = py + static_cast<float>(static_cast<int32_t>(channel[1][i])) * sy;
+				decoded[2][i] = pz + static_cast<float>(static_cast<int32_t>(channel[2][i])) * sz;
+			}
+
+			float inverseLength[BlockSize];
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				float nx = static_cast<float>(static_cast<int32_t>(channel[3][i])) * normalScale - 1.0f;
+				float ny = static_cast<float>(static_cast<int32_t>(channel[4][i])) * normalScale - 1.0f;
+				float nz = 1.0f - std::fabs(nx) - std::fabs(ny);
+				float fold = std::max(-nz, 0.0f);
+				nx += nx >= 0.0f ? -fold : fold;
+				ny += ny >= 0.0f ? -fold : fold;
+				decoded[3][i] = nx;
+				decoded[4][i] = ny;
+				decoded[5][i] = nz;
+				inverseLength[i] = nx * nx + ny * ny + nz * nz;
+			}
+
+			// std::sqrt may set errno, which keeps it out of the loops above and below.
+			for (uint32_t i = 0; i < BlockSize; ++i)
+				inverseLength[i] = 1.0f / std::sqrt(inverseLength[i]);
+
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				decoded[3][i] *= inverseLength[i];
+				decoded[4][i] *= inverseLength[i];
+				decoded[5][i] *= inverseLength[i];
+			}
+
+			for (uint32_t i = 0; i < BlockSize; ++i) {
+				decoded[6][i] = tu + static_cast<float>(static_cast<int32_t>(channel[5][i])) * su;
+				decoded[7][i] = tv + static_cast<float>(static_cast<int32_t>(channel[6][i])) * sv;
+			}
+
+			const uint32_t count = std::min(BlockSize, vertexCount - first);
+			GLfloat* out = vertices + static_cast<size_t>(first) * VertexFloats;
+			for (uint32_t i = 0; i < count; ++i, out += VertexFloats)
+				for (uint32_t k = 0; k < VertexFloats; ++k) out[k] = decoded[k][i];
+		}
+
+		// --- Indices, none past the last vertex ---
+		// Whole blocks decode straight into the output; the last one goes
+		// through scratch so nothing is written past indexCount.
+		uint32_t block[BlockSize];
+		uint32_t maxIndex = 0;
+		for (uint32_t first = 0; first < indexCount; first += BlockSize) {
+			const uint32_t count = std::min(BlockSize, indexCount - first);
+			uint32_t* out = count == BlockSize ? indices + first : block;
+			streams[IndexStream].Next(out);
+			for (uint32_t i = 0; i < count; ++i) maxIndex = std::max(maxIndex, out[i]);
+			if (out == block) std::memcpy(indices + first, block, count * sizeof(GLuint));
+		}
+
+		return indexCount == 0 || maxIndex < vertexCount;
+	}
+
+	bool Decode(const unsigned char* data, size_t size, std::vector<GLfloat>& vertices, std::vector<GLuint>& indices)
+	{
+		const EncodedMeshHeader* header = ReadHeader(data, size);
+		if (!header) return false;
+
+		vertices.resize(static_cast<size_t>(header->vertexCount) * VertexFloats);
+		indices.resize(header->indexCount);
+		return Decode(data, size, vertices.data(), indices.data());
+	}
+}
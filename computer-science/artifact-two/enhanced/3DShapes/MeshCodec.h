@@ -0,0 +1,137 @@
+/******************************************
+ * MeshCodec
+ * ---------------------------------------
+ * Lossy compression for generated meshes
+ * (interleaved Vertex data plus GLuint
+ * indices), with no external dependencies.
+ *
+ * Encoding:
+ * - Positions and UVs are quantized to a fixed
+ *   number of bits over the mesh's bounds.
+ * - Normals are octahedron-mapped to two
+ *   components, then quantized.
+ * - Every attribute channel and the index list
+ *   become separate streams of integers that
+ *   are delta coded (zigzag, against the
+ *   previous value) and bit-packed in blocks of
+ *   32 values, each block using the smallest
+ *   bit width that fits it.
+ *
+ * Decoding unpacks each block with a routine
+ * specialised for its bit width (fixed shifts,
+ * no branches), so the compiler can vectorise
+ * it. Each 32-vertex block is decoded channel
+ * by channel into scratch, then interleaved
+ * into the vertex layout. That runs at 1.2-2.3
+ * GB/s on a 2 GHz core, a quarter to a third
+ * of memcpy and short of the multiple GB/s a
+ * loader would want: the delta sums, the
+ * normal's sqrt and the interleave stay scalar.
+ *
+ * Quantization error is at most half a step:
+ * extent / (2^bits - 1) / 2 per position axis
+ * or UV component. Zero-length normals decode
+ * as (0, 0, 1).
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/******************************************
+ * EncodedMeshHeader
+ * ---------------------------------------
+ * Fixed-size header at the start of every
+ * encoded mesh. Stream offsets are bytes from
+ * the start of the header, 4-byte aligned.
+ *
+ * Streams, in order: position x, y, z; normal
+ * octahedral u, v; texture u, v; indices.
+ ******************************************/
+
+struct EncodedMeshHeader {
+    static constexpr uint32_t MagicValue = 0x5A434D53;   // "SMCZ"
+    static constexpr uint32_t FormatVersion = 1;
+    static constexpr uint32_t StreamCount = 8;
+
+    uint32_t magic;
+    uint32_t formatVersion;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+
+    uint32_t positionBits;
+    uint32_t normalBits;
+    uint32_t uvBits;
+    uint32_t reserved;
+
+    float positionMin[3];
+    float positionStep[3];      // Quantization step per axis (0 for a flat axis)
+    float uvMin[2];
+    float uvStep[2];
+
+    uint64_t streamOffset[StreamCount];
+    uint64_t totalBytes;
+};
+
+namespace MeshCodec
+{
+    /******************************************
+     * Options
+     * ---------------------------------------
+     * Quantization precision, in bits per
+     * component. The defaults keep position
+     * error below 1/100000 of the mesh size and
+     * normal error below 0.05 degrees.
+     ******************************************/
+
+    struct Options {
+        uint32_t positionBits = 16;   // 1..24
+        uint32_t normalBits = 12;     // 2..24
+        uint32_t uvBits = 14;         // 1..24
+    };
+
+    /******************************************
+     * Encode
+     * ---------------------------------------
+     * Compresses a mesh into out (replacing its
+     * contents). Returns false for a vertex array
+     * that is not whole Vertex records or for
+     * out-of-range options.
+     *
+     * @param vertices Interleaved Vertex data (8 floats each).
+     * @param vertexFloatCount Number of floats in vertices.
+     * @param indices Index data (may be null when indexCount is 0).
+     * @param indexCount Number of indices.
+     ******************************************/
+
+    bool Encode(const GLfloat* vertices, size_t vertexFloatCount, const GLuint* indices, size_t indexCount,
+        std::vector<unsigned char>& out, const Options& options = Options());
+
+    /******************************************
+     * ReadHeader
+     * ---------------------------------------
+     * Validates an encoded mesh's header and
+     * stream table. Returns nullptr if the data
+     * is not a well-formed encoded mesh.
+     ******************************************/
+
+    const EncodedMeshHeader* ReadHeader(const unsigned char* data, size_t size);
+
+    /******************************************
+     * Decode
+     * ---------------------------------------
+     * Decompresses into caller-provided arrays
+     * of vertexCount * 8 floats and indexCount
+     * indices (see ReadHeader), or into vectors
+     * that are resized to fit. Returns false if
+     * the data is malformed, including an index
+     * that is not below vertexCount.
+     ******************************************/
+
+    bool Decode(const unsigned char* data, size_t size, GLfloat* vertices, GLuint* indices);
+    bool Decode(const unsigned char* data, size_t size, std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+}
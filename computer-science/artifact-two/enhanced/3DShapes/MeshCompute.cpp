@@ -0,0 +1,539 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshCompute.cpp
+// ===============
+// Compute-shader mesh generation. See MeshCompute.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshCompute.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	constexpr GLint PassVertices = 0;
+	constexpr GLint PassNormals = 1;     // Sine cone only, after PassVertices
+	constexpr GLint PassIndices = 2;     // Spiral only
+
+	constexpr GLuint LocalSize = 64;
+	constexpr GLuint MaxGroupsX = 65535;
+	constexpr uint32_t SpiralCapRings = 8;
+
+	constexpr GLuint VertexBinding = 0;
+	constexpr GLuint IndexBinding = 1;
+	constexpr GLuint FrameBinding = 2;
+
+	/******************************************
+	 * MeshComputeShader
+	 * ---------------------------------------
+	 * One invocation per vertex (or, for the
+	 * spiral's indices, per quad). Each branch
+	 * follows the CPU generator of the same
+	 * shape line for line, so the results
+	 * differ only by float rounding.
+	 *
+	 * Large meshes are dispatched as a 2D grid
+	 * of groups, so the invocation index is
+	 * flattened from gl_GlobalInvocationID and
+	 * anything past invocationCount returns.
+	 ******************************************/
+
+	const char* const MeshComputeShader = R"GLSL(#version 430 core
+
+layout(local_size_x = 64) in;
+
+const int ShapeSpring = 0;
+const int ShapeSpiral = 1;
+const int ShapeSineCone = 2;
+const int ShapeSuperellipsoid = 3;
+
+const int PassVertices = 0;
+const int PassNormals = 1;
+const int PassIndices = 2;
+
+const uint SpiralCapRings = 8u;
+const float Pi = 3.141592653589793;
+
+uniform int meshShape;
+uniform int meshPass;
+uniform uvec2 meshSize;        // rows, cols
+uniform vec4 meshParams[2];
+uniform uint invocationCount;
+
+layout(std430, binding = 0) buffer Vertices { float vertices[]; };
+layout(std430, binding = 1) writeonly buffer Indices { uint indices[]; };
+layout(std430, binding = 2) readonly buffer Frames { vec4 frames[]; };   // center, tangent, normal, binormal per ring
+
+void WriteVertex(uint k, vec3 position, vec3 normal, vec2 uv)
+{
+	uint base = k * 8u;
+	vertices[base + 0u] = position.x;
+	vertices[base + 1u] = position.y;
+	vertices[base + 2u] = position.z;
+	vertices[base + 3u] = normal.x;
+	vertices[base + 4u] = normal.y;
+	vertices[base + 5u] = normal.z;
+	vertices[base + 6u] = uv.x;
+	vertices[base + 7u] = uv.y;
+}
+
+vec3 ReadPosition(uint k)
+{
+	uint base = k * 8u;
+	return vec3(vertices[base], vertices[base + 1u], vertices[base + 2u]);
+}
+
+void WriteQuad(uint quad, uint a, uint b, uint c, uint d)
+{
+	uint base = quad * 6u;
+	indices[base + 0u] = a;
+	indices[base + 1u] = b;
+	indices[base + 2u] = c;
+	indices[base + 3u] = c;
+	indices[base + 4u] = b;
+	indices[base + 5u] = d;
+}
+
+float SignedPow(float x, float e)
+{
+	return sign(x) * pow(abs(x), e);
+}
+
+// GenerateSpringMesh: rows = coil steps, cols = tube segments.
+void SpringVertex(uint id)
+{
+	uint i = id / (meshSize.y + 1u);
+	uint j = id - i * (meshSize.y + 1u);
+	float mainRadius = meshParams[0].x;
+	float tubeRadius = meshParams[0].y;
+	float springLength = meshParams[0].z;
+
+	float mainAngleStep = (2.0 * Pi) / float(meshSize.y);
+	float heightStep = springLength / float(meshSize.x);
+	float mainAngle = float(i) * mainAngleStep;
+	vec3 center = vec3(mainRadius * cos(mainAngle), mainRadius * sin(mainAngle), float(i) * heightStep);
+
+	vec3 tangent = normalize(vec3(-mainRadius * sin(mainAngle), mainRadius * cos(mainAngle), heightStep));
+	vec3 normal = normalize(vec3(-tangent.y, tangent.x, 0.0));
+	vec3 binormal = cross(tangent, normal);
+
+	float tubeAngle = float(j) * 2.0 * Pi / float(meshSize.y);
+	float tx = tubeRadius * cos(tubeAngle);
+	float ty = tubeRadius * sin(tubeAngle);
+
+	WriteVertex(id, center + normal * tx + binormal * ty, normalize(normal * tx + binormal * ty),
+		vec2(float(i) / float(meshSize.x), float(j) / float(meshSize.y)));
+}
+
+// BuildSpiralMesh: rows = rings, cols = tube segments; the cap's rings follow the tube's.
+void SpiralVertex(uint id)
+{
+	float tubeRadius = meshParams[0].x;
+	float flattenFactor = meshParams[0].y;
+	float tubeStep = 2.0 * Pi / float(meshSize.y);
+	uint ringVertices = meshSize.x * meshSize.y;
+
+	if (id < ringVertices) {
+		uint i = id / meshSize.y;
+		uint j = id - i * meshSize.y;
+		vec3 center = frames[i * 4u].xyz;
+		vec3 normal = frames[i * 4u + 2u].xyz;
+		vec3 binormal = frames[i * 4u + 3u].xyz;
+
+		float phi = float(j) * tubeStep;
+		vec3 offset = cos(phi) * normal * (1.0 - flattenFactor) + sin(phi) * binormal;
+		WriteVertex(id, center + offset * tubeRadius, normalize(offset),
+			vec2(float(j) / float(meshSize.y), float(i) / float(meshSize.x - 1u)));
+	}
+	else {
+		// Hemisphere cap in the first ring's frame
+		uint c = id - ringVertices;
+		uint ring = c / meshSize.y + 1u;
+		uint j = c - (ring - 1u) * meshSize.y;
+		vec3 capCenter = frames[0].xyz;
+		vec3 capTangent = frames[1].xyz;
+		vec3 capNormal = frames[2].xyz;
+		vec3 capBinormal = frames[3].xyz;
+
+		float theta = (float(ring) * Pi * 0.5) / float(SpiralCapRings);
+		float r = sin(theta);
+		float z = cos(theta);
+		float phi = float(j) * tubeStep;
+
+		vec3 radial = cos(phi) * capNormal * (1.0 - flattenFactor) + sin(phi) * capBinormal;
+		vec3 offset = radial * r * tubeRadius + capTangent * z * tubeRadius;
+		WriteVertex(id, capCenter - offset, normalize(-offset), vec2(float(j) / float(meshSize.y), -z));
+	}
+}
+
+// Tube quads, then the cap's quads, then the seam between cap and tube.
+void SpiralQuad(uint quad)
+{
+	uint cols = meshSize.y;
+	uint tubeQuads = (meshSize.x - 1u) * cols;
+	uint capQuads = (SpiralCapRings - 1u) * cols;
+	uint capBase = meshSize.x * cols;
+
+	if (quad < tubeQuads + capQuads) {
+		uint base = quad < tubeQuads ? 0u : capBase;
+		uint q = quad < tubeQuads ? quad : quad - tubeQuads;
+		uint i = q / cols;
+		uint j = q - i * cols;
+		uint jNext = (j + 1u) % cols;
+		WriteQuad(quad, base + i * cols + j, base + (i + 1u) * cols + j, base + i * cols + jNext, base + (i + 1u) * cols + jNext);
+	}
+	else {
+		uint j = quad - tubeQuads - capQuads;
+		uint jNext = (j + 1u) % cols;
+		uint capRing = capBase + (SpiralCapRings - 1u) * cols;
+		WriteQuad(quad, capRing + j, j, capRing + jNext, jNext);
+	}
+}
+
+// BuildSineConeMesh, first half: positions and UVs. Normals are left at zero.
+void SineConePosition(uint id)
+{
+	uint i = id / (meshSize.y + 1u);
+	uint j = id - i * (meshSize.y + 1u);
+	float baseRadius = meshParams[0].x;
+	float height = meshParams[0].y;
+	float flattenFactor = meshParams[0].z;
+	float sineAmplitude = meshParams[0].w;
+	float sineFrequency = meshParams[1].x;
+	float sinePhase = meshParams[1].y;
+
+	float radialStep = 2.0 * Pi / float(meshSize.y);
+	float heightStep = height / float(meshSize.x);
+	float h = float(i) * heightStep;
+	float t = float(i) / float(meshSize.x);
+
+	float radius = baseRadius * pow(1.0 - t, 0.65);
+	float sineOffset = sineAmplitude * sin(sineFrequency * t * 2.0 * Pi + sinePhase);
+
+	float theta = float(j) * radialStep;
+	vec3 offset = normalize(vec3(0.0, cos(theta), sin(theta))) * radius;
+	offset.y *= (1.0 - flattenFactor);
+	offset.y += sineOffset;
+
+	WriteVertex(id, vec3(h, offset.y, offset.z), vec3(0.0),
+		vec2(float(j) / float(meshSize.y), float(i) / float(meshSize.x)));
+}
+
+// Area-weighted face normals of quad (qi, qj), as the CPU accumulates them.
+void QuadNormals(uint qi, uint qj, out vec3 n0, out vec3 n1, out float area0, out float area1)
+{
+	uint stride = meshSize.y + 1u;
+	vec3 p0 = ReadPosition(qi * stride + qj);
+	vec3 p1 = ReadPosition((qi + 1u) * stride + qj);
+	vec3 p2 = ReadPosition(qi * stride + qj + 1u);
+	vec3 p3 = ReadPosition((qi + 1u) * stride + qj + 1u);
+
+	n0 = cross(p1 - p0, p2 - p0);
+	n1 = cross(p3 - p2, p1 - p2);
+	area0 = length(n0);
+	area1 = length(n1);
+}
+
+// BuildSineConeMesh, second half: each vertex gathers what the CPU scatters
+// from its (up to) four quads, in the CPU's order.
+void SineConeNormal(uint id)
+{
+	uint stride = meshSize.y + 1u;
+	uint i = id / stride;
+	uint j = id - i * stride;
+	vec3 n0, n1;
+	float area0, area1;
+	vec3 sum = vec3(0.0);
+
+	if (i > 0u && j > 0u) {
+		QuadNormals(i - 1u, j - 1u, n0, n1, area0, area1);
+		sum += n1 * area1;
+	}
+	if (i > 0u && j < meshSize.y) {
+		QuadNormals(i - 1u, j, n0, n1, area0, area1);
+		sum += (n0 + n1) * 0.5 * (area0 + area1);
+	}
+	if (i < meshSize.x && j > 0u) {
+		QuadNormals(i, j - 1u, n0, n1, area0, area1);
+		sum += (n0 + n1) * 0.5 * (area0 + area1);
+	}
+	if (i < meshSize.x && j < meshSize.y) {
+		QuadNormals(i, j, n0, n1, area0, area1);
+		sum += n0 * area0;
+	}
+
+	vec3 normal = normalize(sum);
+	uint base = id * 8u;
+	vertices[base + 3u] = normal.x;
+	vertices[base + 4u] = normal.y;
+	vertices[base + 5u] = normal.z;
+}
+
+// BuildSuperellipsoidMesh: u in [-pi/2, pi/2] by row, v in [-pi, pi] by col.
+void SuperellipsoidVertex(uint id)
+{
+	uint i = id / (meshSize.y + 1u);
+	uint j = id - i * (meshSize.y + 1u);
+	vec3 scale = meshParams[0].xyz;
+	float verticalExponent = meshParams[0].w;
+	float horizontalExponent = meshParams[1].x;
+
+	float u = -Pi * 0.5 + float(i) / float(meshSize.x) * Pi;
+	float v = -Pi + float(j) / float(meshSize.y) * (2.0 * Pi);
+	vec3 surface = vec3(SignedPow(cos(u), verticalExponent) * SignedPow(cos(v), horizontalExponent),
+		SignedPow(cos(u), verticalExponent) * SignedPow(sin(v), horizontalExponent),
+		SignedPow(sin(u), verticalExponent));
+
+	WriteVertex(id, scale * surface, normalize(surface / scale),
+		vec2(float(j) / float(meshSize.y), float(i) / float(meshSize.x)));
+}
+
+void main()
+{
+	uint id = gl_GlobalInvocationID.y * gl_NumWorkGroups.x * gl_WorkGroupSize.x + gl_GlobalInvocationID.x;
+	if (id >= invocationCount) return;
+
+	if (meshPass == PassIndices) SpiralQuad(id);
+	else if (meshPass == PassNormals) SineConeNormal(id);
+	else if (meshShape == ShapeSpring) SpringVertex(id);
+	else if (meshShape == ShapeSpiral) SpiralVertex(id);
+	else if (meshShape == ShapeSineCone) SineConePosition(id);
+	else SuperellipsoidVertex(id);
+}
+)GLSL";
+
+	uint32_t ComputeGridCount(int segments)
+	{
+		return static_cast<uint32_t>(std::max(0, segments));
+	}
+
+	bool CheckStatus(GLuint object, GLenum status, bool program)
+	{
+		GLint ok = GL_FALSE;
+		if (program) glGetProgramiv(object, status, &ok);
+		else glGetShaderiv(object, status, &ok);
+		if (ok == GL_TRUE) return true;
+
+		GLint logLength = 0;
+		if (program) glGetProgramiv(object, GL_INFO_LOG_LENGTH, &logLength);
+		else glGetShaderiv(object, GL_INFO_LOG_LENGTH, &logLength);
+
+		std::string log(static_cast<size_t>(std::max(logLength, 1)), '\0');
+		if (program) glGetProgramInfoLog(object, logLength, nullptr, &log[0]);
+		else glGetShaderInfoLog(object, logLength, nullptr, &log[0]);
+
+		std::cerr << "Error: mesh compute shader failed to " << (program ? "link" : "compile") << ":\n" << log.c_str() << std::endl;
+		return false;
+	}
+}
+
+/******************************************
+ * ComputeMeshParams
+ ******************************************/
+
+size_t ComputeMeshParams::VertexCount() const
+{
+	if (rows == 0 || cols == 0) return 0;
+	if (shape == ComputeMeshShape::Spiral) return static_cast<size_t>(rows + SpiralCapRings) * cols;
+	return static_cast<size_t>(rows + 1) * (cols + 1);
+}
+
+size_t ComputeMeshParams::IndexCount() const
+{
+	if (rows == 0 || cols == 0) return 0;
+	if (shape == ComputeMeshShape::Spiral) return static_cast<size_t>(rows - 1 + SpiralCapRings) * cols * 6;
+	return static_cast<size_t>(rows) * cols * 6;
+}
+
+ComputeMeshParams ComputeMeshParams::Spring(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, float springLength)
+{
+	ComputeMeshParams mesh;
+	mesh.shape = ComputeMeshShape::Spring;
+	mesh.cols = ComputeGridCount(std::max(8, tubeSegments));
+	mesh.rows = ComputeGridCount(std::max(1, mainSegments)) * mesh.cols;
+	mesh.params[0] = mainRadius;
+	mesh.params[1] = tubeRadius;
+	mesh.params[2] = springLength;
+	return mesh;
+}
+
+ComputeMeshParams ComputeMeshParams::Spiral(float tubeRadius, float flattenFactor, int tubeSegments, size_t ringCount)
+{
+	ComputeMeshParams mesh;
+	mesh.shape = ComputeMeshShape::Spiral;
+	mesh.rows = ringCount >= 2 ? static_cast<uint32_t>(ringCount) : 0;   // BuildSpiralMesh needs two rings
+	mesh.cols = ComputeGridCount(tubeSegments);
+	mesh.gridIndices = false;
+	mesh.params[0] = tubeRadius;
+	mesh.params[1] = flattenFactor;
+	return mesh;
+}
+
+ComputeMeshParams ComputeMeshParams::SineCone(float baseRadius, float height, float flattenFactor, float sineAmplitude,
+	float sineFrequency, float sinePhase, int radialSegments, int heightSegments)
+{
+	ComputeMeshParams mesh;
+	mesh.shape = ComputeMeshShape::SineCone;
+	mesh.rows = ComputeGridCount(heightSegments);
+	mesh.cols = ComputeGridCount(radialSegments);
+	mesh.params[0] = baseRadius;
+	mesh.params[1] = height;
+	mesh.params[2] = flattenFactor;
+	mesh.params[3] = sineAmplitude;
+	mesh.params[4] = sineFrequency;
+	mesh.params[5] = sinePhase;
+	return mesh;
+}
+
+ComputeMeshParams ComputeMeshParams::Superellipsoid(float scaleX, float scaleY, float scaleZ,
+	float verticalExponent, float horizontalExponent, int uSegments, int vSegments)
+{
+	ComputeMeshParams mesh;
+	mesh.shape = ComputeMeshShape::Superellipsoid;
+	mesh.rows = ComputeGridCount(std::max(3, uSegments));
+	mesh.cols = ComputeGridCount(std::max(3, vSegments));
+	mesh.params[0] = scaleX > 0.0f ? scaleX : 0.1f;
+	mesh.params[1] = scaleY > 0.0f ? scaleY : 0.1f;
+	mesh.params[2] = scaleZ > 0.0f ? scaleZ : 0.1f;
+	mesh.params[3] = verticalExponent > 0.0f ? verticalExponent : 0.1f;
+	mesh.params[4] = horizontalExponent > 0.0f ? horizontalExponent : 0.1f;
+	return mesh;
+}
+
+/******************************************
+ * MeshComputeGenerator
+ ******************************************/
+
+MeshComputeGenerator::~MeshComputeGenerator()
+{
+	Release();
+}
+
+bool MeshComputeGenerator::IsSupported()
+{
+	return GLEW_VERSION_4_3 || (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object);
+}
+
+bool MeshComputeGenerator::Create()
+{
+	Release();
+
+	GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+	glShaderSource(shader, 1, &MeshComputeShader, nullptr);
+	glCompileShader(shader);
+	if (!CheckStatus(shader, GL_COMPILE_STATUS, false)) {
+		glDeleteShader(shader);
+		return false;
+	}
+
+	GLuint program = glCreateProgram();
+	glAttachShader(program, shader);
+	glLinkProgram(program);
+	glDeleteShader(shader);
+	if (!CheckStatus(program, GL_LINK_STATUS, true)) {
+		glDeleteProgram(program);
+		return false;
+	}
+
+	m_Program = program;
+	m_ShapeLocation = glGetUniformLocation(program, "meshShape");
+	m_PassLocation = glGetUniformLocation(program, "meshPass");
+	m_SizeLocation = glGetUniformLocation(program, "meshSize");
+	m_ParamsLocation = glGetUniformLocation(program, "meshParams");
+	m_CountLocation = glGetUniformLocation(program, "invocationCount");
+	glGenBuffers(1, &m_FrameBuffer);
+	return true;
+}
+
+void MeshComputeGenerator::Release()
+{
+	if (m_Program != 0) glDeleteProgram(m_Program);
+	if (m_FrameBuffer != 0) glDeleteBuffers(1, &m_FrameBuffer);
+	m_Program = 0;
+	m_FrameBuffer = 0;
+}
+
+/******************************************
+ * Generate
+ * ---------------------------------------
+ * The sine cone's normal pass reads the
+ * positions of neighbouring vertices, so a
+ * shader storage barrier separates it from
+ * the position pass. The closing barrier
+ * covers everything the written buffers are
+ * used for next: attribute and index fetch
+ * for drawing, and glMapBufferRange /
+ * glGetBufferSubData for ExportMesh and the
+ * check tool.
+ *
+ * The caller's program is restored, so this
+ * can run in the middle of a scene's draws.
+ ******************************************/
+
+void MeshComputeGenerator::Generate(const ComputeMeshParams& mesh, GLuint vertexBuffer, GLuint indexBuffer, bool writeIndices,
+	const std::vector<SpiralFrame>* frames)
+{
+	const size_t vertexCount = mesh.VertexCount();
+	if (!IsReady() || vertexCount == 0) return;
+
+	const bool spiral = mesh.shape == ComputeMeshShape::Spiral;
+	if (spiral && (!frames || frames->size() < mesh.rows)) {
+		std::cerr << "Error: spiral compute generation needs one frame per ring; nothing was generated." << std::endl;
+		return;
+	}
+
+	GLint previousProgram = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+
+	glUseProgram(m_Program);
+	glUniform1i(m_ShapeLocation, static_cast<GLint>(mesh.shape));
+	glUniform2ui(m_SizeLocation, mesh.rows, mesh.cols);
+	glUniform4fv(m_ParamsLocation, 2, mesh.params);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, VertexBinding, vertexBuffer);
+
+	if (spiral) {
+		// Orphaned on every upload, so a pending dispatch never stalls this.
+		const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(mesh.rows * sizeof(SpiralFrame));
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_FrameBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, frameBytes, frames->data(), GL_STREAM_DRAW);
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, FrameBinding, m_FrameBuffer);
+	}
+
+	Dispatch(PassVertices, vertexCount);
+
+	if (mesh.shape == ComputeMeshShape::SineCone) {
+		glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+		Dispatch(PassNormals, vertexCount);
+	}
+
+	if (spiral && writeIndices) {
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, IndexBinding, indexBuffer);
+		Dispatch(PassIndices, mesh.IndexCount() / 6);
+	}
+
+	glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	for (GLuint binding : { VertexBinding, IndexBinding, FrameBinding })
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+	glUseProgram(static_cast<GLuint>(previousProgram));
+}
+
+/******************************************
+ * Dispatch
+ * ---------------------------------------
+ * Spreads invocations over a 2D grid of work
+ * groups once they exceed the 65535 groups a
+ * single dimension is guaranteed to allow.
+ ******************************************/
+
+void MeshComputeGenerator::Dispatch(GLint pass, size_t invocations)
+{
+	const size_t groups = (invocations + LocalSize - 1) / LocalSize;
+	const GLuint groupsX = static_cast<GLuint>(std::min<size_t>(groups, MaxGroupsX));
+	const GLuint groupsY = static_cast<GLuint>((groups + groupsX - 1) / groupsX);
+
+	glUniform1i(m_PassLocation, pass);
+	glUniform1ui(m_CountLocation, static_cast<GLuint>(invocations));
+	glDispatchCompute(groupsX, groupsY, 1);
+}
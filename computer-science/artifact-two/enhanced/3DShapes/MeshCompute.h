@@ -0,0 +1,163 @@
+/******************************************
+ * MeshCompute
+ * ---------------------------------------
+ * Compute-shader generation for the meshes
+ * that are expensive to build on the CPU at
+ * high resolution: the spring, spiral, sine
+ * cone and superellipsoid. The shaders write
+ * interleaved Vertex data (and, for the
+ * spiral, indices) straight into the mesh's
+ * own VBO and EBO, bound as shader storage
+ * buffers, so nothing is generated or copied
+ * on the CPU.
+ *
+ * Every kernel follows the CPU generator of
+ * the same shape, so vertex k matches vertex k
+ * of GenerateXMesh to within float rounding.
+ * The grid shapes draw with the shared grid
+ * index buffer (see GridTopology), as their
+ * CPU path does.
+ *
+ * Needs OpenGL 4.3, or ARB_compute_shader and
+ * ARB_shader_storage_buffer_object; see
+ * IsSupported(). The MeshCompute case of
+ * ShapeMeshesCheck.cpp compares the two paths
+ * and times them.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Values of the meshShape uniform.
+enum class ComputeMeshShape : GLint {
+    Spring = 0,
+    Spiral = 1,
+    SineCone = 2,
+    Superellipsoid = 3
+};
+
+/******************************************
+ * SpiralFrame
+ * ---------------------------------------
+ * One ring of the spiral's centerline: its
+ * center and the tangent, normal and binormal
+ * of its transported frame, padded to vec4 for
+ * the std430 frame buffer. The frames are a
+ * sequential scan along the curve, so they
+ * are built on the CPU by
+ * ShapeMeshes::GenerateSpiralFrames (one
+ * entry per ring, not per vertex) and only
+ * the rings are expanded on the GPU.
+ ******************************************/
+
+struct SpiralFrame {
+    GLfloat center[4];
+    GLfloat tangent[4];
+    GLfloat normal[4];
+    GLfloat binormal[4];
+};
+
+/******************************************
+ * ComputeMeshParams
+ * ---------------------------------------
+ * One compute generation: the shape, its
+ * vertex grid and its parameters packed the
+ * way the shader reads them.
+ *
+ * - rows / cols: Quads of the grid; the grid
+ *   shapes have (rows + 1) x (cols + 1)
+ *   vertices. For the spiral, rows is the
+ *   number of centerline rings and cols the
+ *   tube segments.
+ * - gridIndices: The indices are the shared
+ *   rows x cols grid; otherwise (spiral) the
+ *   shader writes them.
+ *
+ * The factories take the parameters of the
+ * LoadXMesh/DrawXMesh function of the same
+ * shape and clamp them exactly as its
+ * generator does.
+ ******************************************/
+
+struct ComputeMeshParams {
+    ComputeMeshShape shape = ComputeMeshShape::Spring;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    bool gridIndices = true;
+    GLfloat params[8] = {};     // meshParams[2] in the shader
+
+    size_t VertexCount() const;
+    size_t IndexCount() const;
+
+    static ComputeMeshParams Spring(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, float springLength);
+    static ComputeMeshParams Spiral(float tubeRadius, float flattenFactor, int tubeSegments, size_t ringCount);
+    static ComputeMeshParams SineCone(float baseRadius, float height, float flattenFactor, float sineAmplitude,
+        float sineFrequency, float sinePhase, int radialSegments, int heightSegments);
+    static ComputeMeshParams Superellipsoid(float scaleX, float scaleY, float scaleZ,
+        float verticalExponent, float horizontalExponent, int uSegments, int vSegments);
+};
+
+class MeshComputeGenerator
+{
+public:
+    MeshComputeGenerator() = default;
+    ~MeshComputeGenerator();
+
+    MeshComputeGenerator(const MeshComputeGenerator&) = delete;
+    MeshComputeGenerator& operator=(const MeshComputeGenerator&) = delete;
+
+    // True when the context has compute shaders and shader storage buffers.
+    static bool IsSupported();
+
+    /******************************************
+     * Create / Release
+     * ---------------------------------------
+     * Create() compiles and links the compute
+     * program. Returns false, after printing
+     * the log, if it fails.
+     ******************************************/
+
+    bool Create();
+    void Release();
+
+    bool IsReady() const { return m_Program != 0; }
+
+    /******************************************
+     * Generate
+     * ---------------------------------------
+     * Writes the mesh's vertices into
+     * vertexBuffer from offset 0, and its
+     * indices into indexBuffer when
+     * writeIndices is set and the shape does
+     * not use grid indices. Both buffers must
+     * already hold VertexCount() vertices and
+     * IndexCount() indices. frames is required
+     * for the spiral and ignored otherwise.
+     *
+     * Issues the memory barriers that make the
+     * writes visible to the passes that read
+     * them and to later vertex fetch, index
+     * fetch and buffer reads, so the mesh can
+     * be drawn or mapped right away.
+     ******************************************/
+
+    void Generate(const ComputeMeshParams& mesh, GLuint vertexBuffer, GLuint indexBuffer, bool writeIndices,
+        const std::vector<SpiralFrame>* frames = nullptr);
+
+private:
+    void Dispatch(GLint pass, size_t invocations);
+
+    GLuint m_Program = 0;
+    GLuint m_FrameBuffer = 0;       // Spiral frames, refilled per generation
+
+    GLint m_ShapeLocation = -1;
+    GLint m_PassLocation = -1;
+    GLint m_SizeLocation = -1;
+    GLint m_ParamsLocation = -1;
+    GLint m_CountLocation = -1;
+};
@@ -0,0 +1,488 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshExport.cpp
+// ==============
+// Chunked OBJ, binary PLY and GLB writers. See MeshExport.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshExport.h"
+#include "ShapeMeshes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr size_t ExportVertexFloats = 8;            // position, normal, UV
+	constexpr size_t ExportVertexBytes = ExportVertexFloats * sizeof(GLfloat);
+	constexpr size_t MaxSlices = 4;                     // slices per writev
+
+	struct IoSlice
+	{
+		const void* data;
+		size_t size;
+	};
+
+	/******************************************
+	 * WriteSlices
+	 * ---------------------------------------
+	 * Writes the slices with one writev call,
+	 * continuing after partial writes.
+	 ******************************************/
+
+	bool WriteSlices(int fd, const IoSlice* slices, size_t count)
+	{
+#ifdef _WIN32
+		for (size_t i = 0; i < count; ++i) {
+			const char* data = static_cast<const char*>(slices[i].data);
+			size_t remaining = slices[i].size;
+			while (remaining > 0) {
+				int written = _write(fd, data, static_cast<unsigned int>(std::min<size_t>(remaining, INT_MAX)));
+				if (written <= 0) return false;
+				data += written;
+				remaining -= static_cast<size_t>(written);
+			}
+		}
+		return true;
+#else
+		iovec vectors[MaxSlices];
+		size_t used = 0;
+		for (size_t i = 0; i < count && used < MaxSlices; ++i) {
+			if (slices[i].size == 0) continue;
+			vectors[used].iov_base = const_cast<void*>(slices[i].data);
+			vectors[used].iov_len = slices[i].size;
+			++used;
+		}
+
+		size_t first = 0;
+		while (first < used) {
+			ssize_t written = ::writev(fd, vectors + first, static_cast<int>(used - first));
+			if (written < 0) {
+				if (errno == EINTR) continue;
+				return false;
+			}
+
+			size_t advance = static_cast<size_t>(written);
+			while (first < used && advance >= vectors[first].iov_len) {
+				advance -= vectors[first].iov_len;
+				++first;
+			}
+			if (first < used) {
+				vectors[first].iov_base = static_cast<char*>(vectors[first].iov_base) + advance;
+				vectors[first].iov_len -= advance;
+			}
+		}
+		return true;
+#endif
+	}
+
+	/******************************************
+	 * ChunkWriter
+	 * ---------------------------------------
+	 * Fixed-size output buffer over a file
+	 * descriptor.
+	 *
+	 * - Reserve(n) / Commit(n): Formats up to n
+	 *   bytes in place, flushing first if the
+	 *   buffer cannot hold them.
+	 * - WriteDirect(): Writes a large array from
+	 *   its own memory, a chunk per writev, with
+	 *   any buffered bytes in front of the first
+	 *   chunk.
+	 ******************************************/
+
+	class ChunkWriter
+	{
+	public:
+		explicit ChunkWriter(int fd)
+			: m_Fd(fd), m_Buffer(MeshExport::ExportChunkBytes)
+		{
+		}
+
+		char* Reserve(size_t size)
+		{
+			if (m_Used + size > m_Buffer.size()) Flush();
+			return m_Buffer.data() + m_Used;
+		}
+
+		void Commit(size_t size) { m_Used += size; }
+		void Commit(const char* end) { m_Used = static_cast<size_t>(end - m_Buffer.data()); }
+
+		void Append(const void* data, size_t size)
+		{
+			std::memcpy(Reserve(size), data, size);
+			Commit(size);
+		}
+
+		size_t Capacity() const { return m_Buffer.size(); }
+
+		void WriteDirect(const void* data, size_t size)
+		{
+			const char* bytes = static_cast<const char*>(data);
+			while (size > 0 && m_Ok) {
+				size_t piece = std::min(size, MeshExport::ExportChunkBytes);
+				IoSlice slices[2] = { { m_Buffer.data(), m_Used }, { bytes, piece } };
+				m_Ok = WriteSlices(m_Fd, slices, 2);
+				m_Used = 0;
+				bytes += piece;
+				size -= piece;
+			}
+		}
+
+		bool Flush()
+		{
+			if (m_Used > 0 && m_Ok) {
+				IoSlice slice = { m_Buffer.data(), m_Used };
+				m_Ok = WriteSlices(m_Fd, &slice, 1);
+			}
+			m_Used = 0;
+			return m_Ok;
+		}
+
+	private:
+		int m_Fd;
+		std::vector<char> m_Buffer;
+		size_t m_Used = 0;
+		bool m_Ok = true;
+	};
+
+	char* PutText(char* out, const char* text)
+	{
+		size_t length = std::strlen(text);
+		std::memcpy(out, text, length);
+		return out + length;
+	}
+
+	char* PutFloat(char* out, float value)
+	{
+		return std::to_chars(out, out + 32, value).ptr;
+	}
+
+	char* PutUint(char* out, unsigned long long value)
+	{
+		return std::to_chars(out, out + 24, value).ptr;
+	}
+
+	/******************************************
+	 * ForEachTriangle
+	 * ---------------------------------------
+	 * Calls fn(a, b, c) for every triangle of a
+	 * triangle list or strip (indexed or not).
+	 * Odd strip triangles are flipped to keep
+	 * the winding; degenerate ones are skipped.
+	 ******************************************/
+
+	template <typename Function>
+	void ForEachTriangle(const GLuint* indices, size_t indexCount, size_t vertexCount, GLenum mode, Function&& fn)
+	{
+		const size_t count = indices ? indexCount : vertexCount;
+		auto at = [indices](size_t i) { return indices ? indices[i] : static_cast<GLuint>(i); };
+
+		if (mode == GL_TRIANGLE_STRIP) {
+			for (size_t i = 2; i < count; ++i) {
+				GLuint a = at(i - 2), b = at(i - 1), c = at(i);
+				if (a == b || b == c || a == c) continue;
+				if (i & 1) std::swap(a, b);
+				fn(a, b, c);
+			}
+		}
+		else {
+			for (size_t i = 0; i + 2 < count; i += 3)
+				fn(at(i), at(i + 1), at(i + 2));
+		}
+	}
+
+	size_t CountTriangles(const GLuint* indices, size_t indexCount, size_t vertexCount, GLenum mode)
+	{
+		size_t triangles = 0;
+		ForEachTriangle(indices, indexCount, vertexCount, mode, [&triangles](GLuint, GLuint, GLuint) { ++triangles; });
+		return triangles;
+	}
+
+	/******************************************
+	 * WriteObj
+	 ******************************************/
+
+	bool WriteObj(ChunkWriter& out, const GLfloat* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount, GLenum mode)
+	{
+		constexpr size_t LineMax = 160;   // longest record: "vn" + 3 floats, or "f" + 9 integers
+
+		out.Append("# ShapeMeshes export\n", 21);
+
+		const char* const prefixes[3] = { "v ", "vn ", "vt " };
+		const size_t offsets[3] = { 0, 3, 6 };
+		const size_t components[3] = { 3, 3, 2 };
+
+		for (int record = 0; record < 3; ++record) {
+			for (size_t v = 0; v < vertexCount; ++v) {
+				const GLfloat* attribute = vertices + v * ExportVertexFloats + offsets[record];
+				char* p = PutText(out.Reserve(LineMax), prefixes[record]);
+				for (size_t c = 0; c < components[record]; ++c) {
+					if (c > 0) *p++ = ' ';
+					p = PutFloat(p, attribute[c]);
+				}
+				*p++ = '\n';
+				out.Commit(p);
+			}
+		}
+
+		ForEachTriangle(indices, indexCount, vertexCount, mode, [&out](GLuint a, GLuint b, GLuint c) {
+			char* p = out.Reserve(LineMax);
+			*p++ = 'f';
+			for (GLuint index : { a, b, c }) {
+				*p++ = ' ';
+				char* first = p;
+				p = PutUint(p, static_cast<unsigned long long>(index) + 1);
+				const size_t length = static_cast<size_t>(p - first);
+				for (int repeat = 0; repeat < 2; ++repeat) {
+					*p++ = '/';
+					std::memmove(p, first, length);
+					p += length;
+				}
+			}
+			*p++ = '\n';
+			out.Commit(p);
+		});
+
+		return out.Flush();
+	}
+
+	/******************************************
+	 * WritePly
+	 * ---------------------------------------
+	 * The vertex element matches the Vertex
+	 * layout, so vertices are written directly
+	 * from the source array.
+	 ******************************************/
+
+	bool WritePly(ChunkWriter& out, const GLfloat* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount, GLenum mode)
+	{
+		constexpr size_t FaceBytes = 1 + 3 * sizeof(uint32_t);
+
+		char header[512];
+		int length = std::snprintf(header, sizeof(header),
+			"ply\n"
+			"format binary_little_endian 1.0\n"
+			"comment ShapeMeshes export\n"
+			"element vertex %llu\n"
+			"property float x\nproperty float y\nproperty float z\n"
+			"property float nx\nproperty float ny\nproperty float nz\n"
+			"property float s\nproperty float t\n"
+			"element face %llu\n"
+			"property list uchar uint vertex_indices\n"
+			"end_header\n",
+			static_cast<unsigned long long>(vertexCount),
+			static_cast<unsigned long long>(CountTriangles(indices, indexCount, vertexCount, mode)));
+
+		out.Append(header, static_cast<size_t>(length));
+		out.WriteDirect(vertices, vertexCount * ExportVertexBytes);
+
+		ForEachTriangle(indices, indexCount, vertexCount, mode, [&out](GLuint a, GLuint b, GLuint c) {
+			char* p = out.Reserve(FaceBytes);
+			const uint32_t face[3] = { a, b, c };
+			p[0] = 3;
+			std::memcpy(p + 1, face, sizeof(face));
+			out.Commit(FaceBytes);
+		});
+
+		return out.Flush();
+	}
+
+	/******************************************
+	 * WriteGlb
+	 * ---------------------------------------
+	 * One interleaved vertex buffer view
+	 * (byteStride 32) and an optional index
+	 * view. The JSON only holds counts and
+	 * bounds, so it stays small for any mesh.
+	 * Vertices pass through the chunk buffer to
+	 * flip V; indices go out directly.
+	 ******************************************/
+
+	bool WriteGlb(ChunkWriter& out, const GLfloat* vertices, size_t vertexCount, const GLuint* indices, size_t indexCount, GLenum mode)
+	{
+		float boundsMin[3] = { vertices[0], vertices[1], vertices[2] };
+		float boundsMax[3] = { vertices[0], vertices[1], vertices[2] };
+		for (size_t v = 1; v < vertexCount; ++v) {
+			for (int axis = 0; axis < 3; ++axis) {
+				boundsMin[axis] = std::min(boundsMin[axis], vertices[v * ExportVertexFloats + axis]);
+				boundsMax[axis] = std::max(boundsMax[axis], vertices[v * ExportVertexFloats + axis]);
+			}
+		}
+
+		const uint64_t vertexBytes = static_cast<uint64_t>(vertexCount) * ExportVertexBytes;
+		const uint64_t indexBytes = indices ? static_cast<uint64_t>(indexCount) * sizeof(GLuint) : 0;
+		const uint64_t binBytes = vertexBytes + indexBytes;
+
+		// --- JSON ---
+		auto number = [](float value) {
+			char text[32];
+			return std::string(text, std::to_chars(text, text + sizeof(text), value).ptr);
+		};
+		auto vec3 = [&number](const float* v) {
+			return "[" + number(v[0]) + "," + number(v[1]) + "," + number(v[2]) + "]";
+		};
+
+		const std::string count = std::to_string(vertexCount);
+		std::string json =
+			"{\"asset\":{\"version\":\"2.0\",\"generator\":\"ShapeMeshes\"},"
+			"\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+			"\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,\"TEXCOORD_0\":2}";
+		if (indices) json += ",\"indices\":3";
+		json += ",\"mode\":" + std::string(mode == GL_TRIANGLE_STRIP ? "5" : "4") + "}]}],";
+		json += "\"buffers\":[{\"byteLength\":" + std::to_string(binBytes) + "}],";
+		json += "\"bufferViews\":[{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" + std::to_string(vertexBytes) +
+			",\"byteStride\":32,\"target\":34962}";
+		if (indices)
+			json += ",{\"buffer\":0,\"byteOffset\":" + std::to_string(vertexBytes) + ",\"byteLength\":" + std::to_string(indexBytes) +
+				",\"target\":34963}";
+		json += "],\"accessors\":["
+			"{\"bufferView\":0,\"byteOffset\":0,\"componentType\":5126,\"count\":" + count +
+			",\"type\":\"VEC3\",\"min\":" + vec3(boundsMin) + ",\"max\":" + vec3(boundsMax) + "},"
+			"{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC3\"},"
+			"{\"bufferView\":0,\"byteOffset\":24,\"componentType\":5126,\"count\":" + count + ",\"type\":\"VEC2\"}";
+		if (indices)
+			json += ",{\"bufferView\":1,\"componentType\":5125,\"count\":" + std::to_string(indexCount) + ",\"type\":\"SCALAR\"}";
+		json += "]}";
+		json.append((4 - json.size() % 4) % 4, ' ');
+
+		// --- Header and chunk headers ---
+		const uint64_t totalBytes = 12 + 8 + json.size() + 8 + binBytes;
+		if (totalBytes > UINT32_MAX) {
+			std::cerr << "Error: mesh is too large for a GLB file (" << totalBytes << " bytes)." << std::endl;
+			return false;
+		}
+
+		const uint32_t glbHeader[3] = { 0x46546C67u, 2u, static_cast<uint32_t>(totalBytes) };        // "glTF"
+		const uint32_t jsonHeader[2] = { static_cast<uint32_t>(json.size()), 0x4E4F534Au };          // "JSON"
+		const uint32_t binHeader[2] = { static_cast<uint32_t>(binBytes), 0x004E4942u };              // "BIN\0"
+
+		out.Append(glbHeader, sizeof(glbHeader));
+		out.Append(jsonHeader, sizeof(jsonHeader));
+		out.Append(json.data(), json.size());
+		out.Append(binHeader, sizeof(binHeader));
+
+		// --- Vertices, with V flipped, a buffer-full at a time ---
+		const size_t batch = out.Capacity() / ExportVertexBytes;
+		for (size_t first = 0; first < vertexCount; first += batch) {
+			const size_t count = std::min(batch, vertexCount - first);
+			GLfloat* chunk = reinterpret_cast<GLfloat*>(out.Reserve(count * ExportVertexBytes));
+			std::memcpy(chunk, vertices + first * ExportVertexFloats, count * ExportVertexBytes);
+			for (size_t v = 0; v < count; ++v)
+				chunk[v * ExportVertexFloats + 7] = 1.0f - chunk[v * ExportVertexFloats + 7];
+			out.Commit(count * ExportVertexBytes);
+		}
+
+		if (indices) out.WriteDirect(indices, static_cast<size_t>(indexBytes));
+		return out.Flush();
+	}
+}
+
+namespace MeshExport
+{
+	bool FormatFromPath(const std::string& path, MeshExportFormat& format)
+	{
+		size_t dot = path.find_last_of('.');
+		if (dot == std::string::npos) return false;
+
+		std::string extension = path.substr(dot + 1);
+		std::transform(extension.begin(), extension.end(), extension.begin(),
+			[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+		if (extension == "obj") format = MeshExportFormat::Obj;
+		else if (extension == "ply") format = MeshExportFormat::Ply;
+		else if (extension == "glb") format = MeshExportFormat::Glb;
+		else return false;
+		return true;
+	}
+
+	bool Write(int fd, MeshExportFormat format, const GLfloat* vertices, size_t vertexFloatCount,
+		const GLuint* indices, size_t indexCount, GLenum mode)
+	{
+		const size_t vertexCount = vertexFloatCount / ExportVertexFloats;
+		if (vertexCount == 0 || vertexFloatCount % ExportVertexFloats != 0) {
+			std::cerr << "Error: nothing to export (expected whole vertices of 8 floats)." << std::endl;
+			return false;
+		}
+		if (mode != GL_TRIANGLES && mode != GL_TRIANGLE_STRIP) {
+			std::cerr << "Error: only GL_TRIANGLES and GL_TRIANGLE_STRIP meshes can be exported." << std::endl;
+			return false;
+		}
+		if (indexCount == 0) indices = nullptr;
+		if (indices && std::any_of(indices, indices + indexCount, [vertexCount](GLuint i) { return i >= vertexCount; })) {
+			std::cerr << "Error: mesh has indices past its last vertex." << std::endl;
+			return false;
+		}
+
+		// PLY and GLB are little-endian and the binary data is written as-is.
+		const uint16_t probe = 1;
+		if (format != MeshExportFormat::Obj && *reinterpret_cast<const unsigned char*>(&probe) != 1) {
+			std::cerr << "Error: binary mesh export requires a little-endian host." << std::endl;
+			return false;
+		}
+
+		ChunkWriter out(fd);
+		switch (format) {
+		case MeshExportFormat::Obj: return WriteObj(out, vertices, vertexCount, indices, indexCount, mode);
+		case MeshExportFormat::Ply: return WritePly(out, vertices, vertexCount, indices, indexCount, mode);
+		case MeshExportFormat::Glb: return WriteGlb(out, vertices, vertexCount, indices, indexCount, mode);
+		}
+		return false;
+	}
+
+	bool Write(const std::string& path, const GLfloat* vertices, size_t vertexFloatCount,
+		const GLuint* indices, size_t indexCount, GLenum mode)
+	{
+		MeshExportFormat format;
+		if (!FormatFromPath(path, format)) {
+			std::cerr << "Error: unknown export format for " << path << " (use .obj, .ply or .glb)." << std::endl;
+			return false;
+		}
+
+#ifdef _WIN32
+		int fd = _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+		int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+		if (fd < 0) {
+			std::cerr << "Error: cannot create " << path << std::endl;
+			return false;
+		}
+
+		bool ok = Write(fd, format, vertices, vertexFloatCount, indices, indexCount, mode);
+
+#ifdef _WIN32
+		ok = _close(fd) == 0 && ok;
+#else
+		ok = ::close(fd) == 0 && ok;
+#endif
+		if (!ok) {
+			std::cerr << "Error: failed to export " << path << std::endl;
+			std::remove(path.c_str());
+		}
+		return ok;
+	}
+
+	bool Write(const std::string& path, const MeshData& mesh, GLenum mode)
+	{
+		return Write(path, mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(), mode);
+	}
+}
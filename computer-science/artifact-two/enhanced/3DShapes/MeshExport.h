@@ -0,0 +1,83 @@
+/******************************************
+ * MeshExport
+ * ---------------------------------------
+ * Streaming exporters for ShapeMeshes
+ * geometry (interleaved Vertex data plus
+ * optional GLuint indices):
+ *
+ * - OBJ: Text; v/vn/vt records and 1-based
+ *   f records.
+ * - PLY: binary_little_endian 1.0; vertex
+ *   properties x y z nx ny nz s t, and a
+ *   vertex_indices list per face.
+ * - GLB: Binary glTF 2.0, one mesh with one
+ *   primitive (POSITION, NORMAL, TEXCOORD_0
+ *   and indices). V is flipped to glTF's
+ *   top-left texture origin.
+ *
+ * Output goes to a file descriptor in chunks
+ * of at most ExportChunkBytes, each written
+ * with a single writev (a _write loop on
+ * Windows), so memory use stays bounded no
+ * matter how large the mesh is. Vertex data
+ * is written straight from the source array
+ * where the format allows it.
+ *
+ * Triangle strips (GL_TRIANGLE_STRIP, as used
+ * by the plane, prism and pyramids) are kept
+ * as strips in GLB and expanded to triangles,
+ * minus degenerates, in OBJ and PLY.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <string>
+
+struct MeshData;
+
+enum class MeshExportFormat {
+    Obj,
+    Ply,
+    Glb
+};
+
+namespace MeshExport
+{
+    constexpr size_t ExportChunkBytes = 4 * 1024 * 1024;
+
+    /******************************************
+     * FormatFromPath
+     * ---------------------------------------
+     * Picks the format from the file extension
+     * (.obj, .ply or .glb, any case). Returns
+     * false for anything else.
+     ******************************************/
+
+    bool FormatFromPath(const std::string& path, MeshExportFormat& format);
+
+    /******************************************
+     * Write
+     * ---------------------------------------
+     * Streams a mesh to an open file descriptor,
+     * or to a new file at path (format from its
+     * extension). Errors are reported on
+     * std::cerr and return false.
+     *
+     * @param vertices Interleaved Vertex data (8 floats each).
+     * @param vertexFloatCount Number of floats in vertices.
+     * @param indices Index data, or null for a non-indexed mesh.
+     * @param indexCount Number of indices (0 for non-indexed).
+     * @param mode GL_TRIANGLES or GL_TRIANGLE_STRIP.
+     ******************************************/
+
+    bool Write(int fd, MeshExportFormat format, const GLfloat* vertices, size_t vertexFloatCount,
+        const GLuint* indices, size_t indexCount, GLenum mode = GL_TRIANGLES);
+
+    bool Write(const std::string& path, const GLfloat* vertices, size_t vertexFloatCount,
+        const GLuint* indices, size_t indexCount, GLenum mode = GL_TRIANGLES);
+
+    bool Write(const std::string& path, const MeshData& mesh, GLenum mode = GL_TRIANGLES);
+}
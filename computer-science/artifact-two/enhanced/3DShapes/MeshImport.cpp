@@ -0,0 +1,976 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshImport.cpp
+// ==============
+// Memory-mapped OBJ and PLY loaders. See MeshImport.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshImport.h"
+#include "MeshCache.h"
+#include "ShapeMeshes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr size_t ImportVertexFloats = 8;   // position, normal, UV
+
+	/******************************************
+	 * Tokenizer
+	 * ---------------------------------------
+	 * Pointer-based helpers over the mapped
+	 * text. Each advances p past what it read
+	 * and never reads at or beyond end.
+	 ******************************************/
+
+	inline bool IsBlank(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline const char* SkipBlanks(const char* p, const char* end)
+	{
+		while (p < end && IsBlank(*p)) ++p;
+		return p;
+	}
+
+	inline const char* SkipSpace(const char* p, const char* end)
+	{
+		while (p < end && (IsBlank(*p) || *p == '\n')) ++p;
+		return p;
+	}
+
+	inline const char* LineEnd(const char* p, const char* end)
+	{
+		const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+		return newline ? static_cast<const char*>(newline) : end;
+	}
+
+	inline bool ParseFloat(const char*& p, const char* end, float& value)
+	{
+		if (p < end && *p == '+') ++p;
+		std::from_chars_result result = std::from_chars(p, end, value);
+		if (result.ptr == p) return false;
+		if (result.ec == std::errc::result_out_of_range) value = 0.0f;
+		p = result.ptr;
+		return true;
+	}
+
+	inline bool ParseInt(const char*& p, const char* end, long long& value)
+	{
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative = *p == '-';
+			++p;
+		}
+
+		const char* digits = p;
+		long long result = 0;
+		while (p < end && static_cast<unsigned>(*p - '0') < 10u && p - digits < 18) {
+			result = result * 10 + (*p - '0');
+			++p;
+		}
+		if (p == digits || (p < end && static_cast<unsigned>(*p - '0') < 10u)) return false;
+
+		value = negative ? -result : result;
+		return true;
+	}
+
+	size_t LineNumber(const char* data, const char* at)
+	{
+		return 1 + static_cast<size_t>(std::count(data, at, '\n'));
+	}
+
+	/******************************************
+	 * RunParallel
+	 * ---------------------------------------
+	 * Calls task(i) for i in [0, count), task 0
+	 * on the calling thread and the rest on one
+	 * thread each.
+	 ******************************************/
+
+	template <typename Task>
+	void RunParallel(size_t count, const Task& task)
+	{
+		std::vector<std::thread> workers;
+		workers.reserve(count > 0 ? count - 1 : 0);
+		for (size_t i = 1; i < count; ++i)
+			workers.emplace_back([&task, i]() { task(i); });
+
+		if (count > 0) task(0);
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	size_t ChunkCount(size_t bytes, const MeshImport::Options& options)
+	{
+		size_t threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+		size_t chunks = bytes / std::max<size_t>(options.parallelChunkBytes, 1);
+		return std::max<size_t>(1, std::min(threads, chunks));
+	}
+
+	/******************************************
+	 * GenerateMissingNormals
+	 * ---------------------------------------
+	 * Gives each flagged vertex the normalised
+	 * sum of its triangles' (area-weighted) face
+	 * normals.
+	 ******************************************/
+
+	void GenerateMissingNormals(MeshData& mesh, const std::vector<unsigned char>& missing)
+	{
+		if (std::find(missing.begin(), missing.end(), 1) == missing.end()) return;
+
+		GLfloat* vertices = mesh.vertices.data();
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+			const GLuint corners[3] = { mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2] };
+			const GLfloat* a = vertices + corners[0] * ImportVertexFloats;
+			const GLfloat* b = vertices + corners[1] * ImportVertexFloats;
+			const GLfloat* c = vertices + corners[2] * ImportVertexFloats;
+
+			const float ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+			const float vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+			const float normal[3] = { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+
+			for (GLuint corner : corners) {
+				if (!missing[corner]) continue;
+				GLfloat* target = vertices + corner * ImportVertexFloats + 3;
+				target[0] += normal[0];
+				target[1] += normal[1];
+				target[2] += normal[2];
+			}
+		}
+
+		for (size_t v = 0; v < missing.size(); ++v) {
+			if (!missing[v]) continue;
+			GLfloat* normal = vertices + v * ImportVertexFloats + 3;
+			float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			if (length > 0.0f) {
+				normal[0] /= length;
+				normal[1] /= length;
+				normal[2] /= length;
+			}
+			else {
+				normal[0] = 0.0f;
+				normal[1] = 0.0f;
+				normal[2] = 1.0f;
+			}
+		}
+	}
+
+	// =====================================================================
+	// OBJ
+	// =====================================================================
+
+	struct ObjCorner
+	{
+		int32_t v, t, n;   // 0-based; t and n are -1 when absent
+	};
+
+	enum class ObjRecord { Other, Position, Texcoord, Normal, Face };
+
+	/******************************************
+	 * ObjChunk
+	 * ---------------------------------------
+	 * A line-aligned slice of the file. The
+	 * counting pass fills the record counts;
+	 * the parsing pass writes attributes at the
+	 * chunk's bases and fills corners, three per
+	 * triangle.
+	 ******************************************/
+
+	struct ObjChunk
+	{
+		const char* begin = nullptr;
+		const char* end = nullptr;
+
+		size_t positions = 0, texcoords = 0, normals = 0;
+		size_t positionBase = 0, texcoordBase = 0, normalBase = 0;
+
+		std::vector<ObjCorner> corners;
+
+		const char* error = nullptr;   // start of the first bad line
+		const char* message = nullptr;
+	};
+
+	inline ObjRecord ClassifyObjLine(const char*& p, const char* end)
+	{
+		p = SkipBlanks(p, end);
+		if (end - p < 2) return ObjRecord::Other;
+
+		if (p[0] == 'v') {
+			if (IsBlank(p[1])) {
+				p += 1;
+				return ObjRecord::Position;
+			}
+			if (end - p >= 3 && IsBlank(p[2])) {
+				if (p[1] == 't') {
+					p += 2;
+					return ObjRecord::Texcoord;
+				}
+				if (p[1] == 'n') {
+					p += 2;
+					return ObjRecord::Normal;
+				}
+			}
+		}
+		else if (p[0] == 'f' && IsBlank(p[1])) {
+			p += 1;
+			return ObjRecord::Face;
+		}
+		return ObjRecord::Other;
+	}
+
+	void CountObjChunk(ObjChunk& chunk)
+	{
+		for (const char* line = chunk.begin; line < chunk.end;) {
+			const char* lineEnd = LineEnd(line, chunk.end);
+			const char* p = line;
+			switch (ClassifyObjLine(p, lineEnd)) {
+			case ObjRecord::Position: ++chunk.positions; break;
+			case ObjRecord::Texcoord: ++chunk.texcoords; break;
+			case ObjRecord::Normal: ++chunk.normals; break;
+			default: break;
+			}
+			line = lineEnd + 1;
+		}
+	}
+
+	// 1-based or negative (relative) OBJ index to a 0-based one; -1 if invalid.
+	inline int32_t ResolveObjIndex(long long value, size_t definedSoFar, size_t total)
+	{
+		long long index = value > 0 ? value - 1 : static_cast<long long>(definedSoFar) + value;
+		if (value == 0 || index < 0 || index >= static_cast<long long>(total)) return -1;
+		return static_cast<int32_t>(index);
+	}
+
+	/******************************************
+	 * ParseObjChunk
+	 * ---------------------------------------
+	 * Second pass over a chunk. totals holds the
+	 * whole file's v, vt and vn counts, used to
+	 * reject out-of-range face indices here,
+	 * where the line is still known.
+	 ******************************************/
+
+	void ParseObjChunk(ObjChunk& chunk, float* positions, float* texcoords, float* normals, const size_t totals[3])
+	{
+		size_t positionCount = chunk.positionBase;
+		size_t texcoordCount = chunk.texcoordBase;
+		size_t normalCount = chunk.normalBase;
+
+		std::vector<ObjCorner> polygon;
+
+		auto fail = [&chunk](const char* line, const char* message) {
+			chunk.error = line;
+			chunk.message = message;
+		};
+
+		for (const char* line = chunk.begin; line < chunk.end;) {
+			const char* lineEnd = LineEnd(line, chunk.end);
+			const char* p = line;
+
+			switch (ClassifyObjLine(p, lineEnd)) {
+			case ObjRecord::Position: {
+				float* position = positions + positionCount * 3;
+				for (int axis = 0; axis < 3; ++axis) {
+					p = SkipBlanks(p, lineEnd);
+					if (!ParseFloat(p, lineEnd, position[axis])) return fail(line, "expected three vertex coordinates");
+				}
+				++positionCount;
+				break;
+			}
+			case ObjRecord::Texcoord: {
+				float* texcoord = texcoords + texcoordCount * 2;
+				p = SkipBlanks(p, lineEnd);
+				if (!ParseFloat(p, lineEnd, texcoord[0])) return fail(line, "expected a texture coordinate");
+				p = SkipBlanks(p, lineEnd);
+				if (p == lineEnd || !ParseFloat(p, lineEnd, texcoord[1])) texcoord[1] = 0.0f;
+				++texcoordCount;
+				break;
+			}
+			case ObjRecord::Normal: {
+				float* normal = normals + normalCount * 3;
+				for (int axis = 0; axis < 3; ++axis) {
+					p = SkipBlanks(p, lineEnd);
+					if (!ParseFloat(p, lineEnd, normal[axis])) return fail(line, "expected three normal components");
+				}
+				++normalCount;
+				break;
+			}
+			case ObjRecord::Face: {
+				polygon.clear();
+				for (p = SkipBlanks(p, lineEnd); p < lineEnd; p = SkipBlanks(p, lineEnd)) {
+					ObjCorner corner = { -1, -1, -1 };
+					long long value;
+
+					if (!ParseInt(p, lineEnd, value)) return fail(line, "malformed face corner");
+					corner.v = ResolveObjIndex(value, positionCount, totals[0]);
+					if (corner.v < 0) return fail(line, "face refers to a missing vertex");
+
+					if (p < lineEnd && *p == '/') {
+						++p;
+						if (p < lineEnd && *p != '/') {
+							if (!ParseInt(p, lineEnd, value)) return fail(line, "malformed face corner");
+							corner.t = ResolveObjIndex(value, texcoordCount, totals[1]);
+							if (corner.t < 0) return fail(line, "face refers to a missing texture coordinate");
+						}
+						if (p < lineEnd && *p == '/') {
+							++p;
+							if (!ParseInt(p, lineEnd, value)) return fail(line, "malformed face corner");
+							corner.n = ResolveObjIndex(value, normalCount, totals[2]);
+							if (corner.n < 0) return fail(line, "face refers to a missing normal");
+						}
+					}
+					if (p < lineEnd && !IsBlank(*p)) return fail(line, "malformed face corner");
+
+					polygon.push_back(corner);
+				}
+
+				if (polygon.size() < 3) return fail(line, "face has fewer than three corners");
+				for (size_t k = 1; k + 1 < polygon.size(); ++k) {
+					chunk.corners.push_back(polygon[0]);
+					chunk.corners.push_back(polygon[k]);
+					chunk.corners.push_back(polygon[k + 1]);
+				}
+				break;
+			}
+			default:
+				break;
+			}
+
+			line = lineEnd + 1;
+		}
+	}
+
+	/******************************************
+	 * WeldObjCorners
+	 * ---------------------------------------
+	 * Emits one Vertex per distinct (v, vt, vn)
+	 * triple, in order of first use. Triples are
+	 * found through a chain per position index,
+	 * which usually holds one or two entries.
+	 ******************************************/
+
+	void WeldObjCorners(std::vector<ObjChunk>& chunks, const std::vector<float>& positions,
+		const std::vector<float>& texcoords, const std::vector<float>& normals, MeshData& out)
+	{
+		struct WeldNode
+		{
+			int32_t t, n;
+			GLuint vertex;
+			int32_t next;
+		};
+
+		const size_t positionCount = positions.size() / 3;
+		std::vector<int32_t> head(positionCount, -1);
+		std::vector<WeldNode> nodes;
+		nodes.reserve(positionCount);
+
+		size_t cornerCount = 0;
+		for (const ObjChunk& chunk : chunks) cornerCount += chunk.corners.size();
+
+		out.vertices.reserve(positionCount * ImportVertexFloats);
+		out.indices.resize(cornerCount);
+		std::vector<unsigned char> missingNormal;
+		missingNormal.reserve(positionCount);
+
+		GLuint* index = out.indices.data();
+		for (ObjChunk& chunk : chunks) {
+			for (const ObjCorner& corner : chunk.corners) {
+				int32_t* link = &head[corner.v];
+				while (*link >= 0 && (nodes[*link].t != corner.t || nodes[*link].n != corner.n))
+					link = &nodes[*link].next;
+
+				if (*link < 0) {
+					const GLuint vertex = static_cast<GLuint>(missingNormal.size());
+					const float* position = &positions[static_cast<size_t>(corner.v) * 3];
+					const float* normal = corner.n >= 0 ? &normals[static_cast<size_t>(corner.n) * 3] : nullptr;
+					const float* texcoord = corner.t >= 0 ? &texcoords[static_cast<size_t>(corner.t) * 2] : nullptr;
+
+					out.vertices.insert(out.vertices.end(), {
+						position[0], position[1], position[2],
+						normal ? normal[0] : 0.0f, normal ? normal[1] : 0.0f, normal ? normal[2] : 0.0f,
+						texcoord ? texcoord[0] : 0.0f, texcoord ? texcoord[1] : 0.0f });
+					missingNormal.push_back(normal ? 0 : 1);
+
+					*link = static_cast<int32_t>(nodes.size());   // link may point into nodes; set it before growing
+					nodes.push_back({ corner.t, corner.n, vertex, -1 });
+					*index++ = vertex;
+					continue;
+				}
+
+				*index++ = nodes[*link].vertex;
+			}
+			std::vector<ObjCorner>().swap(chunk.corners);
+		}
+
+		GenerateMissingNormals(out, missingNormal);
+	}
+
+	// =====================================================================
+	// PLY
+	// =====================================================================
+
+	enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+	bool ParsePlyType(const std::string& name, PlyType& type)
+	{
+		static const std::pair<const char*, PlyType> names[] = {
+			{ "char", PlyType::Int8 }, { "int8", PlyType::Int8 },
+			{ "uchar", PlyType::UInt8 }, { "uint8", PlyType::UInt8 },
+			{ "short", PlyType::Int16 }, { "int16", PlyType::Int16 },
+			{ "ushort", PlyType::UInt16 }, { "uint16", PlyType::UInt16 },
+			{ "int", PlyType::Int32 }, { "int32", PlyType::Int32 },
+			{ "uint", PlyType::UInt32 }, { "uint32", PlyType::UInt32 },
+			{ "float", PlyType::Float32 }, { "float32", PlyType::Float32 },
+			{ "double", PlyType::Float64 }, { "float64", PlyType::Float64 },
+		};
+		for (const auto& entry : names) {
+			if (name == entry.first) {
+				type = entry.second;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t PlyTypeSize(PlyType type)
+	{
+		switch (type) {
+		case PlyType::Int8: case PlyType::UInt8: return 1;
+		case PlyType::Int16: case PlyType::UInt16: return 2;
+		case PlyType::Int32: case PlyType::UInt32: case PlyType::Float32: return 4;
+		case PlyType::Float64: return 8;
+		}
+		return 0;
+	}
+
+	template <typename T>
+	inline T LoadPlyScalar(const char* p, bool swap)
+	{
+		char bytes[sizeof(T)];
+		std::memcpy(bytes, p, sizeof(T));
+		if (swap) std::reverse(bytes, bytes + sizeof(T));
+		T value;
+		std::memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	inline double ReadPlyBinary(const char* p, PlyType type, bool swap)
+	{
+		switch (type) {
+		case PlyType::Int8: return static_cast<int8_t>(*p);
+		case PlyType::UInt8: return static_cast<uint8_t>(*p);
+		case PlyType::Int16: return LoadPlyScalar<int16_t>(p, swap);
+		case PlyType::UInt16: return LoadPlyScalar<uint16_t>(p, swap);
+		case PlyType::Int32: return LoadPlyScalar<int32_t>(p, swap);
+		case PlyType::UInt32: return LoadPlyScalar<uint32_t>(p, swap);
+		case PlyType::Float32: return LoadPlyScalar<float>(p, swap);
+		case PlyType::Float64: return LoadPlyScalar<double>(p, swap);
+		}
+		return 0.0;
+	}
+
+	struct PlyProperty
+	{
+		std::string name;
+		PlyType type = PlyType::Float32;    // item type for lists
+		bool isList = false;
+		PlyType countType = PlyType::UInt8;
+	};
+
+	struct PlyElement
+	{
+		std::string name;
+		size_t count = 0;
+		std::vector<PlyProperty> properties;
+
+		// Bytes per binary instance, or 0 if it has list properties.
+		size_t FixedStride() const
+		{
+			size_t stride = 0;
+			for (const PlyProperty& property : properties) {
+				if (property.isList) return 0;
+				stride += PlyTypeSize(property.type);
+			}
+			return stride;
+		}
+	};
+
+	enum class PlyFormat { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+	struct PlyHeader
+	{
+		PlyFormat format = PlyFormat::Ascii;
+		std::vector<PlyElement> elements;
+		size_t dataOffset = 0;
+	};
+
+	bool ParsePlyHeader(const char* data, size_t size, PlyHeader& header, std::string& error)
+	{
+		const char* end = data + size;
+		const char* line = data;
+		bool sawFormat = false;
+
+		for (size_t lineNumber = 1; line < end; ++lineNumber) {
+			const char* lineEnd = LineEnd(line, end);
+			std::istringstream words(std::string(line, lineEnd));
+			std::string keyword;
+			words >> keyword;
+			line = lineEnd + 1;
+
+			if (lineNumber == 1) {
+				if (keyword != "ply") {
+					error = "not a PLY file";
+					return false;
+				}
+				continue;
+			}
+
+			if (keyword == "format") {
+				std::string format;
+				words >> format;
+				if (format == "ascii") header.format = PlyFormat::Ascii;
+				else if (format == "binary_little_endian") header.format = PlyFormat::BinaryLittleEndian;
+				else if (format == "binary_big_endian") header.format = PlyFormat::BinaryBigEndian;
+				else {
+					error = "unknown format '" + format + "'";
+					return false;
+				}
+				sawFormat = true;
+			}
+			else if (keyword == "element") {
+				PlyElement element;
+				long long count = -1;
+				words >> element.name >> count;
+				if (element.name.empty() || count < 0) {
+					error = "malformed element on header line " + std::to_string(lineNumber);
+					return false;
+				}
+				element.count = static_cast<size_t>(count);
+				header.elements.push_back(element);
+			}
+			else if (keyword == "property") {
+				if (header.elements.empty()) {
+					error = "property before any element on header line " + std::to_string(lineNumber);
+					return false;
+				}
+				PlyProperty property;
+				std::string type;
+				words >> type;
+				bool valid;
+				if (type == "list") {
+					std::string countType, itemType;
+					words >> countType >> itemType >> property.name;
+					property.isList = true;
+					valid = ParsePlyType(countType, property.countType) && ParsePlyType(itemType, property.type);
+				}
+				else {
+					words >> property.name;
+					valid = ParsePlyType(type, property.type);
+				}
+				if (!valid || property.name.empty()) {
+					error = "malformed property on header line " + std::to_string(lineNumber);
+					return false;
+				}
+				header.elements.back().properties.push_back(property);
+			}
+			else if (keyword == "end_header") {
+				if (!sawFormat) {
+					error = "header has no format line";
+					return false;
+				}
+				header.dataOffset = static_cast<size_t>(line - data);
+				return true;
+			}
+			// comment, obj_info and blank lines are ignored
+		}
+
+		error = "header has no end_header line";
+		return false;
+	}
+
+	/******************************************
+	 * PlyVertexLayout
+	 * ---------------------------------------
+	 * Which vertex properties feed each of the
+	 * eight Vertex floats (-1 if none).
+	 ******************************************/
+
+	struct PlyVertexLayout
+	{
+		int slot[ImportVertexFloats];
+		bool hasNormals = false;
+	};
+
+	PlyVertexLayout MatchPlyVertexLayout(const PlyElement& element)
+	{
+		static const char* const slotNames[ImportVertexFloats][4] = {
+			{ "x" }, { "y" }, { "z" },
+			{ "nx" }, { "ny" }, { "nz" },
+			{ "s", "u", "texture_u", "texture_s" },
+			{ "t", "v", "texture_v", "texture_t" },
+		};
+
+		PlyVertexLayout layout;
+		for (size_t s = 0; s < ImportVertexFloats; ++s) {
+			layout.slot[s] = -1;
+			for (size_t p = 0; p < element.properties.size() && layout.slot[s] < 0; ++p) {
+				if (element.properties[p].isList) continue;
+				for (const char* name : slotNames[s])
+					if (name && element.properties[p].name == name) layout.slot[s] = static_cast<int>(p);
+			}
+		}
+		layout.hasNormals = layout.slot[3] >= 0 && layout.slot[4] >= 0 && layout.slot[5] >= 0;
+		return layout;
+	}
+
+	int FindPlyFaceList(const PlyElement& element)
+	{
+		for (size_t p = 0; p < element.properties.size(); ++p) {
+			const PlyProperty& property = element.properties[p];
+			if (property.isList && (property.name == "vertex_indices" || property.name == "vertex_index"))
+				return static_cast<int>(p);
+		}
+		return -1;
+	}
+
+	// Fan-triangulates one polygon; false if it is too small or has a bad index.
+	inline bool AppendPlyPolygon(const long long* corners, size_t count, size_t vertexCount, std::vector<GLuint>& indices)
+	{
+		if (count < 3) return false;
+		for (size_t k = 0; k < count; ++k)
+			if (corners[k] < 0 || corners[k] >= static_cast<long long>(vertexCount)) return false;
+
+		for (size_t k = 1; k + 1 < count; ++k) {
+			indices.push_back(static_cast<GLuint>(corners[0]));
+			indices.push_back(static_cast<GLuint>(corners[k]));
+			indices.push_back(static_cast<GLuint>(corners[k + 1]));
+		}
+		return true;
+	}
+
+	/******************************************
+	 * ReadPlyBinaryBody
+	 ******************************************/
+
+	bool ReadPlyBinaryBody(const char* data, size_t size, const PlyHeader& header, MeshData& out,
+		const MeshImport::Options& options, std::string& error)
+	{
+		uint16_t probe = 1;
+		const bool hostLittleEndian = *reinterpret_cast<const unsigned char*>(&probe) == 1;
+		const bool swap = (header.format == PlyFormat::BinaryLittleEndian) != hostLittleEndian;
+
+		const char* p = data + header.dataOffset;
+		const char* end = data + size;
+
+		for (const PlyElement& element : header.elements) {
+			if (element.name == "vertex") {
+				const size_t stride = element.FixedStride();
+				if (stride == 0) {
+					error = "vertex elements with list properties are not supported";
+					return false;
+				}
+				if (static_cast<size_t>(end - p) / stride < element.count) {
+					error = "file ends inside the vertex data";
+					return false;
+				}
+
+				const PlyVertexLayout layout = MatchPlyVertexLayout(element);
+				size_t offsets[ImportVertexFloats] = {};
+				for (size_t s = 0; s < ImportVertexFloats; ++s) {
+					for (int q = 0; q < layout.slot[s]; ++q) offsets[s] += PlyTypeSize(element.properties[q].type);
+				}
+
+				out.vertices.assign(element.count * ImportVertexFloats, 0.0f);
+				const char* vertexData = p;
+				const size_t chunks = ChunkCount(element.count * stride, options);
+
+				RunParallel(chunks, [&](size_t chunk) {
+					const size_t first = element.count * chunk / chunks;
+					const size_t last = element.count * (chunk + 1) / chunks;
+					for (size_t v = first; v < last; ++v) {
+						const char* instance = vertexData + v * stride;
+						GLfloat* vertex = out.vertices.data() + v * ImportVertexFloats;
+						for (size_t s = 0; s < ImportVertexFloats; ++s) {
+							if (layout.slot[s] >= 0)
+								vertex[s] = static_cast<GLfloat>(ReadPlyBinary(instance + offsets[s], element.properties[layout.slot[s]].type, swap));
+						}
+					}
+				});
+
+				p += element.count * stride;
+				continue;
+			}
+
+			const int faceList = element.name == "face" ? FindPlyFaceList(element) : -1;
+			const size_t stride = element.FixedStride();
+			if (faceList < 0 && stride > 0) {
+				if (static_cast<size_t>(end - p) / stride < element.count) {
+					error = "file ends inside the " + element.name + " data";
+					return false;
+				}
+				p += element.count * stride;
+				continue;
+			}
+
+			// Walk instances one by one (list properties make them variable-sized).
+			std::vector<long long> corners;
+			const size_t vertexCount = out.VertexCount();
+			for (size_t i = 0; i < element.count; ++i) {
+				for (size_t q = 0; q < element.properties.size(); ++q) {
+					const PlyProperty& property = element.properties[q];
+					if (!property.isList) {
+						p += PlyTypeSize(property.type);
+						continue;
+					}
+
+					const size_t countSize = PlyTypeSize(property.countType);
+					if (end - p < static_cast<std::ptrdiff_t>(countSize)) {
+						error = "file ends inside the " + element.name + " data";
+						return false;
+					}
+					const double items = ReadPlyBinary(p, property.countType, swap);
+					p += countSize;
+
+					const size_t itemSize = PlyTypeSize(property.type);
+					if (items < 0 || static_cast<size_t>(end - p) / itemSize < static_cast<size_t>(items)) {
+						error = "file ends inside the " + element.name + " data";
+						return false;
+					}
+					const size_t itemCount = static_cast<size_t>(items);
+
+					if (static_cast<int>(q) == faceList) {
+						corners.resize(itemCount);
+						for (size_t k = 0; k < itemCount; ++k)
+							corners[k] = static_cast<long long>(ReadPlyBinary(p + k * itemSize, property.type, swap));
+						if (!AppendPlyPolygon(corners.data(), itemCount, vertexCount, out.indices)) {
+							error = "face " + std::to_string(i) + " is degenerate or refers to a missing vertex";
+							return false;
+						}
+					}
+					p += itemCount * itemSize;
+				}
+				if (p > end) {
+					error = "file ends inside the " + element.name + " data";
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/******************************************
+	 * ReadPlyAsciiBody
+	 * ---------------------------------------
+	 * Values are read as a whitespace-separated
+	 * stream, in element and property order.
+	 ******************************************/
+
+	bool ReadPlyAsciiBody(const char* data, size_t size, const PlyHeader& header, MeshData& out, std::string& error)
+	{
+		const char* p = data + header.dataOffset;
+		const char* end = data + size;
+
+		auto fail = [&](const std::string& message) {
+			error = message + " (line " + std::to_string(LineNumber(data, p)) + ")";
+			return false;
+		};
+
+		std::vector<long long> corners;
+		for (const PlyElement& element : header.elements) {
+			const bool isVertex = element.name == "vertex";
+			const int faceList = element.name == "face" ? FindPlyFaceList(element) : -1;
+			const PlyVertexLayout layout = MatchPlyVertexLayout(element);
+			const size_t vertexCount = out.VertexCount();
+
+			if (isVertex) out.vertices.assign(element.count * ImportVertexFloats, 0.0f);
+
+			for (size_t i = 0; i < element.count; ++i) {
+				if (!isVertex && faceList < 0) {
+					// Not needed: one instance per line.
+					p = SkipSpace(p, end);
+					p = std::min(end, LineEnd(p, end) + 1);
+					continue;
+				}
+
+				for (size_t q = 0; q < element.properties.size(); ++q) {
+					const PlyProperty& property = element.properties[q];
+					p = SkipSpace(p, end);
+
+					if (!property.isList) {
+						float value;
+						if (!ParseFloat(p, end, value)) return fail("expected a number for " + element.name + " property " + property.name);
+						if (isVertex) {
+							for (size_t s = 0; s < ImportVertexFloats; ++s)
+								if (layout.slot[s] == static_cast<int>(q)) out.vertices[i * ImportVertexFloats + s] = value;
+						}
+						continue;
+					}
+
+					long long itemCount;
+					if (!ParseInt(p, end, itemCount) || itemCount < 0) return fail("expected a list length");
+					corners.resize(static_cast<size_t>(itemCount));
+					for (long long k = 0; k < itemCount; ++k) {
+						p = SkipSpace(p, end);
+						if (!ParseInt(p, end, corners[static_cast<size_t>(k)])) return fail("expected a list item");
+					}
+
+					if (static_cast<int>(q) == faceList && !AppendPlyPolygon(corners.data(), corners.size(), vertexCount, out.indices))
+						return fail("face is degenerate or refers to a missing vertex");
+				}
+			}
+		}
+		return true;
+	}
+
+	bool HasExtension(const std::string& path, const char* extension)
+	{
+		const size_t length = std::strlen(extension);
+		if (path.size() < length) return false;
+		return std::equal(path.end() - static_cast<std::ptrdiff_t>(length), path.end(), extension, [](char a, char b) {
+			return std::tolower(static_cast<unsigned char>(a)) == b;
+		});
+	}
+}
+
+namespace MeshImport
+{
+	/******************************************
+	 * ReadObj
+	 ******************************************/
+
+	bool ReadObj(const char* data, size_t size, MeshData& out, const Options& options, const std::string& name)
+	{
+		out.Clear();
+
+		// --- Line-aligned chunks ---
+		const size_t chunkCount = ChunkCount(size, options);
+		std::vector<ObjChunk> chunks(chunkCount);
+		const char* end = data + size;
+		const char* start = data;
+		for (size_t i = 0; i < chunkCount; ++i) {
+			const char* split = i + 1 == chunkCount ? end : data + size * (i + 1) / chunkCount;
+			if (split < start) split = start;
+			if (split < end) split = std::min(end, LineEnd(split, end) + 1);
+			chunks[i].begin = start;
+			chunks[i].end = split;
+			start = split;
+		}
+
+		// --- Count records, then give each chunk its bases ---
+		RunParallel(chunkCount, [&chunks](size_t i) { CountObjChunk(chunks[i]); });
+
+		size_t totals[3] = {};
+		for (ObjChunk& chunk : chunks) {
+			chunk.positionBase = totals[0];
+			chunk.texcoordBase = totals[1];
+			chunk.normalBase = totals[2];
+			totals[0] += chunk.positions;
+			totals[1] += chunk.texcoords;
+			totals[2] += chunk.normals;
+		}
+
+		if (totals[0] > static_cast<size_t>(INT32_MAX) || totals[1] > static_cast<size_t>(INT32_MAX) || totals[2] > static_cast<size_t>(INT32_MAX)) {
+			std::cerr << "Error: " << name << " has too many vertex records." << std::endl;
+			return false;
+		}
+
+		// --- Parse into the shared attribute arrays ---
+		std::vector<float> positions(totals[0] * 3), texcoords(totals[1] * 2), normals(totals[2] * 3);
+		RunParallel(chunkCount, [&](size_t i) {
+			ParseObjChunk(chunks[i], positions.data(), texcoords.data(), normals.data(), totals);
+		});
+
+		for (const ObjChunk& chunk : chunks) {
+			if (chunk.error) {
+				std::cerr << "Error: " << name << ":" << LineNumber(data, chunk.error) << ": " << chunk.message << std::endl;
+				return false;
+			}
+		}
+
+		// --- Weld corners into indexed vertices ---
+		WeldObjCorners(chunks, positions, texcoords, normals, out);
+		if (out.indices.empty()) {
+			std::cerr << "Error: " << name << " has no faces." << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	/******************************************
+	 * ReadPly
+	 ******************************************/
+
+	bool ReadPly(const char* data, size_t size, MeshData& out, const Options& options, const std::string& name)
+	{
+		out.Clear();
+
+		PlyHeader header;
+		std::string error;
+		bool ok = ParsePlyHeader(data, size, header, error);
+
+		if (ok && std::none_of(header.elements.begin(), header.elements.end(), [](const PlyElement& e) { return e.name == "vertex"; })) {
+			error = "no vertex element";
+			ok = false;
+		}
+
+		if (ok) {
+			ok = header.format == PlyFormat::Ascii
+				? ReadPlyAsciiBody(data, size, header, out, error)
+				: ReadPlyBinaryBody(data, size, header, out, options, error);
+		}
+		if (ok && out.indices.empty()) {
+			error = "no faces";
+			ok = false;
+		}
+
+		if (!ok) {
+			std::cerr << "Error: " << name << ": " << error << "." << std::endl;
+			out.Clear();
+			return false;
+		}
+
+		// Normals are all present or all missing in a PLY file; missing ones were left at zero.
+		const PlyElement& vertexElement = *std::find_if(header.elements.begin(), header.elements.end(),
+			[](const PlyElement& e) { return e.name == "vertex"; });
+		if (!MatchPlyVertexLayout(vertexElement).hasNormals)
+			GenerateMissingNormals(out, std::vector<unsigned char>(out.VertexCount(), 1));
+		return true;
+	}
+
+	/******************************************
+	 * Read
+	 ******************************************/
+
+	bool Read(const std::string& path, MeshData& out, const Options& options)
+	{
+		const bool isObj = HasExtension(path, ".obj");
+		if (!isObj && !HasExtension(path, ".ply")) {
+			std::cerr << "Error: unknown mesh format for " << path << " (use .obj or .ply)." << std::endl;
+			return false;
+		}
+
+		MappedFile file;
+		if (!file.Open(path)) {
+			std::cerr << "Error: cannot open " << path << " (missing or empty)." << std::endl;
+			return false;
+		}
+
+		const char* data = reinterpret_cast<const char*>(file.Data());
+		return isObj
+			? ReadObj(data, file.Size(), out, options, path)
+			: ReadPly(data, file.Size(), out, options, path);
+	}
+}
@@ -0,0 +1,86 @@
+/******************************************
+ * MeshImport
+ * ---------------------------------------
+ * Loads OBJ and PLY files into MeshData, so
+ * scanned or modelled parts can be uploaded
+ * with InitializeMesh() like any generated
+ * shape.
+ *
+ * The file is memory-mapped and parsed in
+ * place; the tokenizer works on pointers into
+ * the mapping and never allocates per token.
+ *
+ * - OBJ: v, vt and vn records and f records
+ *   (v, v/t, v//n, v/t/n; negative indices
+ *   allowed). Large files are split into
+ *   line-aligned chunks that are parsed on
+ *   separate threads: a counting pass gives
+ *   each chunk the base of its v/vt/vn
+ *   numbering, then every chunk writes its
+ *   attributes straight into the shared
+ *   arrays. Corners are then welded: each
+ *   distinct (v, vt, vn) triple becomes one
+ *   Vertex.
+ * - PLY: ascii, binary_little_endian and
+ *   binary_big_endian. Vertex properties x y z,
+ *   nx ny nz and s t (or u v, texture_u
+ *   texture_v) of any scalar type; a face list
+ *   named vertex_indices or vertex_index.
+ *   Other elements and properties are skipped.
+ *   Binary vertex data is converted on
+ *   separate threads.
+ *
+ * Polygons are fan-triangulated. Vertices
+ * without a normal get an area-weighted
+ * average of their faces' normals; missing
+ * texture coordinates are (0, 0).
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <string>
+
+struct MeshData;
+
+namespace MeshImport
+{
+    /******************************************
+     * Options
+     * ---------------------------------------
+     * - threads: Parser threads; 0 uses every
+     *   hardware thread.
+     * - parallelChunkBytes: Files (or binary
+     *   vertex sections) smaller than this are
+     *   parsed on the calling thread only, and no
+     *   chunk is made smaller than this.
+     ******************************************/
+
+    struct Options {
+        unsigned threads = 0;
+        size_t parallelChunkBytes = 4 * 1024 * 1024;
+    };
+
+    /******************************************
+     * Read
+     * ---------------------------------------
+     * Loads the file at path into out (replacing
+     * its contents), picking the format from the
+     * extension (.obj or .ply, any case). Errors
+     * are reported on std::cerr and return false.
+     ******************************************/
+
+    bool Read(const std::string& path, MeshData& out, const Options& options = Options());
+
+    /******************************************
+     * ReadObj / ReadPly
+     * ---------------------------------------
+     * Parse a file already in memory. name is
+     * only used in error messages.
+     ******************************************/
+
+    bool ReadObj(const char* data, size_t size, MeshData& out, const Options& options = Options(), const std::string& name = "OBJ data");
+    bool ReadPly(const char* data, size_t size, MeshData& out, const Options& options = Options(), const std::string& name = "PLY data");
+}
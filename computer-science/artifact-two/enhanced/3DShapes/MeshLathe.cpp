@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshLathe.cpp
+// =============
+// Ring tables, fans and revolved profiles for turned meshes. See
+// MeshLathe.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshLathe.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	// Writes one interleaved vertex, normalizing its normal.
+	inline void WriteLatheVertex(GLfloat*& out, float x, float y, float z, float nx, float ny, float nz, float u, float v)
+	{
+		float length = std::sqrt(nx * nx + ny * ny + nz * nz);
+		float scale = length > 0.0f ? 1.0f / length : 0.0f;
+
+		out[0] = x;
+		out[1] = y;
+		out[2] = z;
+		out[3] = nx * scale;
+		out[4] = ny * scale;
+		out[5] = nz * scale;
+		out[6] = u;
+		out[7] = v;
+		out += 8;
+	}
+
+	inline void WriteTriangle(GLuint*& out, GLuint a, GLuint b, GLuint c)
+	{
+		out[0] = a;
+		out[1] = b;
+		out[2] = c;
+		out += 3;
+	}
+}
+
+/******************************************
+ * LatheRing Factories
+ ******************************************/
+
+LatheRing LatheRing::Full(int slices, bool seam)
+{
+	LatheRing ring;
+	ring.slices = std::max(1, slices);
+
+	const int count = seam ? ring.slices + 1 : ring.slices;
+	const float step = 2.0f * 3.14159265f / ring.slices;
+	ring.cosines.resize(count);
+	ring.sines.resize(count);
+
+	for (int i = 0; i < count; ++i) {
+		float angle = i * step;
+		ring.cosines[i] = std::cos(angle);
+		ring.sines[i] = std::sin(angle);
+	}
+	return ring;
+}
+
+LatheRing LatheRing::Arc(int slices, float startAngle, float sweepAngle)
+{
+	LatheRing ring;
+	ring.slices = std::max(1, slices);
+	ring.fullCircle = false;
+
+	const float step = sweepAngle / ring.slices;
+	ring.cosines.resize(ring.slices + 1);
+	ring.sines.resize(ring.slices + 1);
+
+	for (int i = 0; i <= ring.slices; ++i) {
+		float angle = startAngle + i * step;
+		ring.cosines[i] = std::cos(angle);
+		ring.sines[i] = std::sin(angle);
+	}
+	return ring;
+}
+
+/******************************************
+ * AddFan / AddSurface
+ ******************************************/
+
+void LatheMesh::AddFan(const LatheFan& fan)
+{
+	Part part;
+	part.isFan = true;
+	part.fan = fan;
+	m_Parts.push_back(std::move(part));
+}
+
+void LatheMesh::AddSurface(LatheSurface surface)
+{
+	Part part;
+	part.surface = std::move(surface);
+	m_Parts.push_back(std::move(part));
+}
+
+/******************************************
+ * VertexCount / IndexCount
+ ******************************************/
+
+size_t LatheMesh::PartVertexCount(const Part& part) const
+{
+	if (part.isFan) {
+		const size_t centers = part.fan.splitCenter ? static_cast<size_t>(m_Ring.slices) : 1;
+		return centers + (part.fan.faceted ? 2 * static_cast<size_t>(m_Ring.slices) : m_Ring.Size());
+	}
+	return part.surface.profile.size() * m_Ring.Size();
+}
+
+size_t LatheMesh::PartIndexCount(const Part& part) const
+{
+	if (part.isFan)
+		return 3 * static_cast<size_t>(m_Ring.slices);
+
+	size_t bands = 0;
+	for (const std::vector<LatheBand>& pass : part.surface.passes)
+		bands += pass.size();
+	return bands * 6 * m_Ring.slices;
+}
+
+size_t LatheMesh::VertexCount() const
+{
+	size_t count = 0;
+	for (const Part& part : m_Parts)
+		count += PartVertexCount(part);
+	return count;
+}
+
+size_t LatheMesh::IndexCount() const
+{
+	size_t count = 0;
+	for (const Part& part : m_Parts)
+		count += PartIndexCount(part);
+	return count;
+}
+
+std::vector<size_t> LatheMesh::PartIndexCounts() const
+{
+	std::vector<size_t> counts;
+	counts.reserve(m_Parts.size());
+	for (const Part& part : m_Parts)
+		counts.push_back(PartIndexCount(part));
+	return counts;
+}
+
+/******************************************
+ * Build
+ ******************************************/
+
+void LatheMesh::Build(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices) const
+{
+	vertices.resize(VertexCount() * 8);
+	indices.resize(IndexCount());
+
+	GLfloat* vertexOut = vertices.data();
+	GLuint* indexOut = indices.data();
+	GLuint base = 0;
+
+	for (const Part& part : m_Parts) {
+		if (part.isFan)
+			WriteFan(part.fan, base, vertexOut, indexOut);
+		else
+			WriteSurface(part.surface, base, vertexOut, indexOut);
+		base += static_cast<GLuint>(PartVertexCount(part));
+	}
+}
+
+/******************************************
+ * WriteFan
+ * ---------------------------------------
+ * Center first, then the rim. A faceted rim
+ * takes the normal halfway between the
+ * slice's two edges for both of its vertices,
+ * as does each center of a split center.
+ ******************************************/
+
+void LatheMesh::WriteFan(const LatheFan& fan, GLuint base, GLfloat*& vertices, GLuint*& indices) const
+{
+	const LatheRing& ring = m_Ring;
+	const LatheProfilePoint& rim = fan.rim;
+	const float slices = static_cast<float>(ring.slices);
+
+	const GLuint centers = fan.splitCenter ? static_cast<GLuint>(ring.slices) : 1;
+	if (fan.splitCenter) {
+		for (int i = 0; i < ring.slices; ++i) {
+			size_t k0 = static_cast<size_t>(i);
+			size_t k1 = ring.Next(k0);
+			float nx = rim.normalRadial * (ring.cosines[k0] + ring.cosines[k1]) * 0.5f;
+			float nz = rim.normalRadial * (ring.sines[k0] + ring.sines[k1]) * 0.5f;
+			WriteLatheVertex(vertices, 0.0f, fan.center.y, 0.0f, nx, rim.normalY, nz, (i + 0.5f) / slices, fan.center.v);
+		}
+	}
+	else {
+		WriteLatheVertex(vertices, 0.0f, fan.center.y, 0.0f, 0.0f, fan.center.normalY, 0.0f, 0.5f, 0.5f);
+	}
+
+	auto writeRim = [&](size_t k, float nx, float nz, float u) {
+		float c = ring.cosines[k];
+		float s = ring.sines[k];
+		if (fan.polarUV)
+			WriteLatheVertex(vertices, rim.radius * c, rim.y, rim.radius * s, nx, rim.normalY, nz, 0.5f + 0.5f * c, 0.5f + 0.5f * s);
+		else
+			WriteLatheVertex(vertices, rim.radius * c, rim.y, rim.radius * s, nx, rim.normalY, nz, u, rim.v);
+	};
+
+	if (fan.faceted) {
+		for (int i = 0; i < ring.slices; ++i) {
+			size_t k0 = static_cast<size_t>(i);
+			size_t k1 = ring.Next(k0);
+			float nx = rim.normalRadial * (ring.cosines[k0] + ring.cosines[k1]) * 0.5f;
+			float nz = rim.normalRadial * (ring.sines[k0] + ring.sines[k1]) * 0.5f;
+			writeRim(k0, nx, nz, i / slices);
+			writeRim(k1, nx, nz, (i + 1) / slices);
+		}
+	}
+	else {
+		for (size_t k = 0; k < ring.Size(); ++k)
+			writeRim(k, rim.normalRadial * ring.cosines[k], rim.normalRadial * ring.sines[k], k / slices);
+	}
+
+	const GLuint rimStart = base + centers;
+	for (int i = 0; i < ring.slices; ++i) {
+		GLuint center = fan.splitCenter ? base + i : base;
+		GLuint current = fan.faceted ? rimStart + 2 * i : rimStart + i;
+		GLuint next = fan.faceted ? current + 1
+			: fan.splitCenter ? rimStart + static_cast<GLuint>(ring.Next(i))
+			: rimStart + (ring.fullCircle ? (i + 1) % ring.slices : i + 1);
+
+		if (fan.reverse)
+			WriteTriangle(indices, center, next, current);
+		else
+			WriteTriangle(indices, center, current, next);
+	}
+}
+
+/******************************************
+ * WriteSurface
+ ******************************************/
+
+void LatheMesh::WriteSurface(const LatheSurface& surface, GLuint base, GLfloat*& vertices, GLuint*& indices) const
+{
+	const LatheRing& ring = m_Ring;
+	const size_t points = surface.profile.size();
+	const bool sliceMajor = surface.layout == LatheLayout::SliceMajor;
+	const float slices = static_cast<float>(ring.slices);
+
+	auto writeVertex = [&](size_t j, size_t k) {
+		const LatheProfilePoint& p = surface.profile[j];
+		float c = ring.cosines[k];
+		float s = ring.sines[k];
+		float u = surface.flipU ? 1.0f - k / slices : k / slices;
+		WriteLatheVertex(vertices, p.radius * c, p.y, p.radius * s, p.normalRadial * c, p.normalY, p.normalRadial * s, u, p.v);
+	};
+
+	if (sliceMajor) {
+		for (size_t k = 0; k < ring.Size(); ++k)
+			for (size_t j = 0; j < points; ++j)
+				writeVertex(j, k);
+	}
+	else {
+		for (size_t j = 0; j < points; ++j)
+			for (size_t k = 0; k < ring.Size(); ++k)
+				writeVertex(j, k);
+	}
+
+	auto index = [&](uint32_t j, size_t k) {
+		return base + static_cast<GLuint>(sliceMajor ? k * points + j : j * ring.Size() + k);
+	};
+
+	auto writeQuad = [&](const LatheBand& band, size_t i) {
+		const size_t next = ring.Next(i);
+		const GLuint corner[4] = { index(band.a, i), index(band.a, next), index(band.b, i), index(band.b, next) };
+		for (uint8_t c : band.corners)
+			*indices++ = corner[c];
+	};
+
+	for (const std::vector<LatheBand>& pass : surface.passes) {
+		if (sliceMajor) {
+			for (int i = 0; i < ring.slices; ++i)
+				for (const LatheBand& band : pass)
+					writeQuad(band, i);
+		}
+		else {
+			for (const LatheBand& band : pass)
+				for (int i = 0; i < ring.slices; ++i)
+					writeQuad(band, i);
+		}
+	}
+}
@@ -0,0 +1,217 @@
+/******************************************
+ * MeshLathe
+ * ---------------------------------------
+ * Turns a 2D profile about the Y axis: the
+ * one generator behind the cylinder, cone,
+ * tapered cylinder, tube, hemisphere and
+ * partial cone, and behind any other turned
+ * part.
+ *
+ * A LatheMesh is built from one LatheRing, the
+ * sin/cos table of its slice angles, which
+ * every part reads instead of calling the trig
+ * functions per vertex, plus an ordered list
+ * of parts:
+ *
+ * - LatheFan: A disc or point-topped cone
+ *   between the axis and one rim point (caps,
+ *   the cone's side).
+ * - LatheSurface: A polyline profile revolved
+ *   into one ring of vertices per point, with
+ *   bands of quads between pairs of points.
+ *
+ * VertexCount() and IndexCount() are known
+ * before anything is written, so Build() sizes
+ * the output once and writes straight into it.
+ * Parts are written in the order they were
+ * added, vertices and indices alike, so a
+ * shape's draw ranges follow from that order.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/******************************************
+ * LatheRing
+ * ---------------------------------------
+ * cos and sin of every slice angle, computed
+ * once per mesh.
+ *
+ * - Full(slices, seam): slices angles around
+ *   the full circle from 0; with seam set the
+ *   first is repeated as 2 pi at the end so
+ *   the texture wraps once.
+ * - Arc(slices, start, sweep): slices + 1
+ *   angles from start to start + sweep.
+ *
+ * Either way a ring has slices quads; the last
+ * one of a seamless full ring closes back on
+ * angle 0.
+ ******************************************/
+
+struct LatheRing {
+    std::vector<float> cosines;
+    std::vector<float> sines;
+    int slices = 0;
+    bool fullCircle = true;
+
+    size_t Size() const { return cosines.size(); }
+    size_t Next(size_t slice) const { return (slice + 1) % Size(); }
+
+    static LatheRing Full(int slices, bool seam);
+    static LatheRing Arc(int slices, float startAngle, float sweepAngle);
+};
+
+// One profile point: its place in the (radius, y) half-plane, the surface
+// normal there in the same plane, and its texture V.
+struct LatheProfilePoint {
+    float radius = 0.0f;
+    float y = 0.0f;
+    float normalRadial = 0.0f;
+    float normalY = 0.0f;
+    float v = 0.0f;
+};
+
+/******************************************
+ * LatheFan
+ * ---------------------------------------
+ * One triangle per slice from a center vertex
+ * on the axis to a rim. The center has UV
+ * (0.5, 0.5). On a full ring the last
+ * triangle closes on the first rim vertex even
+ * when the ring has a seam; an arc's fan stays
+ * open between its ends.
+ *
+ * - faceted: Two rim vertices per slice, both
+ *   with the slice's averaged normal, instead
+ *   of one shared vertex per ring angle.
+ * - splitCenter: One center vertex per slice
+ *   instead of one shared, each with the rim's
+ *   profile normal turned to the middle of its
+ *   slice and UV ((slice + 0.5) / slices,
+ *   center.v). Smooth shading up to a cone's
+ *   apex, where no single normal fits every
+ *   slice. The rim keeps one vertex per ring
+ *   angle, and the last triangle closes on the
+ *   seam vertex when the ring has one.
+ * - polarUV: Rim UVs map the disc onto the
+ *   texture (0.5 + 0.5 cos, 0.5 + 0.5 sin);
+ *   otherwise (slice / slices, rim.v).
+ * - reverse: Triangles are (center, next,
+ *   current) rather than (center, current,
+ *   next).
+ ******************************************/
+
+struct LatheFan {
+    LatheProfilePoint center;   // radius is ignored
+    LatheProfilePoint rim;
+    bool faceted = false;
+    bool splitCenter = false;
+    bool polarUV = true;
+    bool reverse = false;
+};
+
+// Vertex order of a LatheSurface: SliceMajor writes every profile point of a
+// slice before the next slice; RingMajor writes a whole ring per point.
+enum class LatheLayout {
+    SliceMajor,
+    RingMajor
+};
+
+/******************************************
+ * LatheBand
+ * ---------------------------------------
+ * The quads between profile points a and b,
+ * one per slice. Each quad is written as two
+ * triangles over its corners, listed in
+ * corners: point a and point b on slice i
+ * (A0, B0) and on the next slice (A1, B1).
+ * Spelling the corners out lets every shape
+ * keep the exact index order its draw ranges
+ * and caches were built with.
+ ******************************************/
+
+namespace LatheCorner
+{
+    enum Corner : uint8_t { A0, A1, B0, B1 };
+}
+
+struct LatheBand {
+    uint32_t a = 0;
+    uint32_t b = 0;
+    std::array<uint8_t, 6> corners = {};
+};
+
+/******************************************
+ * LatheSurface
+ * ---------------------------------------
+ * A profile revolved into one ring of
+ * vertices per point, each at (radius cos,
+ * y, radius sin) with UV (slice / slices, v),
+ * or 1 - slice / slices with flipU set.
+ *
+ * Quads are written pass by pass. Within a
+ * pass they follow the vertex order: slice by
+ * slice with every band per slice for
+ * SliceMajor, band by band for RingMajor.
+ ******************************************/
+
+struct LatheSurface {
+    std::vector<LatheProfilePoint> profile;
+    std::vector<std::vector<LatheBand>> passes;
+    LatheLayout layout = LatheLayout::SliceMajor;
+    bool flipU = false;
+};
+
+/******************************************
+ * LatheMesh
+ * ---------------------------------------
+ * - AddFan() / AddSurface(): Append a part.
+ * - VertexCount() / IndexCount(): Totals for
+ *   the parts added so far.
+ * - PartIndexCounts(): Indices of each part,
+ *   in the order added, which is the order
+ *   Build writes them in.
+ * - Build(vertices, indices): Resizes both
+ *   arrays to exactly those totals and writes
+ *   every part (8 floats per vertex, see
+ *   Vertex).
+ ******************************************/
+
+class LatheMesh {
+public:
+    explicit LatheMesh(LatheRing ring) : m_Ring(std::move(ring)) { m_Parts.reserve(4); }
+
+    const LatheRing& Ring() const { return m_Ring; }
+
+    void AddFan(const LatheFan& fan);
+    void AddSurface(LatheSurface surface);
+
+    size_t VertexCount() const;
+    size_t IndexCount() const;
+    std::vector<size_t> PartIndexCounts() const;
+
+    void Build(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices) const;
+
+private:
+    struct Part {
+        bool isFan = false;
+        LatheFan fan;
+        LatheSurface surface;
+    };
+
+    size_t PartVertexCount(const Part& part) const;
+    size_t PartIndexCount(const Part& part) const;
+    void WriteFan(const LatheFan& fan, GLuint base, GLfloat*& vertices, GLuint*& indices) const;
+    void WriteSurface(const LatheSurface& surface, GLuint base, GLfloat*& vertices, GLuint*& indices) const;
+
+    LatheRing m_Ring;
+    std::vector<Part> m_Parts;
+};
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshStreamRing.cpp
+// ==================
+// Persistently mapped, fenced streaming buffer. See MeshStreamRing.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshStreamRing.h"
+
+#include <iostream>
+
+namespace
+{
+	constexpr GLbitfield StreamMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	constexpr GLuint64 FenceTimeoutNs = 1000000000ull;   // per wait; waits repeat until signalled
+}
+
+MeshStreamRing::~MeshStreamRing()
+{
+	Release();
+}
+
+bool MeshStreamRing::IsSupported()
+{
+	return GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+}
+
+/******************************************
+ * Create
+ ******************************************/
+
+bool MeshStreamRing::Create(size_t segmentBytes)
+{
+	Release();
+	if (segmentBytes == 0) return false;
+
+	glGenBuffers(1, &m_Buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+	glBufferStorage(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(segmentBytes * SegmentCount), nullptr, StreamMapFlags);
+	m_Mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0,
+		static_cast<GLsizeiptr>(segmentBytes * SegmentCount), StreamMapFlags));
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	if (!m_Mapped) {
+		std::cerr << "Warning: could not map a " << segmentBytes * SegmentCount
+			<< "-byte streaming buffer; dynamic meshes will use glBufferData." << std::endl;
+		glDeleteBuffers(1, &m_Buffer);
+		m_Buffer = 0;
+		return false;
+	}
+
+	m_SegmentBytes = segmentBytes;
+	m_Segment = 0;
+	m_Head = 0;
+	return true;
+}
+
+/******************************************
+ * Release
+ * ---------------------------------------
+ * Waits for every outstanding fence before
+ * unmapping, so no draw still reads from the
+ * storage.
+ ******************************************/
+
+void MeshStreamRing::Release()
+{
+	for (unsigned segment = 0; segment < SegmentCount; ++segment)
+		WaitForSegment(segment);
+
+	if (m_Buffer != 0) {
+		if (m_Mapped) {
+			glBindBuffer(GL_COPY_WRITE_BUFFER, m_Buffer);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+		glDeleteBuffers(1, &m_Buffer);
+	}
+
+	m_Buffer = 0;
+	m_Mapped = nullptr;
+	m_SegmentBytes = 0;
+	m_Segment = 0;
+	m_Head = 0;
+}
+
+/******************************************
+ * Reserve / Commit
+ ******************************************/
+
+unsigned char* MeshStreamRing::Reserve(size_t maxBytes, size_t alignment, size_t& offset)
+{
+	if (!m_Mapped || maxBytes > m_SegmentBytes) return nullptr;
+
+	// Segments start at multiples of m_SegmentBytes; keep offsets aligned in
+	// absolute terms so base vertices come out whole.
+	const size_t segmentStart = static_cast<size_t>(m_Segment) * m_SegmentBytes;
+	size_t aligned = (segmentStart + m_Head + alignment - 1) / alignment * alignment - segmentStart;
+
+	if (aligned + maxBytes > m_SegmentBytes) {
+		Advance();
+		const size_t nextStart = static_cast<size_t>(m_Segment) * m_SegmentBytes;
+		aligned = (nextStart + alignment - 1) / alignment * alignment - nextStart;
+		if (aligned + maxBytes > m_SegmentBytes) return nullptr;
+	}
+
+	m_ReservedAt = aligned;
+	offset = static_cast<size_t>(m_Segment) * m_SegmentBytes + aligned;
+	return m_Mapped + offset;
+}
+
+void MeshStreamRing::Commit(size_t bytes)
+{
+	m_Head = m_ReservedAt + bytes;
+}
+
+/******************************************
+ * EndFrame / Advance
+ ******************************************/
+
+void MeshStreamRing::EndFrame()
+{
+	if (m_Mapped && m_Head > 0) Advance();
+}
+
+void MeshStreamRing::Advance()
+{
+	if (m_Fences[m_Segment]) glDeleteSync(m_Fences[m_Segment]);
+	m_Fences[m_Segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	m_Segment = (m_Segment + 1) % SegmentCount;
+	m_Head = 0;
+	WaitForSegment(m_Segment);
+}
+
+void MeshStreamRing::WaitForSegment(unsigned segment)
+{
+	GLsync& fence = m_Fences[segment];
+	if (!fence) return;
+
+	for (;;) {
+		// The flush makes sure the fence has been submitted, or the wait could never end.
+		GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNs);
+		if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) break;
+		if (result == GL_WAIT_FAILED) {
+			std::cerr << "Error: waiting on a streaming buffer fence failed." << std::endl;
+			break;
+		}
+	}
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
@@ -0,0 +1,133 @@
+/******************************************
+ * MeshStreamRing
+ * ---------------------------------------
+ * A persistently mapped, coherent buffer for
+ * geometry that is regenerated every draw
+ * (the tapered torus, spiral, sine cone and
+ * superellipsoid).
+ *
+ * The storage is created once with
+ * glBufferStorage and stays mapped, so draws
+ * never make the driver reallocate or
+ * orphan anything. It is split into
+ * SegmentCount equal segments used in turn:
+ * draws sub-allocate from the current
+ * segment, and leaving a segment (at
+ * EndFrame(), or when it fills up) puts a
+ * fence behind its draws. A segment is only
+ * written again after its fence has signalled,
+ * so the CPU never overwrites data the GPU is
+ * still reading.
+ *
+ * Needs OpenGL 4.4 or ARB_buffer_storage; see
+ * IsSupported().
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+/******************************************
+ * MappedArray
+ * ---------------------------------------
+ * Fixed-capacity array over mapped memory
+ * with the push_back/size interface the mesh
+ * generators use, so they can write straight
+ * into a ring reservation.
+ ******************************************/
+
+template <typename T>
+class MappedArray
+{
+public:
+    MappedArray() = default;
+    MappedArray(T* data, size_t capacity) : m_Data(data), m_Capacity(capacity) {}
+
+    void push_back(T value) {
+        if (m_Size < m_Capacity) m_Data[m_Size] = value;
+        ++m_Size;
+    }
+    void reserve(size_t) {}
+
+    size_t size() const { return m_Size; }
+    size_t capacity() const { return m_Capacity; }
+    bool overflowed() const { return m_Size > m_Capacity; }
+
+private:
+    T* m_Data = nullptr;
+    size_t m_Size = 0;
+    size_t m_Capacity = 0;
+};
+
+class MeshStreamRing
+{
+public:
+    static constexpr unsigned SegmentCount = 3;
+
+    MeshStreamRing() = default;
+    ~MeshStreamRing();
+
+    MeshStreamRing(const MeshStreamRing&) = delete;
+    MeshStreamRing& operator=(const MeshStreamRing&) = delete;
+
+    // True when the context has glBufferStorage (GL 4.4 or ARB_buffer_storage).
+    static bool IsSupported();
+
+    /******************************************
+     * Create / Release
+     * ---------------------------------------
+     * Create() allocates and maps SegmentCount
+     * segments of segmentBytes each, replacing
+     * any previous storage (after waiting for
+     * the GPU to finish with it). Returns false
+     * if the buffer cannot be created or mapped.
+     ******************************************/
+
+    bool Create(size_t segmentBytes);
+    void Release();
+
+    bool IsReady() const { return m_Mapped != nullptr; }
+    GLuint Buffer() const { return m_Buffer; }
+    size_t SegmentBytes() const { return m_SegmentBytes; }
+    size_t Capacity() const { return m_SegmentBytes * SegmentCount; }
+
+    /******************************************
+     * Reserve / Commit
+     * ---------------------------------------
+     * Reserve() returns mapped memory for up to
+     * maxBytes at a buffer offset that is a
+     * multiple of alignment, moving to the next
+     * segment if the current one is too full.
+     * Returns nullptr if maxBytes is larger than
+     * a segment. Commit() then keeps the bytes
+     * actually written (at most maxBytes).
+     ******************************************/
+
+    unsigned char* Reserve(size_t maxBytes, size_t alignment, size_t& offset);
+    void Commit(size_t bytes);
+
+    /******************************************
+     * EndFrame
+     * ---------------------------------------
+     * Fences the current segment's draws and
+     * moves on to the next segment. Does nothing
+     * if the segment has not been used.
+     ******************************************/
+
+    void EndFrame();
+
+private:
+    void Advance();
+    void WaitForSegment(unsigned segment);
+
+    GLuint m_Buffer = 0;
+    unsigned char* m_Mapped = nullptr;
+    size_t m_SegmentBytes = 0;
+
+    unsigned m_Segment = 0;        // Segment being written
+    size_t m_Head = 0;             // Bytes used in the current segment
+    size_t m_ReservedAt = 0;       // Segment-relative offset of the open reservation
+    GLsync m_Fences[SegmentCount] = {};
+};
@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////
+// MeshSweep.cpp
+// =============
+// Centerline sampling, frames and profiles for swept meshes. See
+// MeshSweep.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "MeshSweep.h"
+
+#include <algorithm>
+#include <cmath>
+
+/******************************************
+ * SweepProfile Factories
+ ******************************************/
+
+SweepProfile SweepProfile::Circle(int segments, bool seam)
+{
+	return Ellipse(segments, seam, 1.0f, 1.0f);
+}
+
+SweepProfile SweepProfile::Ellipse(int segments, bool seam, float normalScale, float binormalScale)
+{
+	SweepProfile profile;
+	profile.segments = std::max(1, segments);
+
+	const int count = seam ? profile.segments + 1 : profile.segments;
+	const float step = 2.0f * 3.14159265f / profile.segments;
+	profile.points.reserve(count);
+	profile.normals.reserve(count);
+
+	for (int j = 0; j < count; ++j) {
+		float angle = j * step;
+		glm::vec2 point(normalScale * std::cos(angle), binormalScale * std::sin(angle));
+		profile.points.push_back(point);
+		// Away from the center, as the tube generators have always shaded it.
+		profile.normals.push_back(glm::normalize(point));
+	}
+	return profile;
+}
+
+/******************************************
+ * SampleCenterline / FiniteDifferenceTangents
+ ******************************************/
+
+void MeshSweep::SampleCenterline(std::vector<SweepFrame>& frames, const std::function<glm::vec3(float)>& curve,
+	int ringCount, float t0, float t1)
+{
+	frames.clear();
+	if (ringCount < 2) return;
+
+	frames.resize(static_cast<size_t>(ringCount));
+	for (int i = 0; i < ringCount; ++i) {
+		float t = t0 + (t1 - t0) * (static_cast<float>(i) / (ringCount - 1));
+		frames[i].center = curve(t);
+		frames[i].along = static_cast<float>(i) / (ringCount - 1);
+	}
+	FiniteDifferenceTangents(frames);
+}
+
+void MeshSweep::SampleCenterline(std::vector<SweepFrame>& frames, const SweepCurve& curve, const std::vector<float>& params)
+{
+	frames.clear();
+	if (params.size() < 2) return;
+
+	const float span = curve.t1 - curve.t0;
+	const float h = span * 1e-4f;
+	frames.resize(params.size());
+
+	for (size_t i = 0; i < params.size(); ++i) {
+		float t = params[i];
+		float ahead = std::min(t + h, curve.t1);
+		float behind = std::max(t - h, curve.t0);
+		frames[i].center = curve.position(t);
+		frames[i].tangent = glm::normalize(curve.position(ahead) - curve.position(behind));
+		frames[i].along = span != 0.0f ? (t - curve.t0) / span : 0.0f;
+	}
+}
+
+void MeshSweep::FiniteDifferenceTangents(std::vector<SweepFrame>& frames)
+{
+	const size_t count = frames.size();
+	if (count < 2) return;
+
+	for (size_t i = 0; i < count; ++i) {
+		const size_t ahead = std::min(i + 1, count - 1);
+		const size_t behind = i == 0 ? 0 : i - 1;
+		frames[i].tangent = glm::normalize(frames[ahead].center - frames[behind].center);
+	}
+}
+
+/******************************************
+ * ChordError / MaxChordError
+ * ---------------------------------------
+ * Distance from each probe to the segment,
+ * not the infinite line, so a step that
+ * doubles back on itself still counts its
+ * full deviation.
+ ******************************************/
+
+namespace
+{
+	const int ChordProbes = 8;
+
+	float DistanceToSegment(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b)
+	{
+		glm::vec3 ab = b - a;
+		float lengthSquared = glm::dot(ab, ab);
+		float s = lengthSquared > 0.0f ? std::clamp(glm::dot(p - a, ab) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+		glm::vec3 offset = p - (a + ab * s);
+		return std::sqrt(glm::dot(offset, offset));
+	}
+}
+
+float MeshSweep::ChordError(const SweepCurve& curve, float a, float b)
+{
+	const glm::vec3 start = curve.position(a);
+	const glm::vec3 end = curve.position(b);
+
+	float error = 0.0f;
+	for (int k = 1; k < ChordProbes; ++k) {
+		float t = a + (b - a) * (static_cast<float>(k) / ChordProbes);
+		error = std::max(error, DistanceToSegment(curve.position(t), start, end));
+	}
+	return error;
+}
+
+float MeshSweep::MaxChordError(const SweepCurve& curve, const std::vector<float>& params)
+{
+	float error = 0.0f;
+	for (size_t i = 1; i < params.size(); ++i)
+		error = std::max(error, ChordError(curve, params[i - 1], params[i]));
+	return error;
+}
+
+/******************************************
+ * UniformParameters / AdaptiveParameters
+ * ---------------------------------------
+ * The adaptive walk tries twice the last step
+ * first (maxStep to begin with), so long
+ * gentle stretches cost a few evaluations,
+ * then bisects between the last step that
+ * passed and the one that failed.
+ ******************************************/
+
+void MeshSweep::UniformParameters(std::vector<float>& params, const SweepCurve& curve, int segments)
+{
+	segments = std::max(1, segments);
+	params.resize(static_cast<size_t>(segments) + 1);
+	for (int i = 0; i <= segments; ++i)
+		params[i] = curve.t0 + (curve.t1 - curve.t0) * (static_cast<float>(i) / segments);
+}
+
+bool MeshSweep::AdaptiveParameters(std::vector<float>& params, const SweepCurve& curve, float tolerance,
+	int maxSegments, float maxStep)
+{
+	const float span = curve.t1 - curve.t0;
+	if (tolerance <= 0.0f || span <= 0.0f) {
+		UniformParameters(params, curve, maxSegments);
+		return false;
+	}
+
+	const float minStep = span * 1e-5f;
+	maxStep = maxStep > 0.0f ? std::min(maxStep, span) : span;
+
+	params.clear();
+	params.push_back(curve.t0);
+
+	float t = curve.t0;
+	float step = maxStep;
+
+	while (t < curve.t1) {
+		if (static_cast<int>(params.size()) > maxSegments) {
+			UniformParameters(params, curve, maxSegments);
+			return false;
+		}
+
+		const float remaining = curve.t1 - t;
+		float trial = std::min({ step * 2.0f, maxStep, remaining });
+
+		if (ChordError(curve, t, t + trial) > tolerance) {
+			float good = minStep;
+			float bad = trial;
+			for (int iteration = 0; iteration < 12; ++iteration) {
+				float middle = 0.5f * (good + bad);
+				if (ChordError(curve, t, t + middle) > tolerance)
+					bad = middle;
+				else
+					good = middle;
+			}
+			trial = std::min(good, remaining);
+		}
+
+		// Snap a sliver left before the end onto the end.
+		t = remaining - trial < minStep ? curve.t1 : t + trial;
+		params.push_back(t);
+		step = trial;
+	}
+
+	if (static_cast<int>(params.size()) - 1 > maxSegments) {
+		UniformParameters(params, curve, maxSegments);
+		return false;
+	}
+	return true;
+}
+
+/******************************************
+ * CompareSampling
+ * ---------------------------------------
+ * Chord error falls as the ring count rises,
+ * so doubling then bisecting the uniform
+ * count finds the fewest even rings whose
+ * error is no worse than params' error.
+ ******************************************/
+
+SweepSamplingReport MeshSweep::CompareSampling(const SweepCurve& curve, const std::vector<float>& params,
+	int configuredSegments, size_t verticesPerRing)
+{
+	SweepSamplingReport report;
+	report.rings = params.size();
+	report.maxError = MaxChordError(curve, params);
+	report.verticesPerRing = verticesPerRing;
+
+	std::vector<float> uniform;
+	UniformParameters(uniform, curve, configuredSegments);
+	report.configuredRings = uniform.size();
+	report.configuredError = MaxChordError(curve, uniform);
+
+	auto errorAt = [&](int segments) {
+		UniformParameters(uniform, curve, segments);
+		return MaxChordError(curve, uniform);
+	};
+
+	int high = 1;
+	while (errorAt(high) > report.maxError && high < (1 << 20))
+		high *= 2;
+
+	int low = high / 2;
+	while (low + 1 < high) {
+		int middle = (low + high) / 2;
+		if (errorAt(middle) > report.maxError)
+			low = middle;
+		else
+			high = middle;
+	}
+	report.uniformRings = static_cast<size_t>(high) + 1;
+	return report;
+}
+
+/******************************************
+ * ComputeFrames
+ * ---------------------------------------
+ * Double reflection: reflecting frame i in
+ * the plane bisecting centers i and i + 1
+ * carries it to ring i + 1 with the tangent
+ * slightly off; a second reflection in the
+ * plane bisecting that tangent and the real
+ * one lines it up. Both are orthogonal, so
+ * the normal stays unit length and
+ * perpendicular to the tangent up to
+ * rounding, which the normalize removes.
+ ******************************************/
+
+void MeshSweep::ComputeFrames(std::vector<SweepFrame>& frames, const glm::vec3& up, SweepFrameMode mode)
+{
+	for (size_t i = 0; i < frames.size(); ++i) {
+		SweepFrame& frame = frames[i];
+
+		if (i == 0 || mode == SweepFrameMode::FixedUp) {
+			glm::vec3 side = glm::cross(up, frame.tangent);
+			if (glm::dot(side, side) < 1e-12f) {
+				// Tangent along up: seed from whichever axis is furthest from it.
+				glm::vec3 axis = std::fabs(frame.tangent.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+				side = glm::cross(axis, frame.tangent);
+			}
+			frame.normal = glm::normalize(side);
+			frame.binormal = glm::cross(frame.tangent, frame.normal);
+			continue;
+		}
+
+		const SweepFrame& previous = frames[i - 1];
+		glm::vec3 normal = previous.normal;
+		glm::vec3 tangent = previous.tangent;
+
+		glm::vec3 v1 = frame.center - previous.center;
+		float c1 = glm::dot(v1, v1);
+		if (c1 > 0.0f) {
+			normal -= (2.0f / c1) * glm::dot(v1, normal) * v1;
+			tangent -= (2.0f / c1) * glm::dot(v1, tangent) * v1;
+		}
+
+		glm::vec3 v2 = frame.tangent - tangent;
+		float c2 = glm::dot(v2, v2);
+		if (c2 > 0.0f)
+			normal -= (2.0f / c2) * glm::dot(v2, normal) * v2;
+
+		frame.normal = glm::normalize(normal);
+		frame.binormal = glm::cross(frame.tangent, frame.normal);
+	}
+}
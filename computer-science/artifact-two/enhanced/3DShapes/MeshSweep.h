@@ -0,0 +1,243 @@
+/******************************************
+ * MeshSweep
+ * ---------------------------------------
+ * Sweeps a cross-section along a centerline:
+ * the one tube-along-a-curve generator behind
+ * the spring, curved cone and spiral, and
+ * behind ShapeMeshes::GenerateSweepMesh for
+ * any other curve.
+ *
+ * A sweep is built in three steps:
+ *
+ * 1. Centerline: one SweepFrame per ring with
+ *    its center and unit tangent, from a shape's
+ *    own sampler or from SampleCenterline().
+ * 2. Frames: ComputeFrames() fills in normal
+ *    and binormal. RotationMinimizing uses the
+ *    double-reflection method (Wang et al.,
+ *    "Computation of Rotation Minimizing
+ *    Frames", 2008): two reflections per ring,
+ *    no matrices, no acos, and no twist or flip
+ *    on any curve. FixedUp keeps the normal
+ *    perpendicular to an up axis, which matches
+ *    a helix's screw symmetry.
+ * 3. Rings: AppendSweepRings() places a cached
+ *    SweepProfile around every frame, scaled by
+ *    a per-ring radius. The profile's sin/cos
+ *    are computed once per mesh, not per ring.
+ *
+ * Rings may be spaced evenly or placed by
+ * AdaptiveParameters(), which puts them where
+ * the curve bends: each chord between
+ * neighbouring rings stays within a distance
+ * tolerance of the true curve.
+ *
+ * Ring i, profile point j is vertex
+ * i * profile.Size() + j, so a sweep is a
+ * GridTopology of (rings - 1) x segments:
+ * Duplicated seam when the profile repeats its
+ * first point, Wrapped otherwise.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+struct SweepFrame {
+    glm::vec3 center;
+    glm::vec3 tangent;      // unit
+    glm::vec3 normal;       // unit, perpendicular to tangent
+    glm::vec3 binormal;     // tangent x normal
+    float along = 0.0f;     // 0 at the first ring to 1 at the last; texture coordinate along the sweep
+};
+
+// A centerline: position as a function of a parameter running from t0 to t1.
+struct SweepCurve {
+    std::function<glm::vec3(float)> position;
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+};
+
+/******************************************
+ * SweepSamplingReport
+ * ---------------------------------------
+ * How many rings a sampling of a curve needs
+ * against even spacing, from
+ * MeshSweep::CompareSampling().
+ *
+ * - rings / maxError: The sampling compared
+ *   and its largest chord error.
+ * - uniformRings: Evenly spaced rings needed to
+ *   get the same maximum error.
+ * - configuredRings / configuredError: The
+ *   even spacing the shape's segment counts
+ *   ask for, and its error.
+ * - verticesPerRing: Profile points per ring,
+ *   to turn rings into vertices.
+ ******************************************/
+
+struct SweepSamplingReport {
+    size_t rings = 0;
+    float maxError = 0.0f;
+    size_t uniformRings = 0;
+    size_t configuredRings = 0;
+    float configuredError = 0.0f;
+    size_t verticesPerRing = 0;
+
+    size_t Vertices() const { return rings * verticesPerRing; }
+    size_t UniformVertices() const { return uniformRings * verticesPerRing; }
+    // Fraction of the equal-error uniform vertices saved; negative if the sampling needs more.
+    float Savings() const { return uniformRings ? 1.0f - static_cast<float>(rings) / uniformRings : 0.0f; }
+};
+
+enum class SweepFrameMode {
+    RotationMinimizing,     // transported from the first frame
+    FixedUp                 // normal = normalize(up x tangent) on every ring
+};
+
+/******************************************
+ * SweepProfile
+ * ---------------------------------------
+ * The cross-section as unit-radius offsets in
+ * the (normal, binormal) plane, in order
+ * around the ring, plus the outward normal of
+ * each in the same plane.
+ *
+ * - Circle(segments, seam): segments points;
+ *   with seam set the first is repeated at the
+ *   end so the texture wraps once.
+ * - Ellipse(...): A circle scaled along the
+ *   normal and binormal.
+ ******************************************/
+
+struct SweepProfile {
+    std::vector<glm::vec2> points;
+    std::vector<glm::vec2> normals;
+    int segments = 0;       // distinct points around the ring
+
+    size_t Size() const { return points.size(); }
+    bool HasSeam() const { return points.size() > static_cast<size_t>(segments); }
+
+    static SweepProfile Circle(int segments, bool seam);
+    static SweepProfile Ellipse(int segments, bool seam, float normalScale, float binormalScale);
+};
+
+namespace MeshSweep
+{
+    /******************************************
+     * SampleCenterline
+     * ---------------------------------------
+     * Evaluates curve at ringCount evenly spaced
+     * parameters from t0 to t1 (ringCount >= 2)
+     * and fills centers and finite-difference
+     * tangents. For curves without an analytic
+     * tangent.
+     ******************************************/
+
+    void SampleCenterline(std::vector<SweepFrame>& frames, const std::function<glm::vec3(float)>& curve,
+        int ringCount, float t0 = 0.0f, float t1 = 1.0f);
+
+    // One ring per parameter in params, with the tangent from a short central difference along the curve.
+    void SampleCenterline(std::vector<SweepFrame>& frames, const SweepCurve& curve, const std::vector<float>& params);
+
+    // Unit tangents from the centers alone: one-sided at the ends, central elsewhere.
+    void FiniteDifferenceTangents(std::vector<SweepFrame>& frames);
+
+    /******************************************
+     * Ring Placement
+     * ---------------------------------------
+     * - ChordError(curve, a, b): Largest distance
+     *   from the curve between parameters a and b
+     *   to the straight chord joining its ends,
+     *   probed at evenly spaced points.
+     * - MaxChordError(curve, params): The largest
+     *   ChordError over neighbouring parameters.
+     * - UniformParameters(params, curve, n): n
+     *   even segments from t0 to t1.
+     * - AdaptiveParameters(...): Walks from t0
+     *   taking the longest step, up to maxStep,
+     *   whose chord is within tolerance. If that
+     *   needs more than maxSegments segments it
+     *   returns the uniform maxSegments sampling
+     *   and false instead, so a mesh never gets
+     *   more rings than its segment counts ask
+     *   for. maxStep keeps a step from spanning a
+     *   whole loop, whose chord can be short.
+     * - CompareSampling(...): Fills a
+     *   SweepSamplingReport for params, searching
+     *   for the uniform ring count that matches
+     *   its maximum error.
+     ******************************************/
+
+    float ChordError(const SweepCurve& curve, float a, float b);
+    float MaxChordError(const SweepCurve& curve, const std::vector<float>& params);
+    void UniformParameters(std::vector<float>& params, const SweepCurve& curve, int segments);
+    bool AdaptiveParameters(std::vector<float>& params, const SweepCurve& curve, float tolerance, int maxSegments, float maxStep);
+    SweepSamplingReport CompareSampling(const SweepCurve& curve, const std::vector<float>& params,
+        int configuredSegments, size_t verticesPerRing);
+
+    /******************************************
+     * ComputeFrames
+     * ---------------------------------------
+     * Fills normal and binormal from center and
+     * tangent. The first frame (every frame for
+     * FixedUp) has normal = normalize(up x
+     * tangent); where a tangent lies along up,
+     * the X or Y axis stands in for it.
+     ******************************************/
+
+    void ComputeFrames(std::vector<SweepFrame>& frames, const glm::vec3& up, SweepFrameMode mode = SweepFrameMode::RotationMinimizing);
+
+    /******************************************
+     * AppendSweepRings
+     * ---------------------------------------
+     * Appends one ring of Vertex data per frame.
+     * Point j of ring i is placed at
+     * center + radius(i) * (p.x * normal +
+     * p.y * binormal) with its normal from the
+     * profile. UVs run around the ring on one
+     * axis (j / segments) and along the sweep on
+     * the other (the frame's along); alongU puts
+     * the sweep on U.
+     *
+     * @param radius Callable taking the ring index,
+     *        returning its radius.
+     ******************************************/
+
+    template <typename VertexArray, typename Radius>
+    void AppendSweepRings(VertexArray& verts, const std::vector<SweepFrame>& frames, const SweepProfile& profile,
+        Radius radius, bool alongU = false)
+    {
+        if (frames.size() < 2) return;
+
+        const float segments = static_cast<float>(profile.segments);
+
+        for (size_t i = 0; i < frames.size(); ++i) {
+            const SweepFrame& frame = frames[i];
+            const float ringRadius = radius(i);
+            const float along = frame.along;
+
+            for (size_t j = 0; j < profile.Size(); ++j) {
+                const glm::vec2& point = profile.points[j];
+                const glm::vec2& outward = profile.normals[j];
+                glm::vec3 position = frame.center + frame.normal * (ringRadius * point.x) + frame.binormal * (ringRadius * point.y);
+                glm::vec3 normal = glm::normalize(frame.normal * outward.x + frame.binormal * outward.y);
+                float around = static_cast<float>(j) / segments;
+
+                verts.push_back(position.x);
+                verts.push_back(position.y);
+                verts.push_back(position.z);
+                verts.push_back(normal.x);
+                verts.push_back(normal.y);
+                verts.push_back(normal.z);
+                verts.push_back(alongU ? along : around);
+                verts.push_back(alongU ? around : along);
+            }
+        }
+    }
+}
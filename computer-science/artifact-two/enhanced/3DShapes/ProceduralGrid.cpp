@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////////////////////
+// ProceduralGrid.cpp
+// ==================
+// Vertex-pulling shader and parameters for the grid primitives. See
+// ProceduralGrid.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ProceduralGrid.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	/******************************************
+	 * GridVertexShader
+	 * ---------------------------------------
+	 * Each branch follows the CPU generator of
+	 * the same shape line for line (angles,
+	 * normals, UV orientation), so the results
+	 * differ only by float rounding.
+	 ******************************************/
+
+	const char* const GridVertexShader = R"GLSL(#version 330 core
+
+const int GridSphere = 0;
+const int GridTorus = 1;
+const int GridSuperellipsoid = 2;
+const float Pi = 3.141592653589793;
+
+uniform int gridShape;
+uniform ivec2 gridSize;        // rows, cols (quads)
+uniform vec4 gridParams[2];
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+
+float SignedPow(float x, float e)
+{
+	return sign(x) * pow(abs(x), e);
+}
+
+void main()
+{
+	int row = gl_VertexID / (gridSize.y + 1);
+	int col = gl_VertexID - row * (gridSize.y + 1);
+	float rows = float(gridSize.x);
+	float cols = float(gridSize.y);
+
+	vec3 position;
+	vec3 normal;
+	vec2 uv;
+
+	if (gridShape == GridTorus) {
+		// GenerateTorusMesh: row = main ring, col = tube ring
+		float mainRadius = gridParams[0].x;
+		float tubeRadius = gridParams[0].y;
+		float mainAngle = float(row) * (2.0 * Pi / rows);
+		float tubeAngle = float(col) * (2.0 * Pi / cols);
+
+		vec3 center = vec3(mainRadius * cos(mainAngle), mainRadius * sin(mainAngle), 0.0);
+		float ring = mainRadius + tubeRadius * cos(tubeAngle);
+		position = vec3(ring * cos(mainAngle), ring * sin(mainAngle), tubeRadius * sin(tubeAngle));
+		normal = normalize(position - center);
+		uv = vec2(float(row) / rows, float(col) / cols);
+	}
+	else if (gridShape == GridSuperellipsoid) {
+		// BuildSuperellipsoidMesh: u in [-pi/2, pi/2] by row, v in [-pi, pi] by col
+		vec3 scale = gridParams[0].xyz;
+		float verticalExponent = gridParams[0].w;
+		float horizontalExponent = gridParams[1].x;
+		float u = -Pi * 0.5 + float(row) / rows * Pi;
+		float v = -Pi + float(col) / cols * (2.0 * Pi);
+
+		float cu = SignedPow(cos(u), verticalExponent);
+		float su = SignedPow(sin(u), verticalExponent);
+		float cv = SignedPow(cos(v), horizontalExponent);
+		float sv = SignedPow(sin(v), horizontalExponent);
+
+		vec3 surface = vec3(cu * cv, cu * sv, su);
+		position = scale * surface;
+		normal = normalize(surface / scale);
+		uv = vec2(float(col) / cols, float(row) / rows);
+	}
+	else {
+		// GenerateSphereMesh / GenerateHemisphereMesh: the hemisphere keeps
+		// the full sphere's latitude step (gridParams[0].y) but has half the rows.
+		float radius = gridParams[0].x;
+		float theta = float(row) * Pi / gridParams[0].y;
+		float phi = float(col) * 2.0 * Pi / cols;
+
+		normal = vec3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+		position = radius * normal;
+		uv = vec2(1.0 - float(col) / cols, 1.0 - float(row) / rows);
+	}
+
+	gl_Position = projection * view * model * vec4(position, 1.0);
+	fragmentPosition = vec3(model * vec4(position, 1.0));
+	fragmentVertexNormal = mat3(transpose(inverse(model))) * normal;
+	fragmentTextureCoordinate = uv;
+}
+)GLSL";
+
+	uint32_t GridCount(int segments)
+	{
+		return static_cast<uint32_t>(std::max(0, segments));
+	}
+}
+
+/******************************************
+ * ProceduralGridParams Factories
+ ******************************************/
+
+ProceduralGridParams ProceduralGridParams::Sphere(int latitudeSegments, int longitudeSegments, float radius)
+{
+	ProceduralGridParams grid;
+	grid.shape = ProceduralShape::Sphere;
+	grid.rows = GridCount(latitudeSegments);
+	grid.cols = GridCount(longitudeSegments);
+	grid.params[0] = radius;
+	grid.params[1] = static_cast<GLfloat>(latitudeSegments);
+	return grid;
+}
+
+ProceduralGridParams ProceduralGridParams::Hemisphere(int latitudeSegments, int longitudeSegments, float radius)
+{
+	ProceduralGridParams grid = Sphere(latitudeSegments, longitudeSegments, radius);
+	grid.rows = GridCount(latitudeSegments / 2);
+	return grid;
+}
+
+ProceduralGridParams ProceduralGridParams::Torus(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments)
+{
+	ProceduralGridParams grid;
+	grid.shape = ProceduralShape::Torus;
+	grid.rows = GridCount(std::max(3, mainSegments));
+	grid.cols = GridCount(std::max(3, tubeSegments));
+	grid.params[0] = mainRadius;
+	grid.params[1] = std::max(0.01f, tubeRadius);
+	return grid;
+}
+
+ProceduralGridParams ProceduralGridParams::Superellipsoid(float scaleX, float scaleY, float scaleZ,
+	float verticalExponent, float horizontalExponent, int uSegments, int vSegments)
+{
+	ProceduralGridParams grid;
+	grid.shape = ProceduralShape::Superellipsoid;
+	grid.rows = GridCount(std::max(3, uSegments));
+	grid.cols = GridCount(std::max(3, vSegments));
+	grid.params[0] = scaleX > 0.0f ? scaleX : 0.1f;
+	grid.params[1] = scaleY > 0.0f ? scaleY : 0.1f;
+	grid.params[2] = scaleZ > 0.0f ? scaleZ : 0.1f;
+	grid.params[3] = verticalExponent > 0.0f ? verticalExponent : 0.1f;
+	grid.params[4] = horizontalExponent > 0.0f ? horizontalExponent : 0.1f;
+	return grid;
+}
+
+/******************************************
+ * ProceduralGridUniforms
+ ******************************************/
+
+bool ProceduralGridUniforms::Locate(GLuint program)
+{
+	shape = glGetUniformLocation(program, "gridShape");
+	size = glGetUniformLocation(program, "gridSize");
+	params = glGetUniformLocation(program, "gridParams");
+
+	if (!IsValid()) {
+		std::cerr << "Error: program " << program << " has no procedural grid uniforms; "
+			<< "link it with ProceduralGrid::CompileVertexShader()." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void ProceduralGridUniforms::Apply(const ProceduralGridParams& grid) const
+{
+	glUniform1i(shape, static_cast<GLint>(grid.shape));
+	glUniform2i(size, static_cast<GLint>(grid.rows), static_cast<GLint>(grid.cols));
+	glUniform4fv(params, 2, grid.params);
+}
+
+/******************************************
+ * VertexShaderSource / CompileVertexShader
+ ******************************************/
+
+const char* ProceduralGrid::VertexShaderSource()
+{
+	return GridVertexShader;
+}
+
+GLuint ProceduralGrid::CompileVertexShader()
+{
+	GLuint shader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(shader, 1, &GridVertexShader, nullptr);
+	glCompileShader(shader);
+
+	GLint compiled = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	if (compiled != GL_TRUE) {
+		GLint logLength = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+		std::string log(static_cast<size_t>(std::max(logLength, 1)), '\0');
+		glGetShaderInfoLog(shader, logLength, nullptr, &log[0]);
+
+		std::cerr << "Error: procedural grid vertex shader failed to compile:\n" << log.c_str() << std::endl;
+		glDeleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
@@ -0,0 +1,113 @@
+/******************************************
+ * ProceduralGrid
+ * ---------------------------------------
+ * Vertex pulling for the grid primitives:
+ * sphere, hemisphere, torus and
+ * superellipsoid. Each is a pure function of
+ * the grid position (row, col) and a few
+ * parameters, so the vertex shader below
+ * works out position, normal and UV from
+ * gl_VertexID and uniforms, and no vertex
+ * buffer exists at all. A draw needs only the
+ * shared index buffer for its grid (see
+ * GridTopology), and changing parameters
+ * costs a few glUniform calls.
+ *
+ * Vertex k of a grid is vertex k of the
+ * matching GenerateXMesh output, so the two
+ * paths draw the same triangles with the same
+ * indices. The ProceduralGrid case of
+ * ShapeMeshesCheck.cpp compares them
+ * headlessly (for example on Mesa llvmpipe).
+ *
+ * Needs GLSL 3.30.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Values of the gridShape uniform; the hemisphere is a sphere with fewer rows.
+enum class ProceduralShape : GLint {
+    Sphere = 0,
+    Torus = 1,
+    Superellipsoid = 2
+};
+
+/******************************************
+ * ProceduralGridParams
+ * ---------------------------------------
+ * One procedural draw: the shape, the grid
+ * size in quads (rows x cols, so
+ * (rows + 1) x (cols + 1) vertices, with the
+ * seam column repeated as the generators do)
+ * and the shape's parameters packed the way
+ * the shader reads them.
+ *
+ * The factories take the parameters of the
+ * LoadXMesh/DrawXMesh function of the same
+ * shape and clamp them exactly as its
+ * generator does.
+ ******************************************/
+
+struct ProceduralGridParams {
+    ProceduralShape shape = ProceduralShape::Sphere;
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    GLfloat params[8] = {};     // gridParams[2] in the shader
+
+    size_t VertexCount() const { return static_cast<size_t>(rows + 1) * (cols + 1); }
+
+    static ProceduralGridParams Sphere(int latitudeSegments, int longitudeSegments, float radius);
+    static ProceduralGridParams Hemisphere(int latitudeSegments, int longitudeSegments, float radius);
+    static ProceduralGridParams Torus(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments);
+    static ProceduralGridParams Superellipsoid(float scaleX, float scaleY, float scaleZ,
+        float verticalExponent, float horizontalExponent, int uSegments, int vSegments);
+};
+
+/******************************************
+ * ProceduralGridUniforms
+ * ---------------------------------------
+ * Locations of the grid uniforms in a program
+ * linked with the procedural vertex shader.
+ *
+ * - Locate(program): Looks them up. Returns
+ *   false if the program does not have them.
+ * - Apply(grid): Sets them on the program
+ *   currently in use.
+ ******************************************/
+
+struct ProceduralGridUniforms {
+    GLint shape = -1;
+    GLint size = -1;
+    GLint params = -1;
+
+    bool Locate(GLuint program);
+    bool IsValid() const { return shape >= 0 && size >= 0 && params >= 0; }
+    void Apply(const ProceduralGridParams& grid) const;
+};
+
+namespace ProceduralGrid
+{
+    /******************************************
+     * VertexShaderSource / CompileVertexShader
+     * ---------------------------------------
+     * The vertex shader reads no attributes. It
+     * uses the scene's model, view and
+     * projection uniforms and writes the outputs
+     * the scene's fragment shader reads
+     * (fragmentPosition, fragmentVertexNormal,
+     * fragmentTextureCoordinate), so it links
+     * with that fragment shader in place of the
+     * usual vertex shader.
+     *
+     * CompileVertexShader() returns the shader
+     * object, or 0 after printing the compile log.
+     ******************************************/
+
+    const char* VertexShaderSource();
+    GLuint CompileVertexShader();
+}
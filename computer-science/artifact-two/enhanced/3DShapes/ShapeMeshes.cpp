@@ -11,6 +11,10 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "shapemeshes.h"
+#include "MeshCache.h"
+#include "MeshBundle.h"
+#include "MeshExport.h"
+#include "MeshImport.h"
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
@@ -19,6 +23,11 @@
 #include <array> // Required for std::array
 #include <vector> // Required for std::vector
 #include <cmath>  // Required for math functions like sqrt and cos
+#include <algorithm> // Required for std::min and std::max
+#include <iomanip>   // Required for std::setw
+#include <cstring>   // Required for std::memchr
+#include <cctype>    // Required for std::tolower
+#include <unordered_map> // Required for std::unordered_map
 
 #include <iostream>
 
@@ -49,52 +58,1764 @@ ShapeMeshes::ShapeMeshes()
 	halfSphereWarned(false), taperedCylinderWarned(false), torusWarned(false), halfTorusWarned(false) {
 }
 
+/******************************************
+ * ShapeMeshes Destructor
+ * ---------------------------------------
+ * Built-in meshes bound to a bundle entry own
+ * no names, so ReleaseMesh skips them and
+ * ReleaseMeshBundle deletes the entry VAOs.
+ ******************************************/
+
+ShapeMeshes::~ShapeMeshes()
+{
+	for (const NamedMesh& entry : MeshTable())
+		ReleaseMesh(this->*entry.mesh);
+	for (ImportedMesh& imported : m_ImportedMeshes)
+		ReleaseMesh(imported.mesh);
+	m_ImportedMeshes.clear();
+
+	ReleaseMeshBundle();
+
+	ReleaseProceduralGrid(m_ProceduralSphere);
+	ReleaseProceduralGrid(m_ProceduralHemisphere);
+	ReleaseProceduralGrid(m_ProceduralTorus);
+	ReleaseProceduralGrid(m_ProceduralSuperellipsoid);
+	ReleaseMesh(m_TessellationPatches);
+
+	m_StreamRing.Release();
+	if (m_StreamRingMesh.vao != 0) glDeleteVertexArrays(1, &m_StreamRingMesh.vao);
+	ReleaseBufferData(m_StreamRingMesh);
+
+	m_Compute.Release();
+}
+
 /******************************************
  * SetWireframeMode
  * ---------------------------------------
- * Configures OpenGL to render meshes in either
- * wireframe mode or solid mode.
+ * Configures OpenGL to render meshes in either
+ * wireframe mode or solid mode.
+ *
+ * @param wireframe If true, sets to wireframe mode.
+ ******************************************/
+
+inline void SetWireframeMode(bool wireframe) {
+	glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
+}
+
+/******************************************
+ * IndexOffset
+ * ---------------------------------------
+ * glDrawElements offset of index `first`
+ * within a mesh's index range. Meshes loaded
+ * from a bundle share one buffer, so their
+ * range starts at mesh.firstIndex, not 0.
+ ******************************************/
+
+inline const void* IndexOffset(const GLMesh& mesh, size_t first = 0) {
+	return reinterpret_cast<const void*>((mesh.firstIndex + first) * sizeof(GLuint));
+}
+
+/******************************************
+ * StreamBytes
+ * ---------------------------------------
+ * The accounting field for one of a mesh's
+ * buffers.
+ ******************************************/
+
+inline GLsizeiptr& StreamBytes(GLMesh& mesh, MeshBufferStream stream) {
+	if (stream == MeshBufferStream::Index) return mesh.indexBytes;
+	if (stream == MeshBufferStream::Instance) return mesh.instanceBytes;
+	if (stream == MeshBufferStream::Edge) return mesh.edgeBytes;
+	return mesh.vertexBytes;
+}
+
+/******************************************
+ * InitializeMesh
+ * ---------------------------------------
+ * Generic function to initialize a mesh by
+ * generating and binding VAOs/VBOs/EBOs.
+ *
+ * @param mesh Reference to the GLMesh struct.
+ * @param verts Vector containing vertex data.
+ * @param indices Vector containing index data (if applicable).
+ ******************************************/
+
+void ShapeMeshes::InitializeMesh(GLMesh& mesh, const std::vector<GLfloat>& verts, const std::vector<GLuint>& indices) {
+	InitializeMesh(mesh, verts.data(), verts.size(), indices.data(), indices.size());
+}
+
+/******************************************
+ * InitializeMesh (pointer overload)
+ * ---------------------------------------
+ * Same as above, for vertex and index data
+ * that does not live in a std::vector, such
+ * as a memory-mapped mesh cache entry.
+ *
+ * @param vertexFloatCount Number of floats in verts.
+ * @param indexCount Number of indices (0 for none).
+ ******************************************/
+
+void ShapeMeshes::InitializeMesh(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount) {
+	// A mesh bound to a bundle entry shares the entry's VAO; give it its own.
+	if (mesh.vbo == 0) {
+		mesh.vao = 0;
+		mesh.ebo = 0;
+	}
+
+	mesh.nVertices = static_cast<GLuint>(vertexFloatCount / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
+	mesh.nIndices = static_cast<GLuint>(indexCount);
+	mesh.firstIndex = 0;
+
+	if (mesh.vao == 0) glGenVertexArrays(1, &mesh.vao);
+	glBindVertexArray(mesh.vao);
+
+	if (mesh.vbo == 0) glGenBuffers(1, &mesh.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+	UpdateBufferData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, vertexFloatCount * sizeof(GLfloat), verts, GL_STATIC_DRAW);
+
+	if (indexCount > 0) {
+		UnshareIndices(mesh);
+		if (mesh.ebo == 0) glGenBuffers(1, &mesh.ebo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+		UpdateBufferData(mesh, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLuint), indices, GL_STATIC_DRAW);
+	}
+
+	if (!m_bMemoryLayoutDone) {
+		SetShaderMemoryLayout();
+	}
+
+	glBindVertexArray(0); // Unbind VAO after setup
+}
+
+/******************************************
+ * InitializeGridMesh
+ * ---------------------------------------
+ * Uploads the vertices as InitializeMesh
+ * does, then points the mesh at the shared
+ * index buffer for topology. A mesh reloaded
+ * with the same topology keeps its reference
+ * without the buffer being recreated.
+ *
+ * @param indices The generator's indices; only
+ *        uploaded if their count does not match
+ *        the topology.
+ * @param topology Grid the indices follow.
+ ******************************************/
+
+void ShapeMeshes::InitializeGridMesh(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount, const GridTopology& topology)
+{
+	if (indexCount == 0 || indexCount != topology.IndexCount()) {
+		InitializeMesh(mesh, verts, vertexFloatCount, indices, indexCount);
+		return;
+	}
+
+	InitializeMesh(mesh, verts, vertexFloatCount, nullptr, 0);
+
+	glBindVertexArray(mesh.vao);
+	BindGridIndices(mesh, topology);
+	glBindVertexArray(0);
+	mesh.nIndices = static_cast<GLuint>(indexCount);
+}
+
+/******************************************
+ * BuildGridIndices
+ * ---------------------------------------
+ * Two triangles per quad, row by row, in the
+ * order described at GridTopology.
+ ******************************************/
+
+template <typename IndexArray>
+void ShapeMeshes::BuildGridIndices(IndexArray& indices, const GridTopology& topology)
+{
+	const bool wrapped = topology.seam == GridSeam::Wrapped;
+	const GLuint stride = wrapped ? topology.cols : topology.cols + 1;
+
+	indices.reserve(topology.IndexCount());
+	for (GLuint row = 0; row < topology.rows; ++row) {
+		for (GLuint col = 0; col < topology.cols; ++col) {
+			const GLuint current = row * stride + col;
+			const GLuint next = current + stride;
+			const GLuint currentRight = wrapped ? row * stride + (col + 1) % topology.cols : current + 1;
+			const GLuint nextRight = currentRight + stride;
+
+			indices.push_back(current);
+			indices.push_back(next);
+			indices.push_back(currentRight);
+
+			if (topology.winding == GridWinding::Rotated) {
+				indices.push_back(next);
+				indices.push_back(nextRight);
+				indices.push_back(currentRight);
+			}
+			else {
+				indices.push_back(currentRight);
+				indices.push_back(next);
+				indices.push_back(nextRight);
+			}
+		}
+	}
+}
+
+/******************************************
+ * RemoveDegenerateTriangles /
+ * CountDegenerateTriangles
+ ******************************************/
+
+namespace
+{
+	bool IsDegenerateTriangle(const GLfloat* vertices, GLuint a, GLuint b, GLuint c, float relativeArea)
+	{
+		if (a == b || b == c || a == c) return true;
+
+		const size_t stride = sizeof(Vertex) / sizeof(GLfloat);
+		auto position = [&](GLuint index) {
+			const GLfloat* v = &vertices[index * stride];
+			return glm::vec3(v[0], v[1], v[2]);
+		};
+
+		const glm::vec3 pa = position(a);
+		const glm::vec3 ab = position(b) - pa;
+		const glm::vec3 ac = position(c) - pa;
+		const glm::vec3 bc = ac - ab;
+		const glm::vec3 normal = glm::cross(ab, ac);
+
+		// |ab x ac| is twice the area; compare squares to skip the roots
+		float longest = std::max({ glm::dot(ab, ab), glm::dot(ac, ac), glm::dot(bc, bc) });
+		float limit = 2.0f * relativeArea * longest;
+		return glm::dot(normal, normal) <= limit * limit;
+	}
+}
+
+size_t ShapeMeshes::RemoveDegenerateTriangles(MeshData& mesh, float relativeArea)
+{
+	std::vector<GLuint>& indices = mesh.indices;
+	const size_t triangles = indices.size() / 3;
+
+	// Triangles kept before each one, to move the subranges with them
+	std::vector<GLuint> keptBefore(triangles + 1, 0);
+	size_t kept = 0;
+	for (size_t t = 0; t < triangles; ++t) {
+		keptBefore[t] = static_cast<GLuint>(kept);
+		const GLuint a = indices[3 * t];
+		const GLuint b = indices[3 * t + 1];
+		const GLuint c = indices[3 * t + 2];
+		if (IsDegenerateTriangle(mesh.vertices.data(), a, b, c, relativeArea)) continue;
+
+		indices[3 * kept] = a;
+		indices[3 * kept + 1] = b;
+		indices[3 * kept + 2] = c;
+		++kept;
+	}
+	keptBefore[triangles] = static_cast<GLuint>(kept);
+	indices.resize(3 * kept);
+
+	for (MeshSubRange& range : mesh.subRanges) {
+		const size_t first = std::min<size_t>(range.first / 3, triangles);
+		const size_t last = std::min<size_t>((range.first + range.count) / 3, triangles);
+		range.first = 3 * keptBefore[first];
+		range.count = 3 * (keptBefore[last] - keptBefore[first]);
+	}
+	return triangles - kept;
+}
+
+size_t ShapeMeshes::CountDegenerateTriangles(const MeshData& mesh, float relativeArea)
+{
+	size_t count = 0;
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+		if (IsDegenerateTriangle(mesh.vertices.data(), mesh.indices[i], mesh.indices[i + 1], mesh.indices[i + 2], relativeArea))
+			++count;
+	return count;
+}
+
+/******************************************
+ * BuildEdgeIndices
+ * ---------------------------------------
+ * Positions are welded on a hash grid with
+ * cells a hundred-thousandth of the mesh's
+ * largest extent: a vertex joins the first
+ * earlier one within a cell's width, so an
+ * edge is written with the indices of the
+ * first vertices at its ends. Degenerate
+ * triangles add their edges but are not
+ * counted as either side of them.
+ ******************************************/
+
+void ShapeMeshes::BuildEdgeIndices(std::vector<GLuint>& edges, const GLfloat* vertices, size_t vertexCount,
+	const GLuint* indices, size_t indexCount, bool omitDiagonals)
+{
+	edges.clear();
+	if (vertexCount == 0 || indexCount < 3) return;
+
+	const size_t stride = sizeof(Vertex) / sizeof(GLfloat);
+	auto position = [&](GLuint index) {
+		const GLfloat* v = &vertices[index * stride];
+		return glm::vec3(v[0], v[1], v[2]);
+	};
+
+	// --- Weld by position ---
+	glm::vec3 low = position(0), high = low;
+	for (GLuint i = 1; i < vertexCount; ++i) {
+		const glm::vec3 p = position(i);
+		for (int axis = 0; axis < 3; ++axis) {
+			low[axis] = std::min(low[axis], p[axis]);
+			high[axis] = std::max(high[axis], p[axis]);
+		}
+	}
+	const glm::vec3 extent = high - low;
+	const float cell = std::max(1e-5f * std::max({ extent.x, extent.y, extent.z }), 1e-12f);
+
+	// Wraps past 2^21 cells per axis, which only costs extra distance tests
+	auto cellKey = [](int64_t x, int64_t y, int64_t z) {
+		return (static_cast<uint64_t>(x) & 0x1fffff) | (static_cast<uint64_t>(y) & 0x1fffff) << 21 | (static_cast<uint64_t>(z) & 0x1fffff) << 42;
+	};
+
+	std::vector<GLuint> weld(vertexCount);
+	std::unordered_multimap<uint64_t, GLuint> cells;
+	cells.reserve(vertexCount);
+	for (GLuint i = 0; i < vertexCount; ++i) {
+		const glm::vec3 p = position(i);
+		const glm::vec3 q = (p - low) / cell;
+		const int64_t cx = static_cast<int64_t>(q.x), cy = static_cast<int64_t>(q.y), cz = static_cast<int64_t>(q.z);
+
+		weld[i] = i;
+		for (int64_t dx = -1; dx <= 1 && weld[i] == i; ++dx)
+			for (int64_t dy = -1; dy <= 1 && weld[i] == i; ++dy)
+				for (int64_t dz = -1; dz <= 1 && weld[i] == i; ++dz) {
+					auto found = cells.equal_range(cellKey(cx + dx, cy + dy, cz + dz));
+					for (auto it = found.first; it != found.second; ++it) {
+						const glm::vec3 d = position(it->second) - p;
+						if (glm::dot(d, d) <= cell * cell) {
+							weld[i] = it->second;
+							break;
+						}
+					}
+				}
+		if (weld[i] == i) cells.emplace(cellKey(cx, cy, cz), i);
+	}
+
+	// --- Unique edges, with the first two triangles on them and their third vertices ---
+	struct UniqueEdge {
+		GLuint a, b;
+		GLuint triangles;
+		GLuint triangle[2];
+		GLuint opposite[2];
+	};
+	std::vector<UniqueEdge> unique;
+	std::unordered_map<uint64_t, size_t> lookup;
+	lookup.reserve(indexCount);
+
+	for (size_t t = 0; t + 2 < indexCount; t += 3) {
+		const GLuint corner[3] = { weld[indices[t]], weld[indices[t + 1]], weld[indices[t + 2]] };
+		const bool solid = !IsDegenerateTriangle(vertices, corner[0], corner[1], corner[2], 1e-6f);
+
+		for (int k = 0; k < 3; ++k) {
+			const GLuint a = corner[k], b = corner[(k + 1) % 3];
+			if (a == b) continue;
+
+			const uint64_t key = static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+			auto inserted = lookup.emplace(key, unique.size());
+			if (inserted.second) unique.push_back({ a, b, 0, { 0, 0 }, { 0, 0 } });
+
+			UniqueEdge& edge = unique[inserted.first->second];
+			if (!solid) continue;
+			if (edge.triangles < 2) {
+				edge.triangle[edge.triangles] = static_cast<GLuint>(t / 3);
+				edge.opposite[edge.triangles] = corner[(k + 2) % 3];
+			}
+			++edge.triangles;
+		}
+	}
+
+	// --- Quad diagonals ---
+	// A candidate is flat, its quad has parallel sides and it is not the
+	// shorter diagonal. Two triangles of neighbouring quads can pass too (a
+	// fine cylinder's side edge between two diagonals), so candidates are
+	// taken longest against the quad's sides first, one per triangle.
+	std::vector<bool> dropped(unique.size(), false);
+	if (omitDiagonals) {
+		std::vector<std::pair<float, size_t>> candidates;
+		for (size_t i = 0; i < unique.size(); ++i) {
+			const UniqueEdge& edge = unique[i];
+			if (edge.triangles != 2) continue;
+
+			const glm::vec3 a = position(edge.a), b = position(edge.b);
+			const glm::vec3 c = position(edge.opposite[0]), d = position(edge.opposite[1]);
+			const glm::vec3 ab = b - a;
+
+			// Oriented to agree when c and d lie on opposite sides of ab
+			const glm::vec3 n1 = glm::cross(ab, c - a);
+			const glm::vec3 n2 = glm::cross(d - a, ab);
+			if (glm::dot(n1, n2) <= 0.95f * glm::length(n1) * glm::length(n2)) continue;
+
+			auto parallel = [](const glm::vec3& u, const glm::vec3& v) {
+				return std::fabs(glm::dot(u, v)) > 0.99f * glm::length(u) * glm::length(v);
+			};
+			if (!parallel(c - a, d - b) && !parallel(b - c, a - d)) continue;
+
+			// A six-slice fan's spoke and rim make a rhombus; the spoke is its short diagonal
+			if (glm::dot(ab, ab) < 0.98f * glm::dot(d - c, d - c)) continue;
+
+			const float longestSide = std::max({ glm::dot(c - a, c - a), glm::dot(b - c, b - c), glm::dot(d - b, d - b), glm::dot(a - d, a - d) });
+			candidates.push_back({ glm::dot(ab, ab) / longestSide, i });
+		}
+
+		std::stable_sort(candidates.begin(), candidates.end(),
+			[](const std::pair<float, size_t>& x, const std::pair<float, size_t>& y) { return x.first > y.first; });
+
+		std::vector<bool> merged(indexCount / 3, false);
+		for (const auto& candidate : candidates) {
+			const UniqueEdge& edge = unique[candidate.second];
+			if (merged[edge.triangle[0]] || merged[edge.triangle[1]]) continue;
+			merged[edge.triangle[0]] = merged[edge.triangle[1]] = true;
+			dropped[candidate.second] = true;
+		}
+	}
+
+	edges.reserve(2 * unique.size());
+	for (size_t i = 0; i < unique.size(); ++i) {
+		if (dropped[i]) continue;
+		edges.push_back(unique[i].a);
+		edges.push_back(unique[i].b);
+	}
+}
+
+/******************************************
+ * ApplyPoleMode
+ * ---------------------------------------
+ * Welding replaces a pole row with one vertex
+ * averaging the row (its normal renormalized),
+ * renumbers the rest in order and remaps the
+ * indices; each collapsed quad then has a
+ * triangle with a repeated index, which the
+ * degenerate pass drops.
+ ******************************************/
+
+size_t ShapeMeshes::ApplyPoleMode(MeshData& mesh, uint32_t cols, bool firstRowPole, bool lastRowPole, PoleMode poles)
+{
+	if (poles == PoleMode::Duplicated) return 0;
+	if (poles == PoleMode::Trimmed) return RemoveDegenerateTriangles(mesh);
+
+	const size_t floats = sizeof(Vertex) / sizeof(GLfloat);
+	const size_t stride = static_cast<size_t>(cols) + 1;
+	const size_t count = mesh.VertexCount();
+	if (count < 2 * stride || count % stride != 0) return RemoveDegenerateTriangles(mesh);
+	const size_t lastRow = count / stride - 1;
+
+	std::vector<GLfloat> vertices;
+	vertices.reserve(mesh.vertices.size());
+	std::vector<GLuint> remap(count);
+
+	for (size_t row = 0; row <= lastRow; ++row) {
+		const bool pole = (row == 0 && firstRowPole) || (row == lastRow && lastRowPole);
+		const GLfloat* source = &mesh.vertices[row * stride * floats];
+
+		if (!pole) {
+			for (size_t col = 0; col < stride; ++col)
+				remap[row * stride + col] = static_cast<GLuint>(vertices.size() / floats + col);
+			vertices.insert(vertices.end(), source, source + stride * floats);
+			continue;
+		}
+
+		GLfloat average[8] = {};
+		for (size_t col = 0; col < stride; ++col)
+			for (size_t k = 0; k < floats; ++k)
+				average[k] += source[col * floats + k] / stride;
+
+		glm::vec3 normal(average[3], average[4], average[5]);
+		if (glm::dot(normal, normal) > 0.0f) normal = glm::normalize(normal);
+		average[3] = normal.x;
+		average[4] = normal.y;
+		average[5] = normal.z;
+
+		const GLuint welded = static_cast<GLuint>(vertices.size() / floats);
+		for (size_t col = 0; col < stride; ++col)
+			remap[row * stride + col] = welded;
+		vertices.insert(vertices.end(), average, average + floats);
+	}
+
+	mesh.vertices.swap(vertices);
+	for (GLuint& index : mesh.indices)
+		index = remap[index];
+	return RemoveDegenerateTriangles(mesh);
+}
+
+/******************************************
+ * BindGridIndices
+ * ---------------------------------------
+ * The new reference is taken before the old
+ * one is dropped, so reloading a mesh with
+ * an unchanged topology never deletes and
+ * rebuilds the shared buffer.
+ *
+ * @param mesh Mesh whose VAO is bound.
+ * @param topology Grid its indices follow.
+ ******************************************/
+
+void ShapeMeshes::BindGridIndices(GLMesh& mesh, const GridTopology& topology)
+{
+	auto shared = std::find_if(m_SharedIndexBuffers.begin(), m_SharedIndexBuffers.end(),
+		[&topology](const SharedIndexBuffer& entry) { return entry.topology == topology; });
+
+	if (shared == m_SharedIndexBuffers.end()) {
+		std::vector<GLuint> indices;
+		BuildGridIndices(indices, topology);
+
+		SharedIndexBuffer entry{};
+		entry.topology = topology;
+		entry.buffer.nIndices = static_cast<GLuint>(indices.size());
+		glGenBuffers(1, &entry.buffer.ebo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, entry.buffer.ebo);
+		UploadBufferData(entry.buffer, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+		m_SharedIndexBuffers.push_back(entry);
+		shared = m_SharedIndexBuffers.end() - 1;
+	}
+	else {
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, shared->buffer.ebo);
+	}
+
+	++shared->references;
+	const GLuint ebo = shared->buffer.ebo;
+
+	if (mesh.sharedIndices) {
+		UnshareIndices(mesh);
+	}
+	else if (mesh.ebo != 0) {
+		glDeleteBuffers(1, &mesh.ebo);
+		m_GpuBytes -= mesh.indexBytes;
+		mesh.indexBytes = 0;
+	}
+
+	mesh.ebo = ebo;
+	mesh.sharedIndices = true;
+}
+
+/******************************************
+ * UnshareIndices
+ * ---------------------------------------
+ * The last reference deletes the buffer.
+ * Leaves mesh.ebo at 0.
+ ******************************************/
+
+void ShapeMeshes::UnshareIndices(GLMesh& mesh)
+{
+	if (!mesh.sharedIndices) return;
+
+	auto shared = std::find_if(m_SharedIndexBuffers.begin(), m_SharedIndexBuffers.end(),
+		[&mesh](const SharedIndexBuffer& entry) { return entry.buffer.ebo == mesh.ebo; });
+
+	if (shared != m_SharedIndexBuffers.end() && --shared->references == 0) {
+		glDeleteBuffers(1, &shared->buffer.ebo);
+		ReleaseBufferData(shared->buffer);
+		m_SharedIndexBuffers.erase(shared);
+	}
+
+	mesh.ebo = 0;
+	mesh.sharedIndices = false;
+}
+
+/******************************************
+ * UploadBufferData
+ * ---------------------------------------
+ * Wrapper around glBufferData that keeps the
+ * GPU memory accounting up to date.
+ *
+ * glBufferData always discards the previous
+ * data store, so an upload to a stream that
+ * already holds bytes counts as a reallocation
+ * (this is what the dynamic meshes do every
+ * draw).
+ *
+ * @param mesh Mesh that owns the bound buffer.
+ * @param stream Which of the mesh's buffers is bound.
+ * @param target Binding target (GL_ARRAY_BUFFER, ...).
+ * @param size Size of the new data store in bytes.
+ * @param data Data to copy, or nullptr.
+ * @param usage Usage hint passed to glBufferData.
+ ******************************************/
+
+void ShapeMeshes::UploadBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	glBufferData(target, size, data, usage);
+	RecordBufferSize(mesh, stream, size);
+}
+
+/******************************************
+ * UpdateBufferData
+ * ---------------------------------------
+ * Replaces the contents of one of a mesh's
+ * buffers, keeping its data store when the
+ * new data fits. A store that is too small
+ * grows to at least 1.5 times its size, so a
+ * mesh reloaded at slowly rising resolutions
+ * reallocates only a handful of times. The
+ * store never shrinks; the GLMesh records its
+ * size, not the size of the data in it.
+ *
+ * The first upload to a stream makes a store
+ * of exactly the data's size, as
+ * UploadBufferData does.
+ *
+ * @param mesh Mesh that owns the bound buffer.
+ * @param stream Which of the mesh's buffers is bound.
+ * @param target Binding target (GL_ARRAY_BUFFER, ...).
+ * @param size Size of the data in bytes.
+ * @param data Data to copy.
+ * @param usage Usage hint for a new data store.
+ ******************************************/
+
+void ShapeMeshes::UpdateBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+	const GLsizeiptr capacity = StreamBytes(mesh, stream);
+
+	if (capacity == 0) {
+		UploadBufferData(mesh, stream, target, size, data, usage);
+		return;
+	}
+
+	ReserveBufferData(mesh, stream, target, size, usage);
+	if (size > 0) glBufferSubData(target, 0, size, data);
+}
+
+/******************************************
+ * ReserveBufferData
+ * ---------------------------------------
+ * The sizing half of UpdateBufferData, for
+ * buffers the GPU fills itself (compute
+ * generation): makes sure the store holds
+ * size bytes, growing it the same way, and
+ * leaves its contents undefined.
+ ******************************************/
+
+void ShapeMeshes::ReserveBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, GLenum usage)
+{
+	const GLsizeiptr capacity = StreamBytes(mesh, stream);
+
+	if (capacity == 0)
+		UploadBufferData(mesh, stream, target, size, nullptr, usage);
+	else if (size > capacity)
+		UploadBufferData(mesh, stream, target, std::max(size, capacity + capacity / 2), nullptr, usage);
+}
+
+/******************************************
+ * RecordBufferSize
+ * ---------------------------------------
+ * The accounting half of UploadBufferData,
+ * for data stores created without
+ * glBufferData (the stream ring's
+ * glBufferStorage).
+ *
+ * @param mesh Mesh that owns the buffer.
+ * @param stream Which of the mesh's buffers it is.
+ * @param size Size of the new data store in bytes.
+ ******************************************/
+
+void ShapeMeshes::RecordBufferSize(GLMesh& mesh, MeshBufferStream stream, GLsizeiptr size)
+{
+	GLsizeiptr* streamBytes = &StreamBytes(mesh, stream);
+
+	if (*streamBytes > 0) {
+		++mesh.reallocations;
+		++m_GpuReallocations;
+	}
+
+	m_GpuBytes += size - *streamBytes;
+	*streamBytes = size;
+
+	mesh.peakBytes = std::max(mesh.peakBytes, mesh.TotalBytes());
+	m_GpuPeakBytes = std::max(m_GpuPeakBytes, m_GpuBytes);
+}
+
+/******************************************
+ * ReleaseBufferData
+ * ---------------------------------------
+ * Records that a mesh's buffers have been
+ * deleted. Peak values are kept.
+ *
+ * @param mesh Mesh whose buffers were deleted.
+ ******************************************/
+
+void ShapeMeshes::ReleaseBufferData(GLMesh& mesh)
+{
+	m_GpuBytes -= mesh.TotalBytes();
+	mesh.vertexBytes = 0;
+	mesh.indexBytes = 0;
+	mesh.instanceBytes = 0;
+	mesh.edgeBytes = 0;
+}
+
+/******************************************
+ * ReleaseMesh
+ * ---------------------------------------
+ * Deletes the VAO and buffers a mesh owns and
+ * resets it to an unloaded GLMesh. A mesh with
+ * no buffer of its own is either unloaded or
+ * bound to a bundle entry, whose VAO belongs
+ * to the bundle, so it is left alone. A
+ * shared index buffer only loses a reference.
+ *
+ * @param mesh Mesh to release.
+ ******************************************/
+
+void ShapeMeshes::ReleaseMesh(GLMesh& mesh)
+{
+	if (mesh.vbo == 0) return;
+
+	glDeleteVertexArrays(1, &mesh.vao);
+	glDeleteBuffers(1, &mesh.vbo);
+	if (mesh.sharedIndices) UnshareIndices(mesh);
+	else if (mesh.ebo != 0) glDeleteBuffers(1, &mesh.ebo);
+	ReleaseEdgeIndices(mesh);
+	ReleaseBufferData(mesh);
+	mesh = GLMesh();
+}
+
+/******************************************
+ * BeginStreamedMesh
+ * ---------------------------------------
+ * Reserves space in the stream ring for a
+ * mesh of at most maxVertices vertices and
+ * maxIndices indices: vertices first, at a
+ * whole-Vertex offset so they can be drawn
+ * with a base vertex, then the indices.
+ *
+ * The ring is created on first use. A mesh
+ * larger than a segment recreates it with
+ * segments at least twice as large, so a
+ * scene settles on one size after its
+ * largest mesh has been drawn once.
+ *
+ * @return False if streaming is unavailable and
+ *         the caller should upload with
+ *         glBufferData instead.
+ ******************************************/
+
+bool ShapeMeshes::BeginStreamedMesh(size_t maxVertices, size_t maxIndices, StreamedMesh& streamed)
+{
+	constexpr size_t MinSegmentBytes = 2 * 1024 * 1024;
+
+	if (m_StreamRingFailed || !MeshStreamRing::IsSupported()) return false;
+
+	const size_t vertexBytes = maxVertices * sizeof(Vertex);
+	const size_t bytes = vertexBytes + maxIndices * sizeof(GLuint);
+
+	if (!m_StreamRing.IsReady() || bytes > m_StreamRing.SegmentBytes()) {
+		const size_t segmentBytes = std::max({ MinSegmentBytes, bytes, m_StreamRing.SegmentBytes() * 2 });
+		if (!m_StreamRing.Create(segmentBytes)) {
+			m_StreamRingFailed = true;
+			RecordBufferSize(m_StreamRingMesh, MeshBufferStream::Vertex, 0);
+			return false;
+		}
+		RecordBufferSize(m_StreamRingMesh, MeshBufferStream::Vertex, static_cast<GLsizeiptr>(m_StreamRing.Capacity()));
+
+		// Every streamed draw goes through one VAO over the whole ring.
+		if (m_StreamRingMesh.vao == 0) glGenVertexArrays(1, &m_StreamRingMesh.vao);
+		glBindVertexArray(m_StreamRingMesh.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_StreamRing.Buffer());
+		SetShaderMemoryLayout();
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_StreamRing.Buffer());
+		glBindVertexArray(0);
+	}
+
+	size_t offset = 0;
+	unsigned char* data = m_StreamRing.Reserve(bytes, sizeof(Vertex), offset);
+	if (!data) return false;
+
+	streamed.vertices = MappedArray<GLfloat>(reinterpret_cast<GLfloat*>(data), maxVertices * (sizeof(Vertex) / sizeof(GLfloat)));
+	streamed.indices = MappedArray<GLuint>(reinterpret_cast<GLuint*>(data + vertexBytes), maxIndices);
+	streamed.vertexOffset = offset;
+	streamed.indexOffset = offset + vertexBytes;
+	return true;
+}
+
+/******************************************
+ * DrawStreamedMesh
+ * ---------------------------------------
+ * Keeps the data a Build*Mesh generator wrote
+ * into the reservation from BeginStreamedMesh
+ * and draws it as triangles.
+ *
+ * All streamed draws share the ring's VAO
+ * (m_StreamRingMesh.vao) and differ only in
+ * their offsets, so no buffer is bound,
+ * specified or resized per draw.
+ *
+ * @param streamed The filled reservation.
+ ******************************************/
+
+void ShapeMeshes::DrawStreamedMesh(const StreamedMesh& streamed)
+{
+	if (!CommitStreamedMesh(streamed)) return;
+
+	glBindVertexArray(m_StreamRingMesh.vao);
+	glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(streamed.indices.size()), GL_UNSIGNED_INT,
+		reinterpret_cast<const void*>(streamed.indexOffset), static_cast<GLint>(streamed.vertexOffset / sizeof(Vertex)));
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * CommitStreamedMesh
+ * ---------------------------------------
+ * Keeps the data written into a reservation
+ * from BeginStreamedMesh, or drops it with an
+ * error if the generator wrote more than was
+ * reserved.
+ *
+ * @return False if the reservation overflowed.
+ ******************************************/
+
+bool ShapeMeshes::CommitStreamedMesh(const StreamedMesh& streamed)
+{
+	if (streamed.vertices.overflowed() || streamed.indices.overflowed()) {
+		std::cerr << "Error: a streamed mesh outgrew its reserved space and was not drawn." << std::endl;
+		m_StreamRing.Commit(0);
+		return false;
+	}
+
+	m_StreamRing.Commit(streamed.indexOffset - streamed.vertexOffset + streamed.indices.size() * sizeof(GLuint));
+	return true;
+}
+
+/******************************************
+ * CopyStreamedData
+ * ---------------------------------------
+ * Copies size bytes at offset in the stream
+ * ring into the start of one of a mesh's
+ * buffers (bound to target), growing it with
+ * ReserveBufferData if needed.
+ *
+ * The copy is a GPU command, queued behind
+ * the draws still reading the old contents,
+ * so unlike glBufferSubData it never waits
+ * for them or makes the driver copy the data
+ * aside.
+ ******************************************/
+
+void ShapeMeshes::CopyStreamedData(GLMesh& mesh, MeshBufferStream stream, GLenum target, size_t offset, GLsizeiptr size)
+{
+	ReserveBufferData(mesh, stream, target, size, GL_DYNAMIC_DRAW);
+	if (size == 0) return;
+
+	glBindBuffer(GL_COPY_READ_BUFFER, m_StreamRing.Buffer());
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, target, static_cast<GLintptr>(offset), 0, size);
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+/******************************************
+ * StreamKey
+ ******************************************/
+
+ShapeMeshes::StreamKey ShapeMeshes::StreamKey::Make(std::initializer_list<float> params)
+{
+	StreamKey key;
+	key.paramCount = static_cast<uint32_t>(std::min<size_t>(params.size(), MaxParams));
+	std::copy(params.begin(), params.begin() + key.paramCount, key.params);
+	return key;
+}
+
+bool ShapeMeshes::StreamKey::operator==(const StreamKey& other) const
+{
+	// Bitwise, so a key always matches itself (NaN included).
+	return paramCount == other.paramCount && std::memcmp(params, other.params, paramCount * sizeof(float)) == 0;
+}
+
+/******************************************
+ * DrawDynamicMesh
+ * ---------------------------------------
+ * Shared draw path of the meshes generated at
+ * draw time. The mesh's own VBO and EBO keep
+ * the last geometry written to them, and
+ * state records the parameters each stream
+ * was built from:
+ *
+ * - Same parameters: the buffers are drawn as
+ *   they are; nothing is generated.
+ * - Same topology (indexKey), other shape
+ *   parameters: only the vertex stream is
+ *   regenerated. The EBO is untouched.
+ * - New topology: both streams are rebuilt.
+ *
+ * When the stream ring is available the
+ * generator writes into it, and the result is
+ * copied into the own buffers on the GPU
+ * (CopyStreamedData), so an animated
+ * parameter never writes a buffer the GPU may
+ * still be reading. Without the ring the
+ * buffers are written with glBufferSubData.
+ *
+ * The own buffers are written at most once
+ * per frame (see EndFrame). Further variants
+ * drawn in the same frame are drawn straight
+ * from the ring, so the first variant stays
+ * resident for the next frame.
+ *
+ * A new topology that is a grid (topology is
+ * not null) uses the shared index buffer for
+ * it, so the generator's indices are only
+ * counted, never kept.
+ *
+ * @param topology Grid topology of the indices, or nullptr.
+ * @param build Generic callable taking
+ *        (vertex array, index array) that runs
+ *        the mesh's Build*Mesh generator.
+ ******************************************/
+
+template <typename Build>
+void ShapeMeshes::DrawDynamicMesh(GLMesh& mesh, DynamicMeshState& state, const StreamKey& indexKey, const StreamKey& vertexKey,
+	size_t maxVertices, size_t maxIndices, const GridTopology* topology, Build build)
+{
+	const bool sameTopology = state.indexKey == indexKey;
+
+	if (!sameTopology || !(state.vertexKey == vertexKey)) {
+		const bool writeOwnBuffers = state.writtenFrame != m_FrameIndex;
+
+		// A vertex-only rebuild into the own buffers keeps the resident indices, so reserve none.
+		StreamedMesh streamed;
+		const bool streaming = maxVertices > 0
+			&& BeginStreamedMesh(maxVertices, writeOwnBuffers && sameTopology ? 0 : maxIndices, streamed);
+
+		if (streaming && !writeOwnBuffers) {
+			build(streamed.vertices, streamed.indices);
+			DrawStreamedMesh(streamed);
+			return;
+		}
+
+		size_t vertexFloats = 0;
+		size_t indexCount = 0;
+		if (streaming) {
+			if (sameTopology) {
+				DiscardArray<GLuint> indices;
+				build(streamed.vertices, indices);
+			}
+			else {
+				build(streamed.vertices, streamed.indices);
+			}
+			if (!CommitStreamedMesh(streamed)) return;
+
+			vertexFloats = streamed.vertices.size();
+			indexCount = streamed.indices.size();
+		}
+		else {
+			m_DynamicVertices.clear();
+			if (sameTopology || (topology && topology->IndexCount() > 0)) {
+				DiscardArray<GLuint> indices;
+				build(m_DynamicVertices, indices);
+				indexCount = indices.size();
+			}
+		}
+
+		const bool shareIndices = !sameTopology && topology && topology->IndexCount() > 0 && indexCount == topology->IndexCount();
+		if (!streaming && !sameTopology && !shareIndices) {
+			m_DynamicVertices.clear();
+			m_DynamicIndices.clear();
+			build(m_DynamicVertices, m_DynamicIndices);
+			indexCount = m_DynamicIndices.size();
+		}
+		if (!streaming) vertexFloats = m_DynamicVertices.size();
+
+		glBindVertexArray(mesh.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+		const GLsizeiptr vertexBytes = static_cast<GLsizeiptr>(vertexFloats * sizeof(GLfloat));
+		if (streaming)
+			CopyStreamedData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, streamed.vertexOffset, vertexBytes);
+		else
+			UpdateBufferData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, vertexBytes, m_DynamicVertices.data(), GL_DYNAMIC_DRAW);
+
+		if (!sameTopology) {
+			SetShaderMemoryLayout();
+
+			if (shareIndices) {
+				BindGridIndices(mesh, *topology);
+			}
+			else {
+				UnshareIndices(mesh);
+				if (mesh.ebo == 0) glGenBuffers(1, &mesh.ebo);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+				const GLsizeiptr indexBytes = static_cast<GLsizeiptr>(indexCount * sizeof(GLuint));
+				if (streaming)
+					CopyStreamedData(mesh, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, streamed.indexOffset, indexBytes);
+				else
+					UpdateBufferData(mesh, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, indexBytes, m_DynamicIndices.data(), GL_DYNAMIC_DRAW);
+			}
+
+			mesh.nIndices = static_cast<GLuint>(indexCount);
+			mesh.firstIndex = 0;
+			state.indexKey = indexKey;
+		}
+		glBindVertexArray(0);
+
+		mesh.nVertices = static_cast<GLuint>(vertexFloats / (sizeof(Vertex) / sizeof(GLfloat)));
+		state.vertexKey = vertexKey;
+		state.writtenFrame = m_FrameIndex;
+	}
+
+	glBindVertexArray(mesh.vao);
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.nIndices), GL_UNSIGNED_INT, nullptr);
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * SetComputeGeneration
+ ******************************************/
+
+bool ShapeMeshes::SetComputeGeneration(bool enable)
+{
+	if (!enable) {
+		m_ComputeGeneration = false;
+		return true;
+	}
+
+	if (!MeshComputeGenerator::IsSupported()) {
+		std::cerr << "Warning: compute shaders are not available; meshes are generated on the CPU." << std::endl;
+		return false;
+	}
+	if (!m_Compute.IsReady() && !m_Compute.Create()) return false;
+
+	m_ComputeGeneration = true;
+	return true;
+}
+
+/******************************************
+ * ComputedTopology
+ * ---------------------------------------
+ * The shared grid a compute-generated grid
+ * shape draws with: one row of quads per row
+ * of the kernel, seam vertices duplicated,
+ * the standard winding of the CPU builders.
+ ******************************************/
+
+GridTopology ShapeMeshes::ComputedTopology(const ComputeMeshParams& params)
+{
+	GridTopology topology;
+	topology.rows = params.rows;
+	topology.cols = params.cols;
+	return topology;
+}
+
+/******************************************
+ * DrawComputedMesh
+ * ---------------------------------------
+ * DrawDynamicMesh with the regeneration done
+ * by m_Compute in the mesh's own buffers:
+ *
+ * - Same parameters: drawn as they are.
+ * - Same topology: the vertex pass reruns in
+ *   place; the EBO is untouched.
+ * - New topology: the VBO (and, for the
+ *   spiral, the EBO) is resized first, and the
+ *   spiral's index pass runs as well. Grid
+ *   shapes take the shared index buffer.
+ *
+ * Later draws are ordered behind the writes
+ * by Generate's barrier, so the stream ring
+ * is not needed for variants drawn in the
+ * same frame.
+ *
+ * @param prepare Callable taking (ComputeMeshParams&)
+ *        that fills in the shape's parameters.
+ ******************************************/
+
+template <typename Prepare>
+void ShapeMeshes::DrawComputedMesh(GLMesh& mesh, DynamicMeshState& state, const StreamKey& indexKey, const StreamKey& vertexKey, Prepare prepare)
+{
+	const bool sameTopology = state.indexKey == indexKey;
+
+	if (!sameTopology || !(state.vertexKey == vertexKey)) {
+		ComputeMeshParams params;
+		prepare(params);
+
+		const size_t vertexCount = params.VertexCount();
+		const size_t indexCount = params.IndexCount();
+
+		if (!sameTopology) {
+			glBindVertexArray(mesh.vao);
+			glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+			ReserveBufferData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), GL_DYNAMIC_DRAW);
+			SetShaderMemoryLayout();
+
+			if (params.gridIndices && indexCount > 0) {
+				BindGridIndices(mesh, ComputedTopology(params));
+			}
+			else {
+				UnshareIndices(mesh);
+				if (mesh.ebo == 0) glGenBuffers(1, &mesh.ebo);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+				ReserveBufferData(mesh, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLuint), GL_DYNAMIC_DRAW);
+			}
+			glBindVertexArray(0);
+
+			mesh.nIndices = static_cast<GLuint>(indexCount);
+			mesh.firstIndex = 0;
+			state.indexKey = indexKey;
+		}
+
+		m_Compute.Generate(params, mesh.vbo, mesh.ebo, !sameTopology && !params.gridIndices, &m_ComputeFrames);
+
+		mesh.nVertices = static_cast<GLuint>(vertexCount);
+		state.vertexKey = vertexKey;
+		state.writtenFrame = m_FrameIndex;
+	}
+
+	if (mesh.nIndices == 0) return;
+
+	glBindVertexArray(mesh.vao);
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.nIndices), GL_UNSIGNED_INT, nullptr);
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * LoadComputedMesh
+ * ---------------------------------------
+ * The compute counterpart of
+ * LoadGeneratedMesh for static meshes: sizes
+ * the VBO, binds the shared grid indices and
+ * runs the vertex pass once.
+ ******************************************/
+
+void ShapeMeshes::LoadComputedMesh(GLMesh& mesh, const ComputeMeshParams& params)
+{
+	// A mesh bound to a bundle entry shares the entry's VAO; give it its own.
+	if (mesh.vbo == 0) {
+		mesh.vao = 0;
+		mesh.ebo = 0;
+	}
+
+	const size_t vertexCount = params.VertexCount();
+	const size_t indexCount = params.IndexCount();
+
+	// The triangles are only ever on the GPU
+	ReleaseEdgeIndices(mesh);
+
+	if (mesh.vao == 0) glGenVertexArrays(1, &mesh.vao);
+	glBindVertexArray(mesh.vao);
+
+	if (mesh.vbo == 0) glGenBuffers(1, &mesh.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+	ReserveBufferData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, vertexCount * sizeof(Vertex), GL_STATIC_DRAW);
+	SetShaderMemoryLayout();
+
+	if (indexCount > 0) BindGridIndices(mesh, ComputedTopology(params));
+	glBindVertexArray(0);
+
+	m_Compute.Generate(params, mesh.vbo, mesh.ebo, false);
+
+	mesh.nVertices = static_cast<GLuint>(vertexCount);
+	mesh.nIndices = static_cast<GLuint>(indexCount);
+	mesh.firstIndex = 0;
+}
+
+/******************************************
+ * LoadGeneratedMesh
+ * ---------------------------------------
+ * Uploads a generated mesh, using the on-disk
+ * mesh cache when a directory has been set.
+ *
+ * A current cache entry is memory-mapped and
+ * its arrays are passed straight to
+ * InitializeMesh, so nothing is regenerated or
+ * copied. A missing or stale entry is
+ * regenerated and rewritten. Either way the
+ * generator's sub-range table is kept in
+ * mesh.subRanges, and its removed-triangle
+ * count in mesh.removedTriangles. The cache
+ * does not store the count; a grid mesh's is
+ * what its indices fall short of the full
+ * grid by.
+ *
+ * @param mesh Mesh to initialize.
+ * @param key Cache key for the generator and its parameters.
+ * @param generate Fills a MeshData on a cache miss.
+ * @param topology Grid topology of the indices, to share
+ *        the index buffer, or nullptr.
+ ******************************************/
+
+void ShapeMeshes::LoadGeneratedMesh(GLMesh& mesh, const MeshCacheKey& key, const std::function<void(MeshData&)>& generate,
+	const GridTopology* topology)
+{
+	auto upload = [&](const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount) {
+		if (topology) InitializeGridMesh(mesh, verts, vertexFloatCount, indices, indexCount, *topology);
+		else InitializeMesh(mesh, verts, vertexFloatCount, indices, indexCount);
+		LoadEdgeIndices(mesh, verts, vertexFloatCount, indices, indexCount);
+	};
+
+	if (!m_MeshCacheDirectory.empty()) {
+		MeshCache cache(m_MeshCacheDirectory, m_MeshCacheCompressed);
+		MappedMesh mapped;
+		if (cache.Open(key, mapped)) {
+			upload(mapped.Vertices(), mapped.VertexFloatCount(), mapped.Indices(), mapped.IndexCount());
+			mesh.subRanges.assign(mapped.SubRanges(), mapped.SubRanges() + mapped.SubRangeCount());
+			const size_t gridTriangles = topology ? static_cast<size_t>(topology->rows) * topology->cols * 2 : 0;
+			mesh.removedTriangles = static_cast<GLuint>(gridTriangles - std::min(gridTriangles, mapped.IndexCount() / 3));
+			return;
+		}
+
+		MeshData data;
+		generate(data);
+		cache.Store(key, data);
+		upload(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size());
+		mesh.subRanges = data.subRanges;
+		mesh.removedTriangles = data.removedTriangles;
+		return;
+	}
+
+	MeshData data;
+	generate(data);
+	upload(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size());
+	mesh.subRanges = data.subRanges;
+	mesh.removedTriangles = data.removedTriangles;
+}
+
+/******************************************
+ * MeshTable
+ * ---------------------------------------
+ * The built-in meshes by the names used in
+ * reports and exports, with the primitive
+ * type their Draw functions render and
+ * whether they draw it from the EBO. Some
+ * non-indexed meshes keep an EBO from an
+ * earlier layout, so its presence says
+ * nothing.
+ ******************************************/
+
+const std::vector<ShapeMeshes::NamedMesh>& ShapeMeshes::MeshTable()
+{
+	static const std::vector<NamedMesh> table = {
+		{ "Box", &ShapeMeshes::m_BoxMesh, GL_TRIANGLES, true },
+		{ "Cone", &ShapeMeshes::m_ConeMesh, GL_TRIANGLES, true },
+		{ "Cylinder", &ShapeMeshes::m_CylinderMesh, GL_TRIANGLES, true },
+		{ "Plane", &ShapeMeshes::m_PlaneMesh, GL_TRIANGLE_STRIP, true },
+		{ "Prism", &ShapeMeshes::m_PrismMesh, GL_TRIANGLE_STRIP, false },
+		{ "Pyramid3", &ShapeMeshes::m_Pyramid3Mesh, GL_TRIANGLE_STRIP, false },
+		{ "Pyramid4", &ShapeMeshes::m_Pyramid4Mesh, GL_TRIANGLE_STRIP, false },
+		{ "Sphere", &ShapeMeshes::m_SphereMesh, GL_TRIANGLES, true },
+		{ "Hemisphere", &ShapeMeshes::m_HemisphereMesh, GL_TRIANGLES, true },
+		{ "TaperedCylinder", &ShapeMeshes::m_TaperedCylinderMesh, GL_TRIANGLES, true },
+		{ "Torus", &ShapeMeshes::m_TorusMesh, GL_TRIANGLES, true },
+		{ "ExtraTorus1", &ShapeMeshes::m_ExtraTorusMesh1, GL_TRIANGLES, false },
+		{ "ExtraTorus2", &ShapeMeshes::m_ExtraTorusMesh2, GL_TRIANGLES, false },
+		{ "Spring", &ShapeMeshes::m_SpringMesh, GL_TRIANGLES, true },
+		{ "Tube", &ShapeMeshes::m_TubeMesh, GL_TRIANGLES, true },
+		{ "Fin", &ShapeMeshes::m_FinMesh, GL_TRIANGLES, true },
+		{ "CurvedCone", &ShapeMeshes::m_CurvedConeMesh, GL_TRIANGLES, true },
+		{ "TaperedTorus", &ShapeMeshes::m_TaperedTorusMesh, GL_TRIANGLES, true },
+		{ "Spiral", &ShapeMeshes::m_SpiralMesh, GL_TRIANGLES, true },
+		{ "SineCone", &ShapeMeshes::m_SineConeMesh, GL_TRIANGLES, true },
+		{ "Superellipsoid", &ShapeMeshes::m_SuperellipsoidMesh, GL_TRIANGLES, true },
+	};
+	return table;
+}
+
+/******************************************
+ * GetGpuMemoryReport
+ * ---------------------------------------
+ * Builds a per-mesh breakdown of GPU buffer
+ * memory together with the overall totals.
+ * Meshes that have never held storage are
+ * left out.
+ ******************************************/
+
+GpuMemoryReport ShapeMeshes::GetGpuMemoryReport() const
+{
+	GpuMemoryReport report;
+	auto addMesh = [&report](const char* name, const GLMesh& mesh) {
+		if (mesh.peakBytes == 0) return;
+
+		MeshMemoryUsage usage;
+		usage.name = name;
+		usage.vertexBytes = mesh.vertexBytes;
+		usage.indexBytes = mesh.indexBytes + mesh.edgeBytes;  // edge indices count as indices
+		usage.instanceBytes = mesh.instanceBytes;
+		usage.totalBytes = mesh.TotalBytes();
+		usage.peakBytes = mesh.peakBytes;
+		usage.reallocations = mesh.reallocations;
+		usage.removedTriangles = mesh.removedTriangles;
+		report.meshes.push_back(usage);
+
+		report.vertexBytes += usage.vertexBytes;
+		report.indexBytes += usage.indexBytes;
+		report.instanceBytes += usage.instanceBytes;
+	};
+
+	for (const NamedMesh& entry : MeshTable())
+		addMesh(entry.name, this->*entry.mesh);
+	addMesh("Bundle", m_BundleMesh);  // vertex and index data of every bundled mesh
+	addMesh("StreamRing", m_StreamRingMesh);  // draw-time dynamic meshes, all segments
+	addMesh("TessellationPatches", m_TessellationPatches);  // coarse patch mesh of every tessellated shape
+
+	GLMesh sharedIndices;
+	for (const SharedIndexBuffer& shared : m_SharedIndexBuffers) {
+		sharedIndices.indexBytes += shared.buffer.indexBytes;
+		sharedIndices.peakBytes += shared.buffer.peakBytes;
+	}
+	addMesh("SharedIndices", sharedIndices);  // grid index buffers, one per topology in use
+	for (const ImportedMesh& imported : m_ImportedMeshes)
+		addMesh(imported.name.c_str(), imported.mesh);
+
+	report.totalBytes = m_GpuBytes;
+	report.peakBytes = m_GpuPeakBytes;
+	report.reallocations = m_GpuReallocations;
+	return report;
+}
+
+/******************************************
+ * PrintGpuMemoryReport
+ * ---------------------------------------
+ * Writes GetGpuMemoryReport() as a table,
+ * one row per mesh followed by the totals.
+ * Removed is the triangles each mesh's
+ * PoleMode dropped.
  *
- * @param wireframe If true, sets to wireframe mode.
+ * @param out Stream to write to.
  ******************************************/
 
-inline void SetWireframeMode(bool wireframe) {
-	glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
+void ShapeMeshes::PrintGpuMemoryReport(std::ostream& out) const
+{
+	GpuMemoryReport report = GetGpuMemoryReport();
+
+	out << std::left << std::setw(18) << "Mesh" << std::right
+		<< std::setw(12) << "Vertex" << std::setw(12) << "Index" << std::setw(12) << "Instance"
+		<< std::setw(12) << "Total" << std::setw(12) << "Peak" << std::setw(10) << "Reallocs" << std::setw(10) << "Removed" << '\n';
+
+	for (const MeshMemoryUsage& usage : report.meshes) {
+		out << std::left << std::setw(18) << usage.name << std::right
+			<< std::setw(12) << usage.vertexBytes << std::setw(12) << usage.indexBytes << std::setw(12) << usage.instanceBytes
+			<< std::setw(12) << usage.totalBytes << std::setw(12) << usage.peakBytes << std::setw(10) << usage.reallocations
+			<< std::setw(10) << usage.removedTriangles << '\n';
+	}
+
+	out << std::left << std::setw(18) << "All meshes" << std::right
+		<< std::setw(12) << report.vertexBytes << std::setw(12) << report.indexBytes << std::setw(12) << report.instanceBytes
+		<< std::setw(12) << report.totalBytes << std::setw(12) << report.peakBytes << std::setw(10) << report.reallocations << '\n';
 }
 
 /******************************************
- * InitializeMesh
+ * ExportMesh
  * ---------------------------------------
- * Generic function to initialize a mesh by
- * generating and binding VAOs/VBOs/EBOs.
+ * Maps the mesh's vertex buffer, and its
+ * index buffer if its Draw function is
+ * indexed, for reading and hands them to
+ * MeshExport, so the only copy made is the
+ * exporter's bounded chunk buffer. Meshes
+ * drawn from a bundle share its buffer and
+ * are refused. A mesh whose positions and
+ * normals are in another mesh's buffer
+ * (attributeVbo) is read back and
+ * interleaved first.
  *
- * @param mesh Reference to the GLMesh struct.
- * @param verts Vector containing vertex data.
- * @param indices Vector containing index data (if applicable).
+ * @param meshName Report name of the mesh (e.g. "Sphere").
+ * @param path Output file; .obj, .ply or .glb.
  ******************************************/
 
-void ShapeMeshes::InitializeMesh(GLMesh& mesh, const std::vector<GLfloat>& verts, const std::vector<GLuint>& indices) {
-	mesh.nVertices = static_cast<GLuint>(verts.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	mesh.nIndices = static_cast<GLuint>(indices.size());
+bool ShapeMeshes::ExportMesh(const std::string& meshName, const std::string& path) const
+{
+	auto sameName = [&meshName](const char* name) {
+		return meshName.size() == std::strlen(name) &&
+			std::equal(meshName.begin(), meshName.end(), name, [](char a, char b) {
+				return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+			});
+	};
 
-	glGenVertexArrays(1, &mesh.vao);
-	glBindVertexArray(mesh.vao);
+	const NamedMesh* entry = nullptr;
+	for (const NamedMesh& candidate : MeshTable())
+		if (sameName(candidate.name)) entry = &candidate;
 
-	glGenBuffers(1, &mesh.vbo);
-	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), verts.data(), GL_STATIC_DRAW);
+	if (!entry) {
+		std::cerr << "Error: no mesh named " << meshName << " to export." << std::endl;
+		return false;
+	}
 
-	if (!indices.empty()) {
-		glGenBuffers(1, &mesh.ebo);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+	const GLMesh& mesh = this->*entry->mesh;
+	if (mesh.vbo == 0 || mesh.vertexBytes == 0 || mesh.nVertices == 0) {
+		std::cerr << "Error: the " << entry->name << " mesh has no buffers of its own to export; load it first." << std::endl;
+		return false;
 	}
 
-	if (!m_bMemoryLayoutDone) {
-		SetShaderMemoryLayout();
+	// Stores can be larger than the data after a reload (see UpdateBufferData).
+	const size_t vertexFloats = static_cast<size_t>(mesh.nVertices) * (sizeof(Vertex) / sizeof(GLfloat));
+	const bool indexed = entry->indexed;
+	if (indexed && (mesh.ebo == 0 || mesh.nIndices == 0)) {
+		std::cerr << "Error: the " << entry->name << " mesh has no indices to export; load it first." << std::endl;
+		return false;
 	}
 
-	glBindVertexArray(0); // Unbind VAO after setup
+	// Keep the element binding of whatever VAO is bound out of this.
+	glBindVertexArray(0);
+
+	const GLfloat* vertices = nullptr;
+	std::vector<GLfloat> interleaved;
+	if (mesh.attributeVbo != 0) {
+		// Positions and normals from the other mesh's first vertices, UVs from vbo
+		constexpr size_t floatsPerVertex = sizeof(Vertex) / sizeof(GLfloat);
+		std::vector<GLfloat> texCoords(static_cast<size_t>(mesh.nVertices) * 2);
+		interleaved.resize(vertexFloats);
+		glBindBuffer(GL_COPY_READ_BUFFER, mesh.attributeVbo);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, 0, vertexFloats * sizeof(GLfloat), interleaved.data());
+		glBindBuffer(GL_COPY_READ_BUFFER, mesh.vbo);
+		glGetBufferSubData(GL_COPY_READ_BUFFER, 0, texCoords.size() * sizeof(GLfloat), texCoords.data());
+		for (size_t i = 0; i < mesh.nVertices; ++i) {
+			interleaved[i * floatsPerVertex + 6] = texCoords[2 * i];
+			interleaved[i * floatsPerVertex + 7] = texCoords[2 * i + 1];
+		}
+		vertices = interleaved.data();
+	}
+	else {
+		glBindBuffer(GL_COPY_READ_BUFFER, mesh.vbo);
+		vertices = static_cast<const GLfloat*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, vertexFloats * sizeof(GLfloat), GL_MAP_READ_BIT));
+	}
+
+	const GLuint* indices = nullptr;
+	if (indexed) {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.ebo);
+		indices = static_cast<const GLuint*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, mesh.nIndices * sizeof(GLuint), GL_MAP_READ_BIT));
+	}
+
+	bool exported = false;
+	if (!vertices || (indexed && !indices)) {
+		std::cerr << "Error: could not map the " << entry->name << " mesh buffers for reading." << std::endl;
+	}
+	else {
+		exported = MeshExport::Write(path, vertices, vertexFloats, indices, indexed ? mesh.nIndices : 0, entry->mode);
+	}
+
+	if (vertices && mesh.attributeVbo == 0) glUnmapBuffer(GL_COPY_READ_BUFFER);
+	if (indices) glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	return exported;
+}
+
+/******************************************
+ * SetBundleVertexLayout
+ * ---------------------------------------
+ * Attribute pointers for a bundle entry whose
+ * vertices start at byteOffset in the bound
+ * GL_ARRAY_BUFFER. Same locations as
+ * SetShaderMemoryLayout; half-float bundles
+ * use GL_HALF_FLOAT components.
+ ******************************************/
+
+static void SetBundleVertexLayout(BundleVertexFormat format, size_t byteOffset)
+{
+	const GLenum type = format == BundleVertexFormat::Half16 ? GL_HALF_FLOAT : GL_FLOAT;
+	const size_t component = format == BundleVertexFormat::Half16 ? sizeof(GLushort) : sizeof(GLfloat);
+	const GLsizei stride = static_cast<GLsizei>(BundleVertexStride(format));
+
+	glVertexAttribPointer(0, FloatsPerVertex, type, GL_FALSE, stride, reinterpret_cast<const void*>(byteOffset));
+	glEnableVertexAttribArray(0);
+
+	glVertexAttribPointer(1, FloatsPerNormal, type, GL_FALSE, stride, reinterpret_cast<const void*>(byteOffset + component * FloatsPerVertex));
+	glEnableVertexAttribArray(1);
+
+	glVertexAttribPointer(2, FloatsPerUV, type, GL_FALSE, stride, reinterpret_cast<const void*>(byteOffset + component * (FloatsPerVertex + FloatsPerNormal)));
+	glEnableVertexAttribArray(2);
+}
+
+/******************************************
+ * LoadMeshBundle
+ * ---------------------------------------
+ * Loads a bundle written by the MeshBaker
+ * tool. The file is memory-mapped and its
+ * vertex and index sections (which are
+ * adjacent) go to the GPU in one glBufferData
+ * call. Each entry then gets a VAO over that
+ * buffer whose attribute pointers start at
+ * the entry's first vertex, and a firstIndex
+ * pointing at its indices.
+ *
+ * @param path Bundle file.
+ * @param lod LOD level passed to SelectBundleLod.
+ * @return True if the bundle was loaded.
+ ******************************************/
+
+bool ShapeMeshes::LoadMeshBundle(const std::string& path, int lod)
+{
+	MappedFile file;
+	if (!file.Open(path)) {
+		std::cerr << "Error: could not open mesh bundle " << path << std::endl;
+		return false;
+	}
+
+	// --- Validate the header and entry table ---
+	const size_t size = file.Size();
+	if (size < sizeof(MeshBundleHeader)) {
+		std::cerr << "Error: mesh bundle " << path << " is truncated." << std::endl;
+		return false;
+	}
+
+	const MeshBundleHeader& header = *reinterpret_cast<const MeshBundleHeader*>(file.Data());
+	const BundleVertexFormat format = static_cast<BundleVertexFormat>(header.vertexFormat);
+	const uint64_t alignment = MeshBundleHeader::SectionAlignment;
+
+	bool valid =
+		header.magic == MeshBundleHeader::MagicValue &&
+		header.formatVersion == MeshBundleHeader::FormatVersion &&
+		header.fileSize == size &&
+		(format == BundleVertexFormat::Float32 || format == BundleVertexFormat::Half16) &&
+		header.vertexStride == BundleVertexStride(format) &&
+		header.entryOffset + static_cast<uint64_t>(header.entryCount) * sizeof(MeshBundleEntry) <= header.vertexOffset &&
+		header.vertexOffset + header.vertexBytes <= header.indexOffset &&
+		header.indexOffset + header.indexBytes <= size &&
+		header.entryOffset % alignment == 0 &&
+		header.vertexOffset % alignment == 0 &&
+		header.indexOffset % alignment == 0;
+
+	if (!valid) {
+		std::cerr << "Error: " << path << " is not a valid mesh bundle." << std::endl;
+		return false;
+	}
+
+	if (header.codeVersion != GeneratorVersion) {
+		std::cerr << "Error: mesh bundle " << path << " was baked with generator version " << header.codeVersion
+			<< " (current " << GeneratorVersion << "); rebake it with MeshBaker." << std::endl;
+		return false;
+	}
+
+	const MeshBundleEntry* entries = reinterpret_cast<const MeshBundleEntry*>(file.Data() + header.entryOffset);
+	const uint64_t vertexCapacity = header.vertexBytes / header.vertexStride;
+	const uint64_t indexCapacity = header.indexBytes / sizeof(GLuint);
+
+	for (uint32_t i = 0; i < header.entryCount; ++i) {
+		const MeshBundleEntry& entry = entries[i];
+		bool partsValid = entry.partCount <= MeshBundleEntry::MaxParts;
+		for (uint32_t part = 0; partsValid && part < entry.partCount; ++part)
+			partsValid = static_cast<uint64_t>(entry.partFirst[part]) + entry.partIndexCount[part] <= entry.indexCount;
+
+		if (!std::memchr(entry.name, '\0', sizeof(entry.name)) ||
+			static_cast<uint64_t>(entry.baseVertex) + entry.vertexCount > vertexCapacity ||
+			static_cast<uint64_t>(entry.firstIndex) + entry.indexCount > indexCapacity ||
+			!partsValid) {
+			std::cerr << "Error: mesh bundle " << path << " has an invalid entry (" << i << ")." << std::endl;
+			return false;
+		}
+	}
+
+	ReleaseMeshBundle();
+
+	// --- One upload for the vertex section, padding and index section ---
+	const GLsizeiptr uploadBytes = static_cast<GLsizeiptr>(header.indexOffset + header.indexBytes - header.vertexOffset);
+	glGenBuffers(1, &m_BundleMesh.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, m_BundleMesh.vbo);
+	UploadBufferData(m_BundleMesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, uploadBytes, file.Data() + header.vertexOffset, GL_STATIC_DRAW);
+
+	// --- One VAO per entry over the shared buffer ---
+	const GLuint indexBase = static_cast<GLuint>((header.indexOffset - header.vertexOffset) / sizeof(GLuint));
+	m_BundledMeshes.reserve(header.entryCount);
+
+	for (uint32_t i = 0; i < header.entryCount; ++i) {
+		const MeshBundleEntry& entry = entries[i];
+
+		BundledMesh bundled;
+		bundled.name = entry.name;
+		bundled.lod = entry.lod;
+
+		GLMesh& mesh = bundled.mesh;
+		mesh.nVertices = entry.vertexCount;
+		mesh.nIndices = entry.indexCount;
+		mesh.firstIndex = indexBase + entry.firstIndex;
+		mesh.numSlices = entry.numSlices;
+		mesh.curveSteps = entry.curveSteps;
+		for (uint32_t part = 0; part < entry.partCount; ++part)
+			mesh.subRanges.push_back({ entry.partFirst[part], entry.partIndexCount[part] });
+
+		glGenVertexArrays(1, &mesh.vao);
+		glBindVertexArray(mesh.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, m_BundleMesh.vbo);
+		if (entry.indexCount > 0)
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_BundleMesh.vbo);
+		SetBundleVertexLayout(format, static_cast<size_t>(entry.baseVertex) * header.vertexStride);
+		glBindVertexArray(0);
+
+		m_BundledMeshes.push_back(bundled);
+	}
+
+	SelectBundleLod(lod);
+	return true;
+}
+
+/******************************************
+ * FindBundledMesh
+ * ---------------------------------------
+ * Returns the entry for name at the highest
+ * level not above lod, or its lowest level
+ * if every level is above lod. Returns
+ * nullptr if the bundle has no such mesh.
+ ******************************************/
+
+const BundledMesh* ShapeMeshes::FindBundledMesh(const std::string& name, int lod) const
+{
+	const BundledMesh* best = nullptr;
+	for (const BundledMesh& bundled : m_BundledMeshes) {
+		if (bundled.name != name) continue;
+
+		const bool fits = static_cast<int>(bundled.lod) <= lod;
+		if (!best) {
+			best = &bundled;
+		}
+		else if (fits) {
+			if (static_cast<int>(best->lod) > lod || bundled.lod > best->lod) best = &bundled;
+		}
+		else if (static_cast<int>(best->lod) > lod && bundled.lod < best->lod) {
+			best = &bundled;
+		}
+	}
+	return best;
+}
+
+/******************************************
+ * BundleTargets
+ * ---------------------------------------
+ * Built-in meshes that can be bound to bundle
+ * entries, keyed by manifest name.
+ ******************************************/
+
+const std::vector<std::pair<const char*, GLMesh ShapeMeshes::*>>& ShapeMeshes::BundleTargets()
+{
+	static const std::vector<std::pair<const char*, GLMesh ShapeMeshes::*>> targets = {
+		{ "cone", &ShapeMeshes::m_ConeMesh },
+		{ "cylinder", &ShapeMeshes::m_CylinderMesh },
+		{ "tapered_cylinder", &ShapeMeshes::m_TaperedCylinderMesh },
+		{ "sphere", &ShapeMeshes::m_SphereMesh },
+		{ "hemisphere", &ShapeMeshes::m_HemisphereMesh },
+		{ "torus", &ShapeMeshes::m_TorusMesh },
+		{ "extra_torus1", &ShapeMeshes::m_ExtraTorusMesh1 },
+		{ "extra_torus2", &ShapeMeshes::m_ExtraTorusMesh2 },
+		{ "spring", &ShapeMeshes::m_SpringMesh },
+		{ "tube", &ShapeMeshes::m_TubeMesh },
+		{ "curved_cone", &ShapeMeshes::m_CurvedConeMesh },
+	};
+	return targets;
+}
+
+/******************************************
+ * SelectBundleLod
+ * ---------------------------------------
+ * Binds the built-in meshes named in the
+ * loaded bundle to their entries for lod.
+ * A built-in mesh that still owns buffers
+ * from a LoadXMesh call has them freed first.
+ *
+ * @param lod Requested LOD level.
+ ******************************************/
+
+void ShapeMeshes::SelectBundleLod(int lod)
+{
+	for (const auto& target : BundleTargets()) {
+		const BundledMesh* bundled = FindBundledMesh(target.first, lod);
+		if (!bundled) continue;
+
+		GLMesh& mesh = this->*target.second;
+		ReleaseMesh(mesh);
+		mesh = bundled->mesh;
+		if (&mesh == &m_SphereMesh) m_SphereParams = SphereGridParams();
+	}
+	RefreshHemisphereOnSphere();
+}
+
+/******************************************
+ * DrawBundledMesh
+ * ---------------------------------------
+ * Draws a bundle entry by name, for entries
+ * that are not bound to a built-in mesh.
+ *
+ * Params:
+ * - name: Mesh name from the manifest.
+ * - lod: LOD level (see FindBundledMesh).
+ * - wireframe: (bool) If true, renders as wireframe.
+ ******************************************/
+
+void ShapeMeshes::DrawBundledMesh(const std::string& name, int lod, bool wireframe) const
+{
+	const BundledMesh* bundled = FindBundledMesh(name, lod);
+	if (!bundled) {
+		std::cerr << "Error: mesh '" << name << "' is not in the loaded mesh bundle." << std::endl;
+		return;
+	}
+
+	SetWireframeMode(wireframe);
+	glBindVertexArray(bundled->mesh.vao);
+	if (bundled->mesh.nIndices > 0)
+		glDrawElements(GL_TRIANGLES, bundled->mesh.nIndices, GL_UNSIGNED_INT, IndexOffset(bundled->mesh));
+	else
+		glDrawArrays(GL_TRIANGLES, 0, bundled->mesh.nVertices);
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * ReleaseMeshBundle
+ * ---------------------------------------
+ * Deletes the bundle buffer and entry VAOs,
+ * and clears any built-in mesh still bound
+ * to an entry.
+ ******************************************/
+
+void ShapeMeshes::ReleaseMeshBundle()
+{
+	if (m_BundleMesh.vbo == 0) return;
+
+	for (BundledMesh& bundled : m_BundledMeshes) {
+		for (const auto& target : BundleTargets()) {
+			GLMesh& mesh = this->*target.second;
+			if (mesh.vbo == 0 && mesh.vao == bundled.mesh.vao) mesh = GLMesh();
+		}
+		glDeleteVertexArrays(1, &bundled.mesh.vao);
+	}
+	m_BundledMeshes.clear();
+
+	glDeleteBuffers(1, &m_BundleMesh.vbo);
+	ReleaseBufferData(m_BundleMesh);
+	m_BundleMesh.vbo = 0;
+}
+
+/******************************************
+ * LoadImportedMesh
+ * ---------------------------------------
+ * Reads an OBJ or PLY file with MeshImport
+ * and uploads the welded result. The parse
+ * happens before any GL call, so a bad file
+ * leaves an existing mesh of that name as it
+ * was.
+ *
+ * @param name Name to draw the mesh by.
+ * @param path File to load (.obj or .ply).
+ ******************************************/
+
+bool ShapeMeshes::LoadImportedMesh(const std::string& name, const std::string& path)
+{
+	MeshData data;
+	if (!MeshImport::Read(path, data)) return false;
+
+	auto existing = std::find_if(m_ImportedMeshes.begin(), m_ImportedMeshes.end(),
+		[&name](const ImportedMesh& imported) { return imported.name == name; });
+
+	if (existing == m_ImportedMeshes.end()) {
+		m_ImportedMeshes.push_back({ name, GLMesh() });
+		existing = m_ImportedMeshes.end() - 1;
+	}
+
+	// A reload keeps the mesh's VAO and buffers (see InitializeMesh).
+	InitializeMesh(existing->mesh, data.vertices, data.indices);
+	LoadEdgeIndices(existing->mesh, data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size());
+	return true;
+}
+
+/******************************************
+ * DrawImportedMesh
+ ******************************************/
+
+void ShapeMeshes::DrawImportedMesh(const std::string& name, bool wireframe) const
+{
+	for (const ImportedMesh& imported : m_ImportedMeshes) {
+		if (imported.name != name) continue;
+		if (wireframe && DrawMeshEdges(imported.mesh)) return;
+
+		SetWireframeMode(wireframe);
+		glBindVertexArray(imported.mesh.vao);
+		glDrawElements(GL_TRIANGLES, imported.mesh.nIndices, GL_UNSIGNED_INT, nullptr);
+		glBindVertexArray(0);
+		return;
+	}
+
+	std::cerr << "Error: no imported mesh named '" << name << "'." << std::endl;
 }
 
 /******************************************
@@ -168,6 +1889,11 @@ void ShapeMeshes::LoadBoxMesh()
 
 	// Use the centralized InitializeMesh function
 	InitializeMesh(m_BoxMesh, verts, indices);
+	LoadEdgeIndices(m_BoxMesh, verts.data(), verts.size(), indices.data(), indices.size());
+
+	// One part per face, in BoxSide order
+	m_BoxMesh.subRanges.clear();
+	for (GLuint face = 0; face < 6; ++face) m_BoxMesh.subRanges.push_back({ face * 6, 6 });
 }
 
 
@@ -180,79 +1906,65 @@ void ShapeMeshes::LoadBoxMesh()
  * @param radius Base radius of the cone.
  * @param height Height of the cone.
  * @param numSlices Number of subdivisions around the base.
+ * @param sides Faceted or welded side (see ConeSideMode).
  *
- * Correct draw calls:
- * glDrawArrays(GL_TRIANGLE_FAN, 0, numSlices + 2);     // Base
- * glDrawArrays(GL_TRIANGLE_STRIP, numSlices + 2, numSlices * 2); // Sides
+ * Either way the indices are numSlices base
+ * triangles followed by numSlices side
+ * triangles, as DrawConeMesh draws them.
  ******************************************/
 
-void ShapeMeshes::LoadConeMesh(float radius, float height, int numSlices)
+void ShapeMeshes::LoadConeMesh(float radius, float height, int numSlices, ConeSideMode sides)
 {
 	if (numSlices < 3) numSlices = 3;
 	m_ConeMesh.numSlices = numSlices;
 
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint>  indices;
-
-	float angleStep = 2.0f * Pi / numSlices;
-
-	// --- Bottom cap (fan) ---
-	int bottomCenterIndex = vertices.size() / 8;
-	// center
-	vertices.insert(vertices.end(), {
-		0,0,0,     0,-1,0,      0.5f,0.5f
-		});
-	// rim (no duplicate at end)
-	for (int i = 0; i < numSlices; ++i) {
-		float a = i * angleStep;
-		float x = radius * cos(a), z = radius * sin(a);
-		vertices.insert(vertices.end(), {
-			x,0,z,  0,-1,0,   0.5f + 0.5f * cos(a), 0.5f + 0.5f * sin(a)
-			});
-		// fan triangles, CCW order as seen from below
-		indices.push_back(bottomCenterIndex);
-		indices.push_back(bottomCenterIndex + ((i + 1) % numSlices) + 1);
-		indices.push_back(bottomCenterIndex + i + 1);
-	}
+	// Faceted sides keep the key they have always had
+	MeshCacheKey key = sides == ConeSideMode::Faceted
+		? MeshCacheKey::Make(MeshGeneratorId::Cone, { radius, height, float(numSlices) })
+		: MeshCacheKey::Make(MeshGeneratorId::Cone, { radius, height, float(numSlices), float(sides) });
 
-	// --- Apex ---
-	int apexIndex = vertices.size() / 8;
-	vertices.insert(vertices.end(), {
-		0,height,0,   0,1,0,    0.5f,0.5f
-		});
+	// --- Generate (or load from cache) and upload mesh ---
+	LoadGeneratedMesh(m_ConeMesh, key,
+		[&](MeshData& data) { GenerateConeMesh(data, radius, height, numSlices, sides); });
+}
 
-	// --- Side ring ---
-	int sideStart = apexIndex + 1;
-	for (int i = 0; i < numSlices; ++i) {
-		float a0 = i * angleStep;
-		float a1 = (i + 1) * angleStep;
-		glm::vec3 p0(radius * cos(a0), 0, radius * sin(a0));
-		glm::vec3 p1(radius * cos(a1), 0, radius * sin(a1));
-		// same normal for the whole quad (averaged)
-		glm::vec3 normal = glm::normalize(glm::vec3(
-			(p0.x + p1.x) * 0.5f,
-			height * 0.5f,
-			(p0.z + p1.z) * 0.5f
-		));
-		// push two verts per slice
-		vertices.insert(vertices.end(), {
-			p0.x,p0.y,p0.z, normal.x,normal.y,normal.z, (float)i / numSlices, 1.0f
-			});
-		vertices.insert(vertices.end(), {
-			p1.x,p1.y,p1.z, normal.x,normal.y,normal.z, (float)(i + 1) / numSlices, 1.0f
-			});
+void ShapeMeshes::GenerateConeMesh(MeshData& mesh, float radius, float height, int numSlices, ConeSideMode sides)
+{
+	mesh.Clear();
+	if (numSlices < 3) numSlices = 3;
 
-		// now two verts at sideStart + 2*i, 2*i+1
-		int v0 = sideStart + 2 * i;
-		int v1 = sideStart + 2 * i + 1;
-		// CCW winding looking at outside of cone
-		indices.push_back(apexIndex);
-		indices.push_back(v0);
-		indices.push_back(v1);
+	// A welded side needs the seam vertex so its U runs 0 to 1 once
+	const bool welded = sides == ConeSideMode::Welded;
+	LatheMesh lathe(LatheRing::Full(numSlices, welded));
+
+	// --- Bottom cap (fan), CCW as seen from below ---
+	LatheFan bottom;
+	bottom.center = { 0.0f, 0.0f, 0.0f, -1.0f, 0.5f };
+	bottom.rim = { radius, 0.0f, 0.0f, -1.0f, 0.5f };
+	bottom.reverse = true;
+	lathe.AddFan(bottom);
+
+	// --- Sides: fan from the apex over two rim vertices per slice, each pair
+	// sharing the slice's averaged (radius, height / 2) normal ---
+	LatheFan side;
+	side.center = { 0.0f, height, 0.0f, 1.0f, 0.5f };
+	side.rim = { radius, 0.0f, radius, height * 0.5f, 1.0f };
+	side.faceted = true;
+	side.polarUV = false;
+
+	// --- Welded: one rim vertex per ring angle with its own normal, and an
+	// apex per slice facing the middle of the slice ---
+	if (welded) {
+		side.center.v = 0.0f;
+		side.faceted = false;
+		side.splitCenter = true;
 	}
+	lathe.AddFan(side);
+
+	lathe.Build(mesh.vertices, mesh.indices);
 
-	// --- Upload mesh ---
-	InitializeMesh(m_ConeMesh, vertices, indices);
+	// Parts in ConePart order: base, sides
+	for (size_t count : lathe.PartIndexCounts()) mesh.AddSubRange(static_cast<GLuint>(count));
 }
 
 
@@ -279,75 +1991,40 @@ void ShapeMeshes::LoadCylinderMesh(float radius, float height, int numSlices)
 	if (numSlices < 3) numSlices = 3;
 	m_CylinderMesh.numSlices = numSlices;
 
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint> indices;
-
-	float angleStep = 2.0f * Pi / numSlices;
-
-	// **Generate Bottom Cap**
-	int bottomCenterIndex = static_cast<int>(vertices.size() / 8);
-	vertices.insert(vertices.end(), { 0.0f, 0.0f, 0.0f,  0.0f, -1.0f, 0.0f,  0.5f, 0.5f });
-
-	for (int i = 0; i <= numSlices; ++i) {
-		float angle = i * angleStep;
-		float x = radius * cos(angle);
-		float z = radius * sin(angle);
-		vertices.insert(vertices.end(), { x, 0.0f, z,  0.0f, -1.0f, 0.0f,  0.5f + 0.5f * cos(angle), 0.5f + 0.5f * sin(angle) });
-
-		if (i < numSlices)
-		{
-			indices.push_back(bottomCenterIndex);
-			indices.push_back(static_cast<GLuint>(bottomCenterIndex + i + 1));
-			indices.push_back(static_cast<GLuint>(bottomCenterIndex + (i + 1) % numSlices + 1));
-		}
-	}
-
-	// **Generate Top Cap**
-	int topCenterIndex = static_cast<int>(vertices.size() / 8);
-	vertices.insert(vertices.end(), { 0.0f, height, 0.0f,  0.0f, 1.0f, 0.0f,  0.5f, 0.5f });
+	// **Generate (or load from cache) and Initialize Mesh**
+	LoadGeneratedMesh(m_CylinderMesh, MeshCacheKey::Make(MeshGeneratorId::Cylinder, { radius, height, float(numSlices) }),
+		[&](MeshData& data) { GenerateCylinderMesh(data, radius, height, numSlices); });
+}
 
-	for (int i = 0; i <= numSlices; ++i) {
-		float angle = i * angleStep;
-		float x = radius * cos(angle);
-		float z = radius * sin(angle);
-		vertices.insert(vertices.end(), { x, height, z,  0.0f, 1.0f, 0.0f,  0.5f + 0.5f * cos(angle), 0.5f + 0.5f * sin(angle) });
+void ShapeMeshes::GenerateCylinderMesh(MeshData& mesh, float radius, float height, int numSlices)
+{
+	mesh.Clear();
+	if (numSlices < 3) numSlices = 3;
+	using namespace LatheCorner;
 
-		if (i < numSlices)
-		{
-			indices.push_back(topCenterIndex);
-			indices.push_back(static_cast<GLuint>(topCenterIndex + i + 1));
-			indices.push_back(static_cast<GLuint>(topCenterIndex + (i + 1) % numSlices + 1));
-		}
-	}
+	LatheMesh lathe(LatheRing::Full(numSlices, true));
 
-	// **Generate Side Faces**
-	int sideStartIndex = static_cast<int>(vertices.size() / 8);
-	for (int i = 0; i <= numSlices; ++i) {
-		float angle = i * angleStep;
-		float x = radius * cos(angle);
-		float z = radius * sin(angle);
-		float nx = cos(angle);
-		float nz = sin(angle);
+	// **Bottom and Top Caps**
+	LatheFan bottom;
+	bottom.center = { 0.0f, 0.0f, 0.0f, -1.0f, 0.5f };
+	bottom.rim = { radius, 0.0f, 0.0f, -1.0f, 0.5f };
+	lathe.AddFan(bottom);
 
-		// Bottom ring vertex
-		vertices.insert(vertices.end(), { x, 0.0f, z,  nx, 0.0f, nz,  static_cast<float>(i) / numSlices, 1.0f });
-		// Top ring vertex
-		vertices.insert(vertices.end(), { x, height, z,  nx, 0.0f, nz,  static_cast<float>(i) / numSlices, 0.0f });
+	LatheFan top;
+	top.center = { 0.0f, height, 0.0f, 1.0f, 0.5f };
+	top.rim = { radius, height, 0.0f, 1.0f, 0.5f };
+	lathe.AddFan(top);
 
-		if (i < numSlices)
-		{
-			indices.push_back(sideStartIndex + (i * 2));
-			indices.push_back(sideStartIndex + (i * 2) + 1);
-			indices.push_back(sideStartIndex + ((i + 1) * 2));
+	// **Side Faces**: bottom and top vertex per slice
+	LatheSurface side;
+	side.profile = { { radius, 0.0f, 1.0f, 0.0f, 1.0f }, { radius, height, 1.0f, 0.0f, 0.0f } };
+	side.passes = { { { 0, 1, { A0, B0, A1, B0, A1, B1 } } } };
+	lathe.AddSurface(std::move(side));
 
-			indices.push_back(sideStartIndex + (i * 2) + 1);
-			indices.push_back(sideStartIndex + ((i + 1) * 2));
-			indices.push_back(sideStartIndex + ((i + 1) * 2) + 1);
-		}
-	}
+	lathe.Build(mesh.vertices, mesh.indices);
 
-	// **Initialize Mesh**
-	InitializeMesh(m_CylinderMesh, vertices, indices);
+	// Parts in CylinderPart order: bottom, top, sides
+	for (size_t count : lathe.PartIndexCounts()) mesh.AddSubRange(static_cast<GLuint>(count));
 }
 
 /******************************************
@@ -665,16 +2342,58 @@ void ShapeMeshes::LoadPyramid4Mesh(float baseSize, float height)
  * - longitudeSegments: Number of horizontal divisions.
  * - radius: Sphere's radius.
  *
+ * - poles: See PoleMode. Trimmed and Welded
+ *   meshes drop the shared grid index buffer
+ *   for a private one, and are cached apart
+ *   from the Duplicated mesh.
+ *
+ * A hemisphere loaded with the same parameters
+ * is drawn from this mesh's buffers (see
+ * LoadHemisphereMesh), and DrawSphereBand
+ * draws any band of its rows.
+ *
  * Correct draw call:
  * glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices, GL_UNSIGNED_INT, nullptr);
  ******************************************/
 
 void ShapeMeshes::LoadSphereMesh(int latitudeSegments,
 	int longitudeSegments,
-	float radius)
+	float radius,
+	PoleMode poles)
 {
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint>  indices;
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(latitudeSegments);
+	topology.cols = static_cast<uint32_t>(longitudeSegments);
+	topology.winding = GridWinding::Rotated;
+
+	// Duplicated poles keep the key they have always had
+	MeshCacheKey key = poles == PoleMode::Duplicated
+		? MeshCacheKey::Make(MeshGeneratorId::Sphere, { float(latitudeSegments), float(longitudeSegments), radius })
+		: MeshCacheKey::Make(MeshGeneratorId::Sphere, { float(latitudeSegments), float(longitudeSegments), radius, float(poles) });
+
+	LoadGeneratedMesh(m_SphereMesh, key,
+		[&](MeshData& data) { GenerateSphereMesh(data, latitudeSegments, longitudeSegments, radius, poles); }, &topology);
+
+	m_SphereParams = { latitudeSegments, longitudeSegments, radius, poles };
+	RefreshHemisphereOnSphere();
+}
+
+/******************************************
+ * GenerateSphereMesh
+ * ---------------------------------------
+ * Headless half of LoadSphereMesh. Builds the
+ * latitude/longitude grid into a MeshData.
+ ******************************************/
+
+void ShapeMeshes::GenerateSphereMesh(MeshData& mesh,
+	int latitudeSegments,
+	int longitudeSegments,
+	float radius,
+	PoleMode poles)
+{
+	mesh.Clear();
+	std::vector<GLfloat>& vertices = mesh.vertices;
+	std::vector<GLuint>& indices = mesh.indices;
 
 	// --- generate full?sphere vertices ---
 	for (int lat = 0; lat <= latitudeSegments; ++lat) {
@@ -726,74 +2445,88 @@ void ShapeMeshes::LoadSphereMesh(int latitudeSegments,
 		}
 	}
 
-	// store counts and initialize VAO/EBO
-	m_SphereMesh.nVertices = GLuint(vertices.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	m_SphereMesh.nIndices = GLuint(indices.size());
-	InitializeMesh(m_SphereMesh, vertices, indices);
+	mesh.removedTriangles = static_cast<GLuint>(ApplyPoleMode(mesh, static_cast<uint32_t>(longitudeSegments), true, true, poles));
 }
 
+/******************************************
+ * LoadHemisphereMesh
+ * ---------------------------------------
+ * The top latitudeSegments / 2 rows of a
+ * sphere. If the loaded sphere has the same
+ * parameters, nothing is generated and only
+ * texture coordinates are uploaded (see
+ * Hemisphere On Sphere in the header);
+ * otherwise the hemisphere gets buffers of
+ * its own.
+ ******************************************/
+
 void ShapeMeshes::LoadHemisphereMesh(int latitudeSegments,
 	int longitudeSegments,
-	float radius)
+	float radius,
+	PoleMode poles)
 {
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint>  indices;
-
-	// we only go up to latitudeSegments/2 so theta [0, pi/2]
-	int hemiLatSegments = latitudeSegments / 2;
-
-	// --- generate hemisphere vertices ---
-	for (int lat = 0; lat <= hemiLatSegments; ++lat) {
-		float theta = lat * Pi / latitudeSegments;  // note divisor is full latitudeSegments
-		float sinTheta = std::sin(theta);
-		float cosTheta = std::cos(theta);
-
-		for (int lon = 0; lon <= longitudeSegments; ++lon) {
-			float phi = lon * 2 * Pi / longitudeSegments;
-			float sinPhi = std::sin(phi);
-			float cosPhi = std::cos(phi);
-
-			float x = radius * sinTheta * cosPhi;
-			float y = radius * cosTheta;
-			float z = radius * sinTheta * sinPhi;
-
-			float nx = sinTheta * cosPhi;
-			float ny = cosTheta;
-			float nz = sinTheta * sinPhi;
-
-			float u = 1.0f - float(lon) / longitudeSegments;
-			float v = 1.0f - float(lat) / hemiLatSegments;  // v ? [0,1] over half sphere
-
-			vertices.push_back(x);
-			vertices.push_back(y);
-			vertices.push_back(z);
-			vertices.push_back(nx);
-			vertices.push_back(ny);
-			vertices.push_back(nz);
-			vertices.push_back(u);
-			vertices.push_back(v);
-		}
+	// --- Rows of the loaded sphere when it matches ---
+	m_HemisphereParams = { latitudeSegments, longitudeSegments, radius, poles };
+	if (CanShareSphere(m_HemisphereParams)) {
+		LoadHemisphereOnSphere(m_HemisphereParams);
+		return;
 	}
 
-	// --- generate hemisphere indices ---
-	for (int lat = 0; lat < hemiLatSegments; ++lat) {
-		for (int lon = 0; lon < longitudeSegments; ++lon) {
-			int first = lat * (longitudeSegments + 1) + lon;
-			int second = first + longitudeSegments + 1;
+	// A hemisphere on the old sphere reads its attributes from there; start over
+	if (m_HemisphereOnSphere) {
+		ReleaseMesh(m_HemisphereMesh);
+		m_HemisphereOnSphere = false;
+	}
 
-			indices.push_back(first);
-			indices.push_back(second);
-			indices.push_back(first + 1);
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(latitudeSegments / 2);
+	topology.cols = static_cast<uint32_t>(longitudeSegments);
+	topology.winding = GridWinding::Rotated;
 
-			indices.push_back(second);
-			indices.push_back(second + 1);
-			indices.push_back(first + 1);
-		}
+	MeshCacheKey key = poles == PoleMode::Duplicated
+		? MeshCacheKey::Make(MeshGeneratorId::Hemisphere, { float(latitudeSegments), float(longitudeSegments), radius })
+		: MeshCacheKey::Make(MeshGeneratorId::Hemisphere, { float(latitudeSegments), float(longitudeSegments), radius, float(poles) });
+
+	LoadGeneratedMesh(m_HemisphereMesh, key,
+		[&](MeshData& data) { GenerateHemisphereMesh(data, latitudeSegments, longitudeSegments, radius, poles); }, &topology);
+}
+
+void ShapeMeshes::GenerateHemisphereMesh(MeshData& mesh,
+	int latitudeSegments,
+	int longitudeSegments,
+	float radius,
+	PoleMode poles)
+{
+	mesh.Clear();
+	using namespace LatheCorner;
+
+	// we only go up to latitudeSegments/2 so theta [0, pi/2]
+	int hemiLatSegments = latitudeSegments / 2;
+
+	// --- one profile point per latitude, one ring per point ---
+	LatheSurface surface;
+	surface.layout = LatheLayout::RingMajor;
+	surface.flipU = true;
+	surface.profile.reserve(hemiLatSegments + 1);
+	for (int lat = 0; lat <= hemiLatSegments; ++lat) {
+		float theta = lat * Pi / latitudeSegments;  // note divisor is full latitudeSegments
+		float sinTheta = std::sin(theta);
+		float cosTheta = std::cos(theta);
+		float v = 1.0f - float(lat) / hemiLatSegments;  // v over half sphere
+		surface.profile.push_back({ radius * sinTheta, radius * cosTheta, sinTheta, cosTheta, v });
 	}
 
-	m_HemisphereMesh.nVertices = GLuint(vertices.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	m_HemisphereMesh.nIndices = GLuint(indices.size());
-	InitializeMesh(m_HemisphereMesh, vertices, indices);
+	// --- bands between neighbouring latitudes ---
+	surface.passes.emplace_back();
+	for (int lat = 0; lat < hemiLatSegments; ++lat)
+		surface.passes[0].push_back({ static_cast<uint32_t>(lat), static_cast<uint32_t>(lat + 1), { A0, B0, A1, B0, B1, A1 } });
+
+	LatheMesh lathe(LatheRing::Full(longitudeSegments, true));
+	lathe.AddSurface(std::move(surface));
+	lathe.Build(mesh.vertices, mesh.indices);
+
+	// Profile point 0 is the pole; the equator row stays open
+	mesh.removedTriangles = static_cast<GLuint>(ApplyPoleMode(mesh, static_cast<uint32_t>(longitudeSegments), true, false, poles));
 }
 
 /******************************************
@@ -826,100 +2559,44 @@ void ShapeMeshes::LoadTaperedCylinderMesh(float bottomRadius, float topRadius, f
 	if (numSlices < 3) numSlices = 3;
 	m_TaperedCylinderMesh.numSlices = numSlices;
 
-	std::vector<GLfloat> vertices; // interleaved: px,py,pz, nx,ny,nz, u,v   (8 floats)
-	std::vector<GLuint>  indices;
+	// Generate (or load from cache) and upload
+	LoadGeneratedMesh(m_TaperedCylinderMesh, MeshCacheKey::Make(MeshGeneratorId::TaperedCylinder, { bottomRadius, topRadius, height, float(numSlices) }),
+		[&](MeshData& data) { GenerateTaperedCylinderMesh(data, bottomRadius, topRadius, height, numSlices); });
+}
 
-	vertices.reserve((2 * (numSlices + 1) /*caps (with centers)*/ + 2 * numSlices /*sides*/) * 8);
-	indices.reserve(numSlices * 3 /*bottom*/ + numSlices * 3 /*top*/ + numSlices * 6 /*sides*/);
+void ShapeMeshes::GenerateTaperedCylinderMesh(MeshData& mesh, float bottomRadius, float topRadius, float height, int numSlices)
+{
+	mesh.Clear();
+	if (numSlices < 3) numSlices = 3;
+	using namespace LatheCorner;
 
-	const float angleStep = 2.0f * Pi / numSlices;
+	LatheMesh lathe(LatheRing::Full(numSlices, false));
 
 	// Bottom Cap (normal down)
-	const int bottomCenterIndex = static_cast<int>(vertices.size() / 8);
-	vertices.insert(vertices.end(), {
-		0.0f, 0.0f, 0.0f,   0.0f,-1.0f, 0.0f,   0.5f, 0.5f
-		});
-
-	for (int i = 0; i < numSlices; ++i) {
-		float a = i * angleStep;
-		float x = bottomRadius * std::cos(a);
-		float z = bottomRadius * std::sin(a);
-		float u = 0.5f + 0.5f * std::cos(a);
-		float v = 0.5f + 0.5f * std::sin(a);
-		vertices.insert(vertices.end(), { x,0.0f,z,  0.0f,-1.0f,0.0f,  u,v });
-
-		// Triangle fan (center, i, i+1)
-		indices.push_back(bottomCenterIndex);
-		indices.push_back(bottomCenterIndex + 1 + i);
-		indices.push_back(bottomCenterIndex + 1 + ((i + 1) % numSlices));
-	}
-
-	// Top Cap (normal up)
-	const int topCenterIndex = static_cast<int>(vertices.size() / 8);
-	vertices.insert(vertices.end(), {
-		0.0f, height, 0.0f,   0.0f, 1.0f, 0.0f,   0.5f, 0.5f
-		});
-
-	for (int i = 0; i < numSlices; ++i) {
-		float a = i * angleStep;
-		float x = topRadius * std::cos(a);
-		float z = topRadius * std::sin(a);
-		float u = 0.5f + 0.5f * std::cos(a);
-		float v = 0.5f + 0.5f * std::sin(a);
-		vertices.insert(vertices.end(), { x,height,z,  0.0f,1.0f,0.0f,  u,v });
-
-		// Triangle fan CCW as seen from ABOVE (center, next, current)
-		indices.push_back(topCenterIndex);
-		indices.push_back(topCenterIndex + 1 + ((i + 1) % numSlices));
-		indices.push_back(topCenterIndex + 1 + i);
-	}
-
-	// Sides (two verts per slice, two triangles per quad)
-	const int sideStartIndex = static_cast<int>(vertices.size() / 8);
-
-	// correct outward normal for a frustum wall: tilt by slope
+	LatheFan bottom;
+	bottom.center = { 0.0f, 0.0f, 0.0f, -1.0f, 0.5f };
+	bottom.rim = { bottomRadius, 0.0f, 0.0f, -1.0f, 0.5f };
+	lathe.AddFan(bottom);
+
+	// Top Cap (normal up), CCW as seen from above
+	LatheFan top;
+	top.center = { 0.0f, height, 0.0f, 1.0f, 0.5f };
+	top.rim = { topRadius, height, 0.0f, 1.0f, 0.5f };
+	top.reverse = true;
+	lathe.AddFan(top);
+
+	// Sides: correct outward normal for a frustum wall, tilted by slope
 	const float slope = (bottomRadius - topRadius) / height; // >0 if bottom > top
-	for (int i = 0; i < numSlices; ++i) {
-		float a = i * angleStep;
-		float cb = std::cos(a), sb = std::sin(a);
-
-		// positions
-		float xB = bottomRadius * cb, zB = bottomRadius * sb;
-		float xT = topRadius * cb, zT = topRadius * sb;
-
-		// outward normal
-		glm::vec3 n = glm::normalize(glm::vec3(cb, slope, sb));
-
-		// bottom ring vertex (side)
-		vertices.insert(vertices.end(), {
-			xB, 0.0f, zB,   n.x, n.y, n.z,   static_cast<float>(i) / numSlices, 1.0f
-			});
-		// top ring vertex (side)
-		vertices.insert(vertices.end(), {
-			xT, height, zT, n.x, n.y, n.z,   static_cast<float>(i) / numSlices, 0.0f
-			});
-	}
+	LatheSurface side;
+	side.profile = { { bottomRadius, 0.0f, 1.0f, slope, 1.0f }, { topRadius, height, 1.0f, slope, 0.0f } };
+	// (B, Bn, T) and (T, Bn, Tn), as the sides have always been wound
+	side.passes = { { { 0, 1, { A0, A1, B0, B0, A1, B1 } } } };
+	lathe.AddSurface(std::move(side));
 
-	for (int i = 0; i < numSlices; ++i) {
-		int iNext = (i + 1) % numSlices;
+	lathe.Build(mesh.vertices, mesh.indices);
 
-		GLuint B = static_cast<GLuint>(sideStartIndex + 2 * i);
-		GLuint T = B + 1;
-		GLuint Bn = static_cast<GLuint>(sideStartIndex + 2 * iNext);
-		GLuint Tn = Bn + 1;
-
-		// CCW as seen from outside: (B, Bn, T) and (T, Bn, Tn)
-		indices.push_back(B);
-		indices.push_back(Bn);
-		indices.push_back(T);
-
-		indices.push_back(T);
-		indices.push_back(Bn);
-		indices.push_back(Tn);
-	}
-
-	// Upload
-	InitializeMesh(m_TaperedCylinderMesh, vertices, indices);
+	// Parts in CylinderPart order: bottom, top, sides
+	for (size_t count : lathe.PartIndexCounts()) mesh.AddSubRange(static_cast<GLuint>(count));
 }
 
 
@@ -946,6 +2623,20 @@ void ShapeMeshes::LoadTaperedCylinderMesh(float bottomRadius, float topRadius, f
 
 void ShapeMeshes::LoadTorusMesh(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments)
 {
+	m_TorusMesh.numSlices = std::max(3, mainSegments);
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(std::max(3, mainSegments));
+	topology.cols = static_cast<uint32_t>(std::max(3, tubeSegments));
+
+	LoadGeneratedMesh(m_TorusMesh, MeshCacheKey::Make(MeshGeneratorId::Torus, { mainRadius, tubeRadius, float(mainSegments), float(tubeSegments) }),
+		[&](MeshData& data) { GenerateTorusMesh(data, mainRadius, tubeRadius, mainSegments, tubeSegments); }, &topology);
+}
+
+void ShapeMeshes::GenerateTorusMesh(MeshData& mesh, float mainRadius, float tubeRadius, int mainSegments, int tubeSegments)
+{
+	mesh.Clear();
+
 	// Validate input parameters
 	mainSegments = std::max(3, mainSegments);
 	tubeSegments = std::max(3, tubeSegments);
@@ -954,8 +2645,8 @@ void ShapeMeshes::LoadTorusMesh(float mainRadius, float tubeRadius, int mainSegm
 	float mainSegmentStep = 2.0f * Pi / mainSegments;
 	float tubeSegmentStep = 2.0f * Pi / tubeSegments;
 
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint> indices;
+	std::vector<GLfloat>& vertices = mesh.vertices;
+	std::vector<GLuint>& indices = mesh.indices;
 
 	// Generate vertices and normals
 	for (int i = 0; i <= mainSegments; ++i) {
@@ -1011,13 +2702,6 @@ void ShapeMeshes::LoadTorusMesh(float mainRadius, float tubeRadius, int mainSegm
 			indices.push_back(next + 1);
 		}
 	}
-
-	// Store vertex and index counts
-	m_TorusMesh.nVertices = static_cast<GLuint>(vertices.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	m_TorusMesh.nIndices = static_cast<GLuint>(indices.size());
-
-	// Use the centralized InitializeMesh function
-	InitializeMesh(m_TorusMesh, vertices, indices);
 }
 
 ///////////////////////////////////////////////////
@@ -1033,200 +2717,14 @@ void ShapeMeshes::LoadTorusMesh(float mainRadius, float tubeRadius, int mainSegm
 ///////////////////////////////////////////////////
 void ShapeMeshes::LoadExtraTorusMesh1(float thickness)
 {
-	int _mainSegments = 30;
-	int _tubeSegments = 30;
-	float _mainRadius = 1.0f;
-	float _tubeRadius = .1f;
-
-	if (thickness <= 1.0)
-	{
-		_tubeRadius = thickness;
-	}
-
-	auto mainSegmentAngleStep = glm::radians(360.0f / float(_mainSegments));
-	auto tubeSegmentAngleStep = glm::radians(360.0f / float(_tubeSegments));
-
-	std::vector<glm::vec3> vertex_list;
-	std::vector<std::vector<glm::vec3>> segments_list;
-	std::vector<glm::vec2> texture_coords;
-	glm::vec3 center(0.0f, 0.0f, 0.0f);
-	glm::vec3 normal;
-	glm::vec3 vertex;
-	glm::vec2 text_coord;
-
-	// generate the torus vertices
-	auto currentMainSegmentAngle = 0.0f;
-	for (auto i = 0; i < _mainSegments; i++)
-	{
-		// Calculate sine and cosine of main segment angle
-		auto sinMainSegment = sin(currentMainSegmentAngle);
-		auto cosMainSegment = cos(currentMainSegmentAngle);
-		auto currentTubeSegmentAngle = 0.0f;
-		std::vector<glm::vec3> segment_points;
-		for (auto j = 0; j < _tubeSegments; j++)
-		{
-			// Calculate sine and cosine of tube segment angle
-			auto sinTubeSegment = sin(currentTubeSegmentAngle);
-			auto cosTubeSegment = cos(currentTubeSegmentAngle);
-
-			// Calculate vertex position on the surface of torus
-			auto surfacePosition = glm::vec3(
-				(_mainRadius + _tubeRadius * cosTubeSegment) * cosMainSegment,
-				(_mainRadius + _tubeRadius * cosTubeSegment) * sinMainSegment,
-				_tubeRadius * sinTubeSegment);
-
-			//vertex_list.push_back(surfacePosition);
-			segment_points.push_back(surfacePosition);
-
-			// Update current tube angle
-			currentTubeSegmentAngle += tubeSegmentAngleStep;
-		}
-		segments_list.push_back(segment_points);
-		segment_points.clear();
-
-		// Update main segment angle
-		currentMainSegmentAngle += mainSegmentAngleStep;
-	}
-
-	float horizontalStep = 1.0 / _mainSegments;
-	float verticalStep = 1.0 / _tubeSegments;
-	float u = 0.0;
-	float v = 0.0;
-
-	// connect the various segments together, forming triangles
-	for (int i = 0; i < _mainSegments; i++)
-	{
-		for (int j = 0; j < _tubeSegments; j++)
-		{
-			if (((i + 1) < _mainSegments) && ((j + 1) < _tubeSegments))
-			{
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i][j + 1]);
-				texture_coords.push_back(glm::vec2(u, v + verticalStep));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v + verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-				vertex_list.push_back(segments_list[i + 1][j]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-				vertex_list.push_back(segments_list[i + 1][j + 1]);
-				texture_coords.push_back(glm::vec2(u + horizontalStep, v - verticalStep));
-				vertex_list.push_back(segments_list[i][j]);
-				texture_coords.push_back(glm::vec2(u, v));
-			}
-			else
-			{
-				if (((i + 1) == _mainSegments) && ((j + 1) == _tubeSegments))
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][0]);
-					texture_coords.push_back(glm::vec2(0, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((i + 1) == _mainSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][j + 1]);
-					texture_coords.push_back(glm::vec2(u, v + verticalStep));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[0][j]);
-					texture_coords.push_back(glm::vec2(0, v));
-					vertex_list.push_back(segments_list[0][j + 1]);
-					texture_coords.push_back(glm::vec2(0, v + verticalStep));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-				else if ((j + 1) == _tubeSegments)
-				{
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i][0]);
-					texture_coords.push_back(glm::vec2(u, 0));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-					vertex_list.push_back(segments_list[i + 1][j]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, v));
-					vertex_list.push_back(segments_list[i + 1][0]);
-					texture_coords.push_back(glm::vec2(u + horizontalStep, 0));
-					vertex_list.push_back(segments_list[i][j]);
-					texture_coords.push_back(glm::vec2(u, v));
-				}
-
-			}
-			v += verticalStep;
-		}
-		v = 0.0;
-		u += horizontalStep;
-	}
-
-	std::vector<GLfloat> combined_values;
-
-	// combine interleaved vertices, normals, and texture coords
-	for (int i = 0; i < vertex_list.size(); i++)
-	{
-		vertex = vertex_list[i];
-		normal = normalize(vertex);
-
-		text_coord = texture_coords[i];
-		combined_values.push_back(vertex.x);
-		combined_values.push_back(vertex.y);
-		combined_values.push_back(vertex.z);
-		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
-	}
-
-	// store vertex and index count
-	m_ExtraTorusMesh1.nVertices = vertex_list.size();
-	m_ExtraTorusMesh1.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_ExtraTorusMesh1.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_ExtraTorusMesh1.vao);
-
-	// Create VBOs
-	glGenBuffers(1, m_ExtraTorusMesh1.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ExtraTorusMesh1.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
-	{
-		SetShaderMemoryLayout();
-	}
+	LoadGeneratedMesh(m_ExtraTorusMesh1, MeshCacheKey::Make(MeshGeneratorId::ExtraTorus, { thickness }),
+		[&](MeshData& data) { GenerateExtraTorusMesh(data, thickness); });
 }
 
-///////////////////////////////////////////////////
-//	LoadExtraTorusMesh2()
-//
-//	Create a torus mesh by specifying the vertices and 
-//  store it in a VAO/VBO.  The normals and texture
-//  coordinates are also set.
-//
-//	Correct triangle drawing command:
-//
-//	glDrawArrays(GL_TRIANGLES, 0, meshes.gExtraTorusMesh1.nVertices);
-///////////////////////////////////////////////////
-void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
+void ShapeMeshes::GenerateExtraTorusMesh(MeshData& mesh, float thickness)
 {
+	mesh.Clear();
+
 	int _mainSegments = 30;
 	int _tubeSegments = 30;
 	float _mainRadius = 1.0f;
@@ -1370,7 +2868,7 @@ void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
 		u += horizontalStep;
 	}
 
-	std::vector<GLfloat> combined_values;
+	std::vector<GLfloat>& combined_values = mesh.vertices;
 
 	// combine interleaved vertices, normals, and texture coords
 	for (int i = 0; i < vertex_list.size(); i++)
@@ -1383,31 +2881,30 @@ void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
 		combined_values.push_back(vertex.y);
 		combined_values.push_back(vertex.z);
 		combined_values.push_back(normal.x);
-		combined_values.push_back(normal.y);
-		combined_values.push_back(normal.z);
-		combined_values.push_back(text_coord.x);
-		combined_values.push_back(text_coord.y);
-	}
-
-	// store vertex and index count
-	m_ExtraTorusMesh2.nVertices = vertex_list.size();
-	m_ExtraTorusMesh2.nIndices = 0;
-
-	// Create VAO
-	glGenVertexArrays(1, &m_ExtraTorusMesh2.vao); // we can also generate multiple VAOs or buffers at the same time
-	glBindVertexArray(m_ExtraTorusMesh2.vao);
-
-	// Create VBOs
-	glGenBuffers(1, m_ExtraTorusMesh2.vbos);
-	glBindBuffer(GL_ARRAY_BUFFER, m_ExtraTorusMesh2.vbos[0]); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * combined_values.size(), combined_values.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
-
-	if (m_bMemoryLayoutDone == false)
-	{
-		SetShaderMemoryLayout();
+		combined_values.push_back(normal.y);
+		combined_values.push_back(normal.z);
+		combined_values.push_back(text_coord.x);
+		combined_values.push_back(text_coord.y);
 	}
 }
 
+///////////////////////////////////////////////////
+//	LoadExtraTorusMesh2()
+//
+//	Create a torus mesh by specifying the vertices and 
+//  store it in a VAO/VBO.  The normals and texture
+//  coordinates are also set.
+//
+//	Correct triangle drawing command:
+//
+//	glDrawArrays(GL_TRIANGLES, 0, meshes.gExtraTorusMesh1.nVertices);
+///////////////////////////////////////////////////
+void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
+{
+	LoadGeneratedMesh(m_ExtraTorusMesh2, MeshCacheKey::Make(MeshGeneratorId::ExtraTorus, { thickness }),
+		[&](MeshData& data) { GenerateExtraTorusMesh(data, thickness); });
+}
+
 /******************************************
  * LoadSpringMesh
  * ---------------------------------------
@@ -1421,88 +2918,127 @@ void ShapeMeshes::LoadExtraTorusMesh2(float thickness)
  * - mainSegments: Number of loops in the spring.
  * - tubeSegments: Number of subdivisions around the tube.
  * - springLength: Total vertical height of the spring.
+ * - chordTolerance: 0 for evenly spaced rings;
+ *   otherwise rings are placed so the tube's
+ *   centerline stays within this distance of
+ *   the helix, never more rings than the even
+ *   spacing. Uses the CPU generator even with
+ *   compute generation on.
  ******************************************/
-void ShapeMeshes::LoadSpringMesh(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, float springLength)
+void ShapeMeshes::LoadSpringMesh(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance)
+{
+	// One row per coil step along the helix, as the generator lays them out.
+	GridTopology topology;
+	topology.cols = static_cast<uint32_t>(std::max(8, tubeSegments));
+	topology.rows = static_cast<uint32_t>(std::max(1, mainSegments)) * topology.cols;
+
+	if (chordTolerance > 0.0f) {
+		std::vector<float> angles;
+		SpringParameters(angles, mainRadius, mainSegments, tubeSegments, springLength, chordTolerance);
+		topology.rows = static_cast<uint32_t>(angles.size() - 1);
+	}
+	else if (m_ComputeGeneration) {
+		LoadComputedMesh(m_SpringMesh, ComputeMeshParams::Spring(mainRadius, tubeRadius, mainSegments, tubeSegments, springLength));
+		return;
+	}
+
+	const MeshCacheKey key = chordTolerance > 0.0f
+		? MeshCacheKey::Make(MeshGeneratorId::Spring, { mainRadius, tubeRadius, float(mainSegments), float(tubeSegments), springLength, chordTolerance })
+		: MeshCacheKey::Make(MeshGeneratorId::Spring, { mainRadius, tubeRadius, float(mainSegments), float(tubeSegments), springLength });
+	LoadGeneratedMesh(m_SpringMesh, key,
+		[&](MeshData& data) { GenerateSpringMesh(data, mainRadius, tubeRadius, mainSegments, tubeSegments, springLength, chordTolerance); }, &topology);
+}
+
+void ShapeMeshes::GenerateSpringMesh(MeshData& mesh, float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance)
 {
+	mesh.Clear();
+
 	// Ensure valid parameters
 	mainSegments = std::max(1, mainSegments);
 	tubeSegments = std::max(8, tubeSegments);  // More segments for smooth coil
 
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint> indices;
-
+	const int steps = mainSegments * tubeSegments;
 	float mainAngleStep = (2.0f * Pi) / tubeSegments; // Angle step per tube segment
-	float heightStep = springLength / (mainSegments * tubeSegments); // Height per step
-	float coilPitch = springLength / mainSegments; // Distance between loops
-
-	// Generate vertices for the helical tube with correct orientation
-	for (int i = 0; i <= mainSegments * tubeSegments; ++i)
+	float heightStep = springLength / steps; // Height per step
+
+	// Helix angles of the rings when placed by tolerance; empty for one ring per step
+	std::vector<float> angles;
+	if (chordTolerance > 0.0f)
+		SpringParameters(angles, mainRadius, mainSegments, tubeSegments, springLength, chordTolerance);
+	const bool adaptive = !angles.empty();
+	const int rings = adaptive ? static_cast<int>(angles.size()) : steps + 1;
+	const float totalAngle = steps * mainAngleStep;
+
+	// Helix centerline with its analytic tangent
+	std::vector<SweepFrame> frames(static_cast<size_t>(rings));
+	for (int i = 0; i < rings; ++i)
 	{
-		float mainAngle = i * mainAngleStep;  // Helix angle
-		float centerX = mainRadius * cos(mainAngle); // Helix X
-		float centerY = mainRadius * sin(mainAngle); // Helix Y
-		float centerZ = i * heightStep;  // Helix height (Z)
-
-		// Tangent direction of the helix (approximate with forward difference)
-		glm::vec3 tangent(
-			-mainRadius * sin(mainAngle),  // dx/d(theta)
-			mainRadius * cos(mainAngle),   // dy/d(theta)
-			heightStep                     // dz/d(theta)
-		);
-		tangent = glm::normalize(tangent); // Normalize tangent vector
-
-		// Compute perpendicular vectors for tube alignment
-		glm::vec3 normal = glm::normalize(glm::vec3(-tangent.y, tangent.x, 0)); // Perpendicular to tangent
-		glm::vec3 binormal = glm::cross(tangent, normal); // Second perpendicular direction
-
-		// Generate circular cross-section along the helix
-		for (int j = 0; j <= tubeSegments; ++j)
-		{
-			float tubeAngle = j * 2.0f * Pi / tubeSegments; // Circular angle
-			float tx = tubeRadius * cos(tubeAngle);
-			float ty = tubeRadius * sin(tubeAngle);
+		float mainAngle = adaptive ? angles[i] : i * mainAngleStep;  // Helix angle
+		float height = adaptive ? mainAngle * (heightStep / mainAngleStep) : i * heightStep;
+		frames[i].center = glm::vec3(mainRadius * cos(mainAngle), mainRadius * sin(mainAngle), height);
+		frames[i].tangent = glm::normalize(glm::vec3(-mainRadius * sin(mainAngle), mainRadius * cos(mainAngle), heightStep));
+		frames[i].along = adaptive ? mainAngle / totalAngle : static_cast<float>(i) / steps;
+	}
 
-			// Compute final position using the normal/binormal basis
-			glm::vec3 point = glm::vec3(centerX, centerY, centerZ) + normal * tx + binormal * ty;
+	// Normal level with the XY plane on every ring: the helix is a screw, so
+	// this is its rotation-minimizing frame up to a constant twist per coil,
+	// and keeping it fixed makes every coil identical.
+	MeshSweep::ComputeFrames(frames, glm::vec3(0.0f, 0.0f, 1.0f), SweepFrameMode::FixedUp);
 
-			// Compute normal vector for shading
-			glm::vec3 normalVector = glm::normalize(normal * tx + binormal * ty);
+	mesh.vertices.reserve(frames.size() * (tubeSegments + 1) * 8);
+	MeshSweep::AppendSweepRings(mesh.vertices, frames, SweepProfile::Circle(tubeSegments, true),
+		[tubeRadius](size_t) { return tubeRadius; }, true);
 
-			// Texture coordinates
-			float u = (float)i / (mainSegments * tubeSegments);
-			float v = (float)j / tubeSegments;
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(rings - 1);
+	topology.cols = static_cast<uint32_t>(tubeSegments);
+	BuildGridIndices(mesh.indices, topology);
+}
 
-			// Store vertex data (position, normal, texture)
-			vertices.insert(vertices.end(), { point.x, point.y, point.z, normalVector.x, normalVector.y, normalVector.z, u, v });
-		}
-	}
+/******************************************
+ * SpringCurve / SpringParameters
+ * ---------------------------------------
+ * The helix as a curve of its angle, rising
+ * heightStep per mainAngleStep so it passes
+ * through every evenly spaced ring.
+ * SpringParameters places rings on it by
+ * chordTolerance; a step is held to a quarter
+ * turn so no chord cuts across a coil.
+ ******************************************/
 
-	// Generate indices for triangle strips
-	for (int i = 0; i < mainSegments * tubeSegments; ++i)
-	{
-		for (int j = 0; j < tubeSegments; ++j)
-		{
-			int current = i * (tubeSegments + 1) + j;
-			int next = (i + 1) * (tubeSegments + 1) + j;
+SweepCurve ShapeMeshes::SpringCurve(float mainRadius, int mainSegments, int tubeSegments, float springLength, int& uniformSegments)
+{
+	mainSegments = std::max(1, mainSegments);
+	tubeSegments = std::max(8, tubeSegments);
 
-			// First triangle
-			indices.push_back(current);
-			indices.push_back(next);
-			indices.push_back(current + 1);
+	uniformSegments = mainSegments * tubeSegments;
+	const float mainAngleStep = (2.0f * Pi) / tubeSegments;
+	const float rise = (springLength / uniformSegments) / mainAngleStep;
 
-			// Second triangle
-			indices.push_back(current + 1);
-			indices.push_back(next);
-			indices.push_back(next + 1);
-		}
-	}
+	SweepCurve curve;
+	curve.position = [mainRadius, rise](float angle) {
+		return glm::vec3(mainRadius * std::cos(angle), mainRadius * std::sin(angle), angle * rise);
+	};
+	curve.t0 = 0.0f;
+	curve.t1 = uniformSegments * mainAngleStep;
+	return curve;
+}
 
-	// Store vertex and index counts
-	m_SpringMesh.nVertices = static_cast<GLuint>(vertices.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	m_SpringMesh.nIndices = static_cast<GLuint>(indices.size());
+void ShapeMeshes::SpringParameters(std::vector<float>& angles, float mainRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance)
+{
+	int uniformSegments = 0;
+	SweepCurve curve = SpringCurve(mainRadius, mainSegments, tubeSegments, springLength, uniformSegments);
+	MeshSweep::AdaptiveParameters(angles, curve, chordTolerance, uniformSegments, 0.5f * Pi);
+}
 
-	// Use the centralized InitializeMesh function
-	InitializeMesh(m_SpringMesh, vertices, indices);
+SweepSamplingReport ShapeMeshes::ReportSpringSampling(float mainRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance)
+{
+	int uniformSegments = 0;
+	SweepCurve curve = SpringCurve(mainRadius, mainSegments, tubeSegments, springLength, uniformSegments);
+
+	std::vector<float> angles;
+	SpringParameters(angles, mainRadius, mainSegments, tubeSegments, springLength, chordTolerance);
+	return MeshSweep::CompareSampling(curve, angles, uniformSegments, static_cast<size_t>(std::max(8, tubeSegments)) + 1);
 }
 
 /******************************************
@@ -1528,74 +3064,35 @@ void ShapeMeshes::LoadTubeMesh(float outerRadius, float innerRadius, float heigh
 	if (numSlices < 3) numSlices = 3;
 	m_TubeMesh.numSlices = numSlices;
 
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint> indices;
-
-	float angleStep = 2.0f * Pi / static_cast<float>(numSlices);
-
-	/*** Generate Outer and Inner Ring Vertices ***/
-	for (int i = 0; i <= numSlices; ++i) {
-		float angle = i * angleStep;
-		float x = cos(angle);
-		float z = sin(angle);
-
-		// Outer ring (bottom and top)
-		vertices.insert(vertices.end(), { outerRadius * x, 0.0f, outerRadius * z, 0.0f, -1.0f, 0.0f, static_cast<float>(i) / numSlices, 1.0f });
-		vertices.insert(vertices.end(), { outerRadius * x, height, outerRadius * z, 0.0f, 1.0f, 0.0f, static_cast<float>(i) / numSlices, 0.0f });
-
-		// Inner ring (bottom and top)
-		vertices.insert(vertices.end(), { innerRadius * x, 0.0f, innerRadius * z, 0.0f, -1.0f, 0.0f, static_cast<float>(i) / numSlices, 1.0f });
-		vertices.insert(vertices.end(), { innerRadius * x, height, innerRadius * z, 0.0f, 1.0f, 0.0f, static_cast<float>(i) / numSlices, 0.0f });
-	}
-
-	/*** Generate Outer and Inner Walls ***/
-	for (int i = 0; i < numSlices; ++i) {
-		GLuint outerBottom1 = static_cast<GLuint>(i * 4);
-		GLuint outerTop1 = outerBottom1 + 1;
-		GLuint outerBottom2 = outerBottom1 + 4;
-		GLuint outerTop2 = outerTop1 + 4;
-
-		GLuint innerBottom1 = outerBottom1 + 2;
-		GLuint innerTop1 = outerTop1 + 2;
-		GLuint innerBottom2 = innerBottom1 + 4;
-		GLuint innerTop2 = innerTop1 + 4;
-
-		// Outer wall
-		indices.insert(indices.end(), { outerBottom1, outerBottom2, outerTop1 });
-		indices.insert(indices.end(), { outerTop1, outerBottom2, outerTop2 });
-
-		// Inner wall (inverted normal)
-		indices.insert(indices.end(), { innerBottom1, innerTop1, innerBottom2 });
-		indices.insert(indices.end(), { innerTop1, innerTop2, innerBottom2 });
-	}
-
-	/*** Generate Ring-shaped End Caps ***/
-	for (int i = 0; i < numSlices; ++i) {
-		GLuint outerBottom1 = static_cast<GLuint>(i * 4);
-		GLuint innerBottom1 = outerBottom1 + 2;
-		GLuint outerBottom2 = outerBottom1 + 4;
-		GLuint innerBottom2 = innerBottom1 + 4;
-
-		GLuint outerTop1 = outerBottom1 + 1;
-		GLuint innerTop1 = innerBottom1 + 1;
-		GLuint outerTop2 = outerBottom2 + 1;
-		GLuint innerTop2 = innerBottom2 + 1;
-
-		// Bottom cap ring
-		indices.insert(indices.end(), { outerBottom1, outerBottom2, innerBottom1 });
-		indices.insert(indices.end(), { innerBottom1, outerBottom2, innerBottom2 });
+	LoadGeneratedMesh(m_TubeMesh, MeshCacheKey::Make(MeshGeneratorId::Tube, { outerRadius, innerRadius, height, float(numSlices) }),
+		[&](MeshData& data) { GenerateTubeMesh(data, outerRadius, innerRadius, height, numSlices); });
+}
 
-		// Top cap ring
-		indices.insert(indices.end(), { innerTop1, outerTop1, innerTop2 });
-		indices.insert(indices.end(), { innerTop2, outerTop1, outerTop2 });
-	}
+void ShapeMeshes::GenerateTubeMesh(MeshData& mesh, float outerRadius, float innerRadius, float height, int numSlices)
+{
+	mesh.Clear();
+	if (numSlices < 3) numSlices = 3;
+	using namespace LatheCorner;
+
+	/*** Outer and inner rings, bottom and top, per slice ***/
+	LatheSurface tube;
+	tube.profile = {
+		{ outerRadius, 0.0f, 0.0f, -1.0f, 1.0f },   // 0: outer bottom
+		{ outerRadius, height, 0.0f, 1.0f, 0.0f },  // 1: outer top
+		{ innerRadius, 0.0f, 0.0f, -1.0f, 1.0f },   // 2: inner bottom
+		{ innerRadius, height, 0.0f, 1.0f, 0.0f }   // 3: inner top
+	};
 
-	/*** Store Vertex and Index Counts ***/
-	m_TubeMesh.nVertices = static_cast<GLuint>(vertices.size() / (FloatsPerVertex + FloatsPerNormal + FloatsPerUV));
-	m_TubeMesh.nIndices = static_cast<GLuint>(indices.size());
+	tube.passes = {
+		// Outer and inner walls (inner with inverted winding)
+		{ { 0, 1, { A0, A1, B0, B0, A1, B1 } }, { 2, 3, { A0, B0, A1, B0, B1, A1 } } },
+		// Ring-shaped end caps
+		{ { 0, 2, { A0, A1, B0, B0, A1, B1 } }, { 3, 1, { A0, B0, A1, A1, B0, B1 } } }
+	};
 
-	/*** Initialize Mesh ***/
-	InitializeMesh(m_TubeMesh, vertices, indices);
+	LatheMesh lathe(LatheRing::Full(numSlices, true));
+	lathe.AddSurface(std::move(tube));
+	lathe.Build(mesh.vertices, mesh.indices);
 }
 
 /******************************************
@@ -1617,6 +3114,7 @@ void ShapeMeshes::DrawBoxMesh(bool wireframe) const
 		std::cerr << "Error: Torus mesh not initialized properly." << std::endl;
 		return;
 	}
+	if (wireframe && DrawMeshEdges(m_BoxMesh)) return;
 
 	SetWireframeMode(wireframe);
 
@@ -1632,8 +3130,8 @@ void ShapeMeshes::DrawBoxMesh(bool wireframe) const
  * the specified face using indexed drawing.
  * Supports wireframe mode.
  *
- * - Each face is made of two triangles (6 indices).
- * - Uses index offsets to select the correct face.
+ * - Draws the side's entry of the box's
+ *   sub-range table (see DrawBoxMeshSides).
  * - Ensures VAO is bound before drawing and unbound afterward.
  *
  * Params:
@@ -1642,44 +3140,152 @@ void ShapeMeshes::DrawBoxMesh(bool wireframe) const
  ******************************************/
 
 void ShapeMeshes::DrawBoxMeshSide(BoxSide side, bool wireframe) {
-	if (m_BoxMesh.vao == 0 || m_BoxMesh.nIndices == 0) {
-		std::cerr << "Error: BoxSide mesh not initialized properly." << std::endl;
+	if (static_cast<int>(side) < 0 || static_cast<int>(side) > static_cast<int>(BoxSide::front)) {
+		std::cerr << "Error: Invalid BoxSide specified." << std::endl;
 		return;
 	}
 
-	// Set polygon mode based on wireframe parameter
+	DrawBoxMeshSides(PartMask(side), wireframe);
+}
+
+/******************************************
+ * DrawBoxMeshSides / DrawFinFaces
+ ******************************************/
+
+void ShapeMeshes::DrawBoxMeshSides(uint32_t sideMask, bool wireframe)
+{
 	SetWireframeMode(wireframe);
+	DrawMeshParts(m_BoxMesh, sideMask, "Box");
+}
 
-	glBindVertexArray(m_BoxMesh.vao);
+void ShapeMeshes::DrawFinFaces(uint32_t faceMask, bool wireframe)
+{
+	SetWireframeMode(wireframe);
+	DrawMeshParts(m_FinMesh, faceMask, "Fin");
+}
 
-	// Each face of the box consists of two triangles (6 indices per face)
-	constexpr int indicesPerFace = 6;
-
-	// Define index offsets for each face
-	int offset = 0;
-	switch (side) {
-	case BoxSide::front:   offset = 0 * indicesPerFace; break;
-	case BoxSide::back:    offset = 1 * indicesPerFace; break;
-	case BoxSide::left:    offset = 2 * indicesPerFace; break;
-	case BoxSide::right:   offset = 3 * indicesPerFace; break;
-	case BoxSide::top:     offset = 4 * indicesPerFace; break;
-	case BoxSide::bottom:  offset = 5 * indicesPerFace; break;
-	default:
-		std::cerr << "Error: Invalid BoxSide specified." << std::endl;
+/******************************************
+ * MaskedPartRanges
+ * ---------------------------------------
+ * Part i is selected by bit i. A selected
+ * part that starts where the previous run
+ * ends extends it, so parts listed in index
+ * order come out as the fewest ranges.
+ ******************************************/
+
+void ShapeMeshes::MaskedPartRanges(std::vector<MeshSubRange>& ranges, const std::vector<MeshSubRange>& parts, uint32_t partMask)
+{
+	ranges.clear();
+	for (size_t i = 0; i < parts.size() && i < 32; ++i) {
+		const MeshSubRange& part = parts[i];
+		if ((partMask & (1u << i)) == 0 || part.count == 0) continue;
+
+		if (!ranges.empty() && ranges.back().first + ranges.back().count == part.first)
+			ranges.back().count += part.count;
+		else
+			ranges.push_back(part);
+	}
+}
+
+/******************************************
+ * DrawMeshParts / DrawIndexRanges
+ ******************************************/
+
+void ShapeMeshes::DrawMeshParts(const GLMesh& mesh, uint32_t partMask, const char* name)
+{
+	if (mesh.vao == 0 || mesh.subRanges.empty()) {
+		std::cerr << "Error: " << name << " mesh not initialized properly." << std::endl;
+		return;
+	}
+
+	MaskedPartRanges(m_PartRanges, mesh.subRanges, partMask);
+
+	glBindVertexArray(mesh.vao);
+	DrawIndexRanges(mesh, m_PartRanges);
+	glBindVertexArray(0);
+}
+
+void ShapeMeshes::DrawIndexRanges(const GLMesh& mesh, const std::vector<MeshSubRange>& ranges)
+{
+	if (ranges.empty()) return;
+
+	if (ranges.size() == 1) {
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(ranges[0].count), GL_UNSIGNED_INT, IndexOffset(mesh, ranges[0].first));
+		return;
+	}
+
+	m_MultiDrawCounts.clear();
+	m_MultiDrawOffsets.clear();
+	for (const MeshSubRange& range : ranges) {
+		m_MultiDrawCounts.push_back(static_cast<GLsizei>(range.count));
+		m_MultiDrawOffsets.push_back(IndexOffset(mesh, range.first));
+	}
+	glMultiDrawElements(GL_TRIANGLES, m_MultiDrawCounts.data(), GL_UNSIGNED_INT,
+		m_MultiDrawOffsets.data(), static_cast<GLsizei>(ranges.size()));
+}
+
+/******************************************
+ * LoadEdgeIndices / ReleaseEdgeIndices /
+ * DrawMeshEdges
+ * ---------------------------------------
+ * The edge VAO reads the mesh's VBO with its
+ * own index buffer, so the solid and the
+ * wireframe draw share the vertices and
+ * neither touches the polygon mode.
+ ******************************************/
+
+void ShapeMeshes::LoadEdgeIndices(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount)
+{
+	std::vector<GLuint> edges;
+	if (m_EdgeWireframes && mesh.vbo != 0)
+		BuildEdgeIndices(edges, verts, vertexFloatCount * sizeof(GLfloat) / sizeof(Vertex), indices, indexCount, m_EdgeOmitDiagonals);
+	if (edges.empty()) {
+		ReleaseEdgeIndices(mesh);
 		return;
 	}
 
-	// Draw only the selected face using indexed drawing
-	glDrawElements(GL_TRIANGLES, indicesPerFace, GL_UNSIGNED_INT, (void*)(offset * sizeof(GLuint)));
+	if (mesh.edgeVao == 0) glGenVertexArrays(1, &mesh.edgeVao);
+	glBindVertexArray(mesh.edgeVao);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+	SetShaderMemoryLayout();
+
+	if (mesh.edgeEbo == 0) glGenBuffers(1, &mesh.edgeEbo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.edgeEbo);
+	UpdateBufferData(mesh, MeshBufferStream::Edge, GL_ELEMENT_ARRAY_BUFFER, edges.size() * sizeof(GLuint), edges.data(), GL_STATIC_DRAW);
+	glBindVertexArray(0);
+
+	mesh.nEdgeIndices = static_cast<GLuint>(edges.size());
+}
+
+void ShapeMeshes::ReleaseEdgeIndices(GLMesh& mesh)
+{
+	if (mesh.edgeVao != 0) glDeleteVertexArrays(1, &mesh.edgeVao);
+	if (mesh.edgeEbo != 0) glDeleteBuffers(1, &mesh.edgeEbo);
+	m_GpuBytes -= mesh.edgeBytes;
+
+	mesh.edgeVao = 0;
+	mesh.edgeEbo = 0;
+	mesh.edgeBytes = 0;
+	mesh.nEdgeIndices = 0;
+}
 
+bool ShapeMeshes::DrawMeshEdges(const GLMesh& mesh) const
+{
+	if (mesh.nEdgeIndices == 0) return false;
+
+	glBindVertexArray(mesh.edgeVao);
+	glDrawElements(GL_LINES, static_cast<GLsizei>(mesh.nEdgeIndices), GL_UNSIGNED_INT, nullptr);
 	glBindVertexArray(0);
+	return true;
 }
 
 /******************************************
  * DrawConeMesh
  * ---------------------------------------
  * Binds the cone mesh's VAO and renders the full
- * cone. Optionally draws the bottom cap.
+ * cone. Optionally draws the bottom cap; both
+ * parts come from the cone's sub-range table,
+ * adjacent, so either way it is one draw call.
  * Supports wireframe mode.
  *
  * Params:
@@ -1689,37 +3295,23 @@ void ShapeMeshes::DrawBoxMeshSide(BoxSide side, bool wireframe) {
 
 void ShapeMeshes::DrawConeMesh(bool bDrawBottom, bool wireframe)
 {
-	if (!m_ConeMesh.vao) return;
+	const uint32_t parts = PartMask(ConePart::sides) | (bDrawBottom ? PartMask(ConePart::bottom) : 0u);
+	if (wireframe && bDrawBottom && DrawMeshEdges(m_ConeMesh)) return;
 
 	SetWireframeMode(wireframe);
-	glBindVertexArray(m_ConeMesh.vao);
-
-	int bottomCount = m_ConeMesh.numSlices * 3;       // one tri per slice
-	int sideCount = m_ConeMesh.numSlices * 3;       // same
-
-	// Disable culling if you still see a seam:
-	// glDisable(GL_CULL_FACE);
-
-	// draw bottom
-	if (bDrawBottom)
-		glDrawElements(GL_TRIANGLES, bottomCount, GL_UNSIGNED_INT, 0);
-
-	// draw sides (offset by bottom indices)
-	glDrawElements(GL_TRIANGLES,
-		sideCount,
-		GL_UNSIGNED_INT,
-		(void*)(bottomCount * sizeof(GLuint)));
-
-	// re?enable if you turned it off
-	// glEnable(GL_CULL_FACE);
-
-	glBindVertexArray(0);
+	DrawMeshParts(m_ConeMesh, parts, "Cone");
 }
 
 
 
 /**************************************
  * Draw Partial Cone Mesh
+ * ------------------------------------
+ * Spreads numSlices over the arc, so it
+ * builds its own mesh each call. To draw
+ * part of the loaded cone without
+ * generating anything, use
+ * DrawMeshArc(ArcShape::cone, ...).
  **************************************/
 void ShapeMeshes::DrawPartialConeMesh(float radius,
 	float height,
@@ -1730,56 +3322,23 @@ void ShapeMeshes::DrawPartialConeMesh(float radius,
 	// --- Validate input ---
 	if (numSlices < 3) numSlices = 3;
 	arcDegrees = glm::clamp(arcDegrees, 0.0f, 360.0f);
-
-	// --- Prepare geometry containers ---
-	std::vector<GLfloat> vertices;
-	std::vector<GLuint>  indices;
+	using namespace LatheCorner;
 
 	float arcRadians = glm::radians(arcDegrees);
-	float angleStep = arcRadians / numSlices;
 	float halfArc = arcRadians * 0.5f;
 
-	// --- Build vertices (bottom + apex) with proper normals ---
-	for (int i = 0; i <= numSlices; ++i) {
-		float angle = -halfArc + i * angleStep;
-		float x = radius * cos(angle);
-		float z = radius * sin(angle);
-		float u = float(i) / numSlices;
-		// compute correct side normal
-		glm::vec3 n = glm::normalize(glm::vec3(cos(angle), radius / height, sin(angle)));
-
-		// bottom vertex
-		vertices.insert(vertices.end(), {
-			x, 0.0f, z,               // pos
-			n.x, n.y, n.z,            // normal
-			u, 1.0f                   // uv
-			});
-		// apex vertex
-		vertices.insert(vertices.end(), {
-			0.0f, height, 0.0f,       // pos
-			n.x, n.y, n.z,            // normal
-			u, 0.0f                   // uv
-			});
-	}
-
-	// --- Build side faces as indexed triangles ---
-	// two triangles per slice
-	for (int i = 0; i < numSlices; ++i) {
-		int b0 = 2 * i;       // bottom vertex i
-		int a0 = b0 + 1;    // apex    vertex i
-		int b1 = 2 * (i + 1);   // bottom vertex i+1
-		int a1 = b1 + 1;    // apex    vertex i+1
+	// --- Bottom and apex vertex per slice, sharing the side normal ---
+	LatheSurface side;
+	side.profile = { { radius, 0.0f, 1.0f, radius / height, 1.0f }, { 0.0f, height, 1.0f, radius / height, 0.0f } };
+	// two triangles per slice: bottom(i), apex(i+1), apex(i) and bottom(i), bottom(i+1), apex(i+1)
+	side.passes = { { { 0, 1, { A0, B1, B0, A0, A1, B1 } } } };
 
-		// triangle 1: bottom(i), apex(i+1), apex(i)
-		indices.push_back(b0);
-		indices.push_back(a1);
-		indices.push_back(a0);
+	LatheMesh lathe(LatheRing::Arc(numSlices, -halfArc, arcRadians));
+	lathe.AddSurface(std::move(side));
 
-		// triangle 2: bottom(i), bottom(i+1), apex(i+1)
-		indices.push_back(b0);
-		indices.push_back(b1);
-		indices.push_back(a1);
-	}
+	std::vector<GLfloat> vertices;
+	std::vector<GLuint>  indices;
+	lathe.Build(vertices, indices);
 
 	// Optional: close ends with two triangles (uncomment to cap the open edges)
 	/*
@@ -1798,15 +3357,18 @@ void ShapeMeshes::DrawPartialConeMesh(float radius,
 	glBindVertexArray(VAO);
 
 	// vertex buffer
+	// Transient buffers are accounted for in the totals only
+	GLMesh transient;
+
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER,
+	UploadBufferData(transient, MeshBufferStream::Vertex, GL_ARRAY_BUFFER,
 		vertices.size() * sizeof(GLfloat),
 		vertices.data(),
 		GL_STATIC_DRAW);
 
 	// index buffer
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+	UploadBufferData(transient, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER,
 		indices.size() * sizeof(GLuint),
 		indices.data(),
 		GL_STATIC_DRAW);
@@ -1833,6 +3395,7 @@ void ShapeMeshes::DrawPartialConeMesh(float radius,
 	glDeleteBuffers(1, &EBO);
 	glDeleteBuffers(1, &VBO);
 	glDeleteVertexArrays(1, &VAO);
+	ReleaseBufferData(transient);
 }
 
 
@@ -1841,7 +3404,9 @@ void ShapeMeshes::DrawPartialConeMesh(float radius,
  * ---------------------------------------
  * Binds the cylinder mesh's VAO and renders the
  * cylinder's top cap, bottom cap, and sides based
- * on the given parameters.
+ * on the given parameters, from its sub-range
+ * table in a single draw call (see
+ * DrawBoxMeshSides).
  * Supports wireframe mode.
  *
  * Params:
@@ -1853,28 +3418,14 @@ void ShapeMeshes::DrawPartialConeMesh(float radius,
 
 void ShapeMeshes::DrawCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides, bool wireframe)
 {
+	const uint32_t parts = (bDrawBottom ? PartMask(CylinderPart::bottom) : 0u)
+		| (bDrawTop ? PartMask(CylinderPart::top) : 0u)
+		| (bDrawSides ? PartMask(CylinderPart::sides) : 0u);
+	if (wireframe && bDrawTop && bDrawBottom && bDrawSides && DrawMeshEdges(m_CylinderMesh)) return;
+
 	// Set wireframe mode before binding VAO
 	SetWireframeMode(wireframe);
-	glBindVertexArray(m_CylinderMesh.vao);
-
-	// **Calculate vertex counts**
-	int bottomVertexCount = m_CylinderMesh.numSlices + 2;
-	int topVertexCount = m_CylinderMesh.numSlices + 2;
-	int sideVertexCount = (m_CylinderMesh.numSlices + 1) * 2;
-
-	// **Draw bottom circle**
-	if (bDrawBottom)
-		glDrawElements(GL_TRIANGLES, m_CylinderMesh.numSlices * 3, GL_UNSIGNED_INT, 0);
-
-	// **Draw top circle**
-	if (bDrawTop)
-		glDrawElements(GL_TRIANGLES, m_CylinderMesh.numSlices * 3, GL_UNSIGNED_INT, (void*)(m_CylinderMesh.numSlices * 3 * sizeof(GLuint)));
-
-	// **Draw side faces**
-	if (bDrawSides)
-		glDrawElements(GL_TRIANGLES, m_CylinderMesh.numSlices * 6, GL_UNSIGNED_INT, (void*)((m_CylinderMesh.numSlices * 6) * sizeof(GLuint)));
-
-	glBindVertexArray(0);
+	DrawMeshParts(m_CylinderMesh, parts, "Cylinder");
 }
 
 
@@ -1974,39 +3525,189 @@ void ShapeMeshes::DrawPyramid4Mesh(bool wireframe)
 		return;
 	}
 
-	// Set polygon mode before binding the VAO
-	SetWireframeMode(wireframe);
-
-	glBindVertexArray(m_Pyramid4Mesh.vao);
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, m_Pyramid4Mesh.nVertices);
-	glBindVertexArray(0); // Unbind the VAO after drawing
+	// Set polygon mode before binding the VAO
+	SetWireframeMode(wireframe);
+
+	glBindVertexArray(m_Pyramid4Mesh.vao);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, m_Pyramid4Mesh.nVertices);
+	glBindVertexArray(0); // Unbind the VAO after drawing
+}
+
+/******************************************
+ * DrawSphereMesh
+ * ---------------------------------------
+ * Binds the sphere mesh's VAO and renders a
+ * complete sphere using indexed triangle drawing.
+ * Supports wireframe mode.
+ *
+ * Params:
+ * - wireframe: (bool) If true, renders as wireframe.
+ ******************************************/
+
+void ShapeMeshes::DrawSphereMesh(bool wireframe)
+{
+	if (wireframe && DrawMeshEdges(m_SphereMesh)) return;
+
+	SetWireframeMode(wireframe);
+	glBindVertexArray(m_SphereMesh.vao);
+	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_SphereMesh));
+	glBindVertexArray(0);
+}
+
+void ShapeMeshes::DrawHemisphereMesh(bool wireframe)
+{
+	if (wireframe && DrawMeshEdges(m_HemisphereMesh)) return;
+
+	SetWireframeMode(wireframe);
+	glBindVertexArray(m_HemisphereMesh.vao);
+	glDrawElements(GL_TRIANGLES, m_HemisphereMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_HemisphereMesh));
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * SphereBandRange
+ * ---------------------------------------
+ * Every row has 2 triangles per quad, but
+ * the pole rows of a Trimmed or Welded sphere
+ * only 1.
+ ******************************************/
+
+MeshSubRange ShapeMeshes::SphereBandRange(int latitudeSegments, int longitudeSegments, PoleMode poles, float startAngle, float endAngle)
+{
+	MeshSubRange range;
+	if (latitudeSegments < 1 || longitudeSegments < 1 || endAngle <= startAngle) return range;
+
+	const GLuint rows = static_cast<GLuint>(latitudeSegments);
+	const GLuint quadIndices = 6 * static_cast<GLuint>(longitudeSegments);
+	const bool trimmedPoles = poles != PoleMode::Duplicated && rows >= 2;
+	auto rowStart = [&](GLuint row) {
+		if (!trimmedPoles || row == 0) return row * quadIndices;
+		if (row == rows) return (rows - 1) * quadIndices;
+		return (row - 1) * quadIndices + quadIndices / 2;
+	};
+
+	const float step = Pi / latitudeSegments;
+	const float slack = 1e-4f;   // keeps an angle on a row edge from taking in the next row
+	int first = static_cast<int>(std::floor(std::max(startAngle, 0.0f) / step + slack));
+	int end = static_cast<int>(std::ceil(std::min(endAngle, Pi) / step - slack));
+	first = std::clamp(first, 0, latitudeSegments - 1);
+	end = std::clamp(end, first + 1, latitudeSegments);
+
+	range.first = rowStart(static_cast<GLuint>(first));
+	range.count = rowStart(static_cast<GLuint>(end)) - range.first;
+	return range;
+}
+
+/******************************************
+ * DrawSphereBand
+ ******************************************/
+
+void ShapeMeshes::DrawSphereBand(float startAngle, float endAngle, bool wireframe)
+{
+	if (m_SphereMesh.vao == 0 || m_SphereMesh.nIndices == 0 || m_SphereParams.latitudeSegments == 0) {
+		std::cerr << "Error: DrawSphereBand called before LoadSphereMesh." << std::endl;
+		return;
+	}
+
+	const SphereGridParams& sphere = m_SphereParams;
+	const MeshSubRange range = SphereBandRange(sphere.latitudeSegments, sphere.longitudeSegments, sphere.poles, startAngle, endAngle);
+	if (range.count == 0) return;
+
+	SetWireframeMode(wireframe);
+	glBindVertexArray(m_SphereMesh.vao);
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.count), GL_UNSIGNED_INT, IndexOffset(m_SphereMesh, range.first));
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * CanShareSphere / LoadHemisphereOnSphere /
+ * RefreshHemisphereOnSphere
+ ******************************************/
+
+bool ShapeMeshes::CanShareSphere(const SphereGridParams& hemisphere) const
+{
+	return m_SphereMesh.vbo != 0 && m_SphereMesh.sharedIndices && hemisphere == m_SphereParams
+		&& hemisphere.poles == PoleMode::Duplicated && hemisphere.latitudeSegments >= 2;
+}
+
+void ShapeMeshes::LoadHemisphereOnSphere(const SphereGridParams& hemisphere)
+{
+	ReleaseMesh(m_HemisphereMesh);
+
+	const int rows = hemisphere.latitudeSegments / 2;
+	const int cols = hemisphere.longitudeSegments;
+
+	std::vector<GLfloat> texCoords;
+	BuildHemisphereTexCoords(texCoords, hemisphere.latitudeSegments, cols);
+
+	GLMesh& mesh = m_HemisphereMesh;
+	glGenVertexArrays(1, &mesh.vao);
+	glBindVertexArray(mesh.vao);
+
+	// --- Positions and normals from the sphere's vertices ---
+	constexpr GLsizei stride = sizeof(Vertex);
+	glBindBuffer(GL_ARRAY_BUFFER, m_SphereMesh.vbo);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, position));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Vertex, normal));
+	glEnableVertexAttribArray(1);
+
+	// --- Texture coordinates of its own ---
+	glGenBuffers(1, &mesh.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+	UploadBufferData(mesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, texCoords.size() * sizeof(GLfloat), texCoords.data(), GL_STATIC_DRAW);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+	glEnableVertexAttribArray(2);
+
+	// --- The sphere's grid indices, whose first rows are the hemisphere ---
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(hemisphere.latitudeSegments);
+	topology.cols = static_cast<uint32_t>(cols);
+	topology.winding = GridWinding::Rotated;
+	BindGridIndices(mesh, topology);
+	glBindVertexArray(0);
+
+	mesh.nVertices = static_cast<GLuint>((rows + 1) * (cols + 1));
+	mesh.nIndices = static_cast<GLuint>(rows * cols * 6);
+	mesh.firstIndex = 0;
+	mesh.attributeVbo = m_SphereMesh.vbo;
+	m_HemisphereOnSphere = true;
+}
+
+void ShapeMeshes::RefreshHemisphereOnSphere()
+{
+	// Unloaded, or bound to a bundle entry
+	if (m_HemisphereMesh.vbo == 0) {
+		m_HemisphereOnSphere = false;
+		return;
+	}
+	if (!m_HemisphereOnSphere && !CanShareSphere(m_HemisphereParams)) return;
+
+	const SphereGridParams hemisphere = m_HemisphereParams;
+	LoadHemisphereMesh(hemisphere.latitudeSegments, hemisphere.longitudeSegments, hemisphere.radius, hemisphere.poles);
 }
 
 /******************************************
- * DrawSphereMesh
+ * BuildHemisphereTexCoords
  * ---------------------------------------
- * Binds the sphere mesh's VAO and renders a
- * complete sphere using indexed triangle drawing.
- * Supports wireframe mode.
- *
- * Params:
- * - wireframe: (bool) If true, renders as wireframe.
+ * The UVs GenerateHemisphereMesh writes, two
+ * floats per vertex in the same order.
  ******************************************/
 
-void ShapeMeshes::DrawSphereMesh(bool wireframe)
-{
-	SetWireframeMode(wireframe);
-	glBindVertexArray(m_SphereMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices, GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
-}
-
-void ShapeMeshes::DrawHemisphereMesh(bool wireframe)
+void ShapeMeshes::BuildHemisphereTexCoords(std::vector<GLfloat>& texCoords, int latitudeSegments, int longitudeSegments)
 {
-	SetWireframeMode(wireframe);
-	glBindVertexArray(m_HemisphereMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_HemisphereMesh.nIndices, GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
+	const int rows = latitudeSegments / 2;
+	const float slices = static_cast<float>(std::max(1, longitudeSegments));
+
+	texCoords.clear();
+	texCoords.reserve(static_cast<size_t>(rows + 1) * (longitudeSegments + 1) * 2);
+	for (int lat = 0; lat <= rows; ++lat) {
+		float v = 1.0f - float(lat) / rows;
+		for (size_t k = 0; k <= static_cast<size_t>(longitudeSegments); ++k) {
+			texCoords.push_back(1.0f - k / slices);
+			texCoords.push_back(v);
+		}
+	}
 }
 
 
@@ -2034,7 +3735,7 @@ void ShapeMeshes::DrawHalfSphereMesh(bool wireframe)
 	SetWireframeMode(wireframe);
 
 	glBindVertexArray(m_SphereMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices / 2, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_SphereMesh.nIndices / 2, GL_UNSIGNED_INT, IndexOffset(m_SphereMesh));
 	glBindVertexArray(0); // Unbind the VAO after drawing
 }
 
@@ -2136,18 +3837,18 @@ void ShapeMeshes::LoadFinMesh(float baseLength, float topLength, float height, f
 		20, 21, 22,  21, 23, 22
 	};
 
-	// Initialize VAO/VBO/EBO
-	glGenVertexArrays(1, &m_FinMesh.vao);
-	glGenBuffers(1, &m_FinMesh.vbo);
-	glGenBuffers(1, &m_FinMesh.ebo);
+	// Initialize VAO/VBO/EBO (kept on a reload)
+	if (m_FinMesh.vao == 0) glGenVertexArrays(1, &m_FinMesh.vao);
+	if (m_FinMesh.vbo == 0) glGenBuffers(1, &m_FinMesh.vbo);
+	if (m_FinMesh.ebo == 0) glGenBuffers(1, &m_FinMesh.ebo);
 
 	glBindVertexArray(m_FinMesh.vao);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_FinMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, nVertices.size() * sizeof(GLfloat), nVertices.data(), GL_STATIC_DRAW);
+	UpdateBufferData(m_FinMesh, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, nVertices.size() * sizeof(GLfloat), nVertices.data(), GL_STATIC_DRAW);
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_FinMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+	UpdateBufferData(m_FinMesh, MeshBufferStream::Index, GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
 
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0); // Position
 	glEnableVertexAttribArray(0);
@@ -2161,8 +3862,15 @@ void ShapeMeshes::LoadFinMesh(float baseLength, float topLength, float height, f
 
 	glBindVertexArray(0);
 
-	// Store index count for drawing
+	LoadEdgeIndices(m_FinMesh, nVertices.data(), nVertices.size(), indices.data(), indices.size());
+
+	// Store counts for drawing and export
+	m_FinMesh.nVertices = static_cast<GLuint>(nVertices.size() / 8);
 	m_FinMesh.nIndices = static_cast<int>(indices.size());
+
+	// One part per face, in FinFace order
+	m_FinMesh.subRanges.clear();
+	for (GLuint face = 0; face < 6; ++face) m_FinMesh.subRanges.push_back({ face * 6, 6 });
 }
 
 
@@ -2178,6 +3886,8 @@ void ShapeMeshes::LoadFinMesh(float baseLength, float topLength, float height, f
 
 void ShapeMeshes::DrawFinMesh(bool wireframe)
 {
+	if (wireframe && DrawMeshEdges(m_FinMesh)) return;
+
 	glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
 
 	glBindVertexArray(m_FinMesh.vao);
@@ -2189,29 +3899,18 @@ void ShapeMeshes::DrawFinMesh(bool wireframe)
 
 void ShapeMeshes::DrawFinSides()
 {
-	glBindVertexArray(m_FinMesh.vao);
-
-	// Front Face (first 6 indices)
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-
-	// Back Face (next 6 indices)
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(6 * sizeof(GLuint)));
-
-	glBindVertexArray(0);
+	// Front and back faces
+	DrawMeshParts(m_FinMesh, PartMask(FinFace::front) | PartMask(FinFace::back), "Fin");
 }
 
 void ShapeMeshes::DrawFinFrontOnly()
 {
-	glBindVertexArray(m_FinMesh.vao);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0); // Front face = first 6 indices
-	glBindVertexArray(0);
+	DrawMeshParts(m_FinMesh, PartMask(FinFace::front), "Fin");
 }
 
 void ShapeMeshes::DrawFinBackOnly()
 {
-	glBindVertexArray(m_FinMesh.vao);
-	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)(6 * sizeof(GLuint))); // Back face
-	glBindVertexArray(0);
+	DrawMeshParts(m_FinMesh, PartMask(FinFace::back), "Fin");
 }
 
 /******************************************
@@ -2222,13 +3921,8 @@ void ShapeMeshes::DrawFinBackOnly()
  ******************************************/
 void ShapeMeshes::DrawFinUntexturedSides()
 {
-	glBindVertexArray(m_FinMesh.vao);
-
-	// Skip first 12 indices (front and back)
-	// Top, Bottom, Left, Right = 6 indices each  4 faces = 24 indices
-	glDrawElements(GL_TRIANGLES, 24, GL_UNSIGNED_INT, (void*)(12 * sizeof(GLuint)));
-
-	glBindVertexArray(0);
+	DrawMeshParts(m_FinMesh, PartMask(FinFace::top) | PartMask(FinFace::bottom)
+		| PartMask(FinFace::left) | PartMask(FinFace::right), "Fin");
 }
 
 /******************************************
@@ -2236,7 +3930,8 @@ void ShapeMeshes::DrawFinUntexturedSides()
  * ---------------------------------------
  * Binds the tapered cylinder mesh's VAO and renders
  * the top cap, bottom cap, and sides based on the
- * given parameters.
+ * given parameters, in a single draw call like
+ * DrawCylinderMesh.
  * Supports wireframe mode.
  *
  * Params:
@@ -2247,29 +3942,13 @@ void ShapeMeshes::DrawFinUntexturedSides()
  ******************************************/
 void ShapeMeshes::DrawTaperedCylinderMesh(bool bDrawTop, bool bDrawBottom, bool bDrawSides, bool wireframe)
 {
-	SetWireframeMode(wireframe);
-	glBindVertexArray(m_TaperedCylinderMesh.vao);
-
-	const int n = m_TaperedCylinderMesh.numSlices;
-
-	const GLsizei bottomCount = n * 3; // numSlices triangles * 3 indices
-	const GLsizei topCount = n * 3;
-	const GLsizei sideCount = n * 6;
-
-	const size_t bottomOff = 0;
-	const size_t topOff = bottomCount;
-	const size_t sideOff = bottomCount + topCount;
+	const uint32_t parts = (bDrawBottom ? PartMask(CylinderPart::bottom) : 0u)
+		| (bDrawTop ? PartMask(CylinderPart::top) : 0u)
+		| (bDrawSides ? PartMask(CylinderPart::sides) : 0u);
+	if (wireframe && bDrawTop && bDrawBottom && bDrawSides && DrawMeshEdges(m_TaperedCylinderMesh)) return;
 
-	if (bDrawBottom)
-		glDrawElements(GL_TRIANGLES, bottomCount, GL_UNSIGNED_INT, (void*)(sizeof(GLuint) * bottomOff));
-
-	if (bDrawTop)
-		glDrawElements(GL_TRIANGLES, topCount, GL_UNSIGNED_INT, (void*)(sizeof(GLuint) * topOff));
-
-	if (bDrawSides)
-		glDrawElements(GL_TRIANGLES, sideCount, GL_UNSIGNED_INT, (void*)(sizeof(GLuint) * sideOff));
-
-	glBindVertexArray(0);
+	SetWireframeMode(wireframe);
+	DrawMeshParts(m_TaperedCylinderMesh, parts, "Tapered cylinder");
 }
 
 
@@ -2292,11 +3971,13 @@ void ShapeMeshes::DrawTorusMesh(bool wireframe)
 		return;
 	}
 
+	if (wireframe && DrawMeshEdges(m_TorusMesh)) return;
+
 	// Set polygon mode before binding the VAO
 	SetWireframeMode(wireframe);
 
 	glBindVertexArray(m_TorusMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_TorusMesh.nIndices, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_TorusMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_TorusMesh));
 	glBindVertexArray(0);
 }
 
@@ -2334,7 +4015,8 @@ void ShapeMeshes::DrawExtraTorusMesh2()
  * ---------------------------------------
  * Binds the torus mesh's VAO and renders only
  * the upper half of the torus using indexed
- * triangle drawing.
+ * triangle drawing. DrawMeshArc draws any
+ * other range the same way.
  * Supports wireframe mode.
  *
  * Params:
@@ -2353,7 +4035,104 @@ void ShapeMeshes::DrawHalfTorusMesh(bool wireframe)
 	SetWireframeMode(wireframe);
 
 	glBindVertexArray(m_TorusMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_TorusMesh.nIndices / 2, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_TorusMesh.nIndices / 2, GL_UNSIGNED_INT, IndexOffset(m_TorusMesh));
+	glBindVertexArray(0);
+}
+
+/******************************************
+ * ArcLayoutFor
+ * ---------------------------------------
+ * Blocks in the order each generator adds
+ * its lathe parts (see GenerateXMesh).
+ ******************************************/
+
+ArcLayout ShapeMeshes::ArcLayoutFor(ArcShape shape, int slices, size_t indexCount)
+{
+	ArcLayout layout;
+	layout.slices = std::max(3, slices);
+	const GLuint n = static_cast<GLuint>(layout.slices);
+
+	switch (shape) {
+	case ArcShape::cone:
+		layout.blocks = { { 0, 3, true }, { 3 * n, 3, false } };
+		break;
+	case ArcShape::cylinder:
+	case ArcShape::taperedCylinder:
+		layout.blocks = { { 0, 3, true }, { 3 * n, 3, true }, { 6 * n, 6, false } };
+		break;
+	case ArcShape::tube:
+		// Walls, then end rings: two bands per slice in each pass
+		layout.blocks = { { 0, 12, false }, { 12 * n, 12, true } };
+		break;
+	case ArcShape::torus:
+		// One grid row of tube quads per main segment
+		layout.blocks = { { 0, static_cast<GLuint>(indexCount / n), false } };
+		break;
+	}
+	return layout;
+}
+
+/******************************************
+ * ArcIndexRanges
+ ******************************************/
+
+void ShapeMeshes::ArcIndexRanges(std::vector<MeshSubRange>& ranges, const ArcLayout& layout, float startAngle, float endAngle, bool drawCaps)
+{
+	ranges.clear();
+	const float span = endAngle - startAngle;
+	if (layout.slices <= 0 || span <= 0.0f) return;
+
+	const float turn = 2.0f * Pi;
+	const float step = turn / layout.slices;
+	const float slack = 1e-4f;   // keeps an angle on a slice edge from taking in the next slice
+
+	GLuint first = 0;
+	GLuint count = static_cast<GLuint>(layout.slices);
+	if (span < turn) {
+		float start = std::fmod(startAngle, turn);
+		if (start < 0.0f) start += turn;
+
+		int firstSlice = std::min(static_cast<int>(std::floor(start / step + slack)), layout.slices - 1);
+		int endSlice = static_cast<int>(std::ceil((start + span) / step - slack));
+		first = static_cast<GLuint>(firstSlice);
+		count = static_cast<GLuint>(std::clamp(endSlice - firstSlice, 1, layout.slices));
+	}
+
+	// Slices past the last one wrap to the start of the block
+	const GLuint head = std::min(count, static_cast<GLuint>(layout.slices) - first);
+	for (const ArcBlock& block : layout.blocks) {
+		if (block.cap && !drawCaps) continue;
+		ranges.push_back({ block.firstIndex + first * block.indicesPerSlice, head * block.indicesPerSlice });
+		if (count > head)
+			ranges.push_back({ block.firstIndex, (count - head) * block.indicesPerSlice });
+	}
+}
+
+/******************************************
+ * DrawMeshArc
+ ******************************************/
+
+void ShapeMeshes::DrawMeshArc(ArcShape shape, float startAngle, float endAngle, bool drawCaps, bool wireframe)
+{
+	GLMesh* mesh = nullptr;
+	switch (shape) {
+	case ArcShape::cone:            mesh = &m_ConeMesh; break;
+	case ArcShape::cylinder:        mesh = &m_CylinderMesh; break;
+	case ArcShape::taperedCylinder: mesh = &m_TaperedCylinderMesh; break;
+	case ArcShape::tube:            mesh = &m_TubeMesh; break;
+	case ArcShape::torus:           mesh = &m_TorusMesh; break;
+	}
+
+	if (mesh == nullptr || mesh->vao == 0 || mesh->nIndices == 0 || mesh->numSlices <= 0) {
+		std::cerr << "Error: DrawMeshArc called for a mesh that is not loaded." << std::endl;
+		return;
+	}
+
+	ArcIndexRanges(m_ArcRanges, ArcLayoutFor(shape, mesh->numSlices, mesh->nIndices), startAngle, endAngle, drawCaps);
+
+	SetWireframeMode(wireframe);
+	glBindVertexArray(mesh->vao);
+	DrawIndexRanges(*mesh, m_ArcRanges);
 	glBindVertexArray(0);
 }
 
@@ -2373,11 +4152,12 @@ void ShapeMeshes::DrawSpringMesh(bool wireframe)
 		std::cerr << "Error: Spring mesh not initialized properly." << std::endl;
 		return;
 	}
+	if (wireframe && DrawMeshEdges(m_SpringMesh)) return;
 
 	SetWireframeMode(wireframe);
 
 	glBindVertexArray(m_SpringMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_SpringMesh.nIndices, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_SpringMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_SpringMesh));
 	glBindVertexArray(0);
 }
 
@@ -2396,11 +4176,12 @@ void ShapeMeshes::DrawTubeMesh(bool wireframe) const
 		std::cerr << "Error: Tube mesh not initialized properly." << std::endl;
 		return;
 	}
+	if (wireframe && DrawMeshEdges(m_TubeMesh)) return;
 
 	SetWireframeMode(wireframe);
 
 	glBindVertexArray(m_TubeMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_TubeMesh.nIndices, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_TubeMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_TubeMesh));
 	glBindVertexArray(0);
 }
 
@@ -2429,7 +4210,7 @@ void ShapeMeshes::DrawConeMeshLines() {
 		std::cerr << "Warning: DrawConeMeshLines() is deprecated. Use DrawConeMesh(true) instead.\n";
 		coneWarned = true;
 	}
-	DrawConeMesh(true);
+	DrawConeMesh(true, true);
 }
 
 void ShapeMeshes::DrawCylinderMeshLines() {
@@ -2437,7 +4218,7 @@ void ShapeMeshes::DrawCylinderMeshLines() {
 		std::cerr << "Warning: DrawCylinderMeshLines() is deprecated. Use DrawCylinderMesh(true) instead.\n";
 		cylinderWarned = true;
 	}
-	DrawCylinderMesh(true);
+	DrawCylinderMesh(true, true, true, true);
 }
 
 void ShapeMeshes::DrawPlaneMeshLines() {
@@ -2493,7 +4274,7 @@ void ShapeMeshes::DrawTaperedCylinderMeshLines() {
 		std::cerr << "Warning: DrawTaperedCylinderMeshLines() is deprecated. Use DrawTaperedCylinderMesh(true) instead.\n";
 		taperedCylinderWarned = true;
 	}
-	DrawTaperedCylinderMesh(true);
+	DrawTaperedCylinderMesh(true, true, true, true);
 }
 
 void ShapeMeshes::DrawTorusMeshLines() {
@@ -2673,87 +4454,48 @@ void ShapeMeshes::LoadCurvedConeMesh(int numSlices, int curveSteps, float radius
 	m_CurvedConeMesh.numSlices = numSlices;
 	m_CurvedConeMesh.curveSteps = curveSteps;
 
-	// Interleaved vertex buffer and index buffer
-	std::vector<GLfloat> verts;
-	std::vector<GLuint> indices;
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(std::max(1, curveSteps));
+	topology.cols = static_cast<uint32_t>(std::max(3, numSlices));
+
+	LoadGeneratedMesh(m_CurvedConeMesh, MeshCacheKey::Make(MeshGeneratorId::CurvedCone, { float(numSlices), float(curveSteps), radius, height, bendRadius }),
+		[&](MeshData& data) { GenerateCurvedConeMesh(data, numSlices, curveSteps, radius, height, bendRadius); }, &topology);
+}
+
+void ShapeMeshes::GenerateCurvedConeMesh(MeshData& mesh, int numSlices, int curveSteps, float radius, float height, float bendRadius)
+{
+	mesh.Clear();
+
+	// Ensure minimum valid geometry
+	if (numSlices < 3) numSlices = 3;
+	if (curveSteps < 1) curveSteps = 1;
 
-	// Angle between radial slices
-	float angleStep = 2.0f * Pi / static_cast<float>(numSlices);
 	// Total bend angle of the arc (height mapped onto circular arc)
 	float bendAngle = height / bendRadius;
 
-	// Generate rings along the curved centerline
+	// Circular-arc centerline in the XY plane with its analytic tangent
+	std::vector<SweepFrame> frames(static_cast<size_t>(curveSteps) + 1);
 	for (int step = 0; step <= curveSteps; ++step) {
-		float t = static_cast<float>(step) / curveSteps;  // normalized arc parameter
-		float arcTheta = t * bendAngle;  // angle along the bend
-
-		// Compute center point on the circular arc
-		float centerX = bendRadius * sin(arcTheta);
-		float centerY = bendRadius * (1.0f - cos(arcTheta));
-		float centerZ = 0.0f;
-
-		// Tangent direction along the arc
-		glm::vec3 tangent(cos(arcTheta), sin(arcTheta), 0.0f);
-		// Perpendicular direction used to orient the cone's circular cross-section
-		glm::vec3 normalDir = glm::normalize(glm::vec3(-tangent.y, tangent.x, 0.0f));
-
-		// Linearly shrinking radius from base to tip
-		float coneRadius = radius * (1.0f - t);
-
-		// Sweep a circle around the local frame
-		for (int slice = 0; slice <= numSlices; ++slice) {
-			float angle = slice * angleStep;
-			// Local circle coordinates
-			float localX = coneRadius * cos(angle);
-			float localZ = coneRadius * sin(angle);
-
-			// Offset from centerline using local frame
-			glm::vec3 offset = normalDir * localX + glm::vec3(0.0f, 0.0f, localZ);
-			// Final vertex position
-			glm::vec3 position = glm::vec3(centerX, centerY, centerZ) + offset;
-
-			// Approximate normal: direction away from centerline
-			glm::vec3 normal = glm::normalize(offset);
-
-			// UV coordinates: slice index -> U, arc progression -> V
-			float u = static_cast<float>(slice) / numSlices;
-			float v = t;
-
-			// Pack vertex: position (3), normal (3), UV (2)
-			verts.push_back(position.x);
-			verts.push_back(position.y);
-			verts.push_back(position.z);
-			verts.push_back(normal.x);
-			verts.push_back(normal.y);
-			verts.push_back(normal.z);
-			verts.push_back(u);
-			verts.push_back(v);
-		}
+		float arcTheta = (static_cast<float>(step) / curveSteps) * bendAngle;  // angle along the bend
+		frames[step].center = glm::vec3(bendRadius * sin(arcTheta), bendRadius * (1.0f - cos(arcTheta)), 0.0f);
+		frames[step].tangent = glm::vec3(cos(arcTheta), sin(arcTheta), 0.0f);
+		frames[step].along = static_cast<float>(step) / curveSteps;
 	}
 
-	// Build triangle indices between adjacent rings
-	for (int step = 0; step < curveSteps; ++step) {
-		for (int slice = 0; slice < numSlices; ++slice) {
-			int current = step * (numSlices + 1) + slice;
-			int next = (step + 1) * (numSlices + 1) + slice;
-
-			// First triangle
-			indices.push_back(current);
-			indices.push_back(next);
-			indices.push_back(current + 1);
+	// The arc is planar, so the transported binormal stays on +Z.
+	MeshSweep::ComputeFrames(frames, glm::vec3(0.0f, 0.0f, 1.0f));
 
-			// Second triangle
-			indices.push_back(current + 1);
-			indices.push_back(next);
-			indices.push_back(next + 1);
-		}
-	}
+	// Linearly shrinking radius from base to tip; slices around U, the arc along V
+	mesh.vertices.reserve(frames.size() * (numSlices + 1) * 8);
+	MeshSweep::AppendSweepRings(mesh.vertices, frames, SweepProfile::Circle(numSlices, true),
+		[radius, curveSteps](size_t step) { return radius * (1.0f - static_cast<float>(step) / curveSteps); });
 
-	// Upload mesh to GPU using centralized initializer
-	InitializeMesh(m_CurvedConeMesh, verts, indices);
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(curveSteps);
+	topology.cols = static_cast<uint32_t>(numSlices);
+	BuildGridIndices(mesh.indices, topology);
 }
 
-
 /******************************************
  * DrawCurvedConeMesh
  * ---------------------------------------
@@ -2763,7 +4505,7 @@ void ShapeMeshes::LoadCurvedConeMesh(int numSlices, int curveSteps, float radius
 void ShapeMeshes::DrawCurvedConeMesh()
 {
 	glBindVertexArray(m_CurvedConeMesh.vao);
-	glDrawElements(GL_TRIANGLES, m_CurvedConeMesh.nIndices, GL_UNSIGNED_INT, nullptr);
+	glDrawElements(GL_TRIANGLES, m_CurvedConeMesh.nIndices, GL_UNSIGNED_INT, IndexOffset(m_CurvedConeMesh));
 	glBindVertexArray(0);
 }
 
@@ -2812,9 +4554,9 @@ void ShapeMeshes::LoadTaperedTorusMesh()
 {
 	// Allocate VAO, VBO, and EBO once.
 	// Vertex/index data will be uploaded in DrawTaperedTorusMesh().
-	glGenVertexArrays(1, &m_TaperedTorusMesh.vao);
-	glGenBuffers(1, &m_TaperedTorusMesh.vbo);
-	glGenBuffers(1, &m_TaperedTorusMesh.ebo);
+	if (m_TaperedTorusMesh.vao == 0) glGenVertexArrays(1, &m_TaperedTorusMesh.vao);
+	if (m_TaperedTorusMesh.vbo == 0) glGenBuffers(1, &m_TaperedTorusMesh.vbo);
+	if (m_TaperedTorusMesh.ebo == 0) glGenBuffers(1, &m_TaperedTorusMesh.ebo);
 }
 
 void ShapeMeshes::DrawTaperedTorusMesh(
@@ -2825,10 +4567,44 @@ void ShapeMeshes::DrawTaperedTorusMesh(
 	int tubeSegments,
 	float sweepAngleRadians)
 {
-	// Interleaved vertex buffer and index buffer
-	std::vector<GLfloat> verts;
-	std::vector<GLuint> indices;
+	// Indices depend only on the segment counts; the radii and sweep only move vertices.
+	const size_t maxVertices = static_cast<size_t>(std::max(0, mainSegments + 1)) * std::max(0, tubeSegments + 1);
+	const size_t maxIndices = static_cast<size_t>(std::max(0, mainSegments)) * std::max(0, tubeSegments) * 6;
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(std::max(0, mainSegments));
+	topology.cols = static_cast<uint32_t>(std::max(0, tubeSegments));
+
+	DrawDynamicMesh(m_TaperedTorusMesh, m_TaperedTorusState,
+		StreamKey::Make({ float(mainSegments), float(tubeSegments) }),
+		StreamKey::Make({ mainRadius, tubeRadiusStart, tubeRadiusEnd, float(mainSegments), float(tubeSegments), sweepAngleRadians }),
+		maxVertices, maxIndices, &topology,
+		[&](auto& verts, auto& indices) {
+			BuildTaperedTorusMesh(verts, indices, mainRadius, tubeRadiusStart, tubeRadiusEnd, mainSegments, tubeSegments, sweepAngleRadians);
+		});
+}
+
+void ShapeMeshes::GenerateTaperedTorusMesh(MeshData& mesh,
+	float mainRadius,
+	float tubeRadiusStart,
+	float tubeRadiusEnd,
+	int mainSegments,
+	int tubeSegments,
+	float sweepAngleRadians)
+{
+	mesh.Clear();
+	BuildTaperedTorusMesh(mesh.vertices, mesh.indices, mainRadius, tubeRadiusStart, tubeRadiusEnd, mainSegments, tubeSegments, sweepAngleRadians);
+}
 
+template <typename VertexArray, typename IndexArray>
+void ShapeMeshes::BuildTaperedTorusMesh(VertexArray& verts, IndexArray& indices,
+	float mainRadius,
+	float tubeRadiusStart,
+	float tubeRadiusEnd,
+	int mainSegments,
+	int tubeSegments,
+	float sweepAngleRadians)
+{
 	// Angular increments for main ring and tube
 	float mainStep = sweepAngleRadians / mainSegments;
 	float tubeStep = 2.0f * Pi / tubeSegments;
@@ -2886,27 +4662,6 @@ void ShapeMeshes::DrawTaperedTorusMesh(
 			indices.push_back(next + 1);
 		}
 	}
-
-	// Upload to GPU (dynamic draw pattern)
-	glBindVertexArray(m_TaperedTorusMesh.vao);
-
-	glBindBuffer(GL_ARRAY_BUFFER, m_TaperedTorusMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), verts.data(), GL_DYNAMIC_DRAW);
-
-	// Vertex attribute layout: position (0), normal (1), UV (2)
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0); // position
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat))); // normal
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat))); // UV
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_TaperedTorusMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_DYNAMIC_DRAW);
-
-	// Draw the tapered torus
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
 }
 
 /******************************************
@@ -2924,6 +4679,13 @@ void ShapeMeshes::DrawTaperedTorusMesh(
  *   - numLoops:       number of spiral turns
  *   - tubeSegments:   number of segments around tube
  *   - spiralSegments: number of segments along spiral
+ *   - chordTolerance: 0 for evenly spaced rings;
+ *     otherwise rings are placed so the tube's
+ *     centerline stays within this distance of
+ *     the spiral, denser at the tight inner turn
+ *     and sparser outside, never more rings than
+ *     spiralSegments gives. Drawn with the CPU
+ *     generator even with compute generation on.
  *
  * The centerline is computed first, producing a
  * sequence of points along an expanding spiral.
@@ -2948,9 +4710,9 @@ void ShapeMeshes::DrawTaperedTorusMesh(
 
 void ShapeMeshes::LoadSpiralMesh() {
 	// Allocate VAO/VBO/EBO once; geometry is uploaded in DrawSpiralMesh().
-	glGenVertexArrays(1, &m_SpiralMesh.vao);
-	glGenBuffers(1, &m_SpiralMesh.vbo);
-	glGenBuffers(1, &m_SpiralMesh.ebo);
+	if (m_SpiralMesh.vao == 0) glGenVertexArrays(1, &m_SpiralMesh.vao);
+	if (m_SpiralMesh.vbo == 0) glGenBuffers(1, &m_SpiralMesh.vbo);
+	if (m_SpiralMesh.ebo == 0) glGenBuffers(1, &m_SpiralMesh.ebo);
 }
 
 void ShapeMeshes::DrawSpiralMesh(
@@ -2959,28 +4721,89 @@ void ShapeMeshes::DrawSpiralMesh(
 	float loopSpacing,
 	float numLoops,
 	int tubeSegments,
-	int spiralSegments
+	int spiralSegments,
+	float chordTolerance
 ) {
-	std::vector<GLfloat> verts;
-	std::vector<GLuint> indices;
+	// The ring count comes from numLoops and spiralSegments, so both are
+	// topology; placed by tolerance it also depends on the curve's shape.
+	// At most spiralSegments + 1 rings, plus the 8-ring cap.
+	const size_t maxVertices = static_cast<size_t>(std::max(0, spiralSegments + 1 + 8)) * std::max(0, tubeSegments);
+	const size_t maxIndices = static_cast<size_t>(std::max(0, spiralSegments + 8)) * std::max(0, tubeSegments) * 6;
+	const StreamKey indexKey = chordTolerance > 0.0f
+		? StreamKey::Make({ numLoops, float(tubeSegments), float(spiralSegments), loopSpacing, chordTolerance })
+		: StreamKey::Make({ numLoops, float(tubeSegments), float(spiralSegments) });
+	const StreamKey vertexKey = StreamKey::Make({ tubeRadius, flattenFactor, loopSpacing, numLoops, float(tubeSegments), float(spiralSegments), chordTolerance });
+
+	if (m_ComputeGeneration && chordTolerance <= 0.0f) {
+		DrawComputedMesh(m_SpiralMesh, m_SpiralState, indexKey, vertexKey, [&](ComputeMeshParams& params) {
+			GenerateSpiralFrames(m_ComputeFrames, loopSpacing, numLoops, spiralSegments);
+			params = ComputeMeshParams::Spiral(tubeRadius, flattenFactor, tubeSegments, m_ComputeFrames.size());
+		});
+		return;
+	}
+
+	DrawDynamicMesh(m_SpiralMesh, m_SpiralState, indexKey, vertexKey,
+		maxVertices, maxIndices, nullptr,   // rings plus a stitched cap; not a plain grid
+		[&](auto& verts, auto& indices) {
+			BuildSpiralMesh(verts, indices, tubeRadius, flattenFactor, loopSpacing, numLoops, tubeSegments, spiralSegments, chordTolerance);
+		});
+}
+
+void ShapeMeshes::GenerateSpiralMesh(MeshData& mesh,
+	float tubeRadius,
+	float flattenFactor,
+	float loopSpacing,
+	float numLoops,
+	int tubeSegments,
+	int spiralSegments,
+	float chordTolerance
+) {
+	mesh.Clear();
+	BuildSpiralMesh(mesh.vertices, mesh.indices, tubeRadius, flattenFactor, loopSpacing, numLoops, tubeSegments, spiralSegments, chordTolerance);
+}
+
+/******************************************
+ * SpiralCenterline / GenerateSpiralFrames
+ * ---------------------------------------
+ * The spiral's centerline, one entry per
+ * ring: center, finite-difference tangent,
+ * and a rotation-minimizing frame seeded with
+ * its binormal on +Z. Each frame depends on
+ * the one before it, so this stays on the CPU
+ * even for compute generation; it is
+ * O(rings), not O(vertices).
+ *
+ * With a chordTolerance the rings are placed
+ * on SpiralCurve, which runs over the same
+ * angles, and take the curve's own tangent.
+ ******************************************/
+
+void ShapeMeshes::SpiralCenterline(std::vector<SweepFrame>& frames, float loopSpacing, float numLoops, int spiralSegments, float chordTolerance)
+{
+	frames.clear();
+
+	if (chordTolerance > 0.0f) {
+		int uniformSegments = 0;
+		SweepCurve curve = SpiralCurve(loopSpacing, numLoops, spiralSegments, uniformSegments);
+		if (uniformSegments < 1) return;
+
+		std::vector<float> angles;
+		MeshSweep::AdaptiveParameters(angles, curve, chordTolerance, uniformSegments, 0.5f * 3.14159265f);
+		MeshSweep::SampleCenterline(frames, curve, angles);
+		MeshSweep::ComputeFrames(frames, glm::vec3(0.0f, 0.0f, 1.0f));
+		return;
+	}
 
 	const float PI = 3.14159265f;
 	// Total angular sweep of the spiral
 	float totalAngle = numLoops * 2.0f * PI;
-	// Step size along spiral and around tube
+	// Step size along spiral
 	float spiralStep = totalAngle / spiralSegments;
-	float tubeStep = 2.0f * PI / tubeSegments;
 
 	// Start halfway around the circle to create a partial-loop effect
 	float startAngle = PI;
 	int startSegment = static_cast<int>(startAngle / spiralStep);
 
-	// Up direction for flattening and frame construction
-	glm::vec3 worldUp(1.0f, 0.0f, 0.0f); // Flatten along X axis
-
-	std::vector<glm::vec3> centers;
-	std::vector<glm::vec3> tangents;
-
 	// --- Generate spiral centerline with partial loop support ---
 	for (int i = startSegment; i <= spiralSegments; ++i) {
 		float theta = i * spiralStep;
@@ -2989,113 +4812,220 @@ void ShapeMeshes::DrawSpiralMesh(
 		// Spiral radius increases with angle
 		float radius = loopSpacing * theta / (2.0f * PI);
 		// Center point on spiral
-		centers.push_back(glm::vec3(radius * cos(theta), radius * sin(theta), 0.0f));
+		SweepFrame frame;
+		frame.center = glm::vec3(radius * cos(theta), radius * sin(theta), 0.0f);
+		frames.push_back(frame);
 	}
 
-	int ringCount = static_cast<int>(centers.size());
-
-	// --- Compute tangent vectors along the centerline ---
-	for (int i = 0; i < ringCount; ++i) {
-		glm::vec3 tangent;
-		if (i == 0) {
-			tangent = glm::normalize(centers[1] - centers[0]);
-		}
-		else if (i == ringCount - 1) {
-			tangent = glm::normalize(centers[ringCount - 1] - centers[ringCount - 2]);
-		}
-		else {
-			tangent = glm::normalize(centers[i + 1] - centers[i - 1]);
-		}
-		tangents.push_back(tangent);
+	if (frames.size() < 2) {
+		frames.clear();
+		return;
 	}
 
-	int ringStride = tubeSegments;
-	glm::vec3 prevNormal, prevBinormal;
-	std::vector<GLuint> ringStartIndices;
+	for (size_t i = 0; i < frames.size(); ++i)
+		frames[i].along = static_cast<float>(i) / static_cast<float>(frames.size() - 1);
 
-	// --- Generate tube rings along the spiral ---
-	for (int i = 0; i < ringCount; ++i) {
-		float sweepT = static_cast<float>(i) / (ringCount - 1);
-		glm::vec3 center = centers[i];
-		glm::vec3 tangent = tangents[i];
+	MeshSweep::FiniteDifferenceTangents(frames);
+	MeshSweep::ComputeFrames(frames, glm::vec3(0.0f, 0.0f, 1.0f));
+}
 
-		glm::vec3 normal, binormal;
-		// Construct local frame
-		if (i == 0) {
-			// Initial frame from worldUp
-			binormal = glm::normalize(glm::cross(tangent, worldUp));
-			normal = glm::normalize(glm::cross(binormal, tangent));
-		}
-		else {
-			// Rotate previous frame to align with new tangent
-			glm::vec3 v = tangents[i - 1];
-			glm::vec3 w = tangent;
-			glm::vec3 axis = glm::normalize(glm::cross(v, w));
-			float angle = acos(glm::clamp(glm::dot(v, w), -1.0f, 1.0f));
-			glm::mat3 rot = glm::mat3(glm::rotate(glm::mat4(1.0f), angle, axis));
-			normal = glm::normalize(rot * prevNormal);
-			binormal = glm::normalize(glm::cross(tangent, normal));
-		}
+/******************************************
+ * SpiralCurve
+ * ---------------------------------------
+ * The spiral r = loopSpacing * theta / 2 pi
+ * over the angles the even rings cover, from
+ * the first whole step past half a turn to
+ * numLoops turns; uniformSegments is the
+ * number of even steps between them.
+ ******************************************/
 
-		prevNormal = normal;
-		prevBinormal = binormal;
+SweepCurve ShapeMeshes::SpiralCurve(float loopSpacing, float numLoops, int spiralSegments, int& uniformSegments)
+{
+	const float PI = 3.14159265f;
+	SweepCurve curve;
+	uniformSegments = 0;
+	if (spiralSegments < 1) return curve;
+
+	const float totalAngle = numLoops * 2.0f * PI;
+	const float spiralStep = totalAngle / spiralSegments;
+	const int startSegment = static_cast<int>(PI / spiralStep);
+
+	uniformSegments = spiralSegments - startSegment;
+	curve.t0 = startSegment * spiralStep;
+	curve.t1 = totalAngle;
+	curve.position = [loopSpacing, PI](float theta) {
+		float radius = loopSpacing * theta / (2.0f * PI);
+		return glm::vec3(radius * std::cos(theta), radius * std::sin(theta), 0.0f);
+	};
+	return curve;
+}
 
-		// Sweep tube around the ring
-		for (int j = 0; j < tubeSegments; ++j) {
-			float phi = j * tubeStep;
-			float x = cos(phi);
-			float y = sin(phi);
+SweepSamplingReport ShapeMeshes::ReportSpiralSampling(float loopSpacing, float numLoops, int tubeSegments, int spiralSegments, float chordTolerance)
+{
+	int uniformSegments = 0;
+	SweepCurve curve = SpiralCurve(loopSpacing, numLoops, spiralSegments, uniformSegments);
+	if (uniformSegments < 1) return SweepSamplingReport();
 
-			// Offset from center using local frame
-			glm::vec3 offset = x * normal * (1.0f - flattenFactor) + y * binormal;
-			glm::vec3 position = center + offset * tubeRadius;
-			glm::vec3 normalVec = glm::normalize(offset);
+	std::vector<float> angles;
+	MeshSweep::AdaptiveParameters(angles, curve, chordTolerance, uniformSegments, 0.5f * 3.14159265f);
+	return MeshSweep::CompareSampling(curve, angles, uniformSegments, static_cast<size_t>(std::max(0, tubeSegments)));
+}
 
-			float u = static_cast<float>(j) / tubeSegments;
-			float v = sweepT;
+void ShapeMeshes::GenerateSpiralFrames(std::vector<SpiralFrame>& frames, float loopSpacing, float numLoops, int spiralSegments)
+{
+	std::vector<SweepFrame> sweep;
+	SpiralCenterline(sweep, loopSpacing, numLoops, spiralSegments);
+
+	frames.clear();
+	frames.reserve(sweep.size());
+	for (const SweepFrame& frame : sweep) {
+		frames.push_back({
+			{ frame.center.x, frame.center.y, frame.center.z, 1.0f },
+			{ frame.tangent.x, frame.tangent.y, frame.tangent.z, 0.0f },
+			{ frame.normal.x, frame.normal.y, frame.normal.z, 0.0f },
+			{ frame.binormal.x, frame.binormal.y, frame.binormal.z, 0.0f } });
+	}
+}
 
-			// Pack vertex: position (3), normal (3), UV (2)
-			verts.push_back(position.x);
-			verts.push_back(position.y);
-			verts.push_back(position.z);
-			verts.push_back(normalVec.x);
-			verts.push_back(normalVec.y);
-			verts.push_back(normalVec.z);
-			verts.push_back(u);
-			verts.push_back(v);
-		}
+/******************************************
+ * GenerateSweepMesh
+ * ---------------------------------------
+ * Samples the curve, transports a frame
+ * along it and sweeps a seamed circle, so
+ * the result is a Duplicated-seam grid of
+ * (ringCount - 1) x segments.
+ ******************************************/
 
-		// Store first ring indices for cap stitching
-		if (i == 0) {
-			for (int j = 0; j < tubeSegments; ++j) {
-				ringStartIndices.push_back(j);
-			}
-		}
-	}
+void ShapeMeshes::GenerateSweepMesh(MeshData& mesh, const std::function<glm::vec3(float)>& curve, int ringCount, int segments,
+	const std::function<float(float)>& radius, const glm::vec3& up)
+{
+	mesh.Clear();
 
-	// --- Connect tube rings with triangles ---
-	for (int i = 0; i < ringCount - 1; ++i) {
-		for (int j = 0; j < tubeSegments; ++j) {
-			int curr = i * ringStride + j;
-			int next = (i + 1) * ringStride + j;
-			int currNext = i * ringStride + (j + 1) % tubeSegments;
-			int nextNext = (i + 1) * ringStride + (j + 1) % tubeSegments;
+	ringCount = std::max(2, ringCount);
+	segments = std::max(3, segments);
 
-			indices.push_back(curr);
-			indices.push_back(next);
-			indices.push_back(currNext);
+	std::vector<SweepFrame> frames;
+	MeshSweep::SampleCenterline(frames, curve, ringCount);
+	MeshSweep::ComputeFrames(frames, up);
 
-			indices.push_back(currNext);
-			indices.push_back(next);
-			indices.push_back(nextNext);
-		}
+	const float lastRing = static_cast<float>(ringCount - 1);
+	mesh.vertices.reserve(frames.size() * (segments + 1) * 8);
+	MeshSweep::AppendSweepRings(mesh.vertices, frames, SweepProfile::Circle(segments, true),
+		[&radius, lastRing](size_t ring) { return radius(static_cast<float>(ring) / lastRing); });
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(ringCount - 1);
+	topology.cols = static_cast<uint32_t>(segments);
+	BuildGridIndices(mesh.indices, topology);
+}
+
+/******************************************
+ * GenerateLatheMesh
+ * ---------------------------------------
+ * Each point's normal averages the outward
+ * normals of the profile segments on either
+ * side of it. A zero-length segment counts
+ * for neither, so a repeated point splits the
+ * shading into a crease.
+ ******************************************/
+
+void ShapeMeshes::GenerateLatheMesh(MeshData& mesh, const std::vector<glm::vec2>& profile, int numSlices,
+	bool capBottom, bool capTop, float arcDegrees)
+{
+	mesh.Clear();
+	if (profile.size() < 2) {
+		std::cerr << "Error: A lathe profile needs at least two points." << std::endl;
+		return;
+	}
+	if (numSlices < 3) numSlices = 3;
+	arcDegrees = glm::clamp(arcDegrees, 0.0f, 360.0f);
+	using namespace LatheCorner;
+
+	const size_t count = profile.size();
+
+	// Outward normal of each segment (travel turned clockwise) and the length along the profile
+	std::vector<glm::vec2> segmentNormals(count - 1);
+	std::vector<float> distance(count, 0.0f);
+	for (size_t j = 0; j + 1 < count; ++j) {
+		glm::vec2 d = profile[j + 1] - profile[j];
+		float length = std::sqrt(glm::dot(d, d));
+		segmentNormals[j] = length > 0.0f ? glm::vec2(d.y / length, -d.x / length) : glm::vec2(0.0f);
+		distance[j + 1] = distance[j] + length;
+	}
+	const float total = distance[count - 1] > 0.0f ? distance[count - 1] : 1.0f;
+
+	LatheSurface surface;
+	surface.profile.reserve(count);
+	for (size_t j = 0; j < count; ++j) {
+		glm::vec2 normal(0.0f);
+		if (j > 0) normal = normal + segmentNormals[j - 1];
+		if (j + 1 < count) normal = normal + segmentNormals[j];
+		surface.profile.push_back({ profile[j].x, profile[j].y, normal.x, normal.y, 1.0f - distance[j] / total });
 	}
 
+	// CCW as seen from the side the normals face
+	surface.passes.emplace_back();
+	for (uint32_t j = 0; j + 1 < count; ++j)
+		surface.passes[0].push_back({ j, j + 1, { A0, B0, A1, A1, B0, B1 } });
+
+	float arcRadians = glm::radians(arcDegrees);
+	LatheMesh lathe(arcDegrees < 360.0f ? LatheRing::Arc(numSlices, -arcRadians * 0.5f, arcRadians) : LatheRing::Full(numSlices, true));
+
+	// Caps face down at the first point and up at the last
+	const glm::vec2& first = profile.front();
+	const glm::vec2& last = profile.back();
+	if (capBottom && first.x > 0.0f) {
+		LatheFan bottom;
+		bottom.center = { 0.0f, first.y, 0.0f, -1.0f, 0.5f };
+		bottom.rim = { first.x, first.y, 0.0f, -1.0f, 0.5f };
+		lathe.AddFan(bottom);
+	}
+	if (capTop && last.x > 0.0f) {
+		LatheFan top;
+		top.center = { 0.0f, last.y, 0.0f, 1.0f, 0.5f };
+		top.rim = { last.x, last.y, 0.0f, 1.0f, 0.5f };
+		top.reverse = true;
+		lathe.AddFan(top);
+	}
+
+	lathe.AddSurface(std::move(surface));
+	lathe.Build(mesh.vertices, mesh.indices);
+}
+
+template <typename VertexArray, typename IndexArray>
+void ShapeMeshes::BuildSpiralMesh(VertexArray& verts, IndexArray& indices,
+	float tubeRadius,
+	float flattenFactor,
+	float loopSpacing,
+	float numLoops,
+	int tubeSegments,
+	int spiralSegments,
+	float chordTolerance
+) {
+	const float PI = 3.14159265f;
+	float tubeStep = 2.0f * PI / tubeSegments;
+
+	std::vector<SweepFrame> frames;
+	SpiralCenterline(frames, loopSpacing, numLoops, spiralSegments, chordTolerance);
+	if (frames.size() < 2) return;   // no tube to sweep
+
+	// --- Tube rings along the spiral, flattened along each ring's normal ---
+	MeshSweep::AppendSweepRings(verts, frames, SweepProfile::Ellipse(tubeSegments, false, 1.0f - flattenFactor, 1.0f),
+		[tubeRadius](size_t) { return tubeRadius; });
+
+	// --- Connect tube rings with triangles; ring i starts at i * tubeSegments ---
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(frames.size() - 1);
+	topology.cols = static_cast<uint32_t>(tubeSegments);
+	topology.seam = GridSeam::Wrapped;
+	BuildGridIndices(indices, topology);
+
 	// --- Hemisphere cap at start of spiral ---
-	glm::vec3 capCenter = centers[0];
-	glm::vec3 capTangent = tangents[0];
-	glm::vec3 capBinormal = glm::normalize(glm::cross(capTangent, worldUp));
-	glm::vec3 capNormal = glm::normalize(glm::cross(capBinormal, capTangent));
+	// Built from the first ring's frame so its last ring meets ring 0.
+	glm::vec3 capCenter = frames[0].center;
+	glm::vec3 capTangent = frames[0].tangent;
+	glm::vec3 capBinormal = frames[0].binormal;
+	glm::vec3 capNormal = frames[0].normal;
 
 	int capRings = 8;
 	int capSegments = tubeSegments;
@@ -3151,9 +5081,9 @@ void ShapeMeshes::DrawSpiralMesh(
 	// --- Connect hemisphere to first tube ring ---
 	for (int j = 0; j < capSegments; ++j) {
 		int capRing = baseIndex + (capRings - 1) * capSegments + j;
-		int tubeRing = ringStartIndices[j];
+		int tubeRing = j;
 		int capNext = baseIndex + (capRings - 1) * capSegments + (j + 1) % capSegments;
-		int tubeNext = ringStartIndices[(j + 1) % capSegments];
+		int tubeNext = (j + 1) % capSegments;
 
 		indices.push_back(capRing);
 		indices.push_back(tubeRing);
@@ -3163,27 +5093,6 @@ void ShapeMeshes::DrawSpiralMesh(
 		indices.push_back(tubeRing);
 		indices.push_back(tubeNext);
 	}
-
-	// --- Upload mesh to GPU ---
-	glBindVertexArray(m_SpiralMesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, m_SpiralMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), verts.data(), GL_DYNAMIC_DRAW);
-
-	// Vertex attribute layout: position (0), normal (1), UV (2)
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_SpiralMesh.ebo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_SpiralMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_DYNAMIC_DRAW);
-
-	// Draw the spiral mesh
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
 }
 
 
@@ -3226,9 +5135,9 @@ void ShapeMeshes::DrawSpiralMesh(
 
 void ShapeMeshes::LoadSineConeMesh() {
 	// Allocate VAO/VBO/EBO once; geometry is uploaded in DrawSineConeMesh().
-	glGenVertexArrays(1, &m_SineConeMesh.vao);
-	glGenBuffers(1, &m_SineConeMesh.vbo);
-	glGenBuffers(1, &m_SineConeMesh.ebo);
+	if (m_SineConeMesh.vao == 0) glGenVertexArrays(1, &m_SineConeMesh.vao);
+	if (m_SineConeMesh.vbo == 0) glGenBuffers(1, &m_SineConeMesh.vbo);
+	if (m_SineConeMesh.ebo == 0) glGenBuffers(1, &m_SineConeMesh.ebo);
 }
 
 void ShapeMeshes::DrawSineConeMesh(
@@ -3241,8 +5150,56 @@ void ShapeMeshes::DrawSineConeMesh(
 	int radialSegments,
 	int heightSegments
 ) {
-	std::vector<GLfloat> verts;
-	std::vector<GLuint> indices;
+	// Indices depend only on the segment counts; the sine wave only moves vertices.
+	const size_t maxVertices = static_cast<size_t>(std::max(0, heightSegments + 1)) * std::max(0, radialSegments + 1);
+	const size_t maxIndices = static_cast<size_t>(std::max(0, heightSegments)) * std::max(0, radialSegments) * 6;
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(std::max(0, heightSegments));
+	topology.cols = static_cast<uint32_t>(std::max(0, radialSegments));
+
+	const StreamKey indexKey = StreamKey::Make({ float(radialSegments), float(heightSegments) });
+	const StreamKey vertexKey = StreamKey::Make({ baseRadius, height, flattenFactor, sineAmplitude, sineFrequency, sinePhase, float(radialSegments), float(heightSegments) });
+
+	if (m_ComputeGeneration) {
+		DrawComputedMesh(m_SineConeMesh, m_SineConeState, indexKey, vertexKey, [&](ComputeMeshParams& params) {
+			params = ComputeMeshParams::SineCone(baseRadius, height, flattenFactor, sineAmplitude, sineFrequency, sinePhase, radialSegments, heightSegments);
+		});
+		return;
+	}
+
+	DrawDynamicMesh(m_SineConeMesh, m_SineConeState, indexKey, vertexKey,
+		maxVertices, maxIndices, &topology,
+		[&](auto& verts, auto& indices) {
+			BuildSineConeMesh(verts, indices, baseRadius, height, flattenFactor, sineAmplitude, sineFrequency, sinePhase, radialSegments, heightSegments);
+		});
+}
+
+void ShapeMeshes::GenerateSineConeMesh(MeshData& mesh,
+	float baseRadius,
+	float height,
+	float flattenFactor,
+	float sineAmplitude,
+	float sineFrequency,
+	float sinePhase,
+	int radialSegments,
+	int heightSegments
+) {
+	mesh.Clear();
+	BuildSineConeMesh(mesh.vertices, mesh.indices, baseRadius, height, flattenFactor, sineAmplitude, sineFrequency, sinePhase, radialSegments, heightSegments);
+}
+
+template <typename VertexArray, typename IndexArray>
+void ShapeMeshes::BuildSineConeMesh(VertexArray& verts, IndexArray& indices,
+	float baseRadius,
+	float height,
+	float flattenFactor,
+	float sineAmplitude,
+	float sineFrequency,
+	float sinePhase,
+	int radialSegments,
+	int heightSegments
+) {
 	std::vector<glm::vec3> positions;
 	std::vector<glm::vec3> normals;
 
@@ -3340,26 +5297,6 @@ void ShapeMeshes::DrawSineConeMesh(
 		verts.push_back(u);
 		verts.push_back(v);
 	}
-
-	// --- Upload mesh to GPU ---
-	glBindVertexArray(m_SineConeMesh.vao);
-	glBindBuffer(GL_ARRAY_BUFFER, m_SineConeMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), verts.data(), GL_DYNAMIC_DRAW);
-
-	// Vertex attribute layout: position (0), normal (1), UV (2)
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(2);
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_SineConeMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_DYNAMIC_DRAW);
-
-	// Draw the sine-deformed cone
-	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, nullptr);
-	glBindVertexArray(0);
 }
 
 /******************************************
@@ -3471,9 +5408,9 @@ void ShapeMeshes::DrawSineConeMesh(
 void ShapeMeshes::LoadSuperellipsoidMesh()
 {
 	// Allocate VAO/VBO/EBO once; data will be uploaded in DrawSuperellipsoidMesh.
-	glGenVertexArrays(1, &m_SuperellipsoidMesh.vao);
-	glGenBuffers(1, &m_SuperellipsoidMesh.vbo);
-	glGenBuffers(1, &m_SuperellipsoidMesh.ebo);
+	if (m_SuperellipsoidMesh.vao == 0) glGenVertexArrays(1, &m_SuperellipsoidMesh.vao);
+	if (m_SuperellipsoidMesh.vbo == 0) glGenBuffers(1, &m_SuperellipsoidMesh.vbo);
+	if (m_SuperellipsoidMesh.ebo == 0) glGenBuffers(1, &m_SuperellipsoidMesh.ebo);
 }
 
 void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
@@ -3482,14 +5419,127 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 	float verticalExponent,
 	float horizontalExponent,
 	int   uSegments,
-	int   vSegments)
+	int   vSegments,
+	PoleMode poles)
 {
+	// Store segment count if needed later
+	m_SuperellipsoidMesh.numSlices = std::max(3, vSegments);
+
+	// Indices depend only on the (clamped) segment counts; the scales and
+	// exponents only move vertices.
+	const size_t u = static_cast<size_t>(std::max(3, uSegments));
+	const size_t v = static_cast<size_t>(std::max(3, vSegments));
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(u);
+	topology.cols = static_cast<uint32_t>(v);
+
+	if (poles != PoleMode::Duplicated) {
+		// Trimmed and welded grids are built on the CPU with private indices.
+		// Which triangles are dropped depends on the exponents, so every
+		// parameter is part of the topology.
+		const StreamKey key = StreamKey::Make({ scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, float(u), float(v), float(poles) });
+
+		DrawDynamicMesh(m_SuperellipsoidMesh, m_SuperellipsoidState, key, key,
+			(u + 1) * (v + 1), u * v * 6, nullptr,
+			[&](auto& verts, auto& indices) {
+				MeshData grid;
+				GenerateSuperellipsoidMesh(grid, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uSegments, vSegments, poles);
+				for (GLfloat value : grid.vertices) verts.push_back(value);
+				for (GLuint index : grid.indices) indices.push_back(index);
+				m_SuperellipsoidMesh.removedTriangles = grid.removedTriangles;
+			});
+		return;
+	}
 
-	// --- 1. Validate and clamp parameters ---
+	m_SuperellipsoidMesh.removedTriangles = 0;
+
+	const StreamKey indexKey = StreamKey::Make({ float(u), float(v) });
+	const StreamKey vertexKey = StreamKey::Make({ scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, float(u), float(v) });
+
+	if (m_ComputeGeneration) {
+		DrawComputedMesh(m_SuperellipsoidMesh, m_SuperellipsoidState, indexKey, vertexKey, [&](ComputeMeshParams& params) {
+			params = ComputeMeshParams::Superellipsoid(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uSegments, vSegments);
+		});
+		return;
+	}
+
+	DrawDynamicMesh(m_SuperellipsoidMesh, m_SuperellipsoidState, indexKey, vertexKey,
+		(u + 1) * (v + 1), u * v * 6, &topology,
+		[&](auto& verts, auto& indices) {
+			BuildSuperellipsoidMesh(verts, indices, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uSegments, vSegments);
+		});
+}
+
+void ShapeMeshes::GenerateSuperellipsoidMesh(MeshData& mesh,
+	float scaleX,
+	float scaleY,
+	float scaleZ,
+	float verticalExponent,
+	float horizontalExponent,
+	int   uSegments,
+	int   vSegments,
+	PoleMode poles)
+{
+	mesh.Clear();
+	BuildSuperellipsoidMesh(mesh.vertices, mesh.indices, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uSegments, vSegments);
+
+	// Row 0 is u = -PI/2 and the last row u = PI/2
+	mesh.removedTriangles = static_cast<GLuint>(ApplyPoleMode(mesh, static_cast<uint32_t>(std::max(3, vSegments)), true, true, poles));
+}
+
+template <typename VertexArray, typename IndexArray>
+void ShapeMeshes::BuildSuperellipsoidMesh(VertexArray& verts, IndexArray& indices,
+	float scaleX,
+	float scaleY,
+	float scaleZ,
+	float verticalExponent,
+	float horizontalExponent,
+	int   uSegments,
+	int   vSegments)
+{
+	// --- 1. Validate and clamp segment counts ---
 
 	if (uSegments < 3) uSegments = 3;
 	if (vSegments < 3) vSegments = 3;
 
+	// Even steps through u and v, as fractions of their ranges
+	std::vector<float> uParams(uSegments + 1);
+	std::vector<float> vParams(vSegments + 1);
+	for (int i = 0; i <= uSegments; ++i)
+		uParams[i] = static_cast<float>(i) / static_cast<float>(uSegments);
+	for (int j = 0; j <= vSegments; ++j)
+		vParams[j] = static_cast<float>(j) / static_cast<float>(vSegments);
+
+	BuildSuperellipsoidGrid(verts, indices, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uParams, vParams);
+}
+
+/******************************************
+ * BuildSuperellipsoidGrid
+ * ---------------------------------------
+ * One grid row per entry of uParams and one
+ * column per entry of vParams, each a
+ * fraction of its range (0 at u = -PI/2 or
+ * v = -PI, 1 at the other end), which is
+ * also the vertex's texture coordinate.
+ ******************************************/
+
+template <typename VertexArray, typename IndexArray>
+void ShapeMeshes::BuildSuperellipsoidGrid(VertexArray& verts, IndexArray& indices,
+	float scaleX,
+	float scaleY,
+	float scaleZ,
+	float verticalExponent,
+	float horizontalExponent,
+	const std::vector<float>& uParams,
+	const std::vector<float>& vParams)
+{
+	const int uSegments = static_cast<int>(uParams.size()) - 1;
+	const int vSegments = static_cast<int>(vParams.size()) - 1;
+	if (uSegments < 1 || vSegments < 1) return;
+
+	// --- 1. Validate and clamp parameters ---
+
 	if (scaleX <= 0.0f) scaleX = 0.1f;
 	if (scaleY <= 0.0f) scaleY = 0.1f;
 	if (scaleZ <= 0.0f) scaleZ = 0.1f;
@@ -3497,9 +5547,6 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 	if (verticalExponent <= 0.0f)   verticalExponent = 0.1f;
 	if (horizontalExponent <= 0.0f) horizontalExponent = 0.1f;
 
-	// Store segment count if needed later
-	m_SuperellipsoidMesh.numSlices = vSegments;
-
 
 	// --- 2. Precompute angle tables ---
 
@@ -3513,7 +5560,7 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 	// u in [-PI/2, PI/2]
 	for (int i = 0; i <= uSegments; ++i)
 	{
-		float t = static_cast<float>(i) / static_cast<float>(uSegments);
+		float t = uParams[i];
 		float u = -PI * 0.5f + t * PI;
 		cosU[i] = std::cos(u);
 		sinU[i] = std::sin(u);
@@ -3522,7 +5569,7 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 	// v in [-PI, PI]
 	for (int j = 0; j <= vSegments; ++j)
 	{
-		float t = static_cast<float>(j) / static_cast<float>(vSegments);
+		float t = vParams[j];
 		float v = -PI + t * (2.0f * PI);
 		cosV[j] = std::cos(v);
 		sinV[j] = std::sin(v);
@@ -3530,9 +5577,6 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 
 	// --- 3. Prepare vertex/index buffers ---
 
-	std::vector<GLfloat> verts;
-	std::vector<GLuint>  indices;
-
 	verts.reserve((uSegments + 1) * (vSegments + 1) * 8);
 	indices.reserve(uSegments * vSegments * 6);
 
@@ -3576,8 +5620,8 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 			normal = glm::normalize(normal);
 
 			// UV coordinates: simple cylindrical-style mapping
-			float uCoord = static_cast<float>(j) / static_cast<float>(vSegments);
-			float vCoord = static_cast<float>(i) / static_cast<float>(uSegments);
+			float uCoord = vParams[j];
+			float vCoord = uParams[i];
 
 			// Interleaved vertex: position (3), normal (3), UV (2)
 			verts.push_back(x);
@@ -3615,38 +5659,523 @@ void ShapeMeshes::DrawSuperellipsoidMesh(float scaleX,
 			indices.push_back(idx3);
 		}
 	}
+}
 
-	m_SuperellipsoidMesh.nVertices = static_cast<GLuint>(verts.size() / 8);
-	m_SuperellipsoidMesh.nIndices = static_cast<GLuint>(indices.size());
+/******************************************
+ * Adaptive Superellipsoid
+ * ---------------------------------------
+ * The surface is (sx f.x g.x, sy f.x g.y,
+ * sz f.y), with f the latitude superellipse
+ * in u and g the longitude one in v, so a
+ * grid is as true as its two profiles. Each
+ * is sampled as a curve of its grid fraction
+ * t with MeshSweep::AdaptiveParameters, a
+ * quarter at a time: f's quarters mirror
+ * about the equator, g's about both axes.
+ ******************************************/
+
+namespace
+{
+	// sgn(x) * |x|^exponent, as the superellipsoid generators apply it
+	inline float SignedPower(float x, float exponent)
+	{
+		return static_cast<float>((x > 0.0f) - (x < 0.0f)) * std::pow(std::fabs(x), exponent);
+	}
 
+	void ClampSuperellipsoidShape(float& scaleX, float& scaleY, float& scaleZ, float& verticalExponent, float& horizontalExponent)
+	{
+		if (scaleX <= 0.0f) scaleX = 0.1f;
+		if (scaleY <= 0.0f) scaleY = 0.1f;
+		if (scaleZ <= 0.0f) scaleZ = 0.1f;
+		if (verticalExponent <= 0.0f)   verticalExponent = 0.1f;
+		if (horizontalExponent <= 0.0f) horizontalExponent = 0.1f;
+	}
 
-	// --- 6. Upload to GPU and draw ---
+	/******************************************
+	 * SuperellipsoidProfiles
+	 * ---------------------------------------
+	 * Both profiles over their whole range, t
+	 * from 0 to 1 as the grid maps it. The
+	 * latitude profile is drawn at the widest
+	 * horizontal radius the longitude profile
+	 * reaches, where its chords stray furthest.
+	 ******************************************/
+
+	void SuperellipsoidProfiles(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+		SweepCurve& latitude, SweepCurve& longitude)
+	{
+		const float PI = 3.14159265359f;
 
-	glBindVertexArray(m_SuperellipsoidMesh.vao);
+		longitude.position = [=](float t) {
+			float v = -PI + t * (2.0f * PI);
+			return glm::vec3(scaleX * SignedPower(std::cos(v), horizontalExponent), scaleY * SignedPower(std::sin(v), horizontalExponent), 0.0f);
+		};
 
-	glBindBuffer(GL_ARRAY_BUFFER, m_SuperellipsoidMesh.vbo);
-	glBufferData(GL_ARRAY_BUFFER,
-		verts.size() * sizeof(GLfloat),
-		verts.data(),
-		GL_DYNAMIC_DRAW);
+		float horizontal = 0.0f;
+		for (int k = 0; k <= 64; ++k) {
+			glm::vec3 p = longitude.position(0.5f + 0.25f * k / 64.0f);
+			horizontal = std::max(horizontal, std::sqrt(glm::dot(p, p)));
+		}
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)0);                    // position
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(3 * sizeof(GLfloat))); // normal
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(GLfloat), (void*)(6 * sizeof(GLfloat))); // UV
-	glEnableVertexAttribArray(2);
+		latitude.position = [=](float t) {
+			float u = -PI * 0.5f + t * PI;
+			return glm::vec3(horizontal * SignedPower(std::cos(u), verticalExponent), 0.0f, scaleZ * SignedPower(std::sin(u), verticalExponent));
+		};
+	}
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_SuperellipsoidMesh.ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-		indices.size() * sizeof(GLuint),
-		indices.data(),
-		GL_DYNAMIC_DRAW);
+	// Distance from p to triangle abc (Ericson, Real-Time Collision Detection, 5.1.5).
+	float DistanceToTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+	{
+		auto distance = [&p](const glm::vec3& q) {
+			glm::vec3 d = p - q;
+			return std::sqrt(glm::dot(d, d));
+		};
+
+		const glm::vec3 ab = b - a;
+		const glm::vec3 ac = c - a;
+		const float d1 = glm::dot(ab, p - a);
+		const float d2 = glm::dot(ac, p - a);
+		if (d1 <= 0.0f && d2 <= 0.0f) return distance(a);
+
+		const float d3 = glm::dot(ab, p - b);
+		const float d4 = glm::dot(ac, p - b);
+		if (d3 >= 0.0f && d4 <= d3) return distance(b);
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f && d1 - d3 > 0.0f)
+			return distance(a + ab * (d1 / (d1 - d3)));
+
+		const float d5 = glm::dot(ab, p - c);
+		const float d6 = glm::dot(ac, p - c);
+		if (d6 >= 0.0f && d5 <= d6) return distance(c);
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f && d2 - d6 > 0.0f)
+			return distance(a + ac * (d2 / (d2 - d6)));
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f && (d4 - d3) + (d5 - d6) > 0.0f)
+			return distance(b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+
+		const float area = va + vb + vc;
+		if (area <= 0.0f) return distance(a);   // degenerate: a collapsed pole triangle
+		return distance(a + ab * (vb / area) + ac * (vc / area));
+	}
+}
 
-	glDrawElements(GL_TRIANGLES,
-		static_cast<GLsizei>(indices.size()),
-		GL_UNSIGNED_INT,
-		nullptr);
+void ShapeMeshes::SuperellipsoidParameters(std::vector<float>& uParams, std::vector<float>& vParams, float scaleX, float scaleY, float scaleZ,
+	float verticalExponent, float horizontalExponent, float maxError)
+{
+	ClampSuperellipsoidShape(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent);
+
+	SweepCurve latitude;
+	SweepCurve longitude;
+	SuperellipsoidProfiles(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, latitude, longitude);
+
+	// Half the error to each profile; at most 256 segments a quarter
+	const float profileError = 0.5f * maxError;
+	const int maxQuarterSegments = 256;
+	std::vector<float> quarter;
+
+	// u from the equator to the top pole, mirrored below the equator
+	latitude.t0 = 0.5f;
+	latitude.t1 = 1.0f;
+	MeshSweep::AdaptiveParameters(quarter, latitude, profileError, maxQuarterSegments, 0.5f);
+
+	uParams.clear();
+	uParams.reserve(2 * quarter.size() - 1);
+	for (size_t k = quarter.size() - 1; k > 0; --k)
+		uParams.push_back(1.0f - quarter[k]);
+	uParams.insert(uParams.end(), quarter.begin(), quarter.end());
+
+	// v from 0 to PI/2; the other quarters are its copies mirrored through
+	// the origin, across the x axis and across the y axis
+	longitude.t0 = 0.5f;
+	longitude.t1 = 0.75f;
+	MeshSweep::AdaptiveParameters(quarter, longitude, profileError, maxQuarterSegments, 0.25f);
+
+	const size_t last = quarter.size() - 1;
+	vParams.clear();
+	vParams.reserve(4 * last + 1);
+	for (size_t k = 0; k <= last; ++k)
+		vParams.push_back(quarter[k] - 0.5f);
+	for (size_t k = last; k-- > 0;)
+		vParams.push_back(1.0f - quarter[k]);
+	for (size_t k = 1; k <= last; ++k)
+		vParams.push_back(quarter[k]);
+	for (size_t k = last; k-- > 0;)
+		vParams.push_back(1.5f - quarter[k]);
+
+	uParams.front() = 0.0f;
+	uParams.back() = 1.0f;
+	vParams.front() = 0.0f;
+	vParams.back() = 1.0f;
+}
+
+/******************************************
+ * SuperellipsoidSurfaceError
+ * ---------------------------------------
+ * Probes every cell at 15 points of its
+ * parameter square, edges included, and
+ * takes the distance from each true surface
+ * point to the nearer of the cell's two
+ * triangles: an upper bound on its distance
+ * to the mesh.
+ ******************************************/
+
+float ShapeMeshes::SuperellipsoidSurfaceError(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+	const std::vector<float>& uParams, const std::vector<float>& vParams)
+{
+	ClampSuperellipsoidShape(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent);
+	if (uParams.size() < 2 || vParams.size() < 2) return 0.0f;
+
+	const float PI = 3.14159265359f;
+	const int probes = 4;
+	const size_t rows = uParams.size() - 1;
+	const size_t cols = vParams.size() - 1;
+
+	// Profile factors at every probe: probe a of row i is entry i * probes + a,
+	// and the final entry is the last row (column) itself.
+	auto sample = [probes](const std::vector<float>& params, auto factor) {
+		const size_t cells = params.size() - 1;
+		std::vector<glm::vec2> table(cells * probes + 1);
+		for (size_t i = 0; i < cells; ++i)
+			for (int a = 0; a < probes; ++a)
+				table[i * probes + a] = factor(params[i] + (params[i + 1] - params[i]) * (static_cast<float>(a) / probes));
+		table[cells * probes] = factor(params[cells]);
+		return table;
+	};
+	const std::vector<glm::vec2> f = sample(uParams, [&](float t) {
+		float u = -PI * 0.5f + t * PI;
+		return glm::vec2(SignedPower(std::cos(u), verticalExponent), SignedPower(std::sin(u), verticalExponent));
+	});
+	const std::vector<glm::vec2> g = sample(vParams, [&](float t) {
+		float v = -PI + t * (2.0f * PI);
+		return glm::vec2(SignedPower(std::cos(v), horizontalExponent), SignedPower(std::sin(v), horizontalExponent));
+	});
+
+	auto point = [&](size_t uProbe, size_t vProbe) {
+		const glm::vec2& a = f[uProbe];
+		const glm::vec2& b = g[vProbe];
+		return glm::vec3(scaleX * a.x * b.x, scaleY * a.x * b.y, scaleZ * a.y);
+	};
+
+	float error = 0.0f;
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			const size_t r = i * probes;
+			const size_t c = j * probes;
+			const glm::vec3 p00 = point(r, c);
+			const glm::vec3 p10 = point(r + probes, c);
+			const glm::vec3 p01 = point(r, c + probes);
+			const glm::vec3 p11 = point(r + probes, c + probes);
+
+			for (int a = 0; a < probes; ++a) {
+				for (int b = 0; b < probes; ++b) {
+					if (a == 0 && b == 0) continue;
+					glm::vec3 p = point(r + a, c + b);
+					float distance = std::min(DistanceToTriangle(p, p00, p10, p01), DistanceToTriangle(p, p01, p10, p11));
+					error = std::max(error, distance);
+				}
+			}
+		}
+	}
+	return error;
+}
+
+void ShapeMeshes::DrawAdaptiveSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, float maxError)
+{
+	if (maxError <= 0.0f) {
+		std::cerr << "Error: Adaptive superellipsoid needs a positive maxError." << std::endl;
+		return;
+	}
+
+	// Placing the samples walks both profiles, so it is redone only when the shape changes.
+	const StreamKey shapeKey = StreamKey::Make({ scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, maxError });
+	if (m_AdaptiveSuperellipsoidU.empty() || !(m_AdaptiveSuperellipsoidKey == shapeKey)) {
+		SuperellipsoidParameters(m_AdaptiveSuperellipsoidU, m_AdaptiveSuperellipsoidV, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, maxError);
+		m_AdaptiveSuperellipsoidKey = shapeKey;
+	}
+
+	const size_t u = m_AdaptiveSuperellipsoidU.size() - 1;
+	const size_t v = m_AdaptiveSuperellipsoidV.size() - 1;
+	m_SuperellipsoidMesh.numSlices = static_cast<int>(v);
+
+	GridTopology topology;
+	topology.rows = static_cast<uint32_t>(u);
+	topology.cols = static_cast<uint32_t>(v);
+
+	// Same grid, same indices as the uniform mesh of that size; the shape key
+	// has fewer entries than the uniform vertex key, so the two never match.
+	const StreamKey indexKey = StreamKey::Make({ float(u), float(v) });
+
+	DrawDynamicMesh(m_SuperellipsoidMesh, m_SuperellipsoidState, indexKey, shapeKey,
+		(u + 1) * (v + 1), u * v * 6, &topology,
+		[&](auto& verts, auto& indices) {
+			BuildSuperellipsoidGrid(verts, indices, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent,
+				m_AdaptiveSuperellipsoidU, m_AdaptiveSuperellipsoidV);
+		});
+}
+
+void ShapeMeshes::GenerateAdaptiveSuperellipsoidMesh(MeshData& mesh, float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, float maxError)
+{
+	mesh.Clear();
+	if (maxError <= 0.0f) {
+		std::cerr << "Error: Adaptive superellipsoid needs a positive maxError." << std::endl;
+		return;
+	}
+
+	std::vector<float> uParams;
+	std::vector<float> vParams;
+	SuperellipsoidParameters(uParams, vParams, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, maxError);
+	BuildSuperellipsoidGrid(mesh.vertices, mesh.indices, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uParams, vParams);
+}
+
+/******************************************
+ * ReportSuperellipsoidTessellation
+ * ---------------------------------------
+ * Matching each profile's chord error gives
+ * the uniform grid's proportions; both of its
+ * counts are then scaled together to the
+ * fewest segments whose measured surface
+ * error is no worse than the adaptive grid's.
+ ******************************************/
+
+SuperellipsoidTessellationReport ShapeMeshes::ReportSuperellipsoidTessellation(float scaleX, float scaleY, float scaleZ,
+	float verticalExponent, float horizontalExponent, float maxError)
+{
+	SuperellipsoidTessellationReport report;
+	report.maxError = maxError;
+	if (maxError <= 0.0f) return report;
+
+	std::vector<float> uParams;
+	std::vector<float> vParams;
+	SuperellipsoidParameters(uParams, vParams, scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, maxError);
+	report.uSegments = static_cast<int>(uParams.size()) - 1;
+	report.vSegments = static_cast<int>(vParams.size()) - 1;
+	report.surfaceError = SuperellipsoidSurfaceError(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uParams, vParams);
+
+	float sx = scaleX, sy = scaleY, sz = scaleZ, e1 = verticalExponent, e2 = horizontalExponent;
+	ClampSuperellipsoidShape(sx, sy, sz, e1, e2);
+	SweepCurve latitude;
+	SweepCurve longitude;
+	SuperellipsoidProfiles(sx, sy, sz, e1, e2, latitude, longitude);
+
+	const float uProfile = static_cast<float>(MeshSweep::CompareSampling(latitude, uParams, report.uSegments, 0).uniformRings - 1);
+	const float vProfile = static_cast<float>(MeshSweep::CompareSampling(longitude, vParams, report.vSegments, 0).uniformRings - 1);
+
+	// DrawSuperellipsoidMesh takes no fewer than 3 segments either way
+	std::vector<float> uniformU;
+	std::vector<float> uniformV;
+	auto measure = [&](float scale) {
+		report.uniformUSegments = std::max(3, static_cast<int>(std::lround(uProfile * scale)));
+		report.uniformVSegments = std::max(3, static_cast<int>(std::lround(vProfile * scale)));
+		MeshSweep::UniformParameters(uniformU, latitude, report.uniformUSegments);
+		MeshSweep::UniformParameters(uniformV, longitude, report.uniformVSegments);
+		report.uniformSurfaceError = SuperellipsoidSurfaceError(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uniformU, uniformV);
+		return report.uniformSurfaceError <= report.surfaceError;
+	};
+
+	float low = 0.25f;
+	float high = 1.0f;
+	while (!measure(high) && high < 16.0f)
+		high *= 2.0f;
+	for (int iteration = 0; iteration < 10; ++iteration) {
+		float middle = 0.5f * (low + high);
+		if (measure(middle))
+			high = middle;
+		else
+			low = middle;
+	}
+	measure(high);
+	return report;
+}
+
+/******************************************
+ * Procedural Grid Meshes
+ * ---------------------------------------
+ * Vertex pulling: the program registered with
+ * SetProceduralProgram() evaluates every
+ * vertex from gl_VertexID, so these draws
+ * bind an empty VAO and a shared grid index
+ * buffer and upload nothing but uniforms.
+ ******************************************/
+
+bool ShapeMeshes::SetProceduralProgram(GLuint program)
+{
+	ProceduralGridUniforms uniforms;
+	if (!uniforms.Locate(program)) return false;
+
+	m_ProceduralUniforms = uniforms;
+	return true;
+}
+
+void ShapeMeshes::DrawProceduralSphereMesh(int latitudeSegments, int longitudeSegments, float radius, bool wireframe)
+{
+	DrawProceduralGrid(m_ProceduralSphere, ProceduralGridParams::Sphere(latitudeSegments, longitudeSegments, radius), wireframe);
+}
+
+void ShapeMeshes::DrawProceduralHemisphereMesh(int latitudeSegments, int longitudeSegments, float radius, bool wireframe)
+{
+	DrawProceduralGrid(m_ProceduralHemisphere, ProceduralGridParams::Hemisphere(latitudeSegments, longitudeSegments, radius), wireframe);
+}
+
+void ShapeMeshes::DrawProceduralTorusMesh(float mainRadius, float tubeRadius, int mainSegments, int tubeSegments, bool wireframe)
+{
+	DrawProceduralGrid(m_ProceduralTorus, ProceduralGridParams::Torus(mainRadius, tubeRadius, mainSegments, tubeSegments), wireframe);
+}
+
+void ShapeMeshes::DrawProceduralSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+	int uSegments, int vSegments, bool wireframe)
+{
+	DrawProceduralGrid(m_ProceduralSuperellipsoid,
+		ProceduralGridParams::Superellipsoid(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent, uSegments, vSegments), wireframe);
+}
+
+/******************************************
+ * DrawProceduralGrid
+ * ---------------------------------------
+ * Binds the grid's shared index buffer to its
+ * VAO only when the topology changes; the
+ * sphere and hemisphere use the Rotated
+ * order their generators emit.
+ ******************************************/
+
+void ShapeMeshes::DrawProceduralGrid(ProceduralGridMesh& grid, const ProceduralGridParams& params, bool wireframe)
+{
+	if (!m_ProceduralUniforms.IsValid()) {
+		if (!m_ProceduralWarned) {
+			std::cerr << "Warning: procedural meshes need SetProceduralProgram() first; nothing is drawn." << std::endl;
+			m_ProceduralWarned = true;
+		}
+		return;
+	}
+
+	GridTopology topology;
+	topology.rows = params.rows;
+	topology.cols = params.cols;
+	topology.winding = params.shape == ProceduralShape::Sphere ? GridWinding::Rotated : GridWinding::Standard;
+	if (topology.IndexCount() == 0) return;
+
+	if (grid.mesh.vao == 0) glGenVertexArrays(1, &grid.mesh.vao);
+	glBindVertexArray(grid.mesh.vao);
+
+	if (!grid.mesh.sharedIndices || !(grid.topology == topology)) {
+		BindGridIndices(grid.mesh, topology);
+		grid.mesh.nIndices = static_cast<GLuint>(topology.IndexCount());
+		grid.topology = topology;
+	}
+
+	m_ProceduralUniforms.Apply(params);
+	SetWireframeMode(wireframe);
+	glDrawElements(GL_TRIANGLES, grid.mesh.nIndices, GL_UNSIGNED_INT, nullptr);
+	glBindVertexArray(0);
+}
+
+void ShapeMeshes::ReleaseProceduralGrid(ProceduralGridMesh& grid)
+{
+	UnshareIndices(grid.mesh);
+	if (grid.mesh.vao != 0) glDeleteVertexArrays(1, &grid.mesh.vao);
+	grid = ProceduralGridMesh();
+}
+
+/******************************************
+ * Tessellated Meshes
+ ******************************************/
+
+bool ShapeMeshes::SetTessellationProgram(GLuint program)
+{
+	if (!TessellatedSurface::IsSupported()) {
+		std::cerr << "Warning: tessellation shaders are not available; tessellated meshes are not drawn." << std::endl;
+		return false;
+	}
+
+	TessellatedSurfaceUniforms uniforms;
+	if (!uniforms.Locate(program)) return false;
+
+	m_TessellationUniforms = uniforms;
+	return true;
+}
+
+void ShapeMeshes::SetTessellationDetail(float pixelsPerEdge, int viewportWidth, int viewportHeight, float maxLevel)
+{
+	m_TessellationEdgePixels = pixelsPerEdge;
+	m_TessellationViewport[0] = viewportWidth;
+	m_TessellationViewport[1] = viewportHeight;
+	m_TessellationMaxLevel = maxLevel;
+}
+
+void ShapeMeshes::DrawTessellatedSphereMesh(float radius, bool wireframe)
+{
+	DrawTessellatedSurface(TessellatedSurfaceParams::Sphere(radius), wireframe);
+}
+
+void ShapeMeshes::DrawTessellatedHemisphereMesh(float radius, bool wireframe)
+{
+	DrawTessellatedSurface(TessellatedSurfaceParams::Hemisphere(radius), wireframe);
+}
+
+void ShapeMeshes::DrawTessellatedTorusMesh(float mainRadius, float tubeRadius, bool wireframe)
+{
+	DrawTessellatedSurface(TessellatedSurfaceParams::Torus(mainRadius, tubeRadius), wireframe);
+}
+
+void ShapeMeshes::DrawTessellatedSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+	bool wireframe)
+{
+	DrawTessellatedSurface(TessellatedSurfaceParams::Superellipsoid(scaleX, scaleY, scaleZ, verticalExponent, horizontalExponent), wireframe);
+}
+
+/******************************************
+ * DrawTessellatedSurface
+ * ---------------------------------------
+ * Creates the patch mesh on first use, then
+ * draws all of it as 4-vertex patches.
+ * GL_PATCH_VERTICES is context state, so it
+ * is set on every draw.
+ ******************************************/
+
+void ShapeMeshes::DrawTessellatedSurface(const TessellatedSurfaceParams& surface, bool wireframe)
+{
+	if (!m_TessellationUniforms.IsValid()) {
+		if (!m_TessellationWarned) {
+			std::cerr << "Warning: tessellated meshes need SetTessellationProgram() first; nothing is drawn." << std::endl;
+			m_TessellationWarned = true;
+		}
+		return;
+	}
+
+	GLMesh& patches = m_TessellationPatches;
+	if (patches.vao == 0) {
+		std::vector<GLfloat> corners(TessellatedSurface::PatchVertexCount * 2);
+		TessellatedSurface::FillPatchVertices(corners.data());
+
+		glGenVertexArrays(1, &patches.vao);
+		glBindVertexArray(patches.vao);
+		glGenBuffers(1, &patches.vbo);
+		glBindBuffer(GL_ARRAY_BUFFER, patches.vbo);
+		UploadBufferData(patches, MeshBufferStream::Vertex, GL_ARRAY_BUFFER, corners.size() * sizeof(GLfloat), corners.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+		glEnableVertexAttribArray(0);
+		patches.nVertices = static_cast<GLuint>(TessellatedSurface::PatchVertexCount);
+	}
+	else {
+		glBindVertexArray(patches.vao);
+	}
+
+	float viewportWidth = static_cast<float>(m_TessellationViewport[0]);
+	float viewportHeight = static_cast<float>(m_TessellationViewport[1]);
+	if (m_TessellationViewport[0] <= 0 || m_TessellationViewport[1] <= 0) {
+		GLint viewport[4] = {};
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		viewportWidth = static_cast<float>(viewport[2]);
+		viewportHeight = static_cast<float>(viewport[3]);
+	}
 
+	m_TessellationUniforms.Apply(surface);
+	m_TessellationUniforms.ApplyDetail(m_TessellationEdgePixels, viewportWidth, viewportHeight, m_TessellationMaxLevel);
+	SetWireframeMode(wireframe);
+	glPatchParameteri(GL_PATCH_VERTICES, 4);
+	glDrawArrays(GL_PATCHES, 0, static_cast<GLsizei>(patches.nVertices));
 	glBindVertexArray(0);
 }
\ No newline at end of file
@@ -16,6 +16,17 @@
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "MeshCompute.h"
+#include "MeshLathe.h"
+#include "MeshSweep.h"
+#include "MeshStreamRing.h"
+#include "ProceduralGrid.h"
+#include "TessellatedSurface.h"
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <iostream>
@@ -35,6 +46,20 @@ struct Vertex {
 };
 
 
+/******************************************
+ * MeshSubRange
+ * ---------------------------------------
+ * A contiguous run of a mesh's indices (or
+ * vertices, for non-indexed meshes) that can
+ * be drawn on its own, such as a cap or the
+ * side wall of a cylinder.
+ ******************************************/
+
+struct MeshSubRange {
+    GLuint first = 0;   // First index (or vertex)
+    GLuint count = 0;   // Number of indices (or vertices)
+};
+
 /******************************************
  * GLMesh
  * ---------------------------------------
@@ -48,33 +73,433 @@ struct Vertex {
  * - nVertices: Number of vertices in the mesh
  * - nIndices: Number of indices for indexed drawing
  * - numSlices: Used for cylindrical and toroidal shapes
+ * - firstIndex: First index of the mesh in its EBO
+ *   (non-zero for meshes loaded from a bundle)
+ * - subRanges: The drawable parts (faces, caps,
+ *   sides) its generator listed in
+ *   MeshData::subRanges, relative to firstIndex
+ * - edgeVao / edgeEbo: GL_LINES indices of the
+ *   mesh's unique edges over the same VBO, for
+ *   wireframe drawing (see SetEdgeWireframes)
  ******************************************/
 
 struct GLMesh {
     GLuint vao = 0;        // Vertex Array Object
     GLuint vbo = 0;        // Vertex Buffer Object
-    GLuint vbos[2];     // Handles for the vertex buffer objects
+    GLuint vbos[2] = {};   // Handles for the vertex buffer objects
     GLuint ebo = 0;        // Element Buffer Object (for indexed drawing)
     GLuint nVertices = 0;  // Number of vertices
     GLuint nIndices = 0;   // Number of indices
+    GLuint firstIndex = 0; // First index in the EBO (bundle meshes share one buffer)
     int numSlices = 0;     // Number of slices (specific to cones, cylinders, etc.)
 
     //added for curved cone
-    int curveSteps;
-    GLuint ibo; // Index Buffer Object for glDrawElements
+    int curveSteps = 0;
+    GLuint ibo = 0; // Index Buffer Object for glDrawElements
+
+    // GPU memory accounting, maintained by ShapeMeshes::UploadBufferData
+    GLsizeiptr vertexBytes = 0;    // Current size of the vertex buffer store
+    GLsizeiptr indexBytes = 0;     // Current size of the index buffer store
+    GLsizeiptr instanceBytes = 0;  // Current size of the per-instance buffer store
+    GLsizeiptr edgeBytes = 0;      // Current size of the edge index buffer store
+    GLsizeiptr peakBytes = 0;      // High-water mark of all four combined
+    GLuint reallocations = 0;      // glBufferData calls that replaced an existing store
+
+    GLsizeiptr TotalBytes() const { return vertexBytes + indexBytes + instanceBytes + edgeBytes; }
+
+    bool sharedIndices = false;    // ebo is a shared grid index buffer (see GridTopology), not owned
+    GLuint attributeVbo = 0;       // Another mesh's VBO holding the positions and normals; vbo then
+                                   // holds only the UVs, 2 floats per vertex (see Hemisphere On Sphere)
+
+    std::vector<MeshSubRange> subRanges;   // Parts for the masked Draw functions (see PartMask)
+
+    GLuint edgeVao = 0;        // VAO drawing the VBO with the edge indices
+    GLuint edgeEbo = 0;        // GL_LINES index buffer, 0 when the mesh has none
+    GLuint nEdgeIndices = 0;   // Two per edge
 
+    GLuint removedTriangles = 0;   // Degenerate pole triangles a Trimmed or Welded grid dropped (see PoleMode)
 };
 
+/******************************************
+ * MeshBufferStream
+ * ---------------------------------------
+ * Identifies which of a GLMesh's buffers an
+ * upload targets, for memory accounting.
+ ******************************************/
+
+enum class MeshBufferStream {
+    Vertex,
+    Index,
+    Instance,
+    Edge
+};
+
+/******************************************
+ * MeshData
+ * ---------------------------------------
+ * CPU-side output of a mesh generator. It
+ * holds no OpenGL state, so shapes can be
+ * generated headless (benchmarks, tools) and
+ * uploaded later with InitializeMesh().
+ *
+ * Members:
+ * - vertices: Interleaved position, normal and
+ *             UV data (8 floats, see Vertex).
+ * - indices: Triangle indices (empty for
+ *            non-indexed meshes).
+ * - subRanges: Optional table of separately
+ *              drawable parts; AddSubRange()
+ *              appends the next count indices.
+ * - removedTriangles: Degenerate pole
+ *              triangles a PoleMode dropped.
+ ******************************************/
+
+struct MeshData {
+    std::vector<GLfloat> vertices;
+    std::vector<GLuint> indices;
+    std::vector<MeshSubRange> subRanges;
+    GLuint removedTriangles = 0;
+
+    GLuint VertexCount() const { return static_cast<GLuint>(vertices.size() / (sizeof(Vertex) / sizeof(GLfloat))); }
+    GLuint IndexCount() const { return static_cast<GLuint>(indices.size()); }
+
+    void Clear() {
+        vertices.clear();
+        indices.clear();
+        subRanges.clear();
+        removedTriangles = 0;
+    }
+
+    void AddSubRange(GLuint count) {
+        const GLuint first = subRanges.empty() ? 0 : subRanges.back().first + subRanges.back().count;
+        subRanges.push_back({ first, count });
+    }
+};
+
+/******************************************
+ * GridTopology
+ * ---------------------------------------
+ * Describes the index pattern of a mesh built
+ * as a rows x cols grid of quads, two
+ * triangles each, which is what the sphere,
+ * hemisphere, torus, spring, curved cone,
+ * tapered torus, sine cone and superellipsoid
+ * generate. Meshes with equal topologies have
+ * identical index buffers, so ShapeMeshes
+ * keeps one per topology and shares it.
+ *
+ * - seam: Duplicated grids have cols + 1
+ *   vertices per row (the seam column is
+ *   repeated for its UVs); Wrapped grids have
+ *   cols and the last quad wraps to column 0.
+ * - winding: Vertex order of the second
+ *   triangle in each quad (c = this row,
+ *   n = next row). Both orders give the same
+ *   counter-clockwise triangle; they are kept
+ *   apart so each generator's index data stays
+ *   exactly what it has always produced.
+ *     Standard: (c, n, c+1) (c+1, n, n+1)
+ *     Rotated:  (c, n, c+1) (n, n+1, c+1)
+ ******************************************/
+
+enum class GridSeam : uint8_t { Duplicated, Wrapped };
+enum class GridWinding : uint8_t { Standard, Rotated };
+
+struct GridTopology {
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    GridSeam seam = GridSeam::Duplicated;
+    GridWinding winding = GridWinding::Standard;
+
+    size_t IndexCount() const { return static_cast<size_t>(rows) * cols * 6; }
+    bool operator==(const GridTopology& other) const {
+        return rows == other.rows && cols == other.cols && seam == other.seam && winding == other.winding;
+    }
+};
+
+/******************************************
+ * PoleMode
+ * ---------------------------------------
+ * How a latitude/longitude grid meets a pole,
+ * where a whole row of vertices lands on one
+ * point.
+ *
+ * - Duplicated: A vertex per column on the
+ *   pole row and full quads against it, one
+ *   triangle of each with zero area. The
+ *   layout these shapes have always had, and
+ *   the only one drawn with the shared
+ *   GridTopology index buffer.
+ * - Trimmed: The same vertices with the
+ *   zero-area triangles dropped; pole texture
+ *   coordinates are unchanged.
+ * - Welded: One vertex per pole with a fan of
+ *   triangles around it. Its U is the middle
+ *   of the row, so a texture pinches there.
+ *   It also closes a superellipsoid with
+ *   exponents below 1, whose pole row is a
+ *   small ring folded through the axis.
+ ******************************************/
+
+enum class PoleMode : uint8_t { Duplicated, Trimmed, Welded };
+
+/******************************************
+ * ConeSideMode
+ * ---------------------------------------
+ * How the side of LoadConeMesh is shaded.
+ *
+ * - Faceted: Two rim vertices per slice, both
+ *   with the slice's normal, and one apex;
+ *   every slice is flat.
+ * - Welded: One rim vertex per ring angle,
+ *   shared by the slices either side of it,
+ *   and one apex vertex per slice, so normals
+ *   vary smoothly around the cone. Half the
+ *   rim vertices; the same index layout.
+ ******************************************/
+
+enum class ConeSideMode : uint8_t { Faceted, Welded };
+
+/******************************************
+ * ArcLayout
+ * ---------------------------------------
+ * How a revolved or swept mesh orders its
+ * indices around its axis, so an angular
+ * range [a0, a1] maps to index offsets into
+ * the full mesh instead of a new one.
+ *
+ * - slices: Equal steps of the full turn,
+ *   slice i from 2 pi i / slices.
+ * - blocks: Runs of indices written slice by
+ *   slice, indicesPerSlice each (the side,
+ *   each cap). cap marks the blocks that
+ *   drawCaps leaves out.
+ ******************************************/
+
+struct ArcBlock {
+    GLuint firstIndex = 0;
+    GLuint indicesPerSlice = 0;
+    bool cap = false;
+};
+
+struct ArcLayout {
+    int slices = 0;
+    std::vector<ArcBlock> blocks;
+};
+
+/******************************************
+ * MeshMemoryUsage / GpuMemoryReport
+ * ---------------------------------------
+ * Snapshot of the GPU buffer memory held by a
+ * ShapeMeshes instance, returned by
+ * GetGpuMemoryReport().
+ *
+ * - meshes: One entry per GLMesh member that
+ *           currently owns buffer storage or
+ *           has ever been reallocated.
+ * - totalBytes / peakBytes: Across all meshes,
+ *           including transient buffers such as
+ *           those used by DrawPartialConeMesh.
+ * - reallocations: glBufferData calls that
+ *           replaced an existing buffer store.
+ * - removedTriangles: Degenerate pole
+ *           triangles the mesh's PoleMode left
+ *           out of its index buffer.
+ ******************************************/
+
+struct MeshMemoryUsage {
+    const char* name = "";
+    GLsizeiptr vertexBytes = 0;
+    GLsizeiptr indexBytes = 0;
+    GLsizeiptr instanceBytes = 0;
+    GLsizeiptr totalBytes = 0;
+    GLsizeiptr peakBytes = 0;
+    GLuint reallocations = 0;
+    GLuint removedTriangles = 0;
+};
+
+struct GpuMemoryReport {
+    std::vector<MeshMemoryUsage> meshes;
+    GLsizeiptr vertexBytes = 0;
+    GLsizeiptr indexBytes = 0;
+    GLsizeiptr instanceBytes = 0;
+    GLsizeiptr totalBytes = 0;
+    GLsizeiptr peakBytes = 0;
+    unsigned long long reallocations = 0;
+};
+
+/******************************************
+ * SuperellipsoidTessellationReport
+ * ---------------------------------------
+ * An error-bounded superellipsoid grid against
+ * the evenly spaced grid of the same accuracy,
+ * from ReportSuperellipsoidTessellation().
+ *
+ * - maxError: The error asked for.
+ * - uSegments / vSegments / surfaceError: The
+ *   adaptive grid and the largest distance
+ *   found from the true surface to it.
+ * - uniformUSegments / uniformVSegments /
+ *   uniformSurfaceError: The fewest even
+ *   segments whose latitude and longitude
+ *   profiles are as close to the true curves
+ *   as the adaptive ones, and that grid's
+ *   surface error.
+ ******************************************/
+
+struct SuperellipsoidTessellationReport {
+    float maxError = 0.0f;
+    int uSegments = 0;
+    int vSegments = 0;
+    float surfaceError = 0.0f;
+    int uniformUSegments = 0;
+    int uniformVSegments = 0;
+    float uniformSurfaceError = 0.0f;
+
+    size_t Triangles() const { return static_cast<size_t>(uSegments) * vSegments * 2; }
+    size_t UniformTriangles() const { return static_cast<size_t>(uniformUSegments) * uniformVSegments * 2; }
+    // Fraction of the uniform grid's triangles saved.
+    float Savings() const { return UniformTriangles() ? 1.0f - static_cast<float>(Triangles()) / UniformTriangles() : 0.0f; }
+};
+
+/******************************************
+ * BundledMesh
+ * ---------------------------------------
+ * One mesh/LOD entry loaded from a mesh
+ * bundle by LoadMeshBundle(). Its VAO reads
+ * from the shared bundle buffer.
+ ******************************************/
+
+struct BundledMesh {
+    std::string name;
+    GLuint lod = 0;
+    GLMesh mesh;
+};
+
+/******************************************
+ * ImportedMesh
+ * ---------------------------------------
+ * A mesh loaded from an OBJ or PLY file by
+ * LoadImportedMesh(), with its own buffers.
+ ******************************************/
+
+struct ImportedMesh {
+    std::string name;
+    GLMesh mesh;
+};
+
+struct MeshCacheKey;
+
 class ShapeMeshes
 {
 public:
     ShapeMeshes();  // Use default constructor
 
+    /******************************************
+     * Destructor
+     * ---------------------------------------
+     * Deletes every VAO and buffer the meshes
+     * own: built-in, imported, bundle and the
+     * stream ring. Needs the GL context that
+     * loaded them to still be current.
+     ******************************************/
+
+    ~ShapeMeshes();
+
+    // GL names have one owner; a copy would delete them twice.
+    ShapeMeshes(const ShapeMeshes&) = delete;
+    ShapeMeshes& operator=(const ShapeMeshes&) = delete;
+
+    /******************************************
+     * GeneratorVersion
+     * ---------------------------------------
+     * Version of the GenerateXMesh code, stored
+     * in every mesh cache entry. Bump it whenever
+     * a generator's output changes so existing
+     * cache files are treated as stale.
+     *
+     * 3: The cone, cylinder and tapered
+     *    cylinder list their parts in
+     *    MeshData::subRanges.
+     ******************************************/
+
+    static constexpr unsigned int GeneratorVersion = 3;
+
+    /******************************************
+     * SetMeshCacheDirectory
+     * ---------------------------------------
+     * Enables the on-disk mesh cache (see
+     * MeshCache.h). Generated meshes are loaded
+     * from this directory when a current entry
+     * exists, and written to it otherwise. An
+     * empty string disables the cache (default).
+     * With compress set, new entries are written
+     * through MeshCodec (smaller, slightly lossy).
+     ******************************************/
+
+    void SetMeshCacheDirectory(const std::string& directory, bool compress = false) {
+        m_MeshCacheDirectory = directory;
+        m_MeshCacheCompressed = compress;
+    }
+
+    /******************************************
+     * SetComputeGeneration
+     * ---------------------------------------
+     * Generates the spring, spiral, sine cone
+     * and superellipsoid with compute shaders,
+     * straight into their GPU buffers (see
+     * MeshCompute.h), instead of on the CPU.
+     * Applies to later LoadSpringMesh calls and
+     * to every following dynamic-mesh draw. The
+     * mesh cache is not used for these meshes
+     * while it is on.
+     *
+     * Returns false, and stays on the CPU path,
+     * if the context lacks compute shaders or
+     * the shader fails to build. Needs a current
+     * GL context.
+     ******************************************/
+
+    bool SetComputeGeneration(bool enable);
+    bool IsComputeGenerationEnabled() const { return m_ComputeGeneration; }
+
+    /******************************************
+     * SetEdgeWireframes
+     * ---------------------------------------
+     * Gives meshes loaded afterwards a second
+     * index buffer listing each of their edges
+     * once, for GL_LINES (see BuildEdgeIndices),
+     * and has the whole-mesh Draw functions
+     * draw wireframes with it instead of
+     * switching glPolygonMode to GL_LINE, which
+     * draws every shared edge twice. Off by
+     * default.
+     *
+     * With omitDiagonals set, the diagonal that
+     * splits a flat quad into two triangles is
+     * left out, so grids draw as quads.
+     *
+     * Strip meshes (plane, prism, pyramids),
+     * meshes generated at draw time or by
+     * compute, bundle meshes, the hemisphere
+     * drawn from the sphere's buffers and draws
+     * of only some parts or an arc still use
+     * the polygon mode.
+     ******************************************/
+
+    void SetEdgeWireframes(bool enable, bool omitDiagonals = false) {
+        m_EdgeWireframes = enable;
+        m_EdgeOmitDiagonals = omitDiagonals;
+    }
+
     /******************************************
      * InitializeMesh
      * ---------------------------------------
      * Creates an OpenGL VAO, VBO, and optionally an
      * EBO for a given GLMesh using vertex and index data.
+     * A mesh that already owns them (a reload, for
+     * example at a new resolution) keeps its names
+     * and has its buffers updated in place.
      *
      * Params:
      * - mesh: Reference to the GLMesh structure.
@@ -84,12 +509,28 @@ public:
      ******************************************/
 
     void InitializeMesh(GLMesh& mesh, const std::vector<GLfloat>& verts, const std::vector<GLuint>& indices);
+    void InitializeMesh(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount);
+
+    /******************************************
+     * InitializeGridMesh
+     * ---------------------------------------
+     * Like InitializeMesh for a grid mesh, but
+     * draws with the shared index buffer for
+     * topology instead of uploading indices.
+     * indices is only used (uploaded as the
+     * mesh's own) if its size does not match
+     * the topology, e.g. for degenerate
+     * parameters.
+     ******************************************/
+
+    void InitializeGridMesh(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount, const GridTopology& topology);
 
     /******************************************
      * BoxSide Enum
      * ---------------------------------------
      * Defines the six sides of a box for selective
-     * rendering using `DrawBoxMeshSide()`.
+     * rendering using `DrawBoxMeshSide()`, in the
+     * order of the box's index buffer.
      ******************************************/
 
     enum class BoxSide {
@@ -101,6 +542,39 @@ public:
         front
     };
 
+    /******************************************
+     * Part Enums
+     * ---------------------------------------
+     * The parts of the cone, cylinder, tapered
+     * cylinder and fin, in the order of their
+     * sub-range tables (see GLMesh::subRanges).
+     * PartMask() gives a part's bit; or them
+     * together for DrawBoxMeshSides() and
+     * DrawFinFaces().
+     ******************************************/
+
+    enum class ConePart { bottom, sides };
+    enum class CylinderPart { bottom, top, sides };   // Cylinder and tapered cylinder
+    enum class FinFace { front, back, top, bottom, left, right };
+
+    template <typename Part>
+    static constexpr uint32_t PartMask(Part part) { return 1u << static_cast<uint32_t>(part); }
+
+    /******************************************
+     * ArcShape Enum
+     * ---------------------------------------
+     * The loaded meshes DrawMeshArc() can draw
+     * an angular range of.
+     ******************************************/
+
+    enum class ArcShape {
+        cone,
+        cylinder,
+        taperedCylinder,
+        tube,
+        torus
+    };
+
     /******************************************
      * LoadXMesh (Various)
      * ---------------------------------------
@@ -125,24 +599,170 @@ public:
      ******************************************/
 
     void LoadBoxMesh();
-    void LoadConeMesh(float radius = 1.0f, float height = 1.0f, int numSlices = 18);
+    void LoadConeMesh(float radius = 1.0f, float height = 1.0f, int numSlices = 18, ConeSideMode sides = ConeSideMode::Faceted);
     void LoadCylinderMesh(float radius = 1.0f, float height = 1.0f, int numSlices = 36);
     void LoadPlaneMesh(float width = 2.0f, float height = 2.0f);
     void LoadPrismMesh();
     void LoadPyramid3Mesh();
     void LoadPyramid4Mesh(float baseSize = 1.0f, float height = 1.0f);
-    void LoadSphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f);
-    void LoadHemisphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f);
+    void LoadSphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, PoleMode poles = PoleMode::Duplicated);
+    void LoadHemisphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, PoleMode poles = PoleMode::Duplicated);
 
     void LoadTaperedCylinderMesh(float bottomRadius = 1.0f, float topRadius = 0.5f, float height = 1.0f, int numSlices = 18);
     void LoadTorusMesh(float mainRadius = 1.0f, float tubeRadius = 0.25f, int mainSegments = 18, int tubeSegments = 18);
     // the following torus meshes are provided in case multiple tori of different thicknesses are needed
     void LoadExtraTorusMesh1(float thickness = 0.4);
     void LoadExtraTorusMesh2(float thickness = 0.6);
-    void LoadSpringMesh(float mainRadius = 1.0f, float tubeRadius = 0.1f, int mainSegments = 6, int tubeSegments = 18, float springLength = 4.0f);
+    void LoadSpringMesh(float mainRadius = 1.0f, float tubeRadius = 0.1f, int mainSegments = 6, int tubeSegments = 18, float springLength = 4.0f, float chordTolerance = 0.0f);
     void LoadTubeMesh(float outerRadius = 2.0f, float innerRadius1 = 1.7f, float height = 1.0f, int numSlices = 30);
     void LoadFinMesh(float baseLength = 2.9f, float topLength = 0.75f, float height = 2.5f, float thickness = 0.1f);
 
+    /******************************************
+     * GenerateXMesh (Various)
+     * ---------------------------------------
+     * Headless generator layer. Each function
+     * builds the vertex and index data for a
+     * shape into a MeshData without touching
+     * OpenGL; the matching LoadXMesh/DrawXMesh
+     * function uploads the result.
+     *
+     * Parameters match the LoadXMesh/DrawXMesh
+     * function of the same shape. Any previous
+     * contents of the MeshData are replaced.
+     ******************************************/
+
+    static void GenerateConeMesh(MeshData& mesh, float radius = 1.0f, float height = 1.0f, int numSlices = 18, ConeSideMode sides = ConeSideMode::Faceted);
+    static void GenerateCylinderMesh(MeshData& mesh, float radius = 1.0f, float height = 1.0f, int numSlices = 36);
+    static void GenerateTaperedCylinderMesh(MeshData& mesh, float bottomRadius = 1.0f, float topRadius = 0.5f, float height = 1.0f, int numSlices = 18);
+    static void GenerateSphereMesh(MeshData& mesh, int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, PoleMode poles = PoleMode::Duplicated);
+    static void GenerateHemisphereMesh(MeshData& mesh, int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, PoleMode poles = PoleMode::Duplicated);
+    static void GenerateTorusMesh(MeshData& mesh, float mainRadius = 1.0f, float tubeRadius = 0.25f, int mainSegments = 18, int tubeSegments = 18);
+    static void GenerateExtraTorusMesh(MeshData& mesh, float thickness);
+    static void GenerateSpringMesh(MeshData& mesh, float mainRadius = 1.0f, float tubeRadius = 0.1f, int mainSegments = 6, int tubeSegments = 18, float springLength = 4.0f, float chordTolerance = 0.0f);
+    static void GenerateTubeMesh(MeshData& mesh, float outerRadius = 2.0f, float innerRadius = 1.7f, float height = 1.0f, int numSlices = 30);
+    static void GenerateCurvedConeMesh(MeshData& mesh, int numSlices, int curveSteps, float radius, float height, float bendRadius);
+    static void GenerateTaperedTorusMesh(MeshData& mesh, float mainRadius, float tubeRadiusStart, float tubeRadiusEnd, int mainSegments, int tubeSegments, float sweepAngleRadians);
+    static void GenerateSpiralMesh(MeshData& mesh, float tubeRadius, float flattenFactor, float loopSpacing, float numLoops, int tubeSegments, int spiralSegments, float chordTolerance = 0.0f);
+    static void GenerateSineConeMesh(MeshData& mesh, float baseRadius, float height, float flattenFactor, float sineAmplitude, float sineFrequency, float sinePhase, int radialSegments, int heightSegments);
+    static void GenerateSuperellipsoidMesh(MeshData& mesh, float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, int uSegments, int vSegments,
+        PoleMode poles = PoleMode::Duplicated);
+
+    // Centerline rings of the spiral with their transported frames, shared by
+    // the CPU generator and the compute path.
+    static void GenerateSpiralFrames(std::vector<SpiralFrame>& frames, float loopSpacing, float numLoops, int spiralSegments);
+
+    /******************************************
+     * ReportSpringSampling / ReportSpiralSampling
+     * ---------------------------------------
+     * What a chordTolerance buys: the rings the
+     * adaptive sampling places, against the
+     * evenly spaced rings needed for the same
+     * maximum distance between the tube's
+     * centerline and the true curve, and against
+     * the rings the segment counts ask for (see
+     * SweepSamplingReport). Parameters match
+     * GenerateSpringMesh / GenerateSpiralMesh.
+     ******************************************/
+
+    static SweepSamplingReport ReportSpringSampling(float mainRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance);
+    static SweepSamplingReport ReportSpiralSampling(float loopSpacing, float numLoops, int tubeSegments, int spiralSegments, float chordTolerance);
+
+    /******************************************
+     * RemoveDegenerateTriangles /
+     * CountDegenerateTriangles
+     * ---------------------------------------
+     * A triangle is degenerate if two of its
+     * indices are equal or its area is at most
+     * relativeArea times the square of its
+     * longest edge; collapsed pole quads land
+     * within float rounding of zero, not on it.
+     *
+     * Remove keeps the other triangles in order,
+     * shrinks subRanges to match and returns how
+     * many it dropped. Vertices are untouched.
+     ******************************************/
+
+    static size_t RemoveDegenerateTriangles(MeshData& mesh, float relativeArea = 1e-6f);
+    static size_t CountDegenerateTriangles(const MeshData& mesh, float relativeArea = 1e-6f);
+
+    /******************************************
+     * BuildEdgeIndices
+     * ---------------------------------------
+     * Writes each edge of a triangle list once,
+     * as a pair of indices for GL_LINES, in the
+     * order the triangles first use them.
+     * Vertices at the same position (UV seams,
+     * hard-edge normals, poles) count as one, so
+     * an edge drawn by several of them is still
+     * listed once; zero-length edges are not.
+     *
+     * With omitDiagonals, an edge is dropped if
+     * exactly two triangles share it, they are
+     * nearly coplanar, the quad they form has a
+     * pair of parallel opposite sides and the
+     * edge is not its shorter diagonal: a grid
+     * quad's diagonal, but not a fan's spoke.
+     * A triangle loses at most one edge.
+     *
+     * vertices holds vertexCount Vertex records
+     * (8 floats each).
+     ******************************************/
+
+    static void BuildEdgeIndices(std::vector<GLuint>& edges, const GLfloat* vertices, size_t vertexCount,
+        const GLuint* indices, size_t indexCount, bool omitDiagonals);
+
+    /******************************************
+     * GenerateSweepMesh
+     * ---------------------------------------
+     * A round tube along any curve, built with
+     * the same sweep engine as the spring, curved
+     * cone and spiral (see MeshSweep.h). Upload
+     * the result with InitializeMesh().
+     *
+     * - curve: Centerline position for t in [0, 1].
+     * - ringCount: Rings along the curve (>= 2).
+     * - segments: Subdivisions around the tube.
+     * - radius: Tube radius for t in [0, 1].
+     * - up: Seeds the first ring's frame; the
+     *   rest are rotation minimizing.
+     *
+     * U runs around the tube, V along the curve.
+     ******************************************/
+
+    static void GenerateSweepMesh(MeshData& mesh, const std::function<glm::vec3(float)>& curve, int ringCount, int segments,
+        const std::function<float(float)>& radius, const glm::vec3& up = glm::vec3(0.0f, 0.0f, 1.0f));
+
+    /******************************************
+     * GenerateLatheMesh
+     * ---------------------------------------
+     * Any turned part: a polyline profile of
+     * (radius, y) points revolved about the Y
+     * axis with the lathe engine behind the
+     * cylinder, cone, tube and friends (see
+     * MeshLathe.h). Upload the result with
+     * InitializeMesh().
+     *
+     * - profile: Points from bottom to top; the
+     *   surface faces right of the direction of
+     *   travel in the (radius, y) plane, outward
+     *   for a profile walked upward. Normals are
+     *   smooth; repeat a point for a crease.
+     * - capBottom / capTop: Close the first or
+     *   last point to the axis with a flat disc
+     *   (skipped where that point is on the axis).
+     * - arcDegrees: Below 360 the profile turns
+     *   through a centered arc and the cut faces
+     *   stay open, as the partial cone's do.
+     *
+     * U runs around the axis, V from 1 at the
+     * bottom to 0 at the top by profile length.
+     * Indices are the bottom cap, the top cap,
+     * then the surface.
+     ******************************************/
+
+    static void GenerateLatheMesh(MeshData& mesh, const std::vector<glm::vec2>& profile, int numSlices,
+        bool capBottom = true, bool capTop = true, float arcDegrees = 360.0f);
+
     /******************************************
      * DrawXMesh (Various)
      * ---------------------------------------
@@ -179,6 +799,49 @@ public:
     void DrawSphereMesh(bool wireframe = false);
     void DrawHemisphereMesh(bool wireframe = false);
 
+    /******************************************
+     * DrawSphereBand
+     * ---------------------------------------
+     * Draws the rows of the loaded sphere
+     * between two polar angles (radians from
+     * the +Y pole, 0 to pi), rounded out to
+     * whole rows: one draw call over the
+     * sphere's index buffer, nothing generated.
+     *
+     * SphereBandRange() is the headless half:
+     * the index range of those rows in a sphere
+     * generated with the same parameters.
+     * BuildHemisphereTexCoords() gives the UVs
+     * a hemisphere drawn from the sphere's
+     * buffers uploads, two floats per vertex.
+     ******************************************/
+
+    void DrawSphereBand(float startAngle, float endAngle, bool wireframe = false);
+    static MeshSubRange SphereBandRange(int latitudeSegments, int longitudeSegments, PoleMode poles, float startAngle, float endAngle);
+    static void BuildHemisphereTexCoords(std::vector<GLfloat>& texCoords, int latitudeSegments, int longitudeSegments);
+
+    /******************************************
+     * DrawBoxMeshSides / DrawFinFaces
+     * ---------------------------------------
+     * Draw any set of the box's sides or the
+     * fin's faces, given as a mask of PartMask()
+     * bits. Parts next to each other in the
+     * index buffer are merged, so a mask is one
+     * glDrawElements when its parts form one
+     * run and one glMultiDrawElements when they
+     * do not. DrawBoxMeshSide, the cone and
+     * cylinder Draw functions and the DrawFin*
+     * functions draw through the same path.
+     *
+     * MaskedPartRanges() is the headless half:
+     * the merged ranges a mask selects from a
+     * sub-range table.
+     ******************************************/
+
+    void DrawBoxMeshSides(uint32_t sideMask, bool wireframe = false);
+    void DrawFinFaces(uint32_t faceMask, bool wireframe = false);
+    static void MaskedPartRanges(std::vector<MeshSubRange>& ranges, const std::vector<MeshSubRange>& parts, uint32_t partMask);
+
     void DrawFinMesh(bool wireframe);
     void DrawFinSides();
     void DrawFinFrontOnly();
@@ -194,6 +857,38 @@ public:
     void DrawSpringMesh(bool wireframe = false);
     void DrawTubeMesh(bool wireframe = false) const;
 
+    /******************************************
+     * DrawMeshArc
+     * ---------------------------------------
+     * Draws the slices of a loaded revolved
+     * mesh between startAngle and endAngle
+     * (radians, as its generator measures
+     * them: from +X towards +Z for the lathe
+     * shapes, towards +Y for the torus). The
+     * range is rounded out to whole slices and
+     * may wrap past 2 pi; a span of 2 pi or
+     * more draws the whole mesh. Nothing is
+     * generated or uploaded, and the ranges of
+     * every block go out in one draw call (see
+     * DrawIndexRanges).
+     *
+     * - drawCaps: Also draw the cap blocks
+     *   (cone base, cylinder discs, tube end
+     *   rings) over the same range. The cut
+     *   faces at the ends of the range are not
+     *   closed.
+     *
+     * ArcLayoutFor() / ArcIndexRanges() are the
+     * headless halves: the layout of a shape
+     * generated with slices around and
+     * indexCount indices, and the index ranges
+     * an angular range covers in it.
+     ******************************************/
+
+    void DrawMeshArc(ArcShape shape, float startAngle, float endAngle, bool drawCaps = true, bool wireframe = false);
+    static ArcLayout ArcLayoutFor(ArcShape shape, int slices, size_t indexCount);
+    static void ArcIndexRanges(std::vector<MeshSubRange>& ranges, const ArcLayout& layout, float startAngle, float endAngle, bool drawCaps = true);
+
     /******************************************
     * Deprecated Functions
     * ****************************************/
@@ -219,7 +914,7 @@ public:
     void LoadTaperedTorusMesh();
     void DrawTaperedTorusMesh(float mainRadius, float tubeRadiusStart, float tubeRadiusEnd, int mainSegments, int tubeSegments, float sweepAngleRadians);
     void LoadSpiralMesh();
-    void DrawSpiralMesh(float tubeRadius, float flattenFactor, float loopSpacing, float numLoops, int tubeSegments, int spiralSegments);
+    void DrawSpiralMesh(float tubeRadius, float flattenFactor, float loopSpacing, float numLoops, int tubeSegments, int spiralSegments, float chordTolerance = 0.0f);
     void LoadSineConeMesh();
     void DrawSineConeMesh(float baseRadius, float height, float flattenFactor, float sineAmplitude, float sineFrequency, float sinePhase, int radialSegments, int heightSegments);
     // NEW: Superellipsoid
@@ -230,7 +925,198 @@ public:
         float verticalExponent,
         float horizontalExponent,
         int   uSegments,
-        int   vSegments);
+        int   vSegments,
+        PoleMode poles = PoleMode::Duplicated);
+
+    /******************************************
+     * Adaptive Superellipsoid
+     * ---------------------------------------
+     * The superellipsoid with its sample angles
+     * placed by a geometric error instead of
+     * even steps: dense around sharp edges and
+     * sparse across flat faces, on the same
+     * u x v grid topology as
+     * DrawSuperellipsoidMesh.
+     *
+     * The shape is the product of a latitude and
+     * a longitude superellipse; each quarter of
+     * each is sampled so no chord strays more
+     * than maxError / 2 from it, then mirrored,
+     * so the grid keeps the shape's symmetry and
+     * its surface stays within about maxError.
+     * At most 512 x 1024 segments.
+     *
+     * - DrawAdaptiveSuperellipsoidMesh(...):
+     *   Draws through the same buffers as
+     *   DrawSuperellipsoidMesh, on the CPU path
+     *   even with compute generation on.
+     * - GenerateAdaptiveSuperellipsoidMesh(...):
+     *   The same mesh into a MeshData.
+     * - ReportSuperellipsoidTessellation(...):
+     *   Segments, triangles and measured surface
+     *   error against the uniform grid of the
+     *   same accuracy.
+     ******************************************/
+
+    void DrawAdaptiveSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, float maxError);
+    static void GenerateAdaptiveSuperellipsoidMesh(MeshData& mesh, float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, float maxError);
+    static SuperellipsoidTessellationReport ReportSuperellipsoidTessellation(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, float maxError);
+
+    /******************************************
+     * Procedural Grid Meshes
+     * ---------------------------------------
+     * Sphere, hemisphere, torus and
+     * superellipsoid evaluated in the vertex
+     * shader with no vertex buffer (see
+     * ProceduralGrid.h). Parameters match the
+     * LoadXMesh/DrawXMesh function of the same
+     * shape and may change on every draw for
+     * the cost of a few uniforms; only the grid
+     * size selects the shared index buffer.
+     *
+     * - SetProceduralProgram(program): Registers
+     *   a program linked with
+     *   ProceduralGrid::CompileVertexShader().
+     *   Returns false if it lacks the grid
+     *   uniforms.
+     * - DrawProceduralXMesh(...): Draws with that
+     *   program, which must be in use.
+     ******************************************/
+
+    bool SetProceduralProgram(GLuint program);
+    void DrawProceduralSphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, bool wireframe = false);
+    void DrawProceduralHemisphereMesh(int latitudeSegments = 18, int longitudeSegments = 18, float radius = 1.0f, bool wireframe = false);
+    void DrawProceduralTorusMesh(float mainRadius = 1.0f, float tubeRadius = 0.25f, int mainSegments = 18, int tubeSegments = 18, bool wireframe = false);
+    void DrawProceduralSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+        int uSegments, int vSegments, bool wireframe = false);
+
+    /******************************************
+     * Tessellated Meshes
+     * ---------------------------------------
+     * Sphere, hemisphere, torus and
+     * superellipsoid drawn from one coarse patch
+     * mesh with tessellation shaders (see
+     * TessellatedSurface.h). There is no segment
+     * count: each patch edge is split so its
+     * pieces are about pixelsPerEdge long on
+     * screen, so a shape is smooth up close and
+     * costs a few hundred triangles far away.
+     *
+     * - SetTessellationProgram(program):
+     *   Registers a program linked with
+     *   TessellatedSurface::AttachShaders().
+     *   Returns false if it lacks the surface
+     *   uniforms or the context lacks
+     *   tessellation.
+     * - SetTessellationDetail(pixelsPerEdge,
+     *   viewportWidth, viewportHeight, maxLevel):
+     *   Target edge length and the viewport it is
+     *   measured in. A zero viewport (the
+     *   default) uses the current GL viewport.
+     * - DrawTessellatedXMesh(...): Draws with
+     *   that program, which must be in use.
+     ******************************************/
+
+    bool SetTessellationProgram(GLuint program);
+    void SetTessellationDetail(float pixelsPerEdge, int viewportWidth = 0, int viewportHeight = 0, float maxLevel = 64.0f);
+    void DrawTessellatedSphereMesh(float radius = 1.0f, bool wireframe = false);
+    void DrawTessellatedHemisphereMesh(float radius = 1.0f, bool wireframe = false);
+    void DrawTessellatedTorusMesh(float mainRadius = 1.0f, float tubeRadius = 0.25f, bool wireframe = false);
+    void DrawTessellatedSuperellipsoidMesh(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+        bool wireframe = false);
+
+    /******************************************
+     * GPU Memory Reporting
+     * ---------------------------------------
+     * - GetGpuMemoryReport(): Returns current and
+     *   peak buffer bytes per mesh and in total,
+     *   plus reallocation counts.
+     * - PrintGpuMemoryReport(out): Writes the same
+     *   report as a readable table.
+     ******************************************/
+
+    GpuMemoryReport GetGpuMemoryReport() const;
+    void PrintGpuMemoryReport(std::ostream& out = std::cout) const;
+
+    /******************************************
+     * EndFrame
+     * ---------------------------------------
+     * Call once per frame, after the last draw.
+     * Fences this frame's streamed geometry (see
+     * MeshStreamRing) so the next frames write
+     * to other parts of the ring, and lets each
+     * dynamic mesh update its own buffers again
+     * (see DrawDynamicMesh). Without it the ring
+     * still works, moving on only when a segment
+     * fills up.
+     ******************************************/
+
+    void EndFrame() { m_StreamRing.EndFrame(); ++m_FrameIndex; }
+
+    /******************************************
+     * ExportMesh
+     * ---------------------------------------
+     * Reads a loaded mesh back from its GPU
+     * buffers and streams it to an OBJ, PLY or
+     * GLB file (chosen by the path's extension;
+     * see MeshExport.h). meshName is a name from
+     * GetGpuMemoryReport(), in any case. Returns
+     * false if the mesh is unknown, not loaded,
+     * or the file cannot be written.
+     ******************************************/
+
+    bool ExportMesh(const std::string& meshName, const std::string& path) const;
+
+    /******************************************
+     * Mesh Bundles
+     * ---------------------------------------
+     * Loads meshes baked offline by the MeshBaker
+     * tool (see MeshBundle.h) instead of running
+     * the generators at startup.
+     *
+     * - LoadMeshBundle(path, lod): Maps the bundle
+     *   and uploads all of its vertex and index
+     *   data with a single glBufferData call, then
+     *   selects lod. Returns false (and leaves any
+     *   previous bundle loaded) if the file is
+     *   missing, invalid, or was baked by another
+     *   GeneratorVersion.
+     * - SelectBundleLod(lod): Points each built-in
+     *   mesh named in the bundle (cone, cylinder,
+     *   tapered_cylinder, sphere, hemisphere, torus,
+     *   extra_torus1, extra_torus2, spring, tube,
+     *   curved_cone) at its entry for lod, or the
+     *   closest lower level, so the usual Draw
+     *   functions render it.
+     * - DrawBundledMesh(name, lod): Draws any bundle
+     *   entry, including ones with custom names.
+     ******************************************/
+
+    bool LoadMeshBundle(const std::string& path, int lod = 0);
+    void SelectBundleLod(int lod);
+    void DrawBundledMesh(const std::string& name, int lod = 0, bool wireframe = false) const;
+    const std::vector<BundledMesh>& GetBundledMeshes() const { return m_BundledMeshes; }
+
+    /******************************************
+     * Imported Meshes
+     * ---------------------------------------
+     * Scanned or modelled parts loaded from OBJ
+     * or PLY files (see MeshImport.h) and drawn
+     * alongside the built-in shapes.
+     *
+     * - LoadImportedMesh(name, path): Parses the
+     *   file, welds it into indexed Vertex data and
+     *   uploads it with InitializeMesh. Loading a
+     *   name again replaces that mesh. Returns
+     *   false (keeping any previous mesh) if the
+     *   file cannot be read.
+     * - DrawImportedMesh(name): Draws it as
+     *   indexed triangles.
+     ******************************************/
+
+    bool LoadImportedMesh(const std::string& name, const std::string& path);
+    void DrawImportedMesh(const std::string& name, bool wireframe = false) const;
+    const std::vector<ImportedMesh>& GetImportedMeshes() const { return m_ImportedMeshes; }
 
 
 private:
@@ -260,6 +1146,50 @@ private:
     GLMesh m_Pyramid4Mesh;
     GLMesh m_SphereMesh;
     GLMesh m_HemisphereMesh;
+
+    /******************************************
+     * Hemisphere On Sphere
+     * ---------------------------------------
+     * The hemisphere's vertices are the top
+     * rows of a sphere of the same parameters,
+     * in the same order, and its indices the
+     * first rows of the sphere's. When the
+     * loaded sphere matches (Duplicated poles,
+     * so its indices are a shared grid buffer)
+     * the hemisphere is not generated: its VAO
+     * reads positions and normals from the
+     * sphere's VBO, texture coordinates (V runs
+     * over the half, not the whole) from a
+     * small VBO of its own, and draws the first
+     * rows of the sphere's grid EBO, holding a
+     * reference to it.
+     *
+     * LoadSphereMesh and SelectBundleLod call
+     * RefreshHemisphereOnSphere(), which loads
+     * the hemisphere again if it was on the old
+     * sphere or matches the new one.
+     ******************************************/
+
+    struct SphereGridParams {
+        int latitudeSegments = 0;
+        int longitudeSegments = 0;
+        float radius = 0.0f;
+        PoleMode poles = PoleMode::Duplicated;
+
+        bool operator==(const SphereGridParams& other) const {
+            return latitudeSegments == other.latitudeSegments && longitudeSegments == other.longitudeSegments
+                && radius == other.radius && poles == other.poles;
+        }
+    };
+
+    bool CanShareSphere(const SphereGridParams& hemisphere) const;
+    void LoadHemisphereOnSphere(const SphereGridParams& hemisphere);
+    void RefreshHemisphereOnSphere();
+
+    SphereGridParams m_SphereParams;
+    SphereGridParams m_HemisphereParams;
+    bool m_HemisphereOnSphere = false;
+
     GLMesh m_TaperedCylinderMesh;
     GLMesh m_TorusMesh;
     // the following torus meshes are provided in case multiple tori of different thicknesses are needed
@@ -279,6 +1209,362 @@ private:
 
     bool m_IsMemoryLayoutSet = false;  // Improved variable naming
 
+    // GPU memory totals across every mesh, including transient buffers
+    GLsizeiptr m_GpuBytes = 0;
+    GLsizeiptr m_GpuPeakBytes = 0;
+    unsigned long long m_GpuReallocations = 0;
+
+    /******************************************
+     * Buffer Upload Accounting
+     * ---------------------------------------
+     * Every glBufferData call goes through
+     * UploadBufferData() so the byte counts on
+     * the GLMesh and the totals above stay in
+     * step with what the driver holds.
+     *
+     * - UploadBufferData(): Uploads to the buffer
+     *   currently bound to target and records it
+     *   against the given stream of the mesh.
+     * - UpdateBufferData(): For reloads. Writes
+     *   into the existing store with
+     *   glBufferSubData when the data fits, and
+     *   otherwise grows the store by at least
+     *   half its size, so repeated resolution
+     *   changes settle without reallocating.
+     * - RecordBufferSize(): Records a new data
+     *   store made some other way (for example
+     *   with glBufferStorage).
+     * - ReleaseBufferData(): Records that the
+     *   mesh's buffers were deleted.
+     * - ReleaseMesh(): Deletes the VAO and
+     *   buffers a mesh owns and resets it. Meshes
+     *   bound to a bundle entry own nothing.
+     ******************************************/
+
+    void UploadBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    void UpdateBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    void RecordBufferSize(GLMesh& mesh, MeshBufferStream stream, GLsizeiptr size);
+    void ReleaseBufferData(GLMesh& mesh);
+    void ReleaseMesh(GLMesh& mesh);
+
+    /******************************************
+     * Masked Part Drawing
+     * ---------------------------------------
+     * - DrawMeshParts(): Draws the parts of
+     *   mesh's sub-range table that partMask
+     *   selects. Leaves the polygon mode as it
+     *   is; callers set it.
+     * - DrawIndexRanges(): Draws index ranges of
+     *   the bound VAO, with one glDrawElements
+     *   for a single range and one
+     *   glMultiDrawElements for several.
+     ******************************************/
+
+    void DrawMeshParts(const GLMesh& mesh, uint32_t partMask, const char* name);
+    void DrawIndexRanges(const GLMesh& mesh, const std::vector<MeshSubRange>& ranges);
+
+    /******************************************
+     * Edge Wireframes
+     * ---------------------------------------
+     * - LoadEdgeIndices(): Builds and uploads the
+     *   mesh's edge indices from the triangle
+     *   list just uploaded, reusing its edge
+     *   buffer on a reload, or releases them if
+     *   edge wireframes are off.
+     * - ReleaseEdgeIndices(): Deletes them, for
+     *   meshes whose triangles change without
+     *   going through LoadEdgeIndices.
+     * - DrawMeshEdges(): Draws them as GL_LINES.
+     *   Returns false, drawing nothing, if the
+     *   mesh has none, so the caller can fall
+     *   back to the polygon mode.
+     ******************************************/
+
+    void LoadEdgeIndices(GLMesh& mesh, const GLfloat* verts, size_t vertexFloatCount, const GLuint* indices, size_t indexCount);
+    void ReleaseEdgeIndices(GLMesh& mesh);
+    bool DrawMeshEdges(const GLMesh& mesh) const;
+
+    /******************************************
+     * Shared Grid Index Buffers
+     * ---------------------------------------
+     * One reference-counted EBO per GridTopology
+     * in use.
+     *
+     * - BuildGridIndices(): Writes a topology's
+     *   index pattern.
+     * - BindGridIndices(): Gives the mesh the
+     *   shared EBO for topology (creating it on
+     *   first use) in place of whatever index
+     *   buffer it had, and binds it to the
+     *   currently bound VAO.
+     * - UnshareIndices(): Drops a mesh's
+     *   reference, if it holds one, so it can
+     *   upload indices of its own.
+     *
+     * The shared buffers' bytes are reported
+     * under "SharedIndices", not per mesh.
+     ******************************************/
+
+    struct SharedIndexBuffer {
+        GridTopology topology;
+        GLMesh buffer;          // ebo, nIndices and memory accounting
+        unsigned references = 0;
+    };
+
+    template <typename IndexArray>
+    static void BuildGridIndices(IndexArray& indices, const GridTopology& topology);
+    // Rebuilds a Duplicated-seam grid mesh (cols + 1 vertices a row) for a
+    // PoleMode other than Duplicated; returns the triangles it dropped.
+    static size_t ApplyPoleMode(MeshData& mesh, uint32_t cols, bool firstRowPole, bool lastRowPole, PoleMode poles);
+    void BindGridIndices(GLMesh& mesh, const GridTopology& topology);
+    void UnshareIndices(GLMesh& mesh);
+
+    std::vector<SharedIndexBuffer> m_SharedIndexBuffers;
+
+    /******************************************
+     * Procedural Grid State
+     * ---------------------------------------
+     * Each procedural shape has an empty VAO
+     * holding only the shared index buffer for
+     * the topology it last drew, so alternating
+     * shapes never rebinds or rebuilds indices.
+     ******************************************/
+
+    struct ProceduralGridMesh {
+        GLMesh mesh;            // vao and shared ebo only; vbo stays 0
+        GridTopology topology;
+    };
+
+    void DrawProceduralGrid(ProceduralGridMesh& grid, const ProceduralGridParams& params, bool wireframe);
+    void ReleaseProceduralGrid(ProceduralGridMesh& grid);
+
+    ProceduralGridUniforms m_ProceduralUniforms;
+    ProceduralGridMesh m_ProceduralSphere;
+    ProceduralGridMesh m_ProceduralHemisphere;
+    ProceduralGridMesh m_ProceduralTorus;
+    ProceduralGridMesh m_ProceduralSuperellipsoid;
+    bool m_ProceduralWarned = false;
+
+    /******************************************
+     * Tessellation State
+     * ---------------------------------------
+     * Every tessellated shape draws the same
+     * coarse patch mesh, created on first use;
+     * only the uniforms differ.
+     ******************************************/
+
+    void DrawTessellatedSurface(const TessellatedSurfaceParams& surface, bool wireframe);
+
+    TessellatedSurfaceUniforms m_TessellationUniforms;
+    GLMesh m_TessellationPatches;       // (s, t) patch corners, no indices
+    float m_TessellationEdgePixels = 8.0f;
+    float m_TessellationMaxLevel = 64.0f;
+    int m_TessellationViewport[2] = { 0, 0 };
+    bool m_TessellationWarned = false;
+
+    /******************************************
+     * Streamed Meshes
+     * ---------------------------------------
+     * The tapered torus, spiral, sine cone and
+     * superellipsoid are regenerated on every
+     * draw. When the context supports it their
+     * data goes into m_StreamRing instead of
+     * being re-uploaded with glBufferData:
+     *
+     * - BeginStreamedMesh(): Reserves ring space
+     *   for at most maxVertices and maxIndices,
+     *   creating or growing the ring (doubling
+     *   its segment size) when needed. Returns
+     *   false if streaming is unavailable.
+     * - The Build*Mesh generators then write
+     *   straight into the mapped reservation.
+     * - DrawStreamedMesh(): Keeps what was
+     *   written and draws it with a base vertex,
+     *   through a VAO that points at the ring.
+     * - CommitStreamedMesh(): Only keeps it.
+     * - CopyStreamedData(): Copies kept data into
+     *   a mesh's own buffer on the GPU.
+     ******************************************/
+
+    struct StreamedMesh {
+        MappedArray<GLfloat> vertices;
+        MappedArray<GLuint> indices;
+        size_t vertexOffset = 0;    // Bytes into the ring, a multiple of sizeof(Vertex)
+        size_t indexOffset = 0;
+    };
+
+    bool BeginStreamedMesh(size_t maxVertices, size_t maxIndices, StreamedMesh& streamed);
+    void DrawStreamedMesh(const StreamedMesh& streamed);
+    bool CommitStreamedMesh(const StreamedMesh& streamed);
+    void CopyStreamedData(GLMesh& mesh, MeshBufferStream stream, GLenum target, size_t offset, GLsizeiptr size);
+
+    MeshStreamRing m_StreamRing;
+    GLMesh m_StreamRingMesh;                // The ring's VAO and storage accounting (the ring owns the buffer)
+    bool m_StreamRingFailed = false;        // Creation failed once; stay on the meshes' own buffers
+
+    /******************************************
+     * Dynamic Mesh Dependencies
+     * ---------------------------------------
+     * What the own VBO and EBO of each dynamic
+     * mesh were last built from, so
+     * DrawDynamicMesh regenerates only the
+     * streams a parameter change affects.
+     *
+     * - StreamKey: The exact parameters (ints as
+     *   floats) one stream depends on. An empty
+     *   key matches nothing but another empty
+     *   key, which Make() never returns.
+     * - DynamicMeshState: The index stream's key
+     *   (topology: segment counts and the like),
+     *   the vertex stream's key (every
+     *   parameter), and the frame the buffers
+     *   were last written in.
+     * - DiscardArray: Index sink for vertex-only
+     *   regeneration; push_back only counts.
+     ******************************************/
+
+    struct StreamKey {
+        static constexpr uint32_t MaxParams = 10;
+
+        uint32_t paramCount = 0;
+        float params[MaxParams] = {};
+
+        static StreamKey Make(std::initializer_list<float> params);
+        bool operator==(const StreamKey& other) const;
+    };
+
+    struct DynamicMeshState {
+        StreamKey indexKey;
+        StreamKey vertexKey;
+        unsigned writtenFrame = ~0u;
+    };
+
+    template <typename T>
+    struct DiscardArray {
+        size_t count = 0;
+        void push_back(T) { ++count; }
+        void reserve(size_t) {}
+        size_t size() const { return count; }
+    };
+
+    template <typename Build>
+    void DrawDynamicMesh(GLMesh& mesh, DynamicMeshState& state, const StreamKey& indexKey, const StreamKey& vertexKey,
+        size_t maxVertices, size_t maxIndices, const GridTopology* topology, Build build);
+
+    DynamicMeshState m_TaperedTorusState;
+    DynamicMeshState m_SpiralState;
+    DynamicMeshState m_SineConeState;
+    DynamicMeshState m_SuperellipsoidState;
+    std::vector<GLfloat> m_DynamicVertices;   // Scratch for regeneration, kept to avoid per-draw allocation
+    std::vector<GLuint> m_DynamicIndices;
+    std::vector<MeshSubRange> m_ArcRanges;    // Scratch for DrawMeshArc
+    std::vector<MeshSubRange> m_PartRanges;   // Scratch for DrawMeshParts
+    std::vector<GLsizei> m_MultiDrawCounts;   // Scratch for DrawIndexRanges
+    std::vector<const void*> m_MultiDrawOffsets;
+    unsigned m_FrameIndex = 0;                // Advanced by EndFrame()
+
+    /******************************************
+     * Compute Generation
+     * ---------------------------------------
+     * The GPU counterparts of LoadGeneratedMesh
+     * and DrawDynamicMesh, used while
+     * SetComputeGeneration is on. Buffers are
+     * sized with ReserveBufferData and filled by
+     * m_Compute, so no vertex data crosses the
+     * bus. Dynamic meshes keep the same
+     * DynamicMeshState as on the CPU path, so
+     * unchanged parameters still draw without
+     * any work, and a shape-only change reruns
+     * just the vertex pass.
+     *
+     * DrawComputedMesh calls prepare(params) only
+     * when something must be regenerated; it
+     * fills the ComputeMeshParams (and, for the
+     * spiral, m_ComputeFrames).
+     ******************************************/
+
+    void ReserveBufferData(GLMesh& mesh, MeshBufferStream stream, GLenum target, GLsizeiptr size, GLenum usage);
+    void LoadComputedMesh(GLMesh& mesh, const ComputeMeshParams& params);
+    template <typename Prepare>
+    void DrawComputedMesh(GLMesh& mesh, DynamicMeshState& state, const StreamKey& indexKey, const StreamKey& vertexKey, Prepare prepare);
+    static GridTopology ComputedTopology(const ComputeMeshParams& params);
+
+    MeshComputeGenerator m_Compute;
+    bool m_ComputeGeneration = false;
+    std::vector<SpiralFrame> m_ComputeFrames;  // Scratch for the spiral's rings
+
+    template <typename VertexArray, typename IndexArray>
+    static void BuildTaperedTorusMesh(VertexArray& verts, IndexArray& indices, float mainRadius, float tubeRadiusStart, float tubeRadiusEnd, int mainSegments, int tubeSegments, float sweepAngleRadians);
+    static SweepCurve SpringCurve(float mainRadius, int mainSegments, int tubeSegments, float springLength, int& uniformSegments);
+    static void SpringParameters(std::vector<float>& angles, float mainRadius, int mainSegments, int tubeSegments, float springLength, float chordTolerance);
+    static SweepCurve SpiralCurve(float loopSpacing, float numLoops, int spiralSegments, int& uniformSegments);
+    static void SpiralCenterline(std::vector<SweepFrame>& frames, float loopSpacing, float numLoops, int spiralSegments, float chordTolerance = 0.0f);
+    template <typename VertexArray, typename IndexArray>
+    static void BuildSpiralMesh(VertexArray& verts, IndexArray& indices, float tubeRadius, float flattenFactor, float loopSpacing, float numLoops, int tubeSegments, int spiralSegments, float chordTolerance);
+    template <typename VertexArray, typename IndexArray>
+    static void BuildSineConeMesh(VertexArray& verts, IndexArray& indices, float baseRadius, float height, float flattenFactor, float sineAmplitude, float sineFrequency, float sinePhase, int radialSegments, int heightSegments);
+    template <typename VertexArray, typename IndexArray>
+    static void BuildSuperellipsoidMesh(VertexArray& verts, IndexArray& indices, float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent, int uSegments, int vSegments);
+    template <typename VertexArray, typename IndexArray>
+    static void BuildSuperellipsoidGrid(VertexArray& verts, IndexArray& indices, float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+        const std::vector<float>& uParams, const std::vector<float>& vParams);
+    static void SuperellipsoidParameters(std::vector<float>& uParams, std::vector<float>& vParams, float scaleX, float scaleY, float scaleZ,
+        float verticalExponent, float horizontalExponent, float maxError);
+    static float SuperellipsoidSurfaceError(float scaleX, float scaleY, float scaleZ, float verticalExponent, float horizontalExponent,
+        const std::vector<float>& uParams, const std::vector<float>& vParams);
+
+    // Sample positions of the last adaptive superellipsoid, reused while its parameters hold
+    StreamKey m_AdaptiveSuperellipsoidKey;
+    std::vector<float> m_AdaptiveSuperellipsoidU;
+    std::vector<float> m_AdaptiveSuperellipsoidV;
+
+    // Mesh bundle: m_BundleMesh owns the shared buffer, each entry its own VAO
+    GLMesh m_BundleMesh;
+    std::vector<BundledMesh> m_BundledMeshes;
+
+    // Every built-in mesh by report name, with the primitive its Draw function uses
+    // and whether that draw reads the EBO
+    struct NamedMesh {
+        const char* name;
+        GLMesh ShapeMeshes::* mesh;
+        GLenum mode;
+        bool indexed;
+    };
+
+    static const std::vector<NamedMesh>& MeshTable();
+
+    static const std::vector<std::pair<const char*, GLMesh ShapeMeshes::*>>& BundleTargets();
+    const BundledMesh* FindBundledMesh(const std::string& name, int lod) const;
+    void ReleaseMeshBundle();
+
+    // Meshes loaded by LoadImportedMesh, in load order
+    std::vector<ImportedMesh> m_ImportedMeshes;
+
+    // Directory for cached mesh files; empty disables the cache
+    std::string m_MeshCacheDirectory;
+    bool m_MeshCacheCompressed = false;
+
+    // See SetEdgeWireframes
+    bool m_EdgeWireframes = false;
+    bool m_EdgeOmitDiagonals = false;
+
+    /******************************************
+     * LoadGeneratedMesh
+     * ---------------------------------------
+     * Uploads a generated mesh, going through the
+     * mesh cache when one is set. On a cache hit
+     * the entry is memory-mapped and uploaded
+     * straight from the mapping; otherwise
+     * generate() fills a MeshData, which is
+     * stored in the cache and then uploaded.
+     * With a topology, the mesh draws with the
+     * shared index buffer for it (see
+     * InitializeGridMesh).
+     ******************************************/
+
+    void LoadGeneratedMesh(GLMesh& mesh, const MeshCacheKey& key, const std::function<void(MeshData&)>& generate,
+        const GridTopology* topology = nullptr);
+
     /******************************************
      * Normal Calculation Functions
      * ---------------------------------------
@@ -0,0 +1,405 @@
+///////////////////////////////////////////////////////////////////////////////
+// ShapeMeshesBenchmark.cpp
+// ========================
+// Headless microbenchmark for the ShapeMeshes generator layer.
+//
+// Every GenerateXMesh function is timed across a segment-count sweep
+// (8 to 4096 by default, doubling each step). No OpenGL context is
+// needed: only the CPU-side generators are called.
+//
+// For each (shape, segments) pair the benchmark reports:
+//   - vertex and index counts
+//   - best and mean wall time per generation
+//   - vertices per second (from the best time)
+//   - bytes and number of heap allocations per generation
+//   - MeshCodec compression: encoded size, compression ratio against the
+//     raw 32-byte vertices and 32-bit indices, encode time, decode time
+//     and throughput (decoded bytes per second), and the largest position
+//     error introduced by quantization
+//
+// Results are written as JSON so regressions can be tracked over time. The
+// tracked figures are the generator timings from a --no-codec run; the codec
+// decode rate is reported for reference but stays well below memcpy (see
+// MeshCodec.h) and is too noisy to gate on.
+//
+// Build (example):
+//   g++ -O2 -std=c++17 ShapeMeshesBenchmark.cpp ShapeMeshes.cpp MeshCompute.cpp TessellatedSurface.cpp MeshSweep.cpp MeshLathe.cpp ProceduralGrid.cpp MeshCache.cpp MeshCodec.cpp MeshExport.cpp MeshImport.cpp MeshStreamRing.cpp -lGLEW -lGL
+//
+// Usage:
+//   ShapeMeshesBenchmark [--min-segments N] [--max-segments N]
+//                        [--max-vertices N] [--min-time SECONDS]
+//                        [--no-codec] [--out FILE]
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeMeshes.h"
+#include "MeshCodec.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+/******************************************
+ * Allocation Tracking
+ * ---------------------------------------
+ * Global operator new/delete are replaced so
+ * every heap allocation made while a generator
+ * runs is counted. Each block carries a small
+ * header holding its size so live bytes can
+ * be tracked on release as well.
+ ******************************************/
+
+namespace AllocStats
+{
+	std::atomic<unsigned long long> bytes{ 0 };
+	std::atomic<unsigned long long> count{ 0 };
+	std::atomic<long long> live{ 0 };
+	std::atomic<long long> peak{ 0 };
+	long long baseline = 0;
+
+	constexpr std::size_t HeaderSize = alignof(std::max_align_t);
+
+	void Reset()
+	{
+		bytes = 0;
+		count = 0;
+		baseline = live.load();
+		peak = baseline;
+	}
+
+	void* Allocate(std::size_t size)
+	{
+		void* block = std::malloc(size + HeaderSize);
+		if (!block) throw std::bad_alloc();
+
+		*static_cast<std::size_t*>(block) = size;
+		bytes += size;
+		++count;
+
+		long long now = (live += static_cast<long long>(size));
+		long long prev = peak.load();
+		while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+
+		return static_cast<char*>(block) + HeaderSize;
+	}
+
+	void Release(void* ptr)
+	{
+		if (!ptr) return;
+		void* block = static_cast<char*>(ptr) - HeaderSize;
+		live -= static_cast<long long>(*static_cast<std::size_t*>(block));
+		std::free(block);
+	}
+}
+
+void* operator new(std::size_t size) { return AllocStats::Allocate(size); }
+void* operator new[](std::size_t size) { return AllocStats::Allocate(size); }
+void operator delete(void* ptr) noexcept { AllocStats::Release(ptr); }
+void operator delete[](void* ptr) noexcept { AllocStats::Release(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { AllocStats::Release(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { AllocStats::Release(ptr); }
+
+/******************************************
+ * GeneratorCase
+ * ---------------------------------------
+ * One benchmarked generator.
+ *
+ * - name: Identifier used in the JSON output.
+ * - estimateVertices: Vertex count for a given
+ *   segment count, used to skip cases above the
+ *   vertex budget before allocating anything.
+ * - generate: Runs the generator with every
+ *   segment parameter set to the given count.
+ ******************************************/
+
+struct GeneratorCase
+{
+	const char* name;
+	std::function<double(int)> estimateVertices;
+	std::function<void(MeshData&, int)> generate;
+};
+
+static std::vector<GeneratorCase> BuildCases()
+{
+	// Shape parameters other than segment counts use the same defaults
+	// as the scene code, so timings reflect realistic shapes.
+	return {
+		{ "cone",
+			[](int n) { return double(3 * n + 2); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 1.0f, n); } },
+		{ "cylinder",
+			[](int n) { return double(4 * n + 6); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateCylinderMesh(m, 1.0f, 1.0f, n); } },
+		{ "tapered_cylinder",
+			[](int n) { return double(4 * n + 2); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateTaperedCylinderMesh(m, 1.0f, 0.5f, 1.0f, n); } },
+		{ "sphere",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateSphereMesh(m, n, n, 1.0f); } },
+		{ "hemisphere",
+			[](int n) { return double(n / 2 + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateHemisphereMesh(m, n, n, 1.0f); } },
+		{ "torus",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.25f, n, n); } },
+		{ "spring",
+			// 6 coils, tube resolution swept; rings = coils * tubeSegments + 1
+			[](int n) { return double(6 * n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.1f, 6, n, 4.0f); } },
+		{ "tube",
+			[](int n) { return double(n + 1) * 4; },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateTubeMesh(m, 2.0f, 1.7f, 1.0f, n); } },
+		{ "curved_cone",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateCurvedConeMesh(m, n, n, 0.5f, 2.0f, 3.0f); } },
+		{ "tapered_torus",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateTaperedTorusMesh(m, 1.0f, 0.3f, 0.05f, n, n, 2.0f * 3.14159265f); } },
+		{ "spiral",
+			[](int n) { return double(n + 1) * n + 8.0 * n; },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateSpiralMesh(m, 0.1f, 0.3f, 0.3f, 3.0f, n, n); } },
+		{ "sine_cone",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateSineConeMesh(m, 0.5f, 2.0f, 0.2f, 0.1f, 2.0f, 0.0f, n, n); } },
+		{ "superellipsoid",
+			[](int n) { return double(n + 1) * (n + 1); },
+			[](MeshData& m, int n) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 1.0f, 1.0f, 0.5f, 0.5f, n, n); } },
+	};
+}
+
+/******************************************
+ * CaseResult
+ * ---------------------------------------
+ * Measurements for one (shape, segments) run.
+ ******************************************/
+
+struct CaseResult
+{
+	std::string shape;
+	int segments = 0;
+	bool skipped = false;
+	unsigned long long vertices = 0;
+	unsigned long long indices = 0;
+	int iterations = 0;
+	double bestSeconds = 0.0;
+	double meanSeconds = 0.0;
+	unsigned long long bytesAllocated = 0;
+	unsigned long long allocations = 0;
+	long long peakBytes = 0;
+
+	// MeshCodec results (codec == false when not measured)
+	bool codec = false;
+	unsigned long long rawBytes = 0;
+	unsigned long long encodedBytes = 0;
+	double encodeSeconds = 0.0;
+	double decodeSeconds = 0.0;       // best of the decode runs
+	float maxPositionError = 0.0f;
+};
+
+/******************************************
+ * MeasureCodec
+ * ---------------------------------------
+ * Encodes the generated mesh once, then
+ * decodes it repeatedly (until minTime) into
+ * preallocated arrays, as a loader would.
+ ******************************************/
+
+static void MeasureCodec(const MeshData& mesh, double minTime, CaseResult& result)
+{
+	using Clock = std::chrono::steady_clock;
+
+	std::vector<unsigned char> encoded;
+	auto start = Clock::now();
+	if (!MeshCodec::Encode(mesh.vertices.data(), mesh.vertices.size(), mesh.indices.data(), mesh.indices.size(), encoded))
+		return;
+	result.encodeSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+	std::vector<GLfloat> vertices(mesh.vertices.size());
+	std::vector<GLuint> indices(mesh.indices.size());
+	double total = 0.0;
+	double best = 1e300;
+	int iterations = 0;
+
+	do {
+		start = Clock::now();
+		MeshCodec::Decode(encoded.data(), encoded.size(), vertices.data(), indices.data());
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		total += seconds;
+		best = std::min(best, seconds);
+		++iterations;
+	} while (total < minTime && iterations < 1000);
+
+	const size_t floatsPerVertex = sizeof(Vertex) / sizeof(GLfloat);
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		if (i % floatsPerVertex < 3)
+			result.maxPositionError = std::max(result.maxPositionError, std::fabs(vertices[i] - mesh.vertices[i]));
+	}
+
+	result.codec = true;
+	result.rawBytes = mesh.vertices.size() * sizeof(GLfloat) + mesh.indices.size() * sizeof(GLuint);
+	result.encodedBytes = encoded.size();
+	result.decodeSeconds = best;
+}
+
+static CaseResult RunCase(const GeneratorCase& gen, int segments, double minTime, bool codec)
+{
+	using Clock = std::chrono::steady_clock;
+
+	CaseResult result;
+	result.shape = gen.name;
+	result.segments = segments;
+
+	double total = 0.0;
+	double best = 1e300;
+	int iterations = 0;
+
+	// Repeat until the accumulated time reaches minTime, always at least
+	// once. A fresh MeshData per iteration keeps allocation figures honest.
+	do {
+		MeshData mesh;
+		AllocStats::Reset();
+
+		auto start = Clock::now();
+		gen.generate(mesh, segments);
+		auto stop = Clock::now();
+
+		double seconds = std::chrono::duration<double>(stop - start).count();
+		total += seconds;
+		best = std::min(best, seconds);
+		++iterations;
+
+		result.vertices = mesh.VertexCount();
+		result.indices = mesh.IndexCount();
+		result.bytesAllocated = AllocStats::bytes.load();
+		result.allocations = AllocStats::count.load();
+		result.peakBytes = AllocStats::peak.load() - AllocStats::baseline;
+	} while (total < minTime && iterations < 1000);
+
+	result.iterations = iterations;
+	result.bestSeconds = best;
+	result.meanSeconds = total / iterations;
+
+	if (codec) {
+		MeshData mesh;
+		gen.generate(mesh, segments);
+		MeasureCodec(mesh, minTime, result);
+	}
+
+	return result;
+}
+
+static void WriteJson(FILE* out, const std::vector<CaseResult>& results, int minSegments, int maxSegments, double maxVertices)
+{
+	std::fprintf(out, "{\n");
+	std::fprintf(out, "  \"benchmark\": \"ShapeMeshes generators\",\n");
+	std::fprintf(out, "  \"vertex_bytes\": %zu,\n", sizeof(Vertex));
+	std::fprintf(out, "  \"min_segments\": %d,\n", minSegments);
+	std::fprintf(out, "  \"max_segments\": %d,\n", maxSegments);
+	std::fprintf(out, "  \"max_vertices\": %.0f,\n", maxVertices);
+	std::fprintf(out, "  \"results\": [\n");
+
+	for (size_t i = 0; i < results.size(); ++i) {
+		const CaseResult& r = results[i];
+		const char* sep = (i + 1 < results.size()) ? "," : "";
+
+		if (r.skipped) {
+			std::fprintf(out, "    { \"shape\": \"%s\", \"segments\": %d, \"skipped\": true }%s\n",
+				r.shape.c_str(), r.segments, sep);
+			continue;
+		}
+
+		double vertsPerSecond = r.bestSeconds > 0.0 ? r.vertices / r.bestSeconds : 0.0;
+		std::fprintf(out,
+			"    { \"shape\": \"%s\", \"segments\": %d, \"vertices\": %llu, \"indices\": %llu, "
+			"\"iterations\": %d, \"best_ns\": %.0f, \"mean_ns\": %.0f, \"vertices_per_second\": %.0f, "
+			"\"bytes_allocated\": %llu, \"allocations\": %llu, \"peak_bytes\": %lld",
+			r.shape.c_str(), r.segments, r.vertices, r.indices,
+			r.iterations, r.bestSeconds * 1e9, r.meanSeconds * 1e9, vertsPerSecond,
+			r.bytesAllocated, r.allocations, r.peakBytes);
+
+		if (r.codec) {
+			double ratio = r.encodedBytes ? double(r.rawBytes) / r.encodedBytes : 0.0;
+			double decodeGBps = r.decodeSeconds > 0.0 ? r.rawBytes / r.decodeSeconds / 1e9 : 0.0;
+			std::fprintf(out,
+				", \"codec\": { \"raw_bytes\": %llu, \"encoded_bytes\": %llu, \"ratio\": %.3f, "
+				"\"encode_ns\": %.0f, \"decode_ns\": %.0f, \"decode_gb_per_second\": %.3f, \"max_position_error\": %g }",
+				r.rawBytes, r.encodedBytes, ratio,
+				r.encodeSeconds * 1e9, r.decodeSeconds * 1e9, decodeGBps, r.maxPositionError);
+		}
+
+		std::fprintf(out, " }%s\n", sep);
+	}
+
+	std::fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+	int minSegments = 8;
+	int maxSegments = 4096;
+	double maxVertices = 4.0 * 1024 * 1024;  // skip cases above ~128 MB of vertex data
+	double minTime = 0.2;
+	const char* outPath = nullptr;
+	bool codec = true;
+
+	for (int i = 1; i < argc; ++i) {
+		auto next = [&](const char* flag) -> const char* {
+			if (i + 1 >= argc) {
+				std::fprintf(stderr, "Error: %s requires a value.\n", flag);
+				std::exit(2);
+			}
+			return argv[++i];
+		};
+
+		if (!std::strcmp(argv[i], "--min-segments")) minSegments = std::atoi(next(argv[i]));
+		else if (!std::strcmp(argv[i], "--max-segments")) maxSegments = std::atoi(next(argv[i]));
+		else if (!std::strcmp(argv[i], "--max-vertices")) maxVertices = std::atof(next(argv[i]));
+		else if (!std::strcmp(argv[i], "--min-time")) minTime = std::atof(next(argv[i]));
+		else if (!std::strcmp(argv[i], "--no-codec")) codec = false;
+		else if (!std::strcmp(argv[i], "--out")) outPath = next(argv[i]);
+		else {
+			std::fprintf(stderr, "Usage: %s [--min-segments N] [--max-segments N] [--max-vertices N] [--min-time S] [--no-codec] [--out FILE]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (minSegments < 3) minSegments = 3;
+	if (maxSegments < minSegments) maxSegments = minSegments;
+
+	std::vector<CaseResult> results;
+	for (const GeneratorCase& gen : BuildCases()) {
+		for (int segments = minSegments; segments <= maxSegments; segments *= 2) {
+			if (gen.estimateVertices(segments) > maxVertices) {
+				CaseResult skipped;
+				skipped.shape = gen.name;
+				skipped.segments = segments;
+				skipped.skipped = true;
+				results.push_back(skipped);
+				continue;
+			}
+
+			results.push_back(RunCase(gen, segments, minTime, codec));
+			std::fprintf(stderr, "%-16s %5d segments: %10llu vertices\n",
+				gen.name, segments, results.back().vertices);
+		}
+	}
+
+	FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+	if (!out) {
+		std::fprintf(stderr, "Error: cannot open %s for writing.\n", outPath);
+		return 1;
+	}
+
+	WriteJson(out, results, minSegments, maxSegments, maxVertices);
+
+	if (out != stdout) std::fclose(out);
+	return 0;
+}
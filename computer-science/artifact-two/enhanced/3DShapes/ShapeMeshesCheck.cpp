@@ -0,0 +1,2219 @@
+///////////////////////////////////////////////////////////////////////////////
+// ShapeMeshesCheck.cpp
+// ====================
+// Headless checks of the enhanced ShapeMeshes, one case per feature. Each
+// case is described above its namespace below; the ones that need a GPU
+// create their own surfaceless context (see HeadlessContext.h), so every
+// case runs on its own GL state.
+//
+// Build:
+//   g++ -O2 -std=c++17 ShapeMeshesCheck.cpp ShapeMeshes.cpp MeshCompute.cpp TessellatedSurface.cpp MeshSweep.cpp MeshLathe.cpp ProceduralGrid.cpp MeshCache.cpp MeshCodec.cpp MeshExport.cpp MeshImport.cpp MeshStreamRing.cpp -lGLEW -lEGL -lGL
+//
+// Usage:
+//   LIBGL_ALWAYS_SOFTWARE=1 ShapeMeshesCheck [--list] [--case NAME]... [--tolerance T]
+//       [--edge-pixels P] [--bench] [--repeats N]
+//
+//   --list         Print the case names and exit.
+//   --case         Run only the named case; may be repeated. All cases run
+//                  by default.
+//   --tolerance    Largest vertex error the GL comparisons accept (1e-4).
+//   --edge-pixels  Target patch edge length of TessellatedSurface (8).
+//   --bench        Also time CPU against compute generation (MeshCompute).
+//   --repeats      Repeats per timing with --bench (5).
+//
+// Exits non-zero if any case fails.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ShapeMeshes.h"
+#include "HeadlessContext.h"
+#include "MeshCache.h"
+#include "MeshCompute.h"
+#include "MeshImport.h"
+#include "ProceduralGrid.h"
+#include "TessellatedSurface.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	/******************************************
+	 * CheckOptions
+	 * ---------------------------------------
+	 * The command-line settings, passed to every
+	 * case; each reads only its own.
+	 ******************************************/
+
+	struct CheckOptions {
+		double tolerance = 1e-4;
+		float edgePixels = 8.0f;
+		bool bench = false;
+		int repeats = 5;
+	};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// AdaptiveSuperellipsoid
+// ----------------------
+// Headless report on error-bounded superellipsoid tessellation (see
+// ShapeMeshes::ReportSuperellipsoidTessellation).
+//
+// For a range of exponents, from near-boxy to pinched, and several target
+// errors it prints the adaptive grid, its triangles and measured surface
+// error, and the fewest evenly spaced segments that measure as well, with
+// the triangles saved.
+//
+// Each case checks that:
+// - the measured surface error is within the target;
+// - GenerateAdaptiveSuperellipsoidMesh builds that grid, (u + 1) x (v + 1)
+//   vertices and u * v * 6 indices.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace AdaptiveSuperellipsoidCheck
+{
+	struct CheckCase {
+		const char* name;
+		float scaleX, scaleY, scaleZ;
+		float verticalExponent, horizontalExponent;
+	};
+
+	const CheckCase Cases[] = {
+		{ "sphere",          1.0f, 1.0f, 1.0f, 1.0f, 1.0f },
+		{ "rounded box",     1.0f, 1.0f, 1.0f, 0.2f, 0.2f },
+		{ "box",             1.0f, 1.0f, 1.0f, 0.1f, 0.1f },
+		{ "stretched",       2.0f, 1.0f, 0.5f, 0.3f, 0.6f },
+		{ "star",            1.0f, 1.0f, 1.0f, 2.5f, 2.5f },
+		{ "pinched cushion", 1.0f, 1.0f, 1.0f, 3.0f, 0.2f },
+	};
+
+	int Run(const CheckOptions&)
+	{
+		const float targets[] = { 1e-2f, 3e-3f, 1e-3f };
+
+		std::printf("%-16s %7s %9s %9s %10s %9s %9s %10s %7s\n",
+			"shape", "target", "adaptive", "triangles", "error", "uniform", "triangles", "error", "saved");
+
+		int failures = 0;
+		MeshData mesh;
+		for (const CheckCase& check : Cases) {
+			for (float target : targets) {
+				SuperellipsoidTessellationReport report = ShapeMeshes::ReportSuperellipsoidTessellation(
+					check.scaleX, check.scaleY, check.scaleZ, check.verticalExponent, check.horizontalExponent, target);
+				ShapeMeshes::GenerateAdaptiveSuperellipsoidMesh(mesh,
+					check.scaleX, check.scaleY, check.scaleZ, check.verticalExponent, check.horizontalExponent, target);
+
+				const size_t u = static_cast<size_t>(report.uSegments);
+				const size_t v = static_cast<size_t>(report.vSegments);
+				const bool passed = report.surfaceError <= target
+					&& mesh.vertices.size() == (u + 1) * (v + 1) * 8
+					&& mesh.indices.size() == u * v * 6;
+				if (!passed) ++failures;
+
+				std::printf("%-16s %7.0e %4dx%-4d %9zu %10.3g %4dx%-4d %9zu %10.3g %6.1f%%  %s\n",
+					check.name, target, report.uSegments, report.vSegments, report.Triangles(), report.surfaceError,
+					report.uniformUSegments, report.uniformVSegments, report.UniformTriangles(), report.uniformSurfaceError,
+					100.0f * report.Savings(), passed ? "ok" : "FAILED");
+			}
+		}
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ArcRange
+// --------
+// Headless check of the angular index ranges DrawMeshArc draws (see
+// ShapeMeshes::ArcLayoutFor and ShapeMeshes::ArcIndexRanges).
+//
+// For the cone (both side modes), cylinder, tapered cylinder, tube and torus
+// at several slice counts it checks that:
+// - the layout matches the generated mesh: every triangle of slice i has
+//   its centroid within that slice's wedge, and the blocks cover the whole
+//   index buffer;
+// - a full turn gives back the whole mesh;
+// - for a spread of ranges, some wrapping past 2 pi or starting below 0,
+//   the ranges take in exactly the slices that overlap [a0, a1], with and
+//   without the caps.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace ArcRangeCheck
+{
+	const float TwoPi = 6.28318531f;
+
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - generate: Builds the shape with the
+	 *   given slices.
+	 * - aroundZ: Angles are measured in the XY
+	 *   plane (the torus) rather than XZ.
+	 ******************************************/
+
+	struct CheckCase {
+		std::string name;
+		ShapeMeshes::ArcShape shape;
+		std::function<void(MeshData&, int)> generate;
+		bool aroundZ;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		using Shape = ShapeMeshes::ArcShape;
+		return {
+			{ "cone", Shape::cone, [](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n); }, false },
+			{ "cone (welded)", Shape::cone, [](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n, ConeSideMode::Welded); }, false },
+			{ "cylinder", Shape::cylinder, [](MeshData& m, int n) { ShapeMeshes::GenerateCylinderMesh(m, 1.0f, 2.0f, n); }, false },
+			{ "tapered cylinder", Shape::taperedCylinder, [](MeshData& m, int n) { ShapeMeshes::GenerateTaperedCylinderMesh(m, 1.0f, 0.5f, 2.0f, n); }, false },
+			{ "tube", Shape::tube, [](MeshData& m, int n) { ShapeMeshes::GenerateTubeMesh(m, 1.0f, 0.7f, 2.0f, n); }, false },
+			{ "torus", Shape::torus, [](MeshData& m, int n) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.25f, n, 12); }, true },
+		};
+	}
+
+	// Slice of each triangle, or -1 where the layout does not reach it.
+	std::vector<int> TriangleSlices(const ArcLayout& layout, size_t triangles)
+	{
+		std::vector<int> slices(triangles, -1);
+		for (const ArcBlock& block : layout.blocks) {
+			const size_t perSlice = block.indicesPerSlice / 3;
+			for (size_t t = 0; t < perSlice * layout.slices; ++t) {
+				size_t triangle = block.firstIndex / 3 + t;
+				if (triangle < triangles) slices[triangle] = static_cast<int>(t / perSlice);
+			}
+		}
+		return slices;
+	}
+
+	float CentroidAngle(const MeshData& mesh, size_t triangle, bool aroundZ)
+	{
+		float a = 0.0f, b = 0.0f;
+		for (size_t k = 0; k < 3; ++k) {
+			const GLfloat* v = &mesh.vertices[mesh.indices[3 * triangle + k] * 8];
+			a += v[0];
+			b += aroundZ ? v[1] : v[2];
+		}
+		float angle = std::atan2(b, a);
+		return angle < 0.0f ? angle + TwoPi : angle;
+	}
+
+	// Whether slice i of n overlaps the open range (a0, a0 + span), all angles mod 2 pi.
+	bool Overlaps(int i, int n, float a0, float span)
+	{
+		const float step = TwoPi / n;
+		float start = std::fmod(a0, TwoPi);
+		if (start < 0.0f) start += TwoPi;
+		for (float shift : { -TwoPi, 0.0f, TwoPi }) {
+			float lo = i * step + shift;
+			if (lo + step > start + 1e-3f && lo < start + span - 1e-3f) return true;
+		}
+		return false;
+	}
+
+	int Run(const CheckOptions&)
+	{
+		const float ranges[][2] = {
+			{ 0.0f, 3.14159265f }, { 0.3f, 1.1f }, { 5.5f, 7.0f }, { -1.0f, 0.5f },
+			{ 1.0f, 1.0001f }, { 2.0f, 2.0f + TwoPi }, { 0.0f, 1.5707963f },
+		};
+
+		std::printf("%-18s %6s %9s %9s %12s\n", "shape", "slices", "triangles", "ranges", "drawn (caps)");
+
+		int failures = 0;
+		MeshData mesh;
+		std::vector<MeshSubRange> drawn;
+		for (const CheckCase& check : BuildCases()) {
+			for (int slices : { 3, 8, 18, 64 }) {
+				check.generate(mesh, slices);
+				const ArcLayout layout = ShapeMeshes::ArcLayoutFor(check.shape, slices, mesh.indices.size());
+				const size_t triangles = mesh.indices.size() / 3;
+				const std::vector<int> sliceOf = TriangleSlices(layout, triangles);
+
+				bool passed = true;
+				const float step = TwoPi / slices;
+				for (size_t t = 0; t < triangles; ++t) {
+					if (sliceOf[t] < 0) { passed = false; continue; }
+					float angle = CentroidAngle(mesh, t, check.aroundZ);
+					if (angle < sliceOf[t] * step - 1e-3f || angle > (sliceOf[t] + 1) * step + 1e-3f) passed = false;
+				}
+
+				ShapeMeshes::ArcIndexRanges(drawn, layout, 0.5f, 0.5f + TwoPi);
+				size_t full = 0;
+				for (const MeshSubRange& range : drawn) full += range.count;
+				if (full != mesh.indices.size()) passed = false;
+
+				size_t rangeCount = 0, drawnTriangles = 0;
+				for (const float* range : ranges) {
+					for (bool caps : { true, false }) {
+						ShapeMeshes::ArcIndexRanges(drawn, layout, range[0], range[1], caps);
+						std::vector<bool> selected(triangles, false);
+						for (const MeshSubRange& r : drawn)
+							for (GLuint i = r.first / 3; i < (r.first + r.count) / 3; ++i)
+								selected[i] = true;
+
+						const float span = range[1] - range[0];
+						for (size_t t = 0; t < triangles; ++t) {
+							bool isCap = false;
+							for (const ArcBlock& block : layout.blocks)
+								if (t >= block.firstIndex / 3 && t < block.firstIndex / 3 + block.indicesPerSlice / 3 * static_cast<size_t>(slices))
+									isCap = block.cap;
+							const bool wanted = (caps || !isCap) && (span >= TwoPi || Overlaps(sliceOf[t], slices, range[0], span));
+							if (selected[t] != wanted) passed = false;
+							if (selected[t] && caps) ++drawnTriangles;
+						}
+						rangeCount += drawn.size();
+					}
+				}
+
+				if (!passed) ++failures;
+				std::printf("%-18s %6d %9zu %9zu %12zu  %s\n",
+					check.name.c_str(), slices, triangles, rangeCount, drawnTriangles, passed ? "ok" : "FAILED");
+			}
+		}
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// EdgeWireframe
+// -------------
+// Headless check of the unique-edge line lists drawn for wireframes (see
+// ShapeMeshes::BuildEdgeIndices and ShapeMeshes::SetEdgeWireframes).
+//
+// For each shape at several sizes it prints the lines the polygon mode draws
+// (three per triangle) against the unique edges, with and without quad
+// diagonals, and checks that:
+// - the unique edges are exactly the edges of the triangles once vertices at
+//   the same position are taken as one, each listed once, none of zero
+//   length;
+// - the list without diagonals is part of the full list, each edge it
+//   leaves out is shared by exactly two triangles, and no triangle loses
+//   more than one edge (a quad's diagonal, not a side between two quads);
+// - for the grids whose count is known in closed form (Duplicated sphere,
+//   torus), the edges number as expected: lon (3 lat - 3) and 3 n m in
+//   full, lon (2 lat - 1) and 2 n m without diagonals.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace EdgeWireframeCheck
+{
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - generate: Builds the shape at a size.
+	 * - fullEdges / quadEdges: Expected edge
+	 *   counts with and without diagonals, or
+	 *   nullptr where there is no closed form.
+	 ******************************************/
+
+	struct CheckCase {
+		std::string name;
+		std::function<void(MeshData&, int)> generate;
+		std::function<size_t(int)> fullEdges;
+		std::function<size_t(int)> quadEdges;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		return {
+			{ "cone", [](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n); }, nullptr, nullptr },
+			{ "cone (welded)", [](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n, ConeSideMode::Welded); }, nullptr, nullptr },
+			{ "cylinder", [](MeshData& m, int n) { ShapeMeshes::GenerateCylinderMesh(m, 1.0f, 2.0f, n); }, nullptr, nullptr },
+			{ "tapered cylinder", [](MeshData& m, int n) { ShapeMeshes::GenerateTaperedCylinderMesh(m, 1.0f, 0.5f, 2.0f, n); }, nullptr, nullptr },
+			{ "tube", [](MeshData& m, int n) { ShapeMeshes::GenerateTubeMesh(m, 1.0f, 0.7f, 2.0f, n); }, nullptr, nullptr },
+			{ "sphere", [](MeshData& m, int n) { ShapeMeshes::GenerateSphereMesh(m, n, n, 1.0f); },
+				[](int n) { return size_t(n) * (3 * n - 3); }, [](int n) { return size_t(n) * (2 * n - 1); } },
+			{ "sphere (trimmed)", [](MeshData& m, int n) { ShapeMeshes::GenerateSphereMesh(m, n, n, 1.0f, PoleMode::Trimmed); }, nullptr, nullptr },
+			{ "sphere (welded)", [](MeshData& m, int n) { ShapeMeshes::GenerateSphereMesh(m, n, n, 1.0f, PoleMode::Welded); }, nullptr, nullptr },
+			{ "hemisphere", [](MeshData& m, int n) { ShapeMeshes::GenerateHemisphereMesh(m, n, n, 1.0f); }, nullptr, nullptr },
+			{ "torus", [](MeshData& m, int n) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.25f, n, n / 2 + 3); },
+				[](int n) { return size_t(3) * n * (n / 2 + 3); }, [](int n) { return size_t(2) * n * (n / 2 + 3); } },
+			{ "spring", [](MeshData& m, int n) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.2f, n, n / 2 + 3, 3.0f); }, nullptr, nullptr },
+			{ "superellipsoid", [](MeshData& m, int n) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 1.0f, 1.0f, 0.4f, 0.4f, n, n); }, nullptr, nullptr },
+		};
+	}
+
+	using EdgeSet = std::set<std::pair<GLuint, GLuint>>;
+
+	std::pair<GLuint, GLuint> Key(GLuint a, GLuint b) { return { std::min(a, b), std::max(a, b) }; }
+
+	// The first vertex within tolerance of each vertex, found independently of the hash grid.
+	std::vector<GLuint> FirstAtPosition(const MeshData& mesh, float tolerance)
+	{
+		auto position = [&](GLuint i) { return glm::vec3(mesh.vertices[8 * i], mesh.vertices[8 * i + 1], mesh.vertices[8 * i + 2]); };
+
+		std::vector<std::pair<float, GLuint>> byX;
+		for (GLuint i = 0; i < mesh.VertexCount(); ++i) byX.push_back({ position(i).x, i });
+		std::sort(byX.begin(), byX.end());
+
+		std::vector<GLuint> first(mesh.VertexCount());
+		for (GLuint i = 0; i < mesh.VertexCount(); ++i) {
+			first[i] = i;
+			const glm::vec3 p = position(i);
+			auto it = std::lower_bound(byX.begin(), byX.end(), std::make_pair(p.x - tolerance, GLuint(0)));
+			for (; it != byX.end() && it->first <= p.x + tolerance; ++it) {
+				const GLuint j = it->second;
+				const glm::vec3 d = position(j) - p;
+				if (j < first[i] && first[j] == j && glm::dot(d, d) <= tolerance * tolerance) first[i] = j;
+			}
+		}
+		return first;
+	}
+
+	int Run(const CheckOptions&)
+	{
+		std::printf("%-18s %5s %10s %10s %10s %8s\n", "shape", "size", "poly lines", "edges", "quads", "saved");
+
+		int failures = 0;
+		MeshData mesh;
+		std::vector<GLuint> full, quads;
+		for (const CheckCase& check : BuildCases()) {
+			for (int size : { 8, 18, 64 }) {
+				check.generate(mesh, size);
+				ShapeMeshes::BuildEdgeIndices(full, mesh.vertices.data(), mesh.VertexCount(), mesh.indices.data(), mesh.indices.size(), false);
+				ShapeMeshes::BuildEdgeIndices(quads, mesh.vertices.data(), mesh.VertexCount(), mesh.indices.data(), mesh.indices.size(), true);
+
+				// --- Reference edges, with the solid triangles on each ---
+				const std::vector<GLuint> first = FirstAtPosition(mesh, 1e-5f);
+				std::map<std::pair<GLuint, GLuint>, int> reference;
+				for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+					const GLuint corner[3] = { first[mesh.indices[t]], first[mesh.indices[t + 1]], first[mesh.indices[t + 2]] };
+					const bool solid = corner[0] != corner[1] && corner[1] != corner[2] && corner[0] != corner[2];
+					for (int k = 0; k < 3; ++k) {
+						if (corner[k] == corner[(k + 1) % 3]) continue;
+						reference[Key(corner[k], corner[(k + 1) % 3])] += solid ? 1 : 0;
+					}
+				}
+
+				bool passed = full.size() % 2 == 0 && quads.size() % 2 == 0;
+				EdgeSet fullSet, quadSet;
+				for (size_t i = 0; i + 1 < full.size(); i += 2) {
+					const auto key = Key(full[i], full[i + 1]);
+					if (full[i] == full[i + 1] || !fullSet.insert(key).second || reference.count(key) == 0) passed = false;
+				}
+				if (fullSet.size() != reference.size()) passed = false;
+
+				for (size_t i = 0; i + 1 < quads.size(); i += 2) {
+					const auto key = Key(quads[i], quads[i + 1]);
+					if (!quadSet.insert(key).second || fullSet.count(key) == 0) passed = false;
+				}
+				for (const auto& edge : fullSet)
+					if (quadSet.count(edge) == 0 && reference[edge] != 2) passed = false;
+				for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+					const GLuint corner[3] = { first[mesh.indices[t]], first[mesh.indices[t + 1]], first[mesh.indices[t + 2]] };
+					int lost = 0;
+					for (int k = 0; k < 3; ++k)
+						if (corner[k] != corner[(k + 1) % 3] && quadSet.count(Key(corner[k], corner[(k + 1) % 3])) == 0) ++lost;
+					if (lost > 1 && corner[0] != corner[1] && corner[1] != corner[2] && corner[0] != corner[2]) passed = false;
+				}
+
+				if (check.fullEdges && (fullSet.size() != check.fullEdges(size) || quadSet.size() != check.quadEdges(size)))
+					passed = false;
+
+				if (!passed) ++failures;
+				const size_t polygonLines = mesh.indices.size();
+				std::printf("%-18s %5d %10zu %10zu %10zu %7.1f%%  %s\n",
+					check.name.c_str(), size, polygonLines, fullSet.size(), quadSet.size(),
+					100.0 * (1.0 - double(quadSet.size()) / double(polygonLines)), passed ? "ok" : "FAILED");
+			}
+		}
+
+		// --- A unit box, one quad per face, from the box's own layout ---
+		const GLfloat corners[8][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 } };
+		const int faces[6][4] = { { 0, 1, 2, 3 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 }, { 3, 2, 6, 7 }, { 0, 3, 7, 4 }, { 1, 2, 6, 5 } };
+		MeshData box;
+		for (const auto& face : faces) {
+			const GLuint base = box.VertexCount();
+			for (int k = 0; k < 4; ++k)
+				box.vertices.insert(box.vertices.end(), { corners[face[k]][0], corners[face[k]][1], corners[face[k]][2], 0, 0, 0, 0, 0 });
+			box.indices.insert(box.indices.end(), { base, base + 1, base + 2, base + 2, base + 3, base });
+		}
+		ShapeMeshes::BuildEdgeIndices(full, box.vertices.data(), box.VertexCount(), box.indices.data(), box.indices.size(), false);
+		ShapeMeshes::BuildEdgeIndices(quads, box.vertices.data(), box.VertexCount(), box.indices.data(), box.indices.size(), true);
+		const bool boxPassed = full.size() == 2 * 18 && quads.size() == 2 * 12;
+		if (!boxPassed) ++failures;
+		std::printf("%-18s %5s %10zu %10zu %10zu %7.1f%%  %s\n", "box", "-", box.indices.size(), full.size() / 2, quads.size() / 2,
+			100.0 * (1.0 - double(quads.size() / 2) / double(box.indices.size())), boxPassed ? "ok" : "FAILED");
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MeshCompute
+// -----------
+// Headless check that the compute kernels in MeshCompute.cpp produce the
+// same meshes as the CPU generators, and a timing of the two paths.
+//
+// A surfaceless EGL context is created (Mesa llvmpipe works) and each case
+// is generated with MeshComputeGenerator into a fresh buffer pair, read
+// back with glGetBufferSubData and compared float by float with
+// GenerateXMesh. The spiral's indices are written by its kernel, so they
+// are compared too; the grid shapes must emit rows * cols * 6 indices, the
+// shared grid they draw with.
+//
+// With --bench, each shape is then timed over a sweep of resolutions:
+//   cpu      GenerateXMesh + glBufferData of both streams + glFinish
+//   compute  Generate (spiral frames included) + glFinish
+// The CPU column is what LoadGeneratedMesh/DrawDynamicMesh pay on a cache
+// miss or parameter change.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace MeshComputeCheck
+{
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * prepare fills the compute parameters (and,
+	 * for the spiral, the frames) from the same
+	 * arguments generate passes to the CPU
+	 * generator. normalSlack scales the
+	 * tolerance for the normals only.
+	 ******************************************/
+
+	struct CheckCase {
+		const char* name;
+		std::function<void(ComputeMeshParams&, std::vector<SpiralFrame>&)> prepare;
+		std::function<void(MeshData&)> generate;
+		double normalSlack = 1.0;
+	};
+
+	CheckCase SpringCase(int segments)
+	{
+		return { "spring",
+			[=](ComputeMeshParams& p, std::vector<SpiralFrame>&) { p = ComputeMeshParams::Spring(1.0f, 0.1f, segments / 3 + 1, segments, 4.0f); },
+			[=](MeshData& m) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.1f, segments / 3 + 1, segments, 4.0f); } };
+	}
+
+	CheckCase SpiralCase(int segments)
+	{
+		return { "spiral",
+			[=](ComputeMeshParams& p, std::vector<SpiralFrame>& frames) {
+				ShapeMeshes::GenerateSpiralFrames(frames, 0.4f, 3.0f, segments * 4);
+				p = ComputeMeshParams::Spiral(0.12f, 0.5f, segments, frames.size());
+			},
+			[=](MeshData& m) { ShapeMeshes::GenerateSpiralMesh(m, 0.12f, 0.5f, 0.4f, 3.0f, segments, segments * 4); } };
+	}
+
+	// The sine cone's normals are crossed from the short edges between
+	// neighbouring positions, so a last-bit difference between the GPU's
+	// pow/sin and libm's grows with resolution (about 3e-3 at 257x129 on
+	// llvmpipe, against 2e-5 when both paths start from the same positions).
+	// Its positions and UVs are held to the normal tolerance.
+	CheckCase SineConeCase(int segments)
+	{
+		return { "sine cone",
+			[=](ComputeMeshParams& p, std::vector<SpiralFrame>&) { p = ComputeMeshParams::SineCone(1.0f, 2.0f, 0.7f, 0.15f, 4.0f, 0.3f, segments, segments / 2 + 1); },
+			[=](MeshData& m) { ShapeMeshes::GenerateSineConeMesh(m, 1.0f, 2.0f, 0.7f, 0.15f, 4.0f, 0.3f, segments, segments / 2 + 1); },
+			100.0 };
+	}
+
+	CheckCase SuperellipsoidCase(int segments)
+	{
+		return { "superellipsoid",
+			[=](ComputeMeshParams& p, std::vector<SpiralFrame>&) { p = ComputeMeshParams::Superellipsoid(1.0f, 0.5f, 2.0f, 1.0f, 1.0f, segments, segments); },
+			[=](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 0.5f, 2.0f, 1.0f, 1.0f, segments, segments); } };
+	}
+
+	std::vector<CheckCase> BuildCases()
+	{
+		std::vector<CheckCase> cases;
+
+		for (int segments : { 3, 8, 18, 64, 257 }) {
+			cases.push_back(SpringCase(segments));
+			cases.push_back(SpiralCase(segments));
+			cases.push_back(SineConeCase(segments));
+			cases.push_back(SuperellipsoidCase(segments));
+		}
+
+		// Clamped parameters must clamp the same way on both paths.
+		cases.push_back({ "spring(clamped)",
+			[](ComputeMeshParams& p, std::vector<SpiralFrame>&) { p = ComputeMeshParams::Spring(1.0f, 0.1f, 0, 2, 4.0f); },
+			[](MeshData& m) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.1f, 0, 2, 4.0f); } });
+		cases.push_back({ "spiral(one ring)",
+			[](ComputeMeshParams& p, std::vector<SpiralFrame>& frames) {
+				ShapeMeshes::GenerateSpiralFrames(frames, 0.4f, 0.5f, 2);
+				p = ComputeMeshParams::Spiral(0.12f, 0.5f, 8, frames.size());
+			},
+			[](MeshData& m) { ShapeMeshes::GenerateSpiralMesh(m, 0.12f, 0.5f, 0.4f, 0.5f, 8, 2); } });
+		cases.push_back({ "superellipsoid(clamped)",
+			[](ComputeMeshParams& p, std::vector<SpiralFrame>&) { p = ComputeMeshParams::Superellipsoid(0.0f, -1.0f, 1.0f, 0.5f, 0.0f, 2, 1); },
+			[](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 0.0f, -1.0f, 1.0f, 0.5f, 0.0f, 2, 1); } });
+
+		return cases;
+	}
+
+	/******************************************
+	 * ComputeBuffers
+	 * ---------------------------------------
+	 * A vertex and index buffer pair sized for
+	 * one generation, as DrawComputedMesh sizes
+	 * the mesh's own.
+	 ******************************************/
+
+	struct ComputeBuffers {
+		GLuint vertices = 0;
+		GLuint indices = 0;
+
+		ComputeBuffers()
+		{
+			glGenBuffers(1, &vertices);
+			glGenBuffers(1, &indices);
+		}
+
+		~ComputeBuffers()
+		{
+			glDeleteBuffers(1, &vertices);
+			glDeleteBuffers(1, &indices);
+		}
+
+		void Reserve(const ComputeMeshParams& params)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, vertices);
+			glBufferData(GL_ARRAY_BUFFER, std::max<size_t>(1, params.VertexCount()) * sizeof(Vertex), nullptr, GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, indices);
+			glBufferData(GL_ARRAY_BUFFER, std::max<size_t>(1, params.IndexCount()) * sizeof(GLuint), nullptr, GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	};
+
+	/******************************************
+	 * RunCase
+	 * ---------------------------------------
+	 * Returns the largest absolute difference
+	 * over every vertex float, with normal
+	 * differences divided by the case's
+	 * normalSlack, or a negative value if the
+	 * counts or indices do not match.
+	 ******************************************/
+
+	double RunCase(const CheckCase& check, MeshComputeGenerator& generator, ComputeMeshParams& params)
+	{
+		MeshData expected;
+		check.generate(expected);
+
+		std::vector<SpiralFrame> frames;
+		check.prepare(params, frames);
+
+		const size_t vertexCount = params.VertexCount();
+		const size_t indexCount = params.IndexCount();
+		if (expected.VertexCount() != vertexCount || expected.IndexCount() != indexCount) {
+			std::fprintf(stderr, "%-24s %4ux%-4u count mismatch: %u/%zu vertices, %u/%zu indices\n",
+				check.name, params.rows, params.cols,
+				expected.VertexCount(), vertexCount, expected.IndexCount(), indexCount);
+			return -1.0;
+		}
+		if (vertexCount == 0) return 0.0;
+
+		ComputeBuffers buffers;
+		buffers.Reserve(params);
+		generator.Generate(params, buffers.vertices, buffers.indices, true, &frames);
+
+		const size_t floatCount = vertexCount * (sizeof(Vertex) / sizeof(GLfloat));
+		std::vector<GLfloat> vertices(floatCount);
+		glBindBuffer(GL_ARRAY_BUFFER, buffers.vertices);
+		glGetBufferSubData(GL_ARRAY_BUFFER, 0, floatCount * sizeof(GLfloat), vertices.data());
+
+		if (!params.gridIndices) {
+			std::vector<GLuint> indices(indexCount);
+			glBindBuffer(GL_ARRAY_BUFFER, buffers.indices);
+			glGetBufferSubData(GL_ARRAY_BUFFER, 0, indexCount * sizeof(GLuint), indices.data());
+			if (!std::equal(indices.begin(), indices.end(), expected.indices.begin())) {
+				std::fprintf(stderr, "%-24s %4ux%-4u index mismatch\n", check.name, params.rows, params.cols);
+				return -1.0;
+			}
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		double maxError = 0.0;
+		for (size_t i = 0; i < floatCount; ++i) {
+			double error = std::fabs(vertices[i] - expected.vertices[i]);
+			if (i % 8 >= 3 && i % 8 < 6) error /= check.normalSlack;
+			maxError = std::max(maxError, error);
+		}
+		return maxError;
+	}
+
+	/******************************************
+	 * Bench
+	 * ---------------------------------------
+	 * Best of repeats, in milliseconds, for the
+	 * CPU path and the compute path of one case.
+	 ******************************************/
+
+	void Bench(const CheckCase& check, MeshComputeGenerator& generator, int repeats)
+	{
+		using Clock = std::chrono::steady_clock;
+		auto milliseconds = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+		ComputeMeshParams params;
+		std::vector<SpiralFrame> frames;
+		check.prepare(params, frames);
+
+		ComputeBuffers buffers;
+		buffers.Reserve(params);
+
+		double cpuBest = 1e30;
+		double gpuBest = 1e30;
+		MeshData data;
+		for (int r = 0; r < repeats; ++r) {
+			Clock::time_point start = Clock::now();
+			data.Clear();
+			check.generate(data);
+			glBindBuffer(GL_ARRAY_BUFFER, buffers.vertices);
+			glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(GLfloat), data.vertices.data(), GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, buffers.indices);
+			glBufferData(GL_ARRAY_BUFFER, data.indices.size() * sizeof(GLuint), data.indices.data(), GL_DYNAMIC_DRAW);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glFinish();
+			cpuBest = std::min(cpuBest, milliseconds(Clock::now() - start));
+
+			start = Clock::now();
+			check.prepare(params, frames);
+			generator.Generate(params, buffers.vertices, buffers.indices, true, &frames);
+			glFinish();
+			gpuBest = std::min(gpuBest, milliseconds(Clock::now() - start));
+		}
+
+		std::printf("%-24s %4ux%-4u %9zu vertices  cpu %8.3f ms  compute %8.3f ms  %6.2fx\n",
+			check.name, params.rows, params.cols, params.VertexCount(), cpuBest, gpuBest, cpuBest / gpuBest);
+	}
+
+	int Run(const CheckOptions& options)
+	{
+		const double tolerance = options.tolerance;
+		const bool bench = options.bench;
+		const int repeats = options.repeats;
+
+		HeadlessContext context;
+		if (!context.Create(4, 3)) return 1;
+
+		std::fprintf(stderr, "Renderer: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+		if (!MeshComputeGenerator::IsSupported()) {
+			std::fprintf(stderr, "Error: compute shaders are not supported by this context.\n");
+			return 1;
+		}
+		MeshComputeGenerator generator;
+		if (!generator.Create()) return 1;
+
+		int failures = 0;
+		std::vector<CheckCase> cases = BuildCases();
+		for (const CheckCase& check : cases) {
+			ComputeMeshParams params;
+			double error = RunCase(check, generator, params);
+			bool passed = error >= 0.0 && error <= tolerance;
+			if (!passed) ++failures;
+
+			std::printf("%-24s %4ux%-4u max error %.3g  %s\n",
+				check.name, params.rows, params.cols, error, passed ? "ok" : "FAILED");
+		}
+
+		if (bench) {
+			std::printf("\n");
+			for (int segments : { 16, 64, 128, 256 }) {
+				for (const CheckCase& check : { SpringCase(segments), SpiralCase(segments), SineConeCase(segments), SuperellipsoidCase(segments) })
+					Bench(check, generator, repeats);
+			}
+		}
+
+		GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			std::fprintf(stderr, "Error: GL error 0x%04x.\n", error);
+			++failures;
+		}
+
+		generator.Release();
+
+		std::printf("%d of %zu cases failed\n", failures, cases.size());
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MeshExport
+// ----------
+// Headless check that ExportMesh writes the triangles each built-in mesh's
+// Draw function renders (see ShapeMeshes::MeshTable).
+//
+// Every mesh is loaded (the hemisphere after the sphere, so it is drawn
+// from the sphere's buffers) and drawn once with a vertex-only program
+// whose gl_VertexID is captured by transform feedback, rasterization
+// discarded. Triangles that repeat a vertex are left out, as the exporter
+// leaves out a strip's joining triangles. The mesh is then exported to PLY
+// and read back with MeshImport, and each case checks that the file holds
+// exactly the triangles the draw submitted: an indexed export of a mesh
+// drawn with glDrawArrays (or the reverse) gives a different count.
+//
+// The case runs in a surfaceless GL 3.3 context (see HeadlessContext.h) and
+// writes to a temporary directory, which is removed afterwards.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace MeshExportCheck
+{
+	/******************************************
+	 * CaptureProgram
+	 * ---------------------------------------
+	 * A vertex stage alone, writing out the
+	 * index each vertex was fetched with (the
+	 * vertex number for glDrawArrays).
+	 ******************************************/
+
+	GLuint CaptureProgram()
+	{
+		const char* source =
+			"#version 330 core\n"
+			"layout(location = 0) in vec3 position;\n"
+			"flat out int vertexId;\n"
+			"void main() { vertexId = gl_VertexID; gl_Position = vec4(position, 1.0); }\n";
+
+		GLuint shader = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(shader, 1, &source, nullptr);
+		glCompileShader(shader);
+
+		GLuint program = glCreateProgram();
+		glAttachShader(program, shader);
+		const char* varyings[] = { "vertexId" };
+		glTransformFeedbackVaryings(program, 1, varyings, GL_INTERLEAVED_ATTRIBS);
+		glLinkProgram(program);
+		glDeleteShader(shader);
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (!linked) {
+			std::fprintf(stderr, "Error: the capture program did not link.\n");
+			glDeleteProgram(program);
+			return 0;
+		}
+		return program;
+	}
+
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - name: The mesh's report name.
+	 * - load: Loads it into shapes.
+	 * - draw: Its Draw call, every part drawn.
+	 ******************************************/
+
+	struct CheckCase {
+		const char* name;
+		std::function<void(ShapeMeshes&)> load;
+		std::function<void(ShapeMeshes&)> draw;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		return {
+			{ "Box", [](ShapeMeshes& s) { s.LoadBoxMesh(); }, [](ShapeMeshes& s) { s.DrawBoxMesh(); } },
+			{ "Cone", [](ShapeMeshes& s) { s.LoadConeMesh(); }, [](ShapeMeshes& s) { s.DrawConeMesh(true); } },
+			{ "Cylinder", [](ShapeMeshes& s) { s.LoadCylinderMesh(); }, [](ShapeMeshes& s) { s.DrawCylinderMesh(true, true, true); } },
+			{ "Plane", [](ShapeMeshes& s) { s.LoadPlaneMesh(); }, [](ShapeMeshes& s) { s.DrawPlaneMesh(); } },
+			{ "Prism", [](ShapeMeshes& s) { s.LoadPrismMesh(); }, [](ShapeMeshes& s) { s.DrawPrismMesh(); } },
+			{ "Pyramid3", [](ShapeMeshes& s) { s.LoadPyramid3Mesh(); }, [](ShapeMeshes& s) { s.DrawPyramid3Mesh(); } },
+			{ "Pyramid4", [](ShapeMeshes& s) { s.LoadPyramid4Mesh(); }, [](ShapeMeshes& s) { s.DrawPyramid4Mesh(); } },
+			{ "Sphere", [](ShapeMeshes& s) { s.LoadSphereMesh(); }, [](ShapeMeshes& s) { s.DrawSphereMesh(); } },
+			{ "Hemisphere", [](ShapeMeshes& s) { s.LoadHemisphereMesh(); }, [](ShapeMeshes& s) { s.DrawHemisphereMesh(); } },
+			{ "TaperedCylinder", [](ShapeMeshes& s) { s.LoadTaperedCylinderMesh(); }, [](ShapeMeshes& s) { s.DrawTaperedCylinderMesh(true, true, true); } },
+			{ "Torus", [](ShapeMeshes& s) { s.LoadTorusMesh(); }, [](ShapeMeshes& s) { s.DrawTorusMesh(); } },
+			{ "ExtraTorus1", [](ShapeMeshes& s) { s.LoadExtraTorusMesh1(); }, [](ShapeMeshes& s) { s.DrawExtraTorusMesh1(); } },
+			{ "ExtraTorus2", [](ShapeMeshes& s) { s.LoadExtraTorusMesh2(); }, [](ShapeMeshes& s) { s.DrawExtraTorusMesh2(); } },
+			{ "Spring", [](ShapeMeshes& s) { s.LoadSpringMesh(); }, [](ShapeMeshes& s) { s.DrawSpringMesh(); } },
+			{ "Tube", [](ShapeMeshes& s) { s.LoadTubeMesh(); }, [](ShapeMeshes& s) { s.DrawTubeMesh(); } },
+			{ "Fin", [](ShapeMeshes& s) { s.LoadFinMesh(); }, [](ShapeMeshes& s) { s.DrawFinMesh(false); } },
+			{ "CurvedCone", [](ShapeMeshes& s) { s.LoadCurvedConeMesh(18, 12, 1.0f, 2.0f, 0.5f); }, [](ShapeMeshes& s) { s.DrawCurvedConeMesh(); } },
+			{ "TaperedTorus", [](ShapeMeshes& s) { s.LoadTaperedTorusMesh(); },
+				[](ShapeMeshes& s) { s.DrawTaperedTorusMesh(1.0f, 0.3f, 0.1f, 24, 12, 5.0f); } },
+			{ "Spiral", [](ShapeMeshes& s) { s.LoadSpiralMesh(); },
+				[](ShapeMeshes& s) { s.DrawSpiralMesh(0.1f, 1.0f, 0.3f, 3.0f, 8, 64); } },
+			{ "SineCone", [](ShapeMeshes& s) { s.LoadSineConeMesh(); },
+				[](ShapeMeshes& s) { s.DrawSineConeMesh(1.0f, 2.0f, 0.5f, 0.1f, 3.0f, 0.0f, 24, 8); } },
+			{ "Superellipsoid", [](ShapeMeshes& s) { s.LoadSuperellipsoidMesh(); },
+				[](ShapeMeshes& s) { s.DrawSuperellipsoidMesh(1.0f, 1.0f, 1.0f, 0.5f, 0.5f, 24, 12); } },
+		};
+	}
+
+	int Run(const CheckOptions&)
+	{
+		constexpr size_t MaxTriangles = 1 << 16;
+
+		HeadlessContext context;
+		if (!context.Create(3, 3)) return 1;
+
+		GLuint program = CaptureProgram();
+		if (program == 0) return 1;
+
+		// A surfaceless context has no default framebuffer to draw to, even
+		// with rasterization discarded.
+		GLuint framebuffer = 0;
+		GLuint colorBuffer = 0;
+		GLuint feedback = 0;
+		GLuint query = 0;
+		glGenRenderbuffers(1, &colorBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 1, 1);
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glGenBuffers(1, &feedback);
+		glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+		glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, MaxTriangles * 3 * sizeof(GLint), nullptr, GL_STREAM_READ);
+		glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+		glGenQueries(1, &query);
+		glEnable(GL_RASTERIZER_DISCARD);
+		glUseProgram(program);
+
+		const std::filesystem::path exportDirectory = std::filesystem::temp_directory_path() / "MeshExportCheck";
+		std::filesystem::create_directories(exportDirectory);
+		const std::string path = (exportDirectory / "mesh.ply").string();
+
+		std::printf("%-16s %9s %9s %9s\n", "mesh", "submitted", "joining", "exported");
+
+		int failures = 0;
+		std::vector<CheckCase> cases = BuildCases();
+		{
+			ShapeMeshes shapes;
+			for (const CheckCase& check : cases) check.load(shapes);
+
+			std::vector<GLint> ids;
+			MeshData exported;
+			for (const CheckCase& check : cases) {
+				glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, query);
+				glBeginTransformFeedback(GL_TRIANGLES);
+				check.draw(shapes);
+				glEndTransformFeedback();
+				glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+				GLuint submitted = 0;
+				glGetQueryObjectuiv(query, GL_QUERY_RESULT, &submitted);
+
+				size_t joining = 0;
+				ids.resize(static_cast<size_t>(submitted) * 3);
+				glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+				glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, ids.size() * sizeof(GLint), ids.data());
+				for (size_t i = 0; i + 2 < ids.size(); i += 3)
+					if (ids[i] == ids[i + 1] || ids[i + 1] == ids[i + 2] || ids[i] == ids[i + 2]) ++joining;
+
+				const bool read = shapes.ExportMesh(check.name, path) && MeshImport::Read(path, exported);
+				const size_t triangles = read ? exported.indices.size() / 3 : 0;
+
+				const bool passed = read && submitted > 0 && submitted < MaxTriangles && triangles == submitted - joining;
+				if (!passed) ++failures;
+				std::printf("%-16s %9u %9zu %9zu  %s\n", check.name, submitted, joining, triangles, passed ? "ok" : "FAILED");
+			}
+		}
+
+		GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			std::fprintf(stderr, "Error: GL error 0x%04x.\n", error);
+			++failures;
+		}
+
+		glUseProgram(0);
+		glDeleteQueries(1, &query);
+		glDeleteBuffers(1, &feedback);
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteProgram(program);
+
+		std::error_code ignored;
+		std::filesystem::remove_all(exportDirectory, ignored);
+
+		std::printf("%d of %zu cases failed\n", failures, cases.size());
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PartRange
+// ---------
+// Headless check of the sub-range tables the cone, cylinder and tapered
+// cylinder generators produce, and of the masked part ranges drawn from them
+// (see ShapeMeshes::MaskedPartRanges and GLMesh::subRanges).
+//
+// For each shape at several slice counts it checks that:
+// - the table lists the shape's parts back to back over the whole index
+//   buffer;
+// - every vertex of a cap part has the cap's normal (straight down or up)
+//   and no side vertex has a cap's normal (the faceted cone's apex points
+//   straight up, but that cone has no top cap);
+// - every mask selects exactly the indices of its parts, in as many ranges
+//   as the parts form separate runs;
+// - the table survives a round trip through the mesh cache, compressed and
+//   not.
+//
+// It also checks MaskedPartRanges on a table with gaps between its parts.
+//
+// No GL context is needed. The cache round trip writes to a temporary
+// directory, which is removed afterwards.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace PartRangeCheck
+{
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - generate: Builds the shape with the
+	 *   given slices.
+	 * - capNormals: Y normal of each part's
+	 *   vertices for a cap, 0 for a side.
+	 ******************************************/
+
+	struct CheckCase {
+		std::string name;
+		MeshGeneratorId generator;
+		std::function<void(MeshData&, int)> generate;
+		std::vector<float> capNormals;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		return {
+			{ "cone", MeshGeneratorId::Cone,
+				[](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n); }, { -1.0f, 0.0f } },
+			{ "cone (welded)", MeshGeneratorId::Cone,
+				[](MeshData& m, int n) { ShapeMeshes::GenerateConeMesh(m, 1.0f, 2.0f, n, ConeSideMode::Welded); }, { -1.0f, 0.0f } },
+			{ "cylinder", MeshGeneratorId::Cylinder,
+				[](MeshData& m, int n) { ShapeMeshes::GenerateCylinderMesh(m, 1.0f, 2.0f, n); }, { -1.0f, 1.0f, 0.0f } },
+			{ "tapered cylinder", MeshGeneratorId::TaperedCylinder,
+				[](MeshData& m, int n) { ShapeMeshes::GenerateTaperedCylinderMesh(m, 1.0f, 0.5f, 2.0f, n); }, { -1.0f, 1.0f, 0.0f } },
+		};
+	}
+
+	// Whether ranges select exactly the indices of parts in mask, in the fewest ranges.
+	bool MaskMatches(const std::vector<MeshSubRange>& ranges, const std::vector<MeshSubRange>& parts, uint32_t mask, size_t indexCount)
+	{
+		std::vector<bool> wanted(indexCount, false), selected(indexCount, false);
+		size_t runs = 0;
+		GLuint runEnd = ~0u;
+		for (size_t i = 0; i < parts.size(); ++i) {
+			if ((mask & (1u << i)) == 0 || parts[i].count == 0) continue;
+			for (GLuint k = parts[i].first; k < parts[i].first + parts[i].count; ++k) wanted[k] = true;
+			if (parts[i].first != runEnd) ++runs;
+			runEnd = parts[i].first + parts[i].count;
+		}
+		for (const MeshSubRange& range : ranges) {
+			if (range.first + range.count > indexCount) return false;
+			for (GLuint k = range.first; k < range.first + range.count; ++k) selected[k] = true;
+		}
+		return selected == wanted && ranges.size() == runs;
+	}
+
+	int Run(const CheckOptions&)
+	{
+		const std::filesystem::path cacheDirectory = std::filesystem::temp_directory_path() / "PartRangeCheck";
+		std::filesystem::create_directories(cacheDirectory);
+
+		std::printf("%-18s %6s %6s %8s %9s %6s\n", "shape", "slices", "parts", "indices", "multi", "cache");
+
+		int failures = 0;
+		MeshData mesh;
+		std::vector<MeshSubRange> ranges;
+		for (const CheckCase& check : BuildCases()) {
+			for (int slices : { 3, 8, 36, 128 }) {
+				check.generate(mesh, slices);
+				const std::vector<MeshSubRange>& parts = mesh.subRanges;
+				bool passed = parts.size() == check.capNormals.size();
+
+				// --- Back to back over the whole buffer ---
+				GLuint next = 0;
+				for (const MeshSubRange& part : parts) {
+					if (part.first != next || part.count == 0 || part.count % 3 != 0) passed = false;
+					next = part.first + part.count;
+				}
+				if (next != mesh.IndexCount()) passed = false;
+
+				// --- Caps face straight down or up, sides not as a cap does ---
+				for (size_t i = 0; passed && i < parts.size(); ++i) {
+					for (GLuint k = parts[i].first; k < parts[i].first + parts[i].count; ++k) {
+						const float normalY = mesh.vertices[mesh.indices[k] * 8 + 4];
+						bool likeCap = false;
+						for (float capNormal : check.capNormals)
+							if (capNormal != 0.0f && normalY == capNormal) likeCap = true;
+						if (check.capNormals[i] != 0.0f ? normalY != check.capNormals[i] : likeCap) passed = false;
+					}
+				}
+
+				// --- Every mask ---
+				size_t multiDraws = 0;
+				for (uint32_t mask = 0; passed && mask < (1u << parts.size()); ++mask) {
+					ShapeMeshes::MaskedPartRanges(ranges, parts, mask);
+					if (!MaskMatches(ranges, parts, mask, mesh.IndexCount())) passed = false;
+					if (ranges.size() > 1) ++multiDraws;
+				}
+
+				// --- Through the cache ---
+				bool cached = true;
+				for (bool compress : { false, true }) {
+					MeshCache cache(cacheDirectory.string(), compress);
+					const MeshCacheKey key = MeshCacheKey::Make(check.generator, { float(slices), float(compress), 7.0f });
+					MappedMesh mapped;
+					if (!cache.Store(key, mesh) || !cache.Open(key, mapped) || mapped.SubRangeCount() != parts.size()) {
+						cached = false;
+						continue;
+					}
+					for (size_t i = 0; i < parts.size(); ++i)
+						if (mapped.SubRanges()[i].first != parts[i].first || mapped.SubRanges()[i].count != parts[i].count) cached = false;
+				}
+				if (!cached) passed = false;
+
+				if (!passed) ++failures;
+				std::printf("%-18s %6d %6zu %8u %9zu %6s  %s\n",
+					check.name.c_str(), slices, parts.size(), mesh.IndexCount(), multiDraws, cached ? "ok" : "lost", passed ? "ok" : "FAILED");
+			}
+		}
+
+		// --- A table with gaps and an empty part ---
+		const std::vector<MeshSubRange> gapped = { { 0, 6 }, { 6, 6 }, { 18, 6 }, { 24, 0 }, { 24, 12 }, { 42, 6 } };
+		bool gappedPassed = true;
+		for (uint32_t mask = 0; mask < (1u << gapped.size()); ++mask) {
+			ShapeMeshes::MaskedPartRanges(ranges, gapped, mask);
+			if (!MaskMatches(ranges, gapped, mask, 48)) gappedPassed = false;
+		}
+		if (!gappedPassed) ++failures;
+		std::printf("%-18s %6s %6zu %8d %9s %6s  %s\n", "gapped table", "-", gapped.size(), 48, "-", "-", gappedPassed ? "ok" : "FAILED");
+
+		std::error_code ignored;
+		std::filesystem::remove_all(cacheDirectory, ignored);
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PoleMode
+// --------
+// Headless report on the pole modes of the sphere, hemisphere and
+// superellipsoid (see PoleMode and ShapeMeshes::RemoveDegenerateTriangles).
+//
+// For each shape and size it prints the triangles and vertices of the
+// Duplicated, Trimmed and Welded meshes and the triangles each mode removed.
+//
+// Each case checks that:
+// - Trimmed removes exactly the triangles CountDegenerateTriangles finds in
+//   the Duplicated mesh and keeps every vertex;
+// - neither Trimmed nor Welded leaves a degenerate triangle;
+// - each mesh's removedTriangles is the number of triangles its mode removed;
+// - Welded has one vertex per pole instead of a row of them;
+// - the surface area is unchanged, except where the grid misses the pole.
+//   With superellipsoid exponents below 1 the pole row is a small ring
+//   (float cos(-PI/2) is not 0), mirrored through the axis, so its quads
+//   fold over the pole; Welded moves that row onto the pole, and only its
+//   vertex count is checked there.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace PoleModeCheck
+{
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - generate: Builds the shape in a mode.
+	 * - cols: Quads around a pole row.
+	 * - poleRows: Rows that land on a pole.
+	 * - openPoles: The pole rows miss the pole,
+	 *   so welding changes the area.
+	 ******************************************/
+
+	struct CheckCase {
+		std::string name;
+		std::function<void(MeshData&, PoleMode)> generate;
+		size_t cols;
+		size_t poleRows;
+		bool openPoles;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		std::vector<CheckCase> cases;
+		for (int segments : { 6, 18, 64 }) {
+			const std::string size = "(" + std::to_string(segments) + ")";
+			cases.push_back({ "sphere" + size,
+				[=](MeshData& m, PoleMode poles) { ShapeMeshes::GenerateSphereMesh(m, segments, segments, 1.0f, poles); },
+				static_cast<size_t>(segments), 2, false });
+			cases.push_back({ "hemisphere" + size,
+				[=](MeshData& m, PoleMode poles) { ShapeMeshes::GenerateHemisphereMesh(m, segments, segments, 1.0f, poles); },
+				static_cast<size_t>(segments), 1, false });
+			cases.push_back({ "ellipsoid" + size,
+				[=](MeshData& m, PoleMode poles) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 2.0f, 1.0f, 0.5f, 1.0f, 1.0f, segments, segments, poles); },
+				static_cast<size_t>(segments), 2, false });
+			cases.push_back({ "rounded box" + size,
+				[=](MeshData& m, PoleMode poles) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 1.0f, 1.0f, 0.2f, 0.2f, segments, segments, poles); },
+				static_cast<size_t>(segments), 2, true });
+		}
+		return cases;
+	}
+
+	double SurfaceArea(const MeshData& mesh)
+	{
+		auto position = [&](GLuint index) {
+			const GLfloat* v = &mesh.vertices[index * 8];
+			return glm::vec3(v[0], v[1], v[2]);
+		};
+
+		double area = 0.0;
+		for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+			glm::vec3 a = position(mesh.indices[i]);
+			area += 0.5 * glm::length(glm::cross(position(mesh.indices[i + 1]) - a, position(mesh.indices[i + 2]) - a));
+		}
+		return area;
+	}
+
+	int Run(const CheckOptions&)
+	{
+		std::printf("%-18s %10s %9s %10s %9s %8s %10s %9s %8s\n",
+			"shape", "triangles", "vertices", "trimmed", "vertices", "removed", "welded", "vertices", "removed");
+
+		int failures = 0;
+		MeshData duplicated, trimmed, welded;
+		for (const CheckCase& check : BuildCases()) {
+			check.generate(duplicated, PoleMode::Duplicated);
+			check.generate(trimmed, PoleMode::Trimmed);
+			check.generate(welded, PoleMode::Welded);
+
+			const size_t triangles = duplicated.indices.size() / 3;
+			const size_t trimmedRemoved = triangles - trimmed.indices.size() / 3;
+			const size_t weldedRemoved = triangles - welded.indices.size() / 3;
+
+			const double area = SurfaceArea(duplicated);
+			const double tolerance = 1e-4 * area;
+			const double trimmedArea = SurfaceArea(trimmed);
+			const double weldedArea = SurfaceArea(welded);
+
+			const bool passed = trimmedRemoved == ShapeMeshes::CountDegenerateTriangles(duplicated)
+				&& trimmed.VertexCount() == duplicated.VertexCount()
+				&& ShapeMeshes::CountDegenerateTriangles(trimmed) == 0
+				&& ShapeMeshes::CountDegenerateTriangles(welded) == 0
+				&& duplicated.removedTriangles == 0 && trimmed.removedTriangles == trimmedRemoved && welded.removedTriangles == weldedRemoved
+				&& welded.VertexCount() == duplicated.VertexCount() - check.cols * check.poleRows
+				&& std::fabs(trimmedArea - area) <= tolerance
+				&& (check.openPoles || std::fabs(weldedArea - area) <= tolerance);
+			if (!passed) ++failures;
+
+			std::printf("%-18s %10zu %9u %10zu %9u %8zu %10zu %9u %8zu  %s\n",
+				check.name.c_str(), triangles, duplicated.VertexCount(),
+				trimmed.indices.size() / 3, trimmed.VertexCount(), trimmedRemoved,
+				welded.indices.size() / 3, welded.VertexCount(), weldedRemoved, passed ? "ok" : "FAILED");
+		}
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ProceduralGrid
+// --------------
+// Headless check that the vertex-pulling shader in ProceduralGrid.cpp
+// produces the same vertices as the CPU generators.
+//
+// A surfaceless EGL context is created (Mesa llvmpipe works), the
+// procedural vertex shader is linked on its own, and each case is drawn
+// as GL_POINTS with rasterization discarded. Transform feedback captures
+// fragmentPosition, fragmentVertexNormal and fragmentTextureCoordinate
+// interleaved, which with identity matrices is exactly the 8-float Vertex
+// layout, so vertex k is compared with vertex k of GenerateXMesh.
+//
+// Every case also checks that the generator emitted rows * cols * 6
+// indices, i.e. that its triangles are the shared grid topology the
+// procedural draw uses.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace ProceduralGridCheck
+{
+	/******************************************
+	 * CaptureProgram
+	 * ---------------------------------------
+	 * Links the procedural vertex shader with
+	 * its outputs captured by transform
+	 * feedback, and sets the matrices to
+	 * identity so the outputs are the raw
+	 * position, normal and UV.
+	 ******************************************/
+
+	GLuint CaptureProgram()
+	{
+		GLuint shader = ProceduralGrid::CompileVertexShader();
+		if (shader == 0) return 0;
+
+		GLuint program = glCreateProgram();
+		glAttachShader(program, shader);
+
+		const char* varyings[] = { "fragmentPosition", "fragmentVertexNormal", "fragmentTextureCoordinate" };
+		glTransformFeedbackVaryings(program, 3, varyings, GL_INTERLEAVED_ATTRIBS);
+		glLinkProgram(program);
+		glDeleteShader(shader);
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (linked != GL_TRUE) {
+			char log[1024] = {};
+			glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+			std::fprintf(stderr, "Error: capture program failed to link:\n%s\n", log);
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		glUseProgram(program);
+		const GLfloat identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		for (const char* name : { "model", "view", "projection" })
+			glUniformMatrix4fv(glGetUniformLocation(program, name), 1, GL_FALSE, identity);
+		return program;
+	}
+
+	/******************************************
+	 * CheckCase
+	 ******************************************/
+
+	struct CheckCase {
+		const char* name;
+		ProceduralGridParams grid;
+		std::function<void(MeshData&)> generate;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		std::vector<CheckCase> cases;
+
+		for (int segments : { 3, 8, 18, 64, 257 }) {
+			cases.push_back({ "sphere", ProceduralGridParams::Sphere(segments, segments + 1, 1.5f),
+				[=](MeshData& m) { ShapeMeshes::GenerateSphereMesh(m, segments, segments + 1, 1.5f); } });
+			cases.push_back({ "hemisphere", ProceduralGridParams::Hemisphere(segments, segments, 0.75f),
+				[=](MeshData& m) { ShapeMeshes::GenerateHemisphereMesh(m, segments, segments, 0.75f); } });
+			cases.push_back({ "torus", ProceduralGridParams::Torus(1.0f, 0.3f, segments, segments / 2 + 3),
+				[=](MeshData& m) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.3f, segments, segments / 2 + 3); } });
+
+			// Small exponents magnify the last bit of cos(+-pi/2) and sin(+-pi)
+			// at the poles and seam (pow(1e-7, 0.2) is about 0.04), so a driver
+			// whose cos is coarser than llvmpipe's may need a looser --tolerance.
+			cases.push_back({ "superellipsoid", ProceduralGridParams::Superellipsoid(1.0f, 0.5f, 2.0f, 1.0f, 1.0f, segments, segments),
+				[=](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 0.5f, 2.0f, 1.0f, 1.0f, segments, segments); } });
+			cases.push_back({ "superellipsoid", ProceduralGridParams::Superellipsoid(1.2f, 1.0f, 0.8f, 2.5f, 0.2f, segments, segments * 2),
+				[=](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.2f, 1.0f, 0.8f, 2.5f, 0.2f, segments, segments * 2); } });
+		}
+
+		// Clamped parameters must clamp the same way on both paths.
+		cases.push_back({ "torus(clamped)", ProceduralGridParams::Torus(1.0f, 0.0f, 1, 2),
+			[](MeshData& m) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.0f, 1, 2); } });
+		cases.push_back({ "superellipsoid(clamped)", ProceduralGridParams::Superellipsoid(0.0f, -1.0f, 1.0f, 0.5f, 0.0f, 2, 1),
+			[](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 0.0f, -1.0f, 1.0f, 0.5f, 0.0f, 2, 1); } });
+
+		return cases;
+	}
+
+	/******************************************
+	 * RunCase
+	 * ---------------------------------------
+	 * Returns the largest absolute difference
+	 * over every captured float, or a negative
+	 * value if the counts do not match.
+	 ******************************************/
+
+	double RunCase(const CheckCase& check, const ProceduralGridUniforms& uniforms, GLuint feedback)
+	{
+		MeshData expected;
+		check.generate(expected);
+
+		const size_t vertexCount = check.grid.VertexCount();
+		const size_t indexCount = static_cast<size_t>(check.grid.rows) * check.grid.cols * 6;
+		if (expected.VertexCount() != vertexCount || expected.IndexCount() != indexCount) {
+			std::fprintf(stderr, "%-24s %4ux%-4u count mismatch: %u/%zu vertices, %u/%zu indices\n",
+				check.name, check.grid.rows, check.grid.cols,
+				expected.VertexCount(), vertexCount, expected.IndexCount(), indexCount);
+			return -1.0;
+		}
+
+		const size_t floatCount = vertexCount * (sizeof(Vertex) / sizeof(GLfloat));
+		glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+		glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, floatCount * sizeof(GLfloat), nullptr, GL_STREAM_READ);
+		glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+		uniforms.Apply(check.grid);
+		glBeginTransformFeedback(GL_POINTS);
+		glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(vertexCount));
+		glEndTransformFeedback();
+
+		std::vector<GLfloat> captured(floatCount);
+		glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, floatCount * sizeof(GLfloat), captured.data());
+
+		double maxError = 0.0;
+		for (size_t i = 0; i < floatCount; ++i)
+			maxError = std::max(maxError, static_cast<double>(std::fabs(captured[i] - expected.vertices[i])));
+		return maxError;
+	}
+
+	int Run(const CheckOptions& options)
+	{
+		const double tolerance = options.tolerance;
+
+		HeadlessContext context;
+		if (!context.Create(3, 3)) return 1;
+
+		std::fprintf(stderr, "Renderer: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+		GLuint program = CaptureProgram();
+		ProceduralGridUniforms uniforms;
+		if (program == 0 || !uniforms.Locate(program)) return 1;
+
+		// The shader reads no attributes, but core profile draws need a VAO
+		// bound, and a surfaceless context has no default framebuffer to draw to
+		// even with rasterization discarded.
+		GLuint vao = 0;
+		GLuint feedback = 0;
+		GLuint framebuffer = 0;
+		GLuint colorBuffer = 0;
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+		glGenRenderbuffers(1, &colorBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 1, 1);
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glGenBuffers(1, &feedback);
+		glEnable(GL_RASTERIZER_DISCARD);
+
+		int failures = 0;
+		std::vector<CheckCase> cases = BuildCases();
+		for (const CheckCase& check : cases) {
+			double error = RunCase(check, uniforms, feedback);
+			bool passed = error >= 0.0 && error <= tolerance;
+			if (!passed) ++failures;
+
+			std::printf("%-24s %4ux%-4u max error %.3g  %s\n",
+				check.name, check.grid.rows, check.grid.cols, error, passed ? "ok" : "FAILED");
+		}
+
+		GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			std::fprintf(stderr, "Error: GL error 0x%04x.\n", error);
+			++failures;
+		}
+
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteBuffers(1, &feedback);
+		glDeleteVertexArrays(1, &vao);
+		glDeleteProgram(program);
+
+		std::printf("%d of %zu cases failed\n", failures, cases.size());
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SphereBand
+// ----------
+// Headless check that a hemisphere and any latitude band can be drawn from
+// the sphere's buffers (see ShapeMeshes::SphereBandRange and Hemisphere On
+// Sphere in ShapeMeshes.h).
+//
+// For several sphere sizes it checks that:
+// - the hemisphere's indices are the first rows of the sphere's;
+// - its positions and normals are the sphere's first vertices, to within
+//   float rounding of the two generators' trig tables;
+// - its texture coordinates are exactly those BuildHemisphereTexCoords
+//   uploads;
+// - for each pole mode and a spread of bands, SphereBandRange covers exactly
+//   the triangles of the rows the band overlaps;
+// - ExportMesh writes the same hemisphere whether it is drawn from the
+//   loaded sphere's buffers or has its own, matching GenerateHemisphereMesh.
+//
+// The export case runs in a surfaceless GL 3.3 context (see
+// HeadlessContext.h) and writes to a temporary directory, which is removed
+// afterwards.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace SphereBandCheck
+{
+	const float HalfTurn = 3.14159265f;
+
+	// Row of each triangle, from its centroid's angle to the +Y pole.
+	int TriangleRow(const MeshData& mesh, size_t triangle, int latitudeSegments)
+	{
+		float x = 0.0f, y = 0.0f, z = 0.0f;
+		for (size_t k = 0; k < 3; ++k) {
+			const GLfloat* v = &mesh.vertices[mesh.indices[3 * triangle + k] * 8];
+			x += v[0];
+			y += v[1];
+			z += v[2];
+		}
+		float angle = std::atan2(std::sqrt(x * x + z * z), y);
+		return std::min(static_cast<int>(angle / (HalfTurn / latitudeSegments)), latitudeSegments - 1);
+	}
+
+	// Largest difference between two meshes' vertices, or -1 if their layout or indices differ.
+	float MeshDifference(const MeshData& a, const MeshData& b)
+	{
+		if (a.vertices.size() != b.vertices.size() || a.indices != b.indices) return -1.0f;
+		float difference = 0.0f;
+		for (size_t i = 0; i < a.vertices.size(); ++i)
+			difference = std::max(difference, std::fabs(a.vertices[i] - b.vertices[i]));
+		return difference;
+	}
+
+	int Run(const CheckOptions&)
+	{
+		const float bands[][2] = {
+			{ 0.0f, HalfTurn * 0.5f }, { 0.0f, HalfTurn }, { 0.4f, 0.9f }, { 1.0f, 1.0001f },
+			{ 2.5f, HalfTurn }, { -1.0f, 0.2f }, { 0.7f, 0.7f },
+		};
+		const PoleMode modes[] = { PoleMode::Duplicated, PoleMode::Trimmed, PoleMode::Welded };
+
+		std::printf("%-10s %9s %9s %13s %9s %8s\n", "sphere", "vertices", "shared", "position diff", "uv", "bands");
+
+		int failures = 0;
+		MeshData sphere, hemisphere;
+		std::vector<GLfloat> texCoords;
+		for (int segments : { 4, 7, 18, 64 }) {
+			bool passed = true;
+
+			// --- Hemisphere against the sphere's first rows ---
+			ShapeMeshes::GenerateSphereMesh(sphere, segments, segments, 1.5f);
+			ShapeMeshes::GenerateHemisphereMesh(hemisphere, segments, segments, 1.5f);
+			ShapeMeshes::BuildHemisphereTexCoords(texCoords, segments, segments);
+
+			const size_t rows = static_cast<size_t>(segments / 2);
+			const size_t sharedVertices = (rows + 1) * (segments + 1);
+			const size_t sharedIndices = rows * segments * 6;
+			if (hemisphere.VertexCount() != sharedVertices || hemisphere.IndexCount() != sharedIndices
+				|| !std::equal(hemisphere.indices.begin(), hemisphere.indices.end(), sphere.indices.begin()))
+				passed = false;
+
+			float positionDiff = 0.0f;
+			bool uvExact = texCoords.size() == 2 * sharedVertices;
+			for (size_t i = 0; i < sharedVertices && i < hemisphere.VertexCount(); ++i) {
+				for (size_t k = 0; k < 6; ++k)
+					positionDiff = std::max(positionDiff, std::fabs(hemisphere.vertices[8 * i + k] - sphere.vertices[8 * i + k]));
+				if (uvExact && (hemisphere.vertices[8 * i + 6] != texCoords[2 * i] || hemisphere.vertices[8 * i + 7] != texCoords[2 * i + 1]))
+					uvExact = false;
+			}
+			if (positionDiff > 1e-5f || !uvExact) passed = false;
+
+			// --- Bands in every pole mode ---
+			size_t bandCount = 0;
+			for (PoleMode poles : modes) {
+				ShapeMeshes::GenerateSphereMesh(sphere, segments, segments, 1.5f, poles);
+				const size_t triangles = sphere.indices.size() / 3;
+
+				for (const float* band : bands) {
+					const MeshSubRange range = ShapeMeshes::SphereBandRange(segments, segments, poles, band[0], band[1]);
+					const float step = HalfTurn / segments;
+					for (size_t t = 0; t < triangles; ++t) {
+						const int row = TriangleRow(sphere, t, segments);
+						const bool overlaps = band[1] > band[0]
+							&& (row + 1) * step > band[0] + 1e-3f && row * step < band[1] - 1e-3f;
+						const bool inRange = 3 * t >= range.first && 3 * t < range.first + range.count;
+						// A band narrower than the slack still draws the row it lies in
+						const bool thin = band[1] > band[0] && band[1] - band[0] < 2e-3f && static_cast<int>(band[0] / step) == row;
+						if (inRange != (overlaps || thin)) passed = false;
+					}
+					++bandCount;
+				}
+			}
+
+			if (!passed) ++failures;
+			std::printf("%-10d %9u %9zu %13.3g %9s %8zu  %s\n",
+				segments, sphere.VertexCount(), sharedVertices, positionDiff, uvExact ? "exact" : "differs", bandCount, passed ? "ok" : "FAILED");
+		}
+
+		// --- Export of a hemisphere drawn from the sphere's buffers ---
+		HeadlessContext context;
+		if (!context.Create(3, 3)) return 1;
+
+		const std::filesystem::path exportDirectory = std::filesystem::temp_directory_path() / "SphereBandCheck";
+		std::filesystem::create_directories(exportDirectory);
+
+		std::printf("\n%-10s %9s %14s %14s\n", "export", "uv bytes", "shared diff", "own diff");
+		for (int segments : { 7, 18 }) {
+			const std::string sharedPath = (exportDirectory / "shared.ply").string();
+			const std::string ownPath = (exportDirectory / "own.ply").string();
+
+			// Loaded after a matching sphere, the hemisphere uploads only its UVs
+			GpuMemoryReport report;
+			bool exported = false;
+			{
+				ShapeMeshes shapes;
+				shapes.LoadSphereMesh(segments, segments, 1.5f);
+				shapes.LoadHemisphereMesh(segments, segments, 1.5f);
+				report = shapes.GetGpuMemoryReport();
+				exported = shapes.ExportMesh("Hemisphere", sharedPath);
+			}
+			{
+				ShapeMeshes shapes;
+				shapes.LoadHemisphereMesh(segments, segments, 1.5f);
+				exported = shapes.ExportMesh("Hemisphere", ownPath) && exported;
+			}
+
+			GLsizeiptr uvBytes = -1;
+			for (const MeshMemoryUsage& usage : report.meshes)
+				if (std::string(usage.name) == "Hemisphere") uvBytes = usage.vertexBytes;
+
+			MeshData expected, shared, own;
+			ShapeMeshes::GenerateHemisphereMesh(expected, segments, segments, 1.5f);
+			const bool read = exported && MeshImport::Read(sharedPath, shared) && MeshImport::Read(ownPath, own);
+			const float sharedDiff = read ? MeshDifference(shared, expected) : -1.0f;
+			const float ownDiff = read ? MeshDifference(own, expected) : -1.0f;
+
+			const bool passed = uvBytes == static_cast<GLsizeiptr>(expected.VertexCount() * 2 * sizeof(GLfloat))
+				&& sharedDiff >= 0.0f && sharedDiff <= 1e-5f && ownDiff >= 0.0f && ownDiff <= 1e-5f;
+			if (!passed) ++failures;
+			std::printf("%-10d %9lld %14.3g %14.3g  %s\n", segments, static_cast<long long>(uvBytes), sharedDiff, ownDiff, passed ? "ok" : "FAILED");
+		}
+
+		std::error_code ignored;
+		std::filesystem::remove_all(exportDirectory, ignored);
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// SweepSampling
+// -------------
+// Headless report on chord-tolerance ring placement for the spring and
+// spiral (see MeshSweep::AdaptiveParameters).
+//
+// For each shape and tolerance it prints the rings the adaptive sampling
+// places and their largest chord error, the evenly spaced rings needed
+// for the same error, and the vertex savings between the two. It also
+// prints the even spacing the segment counts ask for, which the adaptive
+// sampling never exceeds.
+//
+// Each case checks that:
+// - the chord error is within the tolerance, unless the tolerance needs
+//   more rings than the segment counts give and the sampling fell back to
+//   even spacing;
+// - the rings are no more than the segment counts give;
+// - GenerateSpringMesh / GenerateSpiralMesh build exactly that many rings.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace SweepSamplingCheck
+{
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * - report: Samples the shape's centerline
+	 *   at a tolerance.
+	 * - generate: Builds the mesh at the same
+	 *   tolerance.
+	 * - capVertices: Vertices the mesh has
+	 *   besides its rings.
+	 ******************************************/
+
+	struct CheckCase {
+		const char* name;
+		std::function<SweepSamplingReport(float)> report;
+		std::function<void(MeshData&, float)> generate;
+		size_t capVertices;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		return {
+			{ "spring(6x18)",
+				[](float tolerance) { return ShapeMeshes::ReportSpringSampling(1.0f, 6, 18, 4.0f, tolerance); },
+				[](MeshData& m, float tolerance) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.1f, 6, 18, 4.0f, tolerance); },
+				0 },
+			{ "spring(6x64)",
+				[](float tolerance) { return ShapeMeshes::ReportSpringSampling(1.0f, 6, 64, 4.0f, tolerance); },
+				[](MeshData& m, float tolerance) { ShapeMeshes::GenerateSpringMesh(m, 1.0f, 0.1f, 6, 64, 4.0f, tolerance); },
+				0 },
+			{ "spiral(3 loops)",
+				[](float tolerance) { return ShapeMeshes::ReportSpiralSampling(0.5f, 3.0f, 16, 400, tolerance); },
+				[](MeshData& m, float tolerance) { ShapeMeshes::GenerateSpiralMesh(m, 0.1f, 0.3f, 0.5f, 3.0f, 16, 400, tolerance); },
+				8 * 16 },
+			{ "spiral(8 loops)",
+				[](float tolerance) { return ShapeMeshes::ReportSpiralSampling(0.3f, 8.0f, 16, 1600, tolerance); },
+				[](MeshData& m, float tolerance) { ShapeMeshes::GenerateSpiralMesh(m, 0.05f, 0.0f, 0.3f, 8.0f, 16, 1600, tolerance); },
+				8 * 16 },
+		};
+	}
+
+	int Run(const CheckOptions&)
+	{
+		const float tolerances[] = { 1e-4f, 1e-3f, 3e-3f, 1e-2f, 3e-2f };
+
+		std::printf("%-16s %9s %6s %10s %8s %9s %9s %8s %10s %10s\n",
+			"shape", "tolerance", "rings", "max error", "uniform", "vertices", "uniform", "saved", "configured", "its error");
+
+		int failures = 0;
+		MeshData mesh;
+		for (const CheckCase& check : BuildCases()) {
+			for (float tolerance : tolerances) {
+				SweepSamplingReport report = check.report(tolerance);
+				check.generate(mesh, tolerance);
+
+				const size_t vertices = mesh.vertices.size() / 8;
+				const bool fellBack = report.rings == report.configuredRings && report.maxError > tolerance;
+				const bool passed = (report.maxError <= tolerance || fellBack)
+					&& report.rings <= report.configuredRings
+					&& vertices == report.Vertices() + check.capVertices;
+				if (!passed) ++failures;
+
+				std::printf("%-16s %9.0e %6zu %10.3g %8zu %9zu %9zu %7.1f%% %10zu %10.3g  %s\n",
+					check.name, tolerance, report.rings, report.maxError, report.uniformRings,
+					report.Vertices(), report.UniformVertices(), 100.0f * report.Savings(),
+					report.configuredRings, report.configuredError, passed ? (fellBack ? "ok (even)" : "ok") : "FAILED");
+			}
+		}
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// TessellatedSurface
+// ------------------
+// Headless check of the tessellation shaders in TessellatedSurface.cpp.
+//
+// A surfaceless EGL context is created (Mesa llvmpipe works) and the patch
+// shaders are linked on their own, with the evaluation stage's outputs
+// captured by transform feedback and rasterization discarded. Each shape is
+// drawn at several camera distances, and the check verifies that:
+//
+//   - every generated vertex lies on the exact surface (its implicit
+//     equation, superellipsoid exponents included) and has a unit normal;
+//   - the triangles face the way the shape's GenerateXMesh triangles do;
+//   - the triangle count never grows with distance, reaches the floor of
+//     two triangles per patch far away, and the nearest view is finer than
+//     the default fixed-resolution mesh.
+//
+// The triangle counts per distance are printed next to the default
+// LoadXMesh resolution for comparison.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace TessellatedSurfaceCheck
+{
+	const GLsizei ViewportWidth = 1280;
+	const GLsizei ViewportHeight = 720;
+	const float MaxLevel = 64.0f;
+
+	/******************************************
+	 * CaptureProgram
+	 * ---------------------------------------
+	 * Links the patch shaders with the
+	 * evaluation outputs captured, a model
+	 * matrix of identity (so the captured
+	 * position and normal are the surface's),
+	 * and a 60 degree perspective projection.
+	 ******************************************/
+
+	GLuint CaptureProgram()
+	{
+		GLuint program = glCreateProgram();
+		if (!TessellatedSurface::AttachShaders(program)) {
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		const char* varyings[] = { "fragmentPosition", "fragmentVertexNormal", "fragmentTextureCoordinate" };
+		glTransformFeedbackVaryings(program, 3, varyings, GL_INTERLEAVED_ATTRIBS);
+		glLinkProgram(program);
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (linked != GL_TRUE) {
+			char log[1024] = {};
+			glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+			std::fprintf(stderr, "Error: capture program failed to link:\n%s\n", log);
+			glDeleteProgram(program);
+			return 0;
+		}
+
+		glUseProgram(program);
+		const float nearPlane = 0.1f;
+		const float farPlane = 1000.0f;
+		const float focal = 1.0f / std::tan(0.5f * 60.0f * 3.14159265f / 180.0f);
+		const float aspect = static_cast<float>(ViewportWidth) / ViewportHeight;
+		const GLfloat identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+		const GLfloat projection[16] = {
+			focal / aspect, 0, 0, 0,
+			0, focal, 0, 0,
+			0, 0, (farPlane + nearPlane) / (nearPlane - farPlane), -1,
+			0, 0, 2.0f * farPlane * nearPlane / (nearPlane - farPlane), 0 };
+		glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, identity);
+		glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, projection);
+		return program;
+	}
+
+	void SetCameraDistance(GLuint program, float distance)
+	{
+		// Looking down -Z from (0, 0, distance).
+		const GLfloat view[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, -distance, 1 };
+		glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, view);
+	}
+
+	/******************************************
+	 * CheckCase
+	 * ---------------------------------------
+	 * surfaceError returns how far a point is
+	 * from the surface, in units of the shape's
+	 * size. generate builds the default
+	 * fixed-resolution mesh of the same shape.
+	 ******************************************/
+
+	struct CheckCase {
+		const char* name;
+		TessellatedSurfaceParams surface;
+		std::function<double(const GLfloat*)> surfaceError;
+		std::function<void(MeshData&)> generate;
+	};
+
+	std::vector<CheckCase> BuildCases()
+	{
+		std::vector<CheckCase> cases;
+
+		cases.push_back({ "sphere", TessellatedSurfaceParams::Sphere(1.5f),
+			[](const GLfloat* p) { return std::fabs(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) - 1.5) / 1.5; },
+			[](MeshData& m) { ShapeMeshes::GenerateSphereMesh(m, 18, 18, 1.5f); } });
+		cases.push_back({ "hemisphere", TessellatedSurfaceParams::Hemisphere(0.75f),
+			[](const GLfloat* p) {
+				double radial = std::fabs(std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) - 0.75) / 0.75;
+				return p[1] < -1e-6 ? 1.0 : radial;     // the upper half only
+			},
+			[](MeshData& m) { ShapeMeshes::GenerateHemisphereMesh(m, 18, 18, 0.75f); } });
+		cases.push_back({ "torus", TessellatedSurfaceParams::Torus(1.0f, 0.3f),
+			[](const GLfloat* p) {
+				double ring = std::sqrt(p[0] * p[0] + p[1] * p[1]) - 1.0;
+				return std::fabs(std::sqrt(ring * ring + p[2] * p[2]) - 0.3);
+			},
+			[](MeshData& m) { ShapeMeshes::GenerateTorusMesh(m, 1.0f, 0.3f, 18, 18); } });
+
+		// (|x/a|^(2/e2) + |y/b|^(2/e2))^(e2/e1) + |z/c|^(2/e1) = 1
+		auto superellipsoid = [](float a, float b, float c, float e1, float e2) {
+			return [=](const GLfloat* p) {
+				double xy = std::pow(std::fabs(p[0] / a), 2.0 / e2) + std::pow(std::fabs(p[1] / b), 2.0 / e2);
+				return std::fabs(std::pow(xy, e2 / e1) + std::pow(std::fabs(p[2] / c), 2.0 / e1) - 1.0);
+			};
+		};
+		cases.push_back({ "superellipsoid", TessellatedSurfaceParams::Superellipsoid(1.0f, 0.5f, 2.0f, 1.0f, 1.0f),
+			superellipsoid(1.0f, 0.5f, 2.0f, 1.0f, 1.0f),
+			[](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.0f, 0.5f, 2.0f, 1.0f, 1.0f, 18, 18); } });
+		cases.push_back({ "superellipsoid", TessellatedSurfaceParams::Superellipsoid(1.2f, 1.0f, 0.8f, 2.5f, 0.4f),
+			superellipsoid(1.2f, 1.0f, 0.8f, 2.5f, 0.4f),
+			[](MeshData& m) { ShapeMeshes::GenerateSuperellipsoidMesh(m, 1.2f, 1.0f, 0.8f, 2.5f, 0.4f, 18, 18); } });
+
+		return cases;
+	}
+
+	/******************************************
+	 * Orientation
+	 * ---------------------------------------
+	 * +1 if most triangles' geometric normals
+	 * point along their vertex normals, -1 if
+	 * most point against them.
+	 ******************************************/
+
+	int Orientation(const GLfloat* vertices, size_t triangleCount, const GLuint* indices = nullptr)
+	{
+		long long votes = 0;
+		for (size_t t = 0; t < triangleCount; ++t) {
+			const GLfloat* v[3];
+			for (int k = 0; k < 3; ++k)
+				v[k] = vertices + 8 * (indices ? indices[t * 3 + k] : t * 3 + k);
+
+			double e1[3], e2[3], n[3] = {};
+			for (int c = 0; c < 3; ++c) {
+				e1[c] = v[1][c] - v[0][c];
+				e2[c] = v[2][c] - v[0][c];
+				for (int k = 0; k < 3; ++k) n[c] += v[k][3 + c];
+			}
+			double cross[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			double dot = cross[0] * n[0] + cross[1] * n[1] + cross[2] * n[2];
+			if (dot > 1e-12) ++votes;
+			else if (dot < -1e-12) --votes;
+		}
+		return votes >= 0 ? 1 : -1;
+	}
+
+	/******************************************
+	 * RunCase
+	 * ---------------------------------------
+	 * Returns the number of failed checks.
+	 ******************************************/
+
+	int RunCase(const CheckCase& check, GLuint program, const TessellatedSurfaceUniforms& uniforms, GLuint feedback,
+		double tolerance, float edgePixels)
+	{
+		MeshData fixed;
+		check.generate(fixed);
+		const int expectedOrientation = Orientation(fixed.vertices.data(), fixed.IndexCount() / 3, fixed.indices.data());
+
+		// Every level at its maximum, fully inside the feedback buffer.
+		const size_t maxTriangles = TessellatedSurface::PatchVertexCount / 4 * static_cast<size_t>(MaxLevel * MaxLevel) * 2;
+		glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+		glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, maxTriangles * 3 * sizeof(Vertex), nullptr, GL_STREAM_READ);
+		glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+		GLuint query = 0;
+		glGenQueries(1, &query);
+
+		int failures = 0;
+		GLuint previousTriangles = 0;
+		GLuint nearestTriangles = 0;
+		std::vector<GLfloat> captured;
+
+		uniforms.Apply(check.surface);
+		uniforms.ApplyDetail(edgePixels, ViewportWidth, ViewportHeight, MaxLevel);
+
+		std::printf("%-16s fixed 18x18: %5u triangles\n", check.name, fixed.IndexCount() / 3);
+		for (float distance : { 2.5f, 5.0f, 10.0f, 40.0f, 160.0f, 900.0f }) {
+			SetCameraDistance(program, distance);
+
+			glBeginQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN, query);
+			glBeginTransformFeedback(GL_TRIANGLES);
+			glPatchParameteri(GL_PATCH_VERTICES, 4);
+			glDrawArrays(GL_PATCHES, 0, static_cast<GLsizei>(TessellatedSurface::PatchVertexCount));
+			glEndTransformFeedback();
+			glEndQuery(GL_TRANSFORM_FEEDBACK_PRIMITIVES_WRITTEN);
+
+			GLuint triangles = 0;
+			glGetQueryObjectuiv(query, GL_QUERY_RESULT, &triangles);
+			captured.resize(static_cast<size_t>(triangles) * 3 * 8);
+			glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, captured.size() * sizeof(GLfloat), captured.data());
+
+			double surfaceError = 0.0;
+			double normalError = 0.0;
+			for (size_t v = 0; v < captured.size(); v += 8) {
+				const GLfloat* vertex = &captured[v];
+				surfaceError = std::max(surfaceError, check.surfaceError(vertex));
+				double length = std::sqrt(vertex[3] * vertex[3] + vertex[4] * vertex[4] + vertex[5] * vertex[5]);
+				normalError = std::max(normalError, std::fabs(length - 1.0));
+			}
+			const int orientation = Orientation(captured.data(), triangles);
+
+			bool passed = surfaceError <= tolerance && normalError <= tolerance && orientation == expectedOrientation;
+			if (previousTriangles != 0 && triangles > previousTriangles) passed = false;
+			if (distance == 2.5f) nearestTriangles = triangles;
+			previousTriangles = triangles;
+			if (!passed) ++failures;
+
+			std::printf("  distance %6.1f: %6u triangles  surface error %.3g  normal error %.3g  %s\n",
+				distance, triangles, surfaceError, normalError, passed ? "ok" : "FAILED");
+		}
+
+		// Far away every edge is at level 1: two triangles per patch.
+		const GLuint floorTriangles = static_cast<GLuint>(TessellatedSurface::PatchVertexCount / 4 * 2);
+		if (previousTriangles != floorTriangles) {
+			std::printf("  farthest view has %u triangles, expected %u  FAILED\n", previousTriangles, floorTriangles);
+			++failures;
+		}
+		if (nearestTriangles <= fixed.IndexCount() / 3) {
+			std::printf("  nearest view is no finer than the fixed mesh  FAILED\n");
+			++failures;
+		}
+
+		glDeleteQueries(1, &query);
+		return failures;
+	}
+
+	int Run(const CheckOptions& options)
+	{
+		const double tolerance = options.tolerance;
+		const float edgePixels = options.edgePixels;
+
+		HeadlessContext context;
+		if (!context.Create(4, 0)) return 1;
+
+		std::fprintf(stderr, "Renderer: %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+		if (!TessellatedSurface::IsSupported()) {
+			std::fprintf(stderr, "Error: tessellation shaders are not supported by this context.\n");
+			return 1;
+		}
+
+		GLuint program = CaptureProgram();
+		TessellatedSurfaceUniforms uniforms;
+		if (program == 0 || !uniforms.Locate(program)) return 1;
+
+		// A surfaceless context has no default framebuffer to draw to, even
+		// with rasterization discarded.
+		std::vector<GLfloat> corners(TessellatedSurface::PatchVertexCount * 2);
+		TessellatedSurface::FillPatchVertices(corners.data());
+
+		GLuint vao = 0;
+		GLuint patches = 0;
+		GLuint feedback = 0;
+		GLuint framebuffer = 0;
+		GLuint colorBuffer = 0;
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+		glGenBuffers(1, &patches);
+		glBindBuffer(GL_ARRAY_BUFFER, patches);
+		glBufferData(GL_ARRAY_BUFFER, corners.size() * sizeof(GLfloat), corners.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
+		glEnableVertexAttribArray(0);
+		glGenRenderbuffers(1, &colorBuffer);
+		glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, 1, 1);
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+		glGenBuffers(1, &feedback);
+		glEnable(GL_RASTERIZER_DISCARD);
+
+		int failures = 0;
+		std::vector<CheckCase> cases = BuildCases();
+		for (const CheckCase& check : cases)
+			failures += RunCase(check, program, uniforms, feedback, tolerance, edgePixels);
+
+		GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			std::fprintf(stderr, "Error: GL error 0x%04x.\n", error);
+			++failures;
+		}
+
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteBuffers(1, &feedback);
+		glDeleteBuffers(1, &patches);
+		glDeleteVertexArrays(1, &vao);
+		glDeleteProgram(program);
+
+		std::printf("%d checks failed\n", failures);
+		return failures;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// WeldedCone
+// ----------
+// Headless check of the cone's welded side (see ConeSideMode and
+// ShapeMeshes::GenerateConeMesh).
+//
+// For several slice counts it builds the Faceted and Welded cones and checks
+// that the Welded one:
+// - has 3 N + 3 vertices: the base center and rim, N + 1 side rim vertices
+//   with the seam repeated, and an apex per slice;
+// - has the same index count, surface area and winding as the Faceted one,
+//   triangle for triangle;
+// - has no U jump at the seam: each side triangle spans at most one slice
+//   of U;
+// - gives the same DrawMeshArc layout and ranges (ArcLayoutFor,
+//   ArcIndexRanges) as the Faceted one, and every triangle of slice i has
+//   its centroid within that slice's wedge.
+//
+// No GL context is needed.
+///////////////////////////////////////////////////////////////////////////////
+
+namespace WeldedConeCheck
+{
+	const float TwoPi = 6.28318531f;
+
+	glm::vec3 Position(const MeshData& mesh, GLuint index)
+	{
+		const GLfloat* v = &mesh.vertices[index * 8];
+		return glm::vec3(v[0], v[1], v[2]);
+	}
+
+	// Twice the area of a triangle, along its winding.
+	glm::vec3 TriangleNormal(const MeshData& mesh, size_t triangle)
+	{
+		const glm::vec3 a = Position(mesh, mesh.indices[3 * triangle]);
+		return glm::cross(Position(mesh, mesh.indices[3 * triangle + 1]) - a, Position(mesh, mesh.indices[3 * triangle + 2]) - a);
+	}
+
+	float CentroidAngle(const MeshData& mesh, size_t triangle)
+	{
+		glm::vec3 sum(0.0f);
+		for (size_t k = 0; k < 3; ++k) sum += Position(mesh, mesh.indices[3 * triangle + k]);
+		const float angle = std::atan2(sum.z, sum.x);
+		return angle < 0.0f ? angle + TwoPi : angle;
+	}
+
+	bool SameRanges(const std::vector<MeshSubRange>& a, const std::vector<MeshSubRange>& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+			[](const MeshSubRange& x, const MeshSubRange& y) { return x.first == y.first && x.count == y.count; });
+	}
+
+	int Run(const CheckOptions&)
+	{
+		const float ranges[][2] = {
+			{ 0.0f, 3.14159265f }, { 0.3f, 1.1f }, { 5.5f, 7.0f }, { -1.0f, 0.5f }, { 2.0f, 2.0f + TwoPi },
+		};
+
+		std::printf("%6s %9s %9s %11s %9s %8s\n", "slices", "faceted", "welded", "area diff", "max du", "ranges");
+
+		int failures = 0;
+		MeshData faceted, welded;
+		std::vector<MeshSubRange> facetedRanges, weldedRanges;
+		for (int slices : { 3, 8, 18, 64 }) {
+			ShapeMeshes::GenerateConeMesh(faceted, 1.0f, 2.0f, slices);
+			ShapeMeshes::GenerateConeMesh(welded, 1.0f, 2.0f, slices, ConeSideMode::Welded);
+
+			bool passed = welded.VertexCount() == static_cast<GLuint>(3 * slices + 3)
+				&& welded.indices.size() == faceted.indices.size()
+				&& welded.indices.size() == static_cast<size_t>(6 * slices);
+			const size_t triangles = std::min(welded.indices.size(), faceted.indices.size()) / 3;
+
+			// --- Area and winding, triangle for triangle ---
+			double facetedArea = 0.0, weldedArea = 0.0;
+			for (size_t t = 0; t < triangles; ++t) {
+				const glm::vec3 f = TriangleNormal(faceted, t);
+				const glm::vec3 w = TriangleNormal(welded, t);
+				facetedArea += 0.5 * glm::length(f);
+				weldedArea += 0.5 * glm::length(w);
+				if (glm::dot(f, w) <= 0.0f) passed = false;
+			}
+			const double areaDiff = std::fabs(weldedArea - facetedArea);
+			if (areaDiff > 1e-5 * facetedArea) passed = false;
+
+			// --- U across each side triangle (after the base's), the seam slice included ---
+			float maxSpan = 0.0f;
+			for (size_t i = 3 * static_cast<size_t>(slices); i + 2 < welded.indices.size(); i += 3) {
+				float lo = 1.0f, hi = 0.0f;
+				for (size_t k = 0; k < 3; ++k) {
+					const float u = welded.vertices[welded.indices[i + k] * 8 + 6];
+					lo = std::min(lo, u);
+					hi = std::max(hi, u);
+				}
+				maxSpan = std::max(maxSpan, hi - lo);
+			}
+			if (maxSpan > 1.0f / slices + 1e-5f) passed = false;
+
+			// --- DrawMeshArc layout and ranges ---
+			const ArcLayout facetedLayout = ShapeMeshes::ArcLayoutFor(ShapeMeshes::ArcShape::cone, slices, faceted.indices.size());
+			const ArcLayout weldedLayout = ShapeMeshes::ArcLayoutFor(ShapeMeshes::ArcShape::cone, slices, welded.indices.size());
+			passed = passed && weldedLayout.slices == facetedLayout.slices
+				&& std::equal(weldedLayout.blocks.begin(), weldedLayout.blocks.end(), facetedLayout.blocks.begin(), facetedLayout.blocks.end(),
+					[](const ArcBlock& a, const ArcBlock& b) { return a.firstIndex == b.firstIndex && a.indicesPerSlice == b.indicesPerSlice && a.cap == b.cap; });
+
+			const float step = TwoPi / slices;
+			for (const ArcBlock& block : weldedLayout.blocks) {
+				const size_t perSlice = block.indicesPerSlice / 3;
+				for (size_t t = 0; t < perSlice * slices && block.firstIndex / 3 + t < triangles; ++t) {
+					const float angle = CentroidAngle(welded, block.firstIndex / 3 + t);
+					const size_t slice = t / perSlice;
+					if (angle < slice * step - 1e-3f || angle > (slice + 1) * step + 1e-3f) passed = false;
+				}
+			}
+
+			size_t rangeCount = 0;
+			for (const float* range : ranges) {
+				for (bool caps : { true, false }) {
+					ShapeMeshes::ArcIndexRanges(facetedRanges, facetedLayout, range[0], range[1], caps);
+					ShapeMeshes::ArcIndexRanges(weldedRanges, weldedLayout, range[0], range[1], caps);
+					if (!SameRanges(weldedRanges, facetedRanges)) passed = false;
+					rangeCount += weldedRanges.size();
+				}
+			}
+
+			if (!passed) ++failures;
+			std::printf("%6d %9u %9u %11.3g %9.4f %8zu  %s\n",
+				slices, faceted.VertexCount(), welded.VertexCount(), areaDiff, maxSpan, rangeCount, passed ? "ok" : "FAILED");
+		}
+
+		std::printf("%d case(s) failed\n", failures);
+		return failures;
+	}
+}
+
+namespace
+{
+	/******************************************
+	 * Check
+	 * ---------------------------------------
+	 * A case by the name --case selects it with.
+	 * run returns the number of failures.
+	 ******************************************/
+
+	struct Check {
+		const char* name;
+		int (*run)(const CheckOptions&);
+	};
+
+	const Check Checks[] = {
+		{ "AdaptiveSuperellipsoid", AdaptiveSuperellipsoidCheck::Run },
+		{ "ArcRange", ArcRangeCheck::Run },
+		{ "EdgeWireframe", EdgeWireframeCheck::Run },
+		{ "MeshCompute", MeshComputeCheck::Run },
+		{ "MeshExport", MeshExportCheck::Run },
+		{ "PartRange", PartRangeCheck::Run },
+		{ "PoleMode", PoleModeCheck::Run },
+		{ "ProceduralGrid", ProceduralGridCheck::Run },
+		{ "SphereBand", SphereBandCheck::Run },
+		{ "SweepSampling", SweepSamplingCheck::Run },
+		{ "TessellatedSurface", TessellatedSurfaceCheck::Run },
+		{ "WeldedCone", WeldedConeCheck::Run },
+	};
+
+	bool IsCheckName(const std::string& name)
+	{
+		return std::any_of(std::begin(Checks), std::end(Checks), [&name](const Check& check) { return name == check.name; });
+	}
+}
+
+int main(int argc, char** argv)
+{
+	CheckOptions options;
+	std::vector<std::string> selected;
+	bool list = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!std::strcmp(argv[i], "--list")) list = true;
+		else if (!std::strcmp(argv[i], "--case") && i + 1 < argc) selected.push_back(argv[++i]);
+		else if (!std::strcmp(argv[i], "--tolerance") && i + 1 < argc) options.tolerance = std::atof(argv[++i]);
+		else if (!std::strcmp(argv[i], "--edge-pixels") && i + 1 < argc) options.edgePixels = static_cast<float>(std::atof(argv[++i]));
+		else if (!std::strcmp(argv[i], "--bench")) options.bench = true;
+		else if (!std::strcmp(argv[i], "--repeats") && i + 1 < argc) options.repeats = std::max(1, std::atoi(argv[++i]));
+		else {
+			std::fprintf(stderr, "Usage: %s [--list] [--case NAME]... [--tolerance T] [--edge-pixels P] [--bench] [--repeats N]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	for (const std::string& name : selected) {
+		if (!IsCheckName(name)) {
+			std::fprintf(stderr, "Error: no check case named %s (see --list).\n", name.c_str());
+			return 2;
+		}
+	}
+
+	if (list) {
+		for (const Check& check : Checks) std::printf("%s\n", check.name);
+		return 0;
+	}
+
+	int run = 0;
+	int failed = 0;
+	for (const Check& check : Checks) {
+		if (!selected.empty() && std::find(selected.begin(), selected.end(), check.name) == selected.end()) continue;
+
+		std::printf("== %s\n", check.name);
+		std::fflush(stdout);
+		const int failures = check.run(options);
+		std::printf("== %s: %s\n\n", check.name, failures == 0 ? "ok" : "FAILED");
+
+		++run;
+		if (failures != 0) ++failed;
+	}
+
+	std::printf("%d of %d checks failed\n", failed, run);
+	return failed == 0 ? 0 : 1;
+}
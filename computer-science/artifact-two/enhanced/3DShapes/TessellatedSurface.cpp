@@ -0,0 +1,333 @@
+///////////////////////////////////////////////////////////////////////////////
+// TessellatedSurface.cpp
+// ======================
+// Tessellation shaders and parameters for the smooth primitives. See
+// TessellatedSurface.h.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "TessellatedSurface.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	/******************************************
+	 * SurfaceCommon
+	 * ---------------------------------------
+	 * Shared by the control and evaluation
+	 * stages: Surface() is the exact shape at
+	 * (s, t), written as the ProceduralGrid
+	 * vertex shader evaluates it at a grid
+	 * vertex, so the tessellated surface passes
+	 * through every GenerateXMesh vertex.
+	 ******************************************/
+
+	const char* const SurfaceCommon = R"GLSL(#version 400 core
+
+const int SurfaceSphere = 0;
+const int SurfaceTorus = 1;
+const int SurfaceSuperellipsoid = 2;
+const float Pi = 3.141592653589793;
+
+uniform int surfaceShape;
+uniform vec4 surfaceParams[2];
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+float SignedPow(float x, float e)
+{
+	return sign(x) * pow(abs(x), e);
+}
+
+void Surface(vec2 st, out vec3 position, out vec3 normal, out vec2 uv)
+{
+	if (surfaceShape == SurfaceTorus) {
+		// GenerateTorusMesh: t = main ring, s = tube ring
+		float mainRadius = surfaceParams[0].x;
+		float tubeRadius = surfaceParams[0].y;
+		float mainAngle = st.y * 2.0 * Pi;
+		float tubeAngle = st.x * 2.0 * Pi;
+
+		vec3 center = vec3(mainRadius * cos(mainAngle), mainRadius * sin(mainAngle), 0.0);
+		float ring = mainRadius + tubeRadius * cos(tubeAngle);
+		position = vec3(ring * cos(mainAngle), ring * sin(mainAngle), tubeRadius * sin(tubeAngle));
+		normal = normalize(position - center);
+		uv = vec2(st.y, st.x);
+	}
+	else if (surfaceShape == SurfaceSuperellipsoid) {
+		// BuildSuperellipsoidMesh: u in [-pi/2, pi/2] along t, v in [-pi, pi] along s
+		vec3 scale = surfaceParams[0].xyz;
+		float verticalExponent = surfaceParams[0].w;
+		float horizontalExponent = surfaceParams[1].x;
+		float u = -Pi * 0.5 + st.y * Pi;
+		float v = -Pi + st.x * (2.0 * Pi);
+
+		vec3 surface = vec3(SignedPow(cos(u), verticalExponent) * SignedPow(cos(v), horizontalExponent),
+			SignedPow(cos(u), verticalExponent) * SignedPow(sin(v), horizontalExponent),
+			SignedPow(sin(u), verticalExponent));
+		position = scale * surface;
+		normal = normalize(surface / scale);
+		uv = st;
+	}
+	else {
+		// GenerateSphereMesh; the hemisphere covers the first
+		// surfaceParams[0].y of the polar angle.
+		float radius = surfaceParams[0].x;
+		float theta = st.y * Pi * surfaceParams[0].y;
+		float phi = st.x * 2.0 * Pi;
+
+		normal = vec3(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+		position = radius * normal;
+		uv = vec2(1.0 - st.x, 1.0 - st.y);
+	}
+}
+)GLSL";
+
+	const char* const PatchVertexShader = R"GLSL(#version 400 core
+
+layout(location = 0) in vec2 patchCoord;
+out vec2 controlCoord;
+
+void main()
+{
+	controlCoord = patchCoord;
+}
+)GLSL";
+
+	/******************************************
+	 * PatchControlShader
+	 * ---------------------------------------
+	 * Corners arrive as (s0,t0) (s1,t0) (s1,t1)
+	 * (s0,t1). An edge's level is its on-screen
+	 * length, measured through its midpoint so a
+	 * curved edge is not mistaken for its chord,
+	 * divided by the target edge length. The
+	 * inner levels follow the longer of the
+	 * opposite edges.
+	 ******************************************/
+
+	const char* const PatchControlShader = R"GLSL(
+layout(vertices = 4) out;
+
+uniform vec2 tessViewport;      // pixels
+uniform float tessEdgePixels;   // target on-screen edge length
+uniform float tessMaxLevel;
+
+in vec2 controlCoord[];
+out vec2 evaluationCoord[];
+
+vec2 ScreenPoint(vec2 st)
+{
+	vec3 position, normal;
+	vec2 uv;
+	Surface(st, position, normal, uv);
+	vec4 clip = projection * view * model * vec4(position, 1.0);
+	return clip.xy / max(clip.w, 1e-4) * 0.5 * tessViewport;
+}
+
+float EdgeLevel(vec2 a, vec2 b)
+{
+	vec2 pa = ScreenPoint(a);
+	vec2 pm = ScreenPoint((a + b) * 0.5);
+	vec2 pb = ScreenPoint(b);
+	float pixels = distance(pa, pm) + distance(pm, pb);
+	return clamp(pixels / tessEdgePixels, 1.0, tessMaxLevel);
+}
+
+void main()
+{
+	evaluationCoord[gl_InvocationID] = controlCoord[gl_InvocationID];
+
+	if (gl_InvocationID == 0) {
+		// Outer edges in quad order: u = 0, v = 0, u = 1, v = 1.
+		gl_TessLevelOuter[0] = EdgeLevel(controlCoord[0], controlCoord[3]);
+		gl_TessLevelOuter[1] = EdgeLevel(controlCoord[0], controlCoord[1]);
+		gl_TessLevelOuter[2] = EdgeLevel(controlCoord[1], controlCoord[2]);
+		gl_TessLevelOuter[3] = EdgeLevel(controlCoord[3], controlCoord[2]);
+		gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+		gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+	}
+}
+)GLSL";
+
+	// cw: the grid generators emit (row, col), (row + 1, col), (row, col + 1)
+	// first, which is clockwise in (s, t).
+	const char* const PatchEvaluationShader = R"GLSL(
+layout(quads, fractional_odd_spacing, cw) in;
+
+in vec2 evaluationCoord[];
+
+out vec3 fragmentPosition;
+out vec3 fragmentVertexNormal;
+out vec2 fragmentTextureCoordinate;
+
+void main()
+{
+	vec2 st = mix(mix(evaluationCoord[0], evaluationCoord[1], gl_TessCoord.x),
+		mix(evaluationCoord[3], evaluationCoord[2], gl_TessCoord.x), gl_TessCoord.y);
+
+	vec3 position, normal;
+	vec2 uv;
+	Surface(st, position, normal, uv);
+
+	gl_Position = projection * view * model * vec4(position, 1.0);
+	fragmentPosition = vec3(model * vec4(position, 1.0));
+	fragmentVertexNormal = mat3(transpose(inverse(model))) * normal;
+	fragmentTextureCoordinate = uv;
+}
+)GLSL";
+
+	/******************************************
+	 * CompileStage
+	 * ---------------------------------------
+	 * Returns the shader object, or 0 after
+	 * printing the compile log. prefix is
+	 * placed ahead of source (the common
+	 * surface code), or may be null.
+	 ******************************************/
+
+	GLuint CompileStage(GLenum type, const char* prefix, const char* source, const char* name)
+	{
+		const char* sources[] = { prefix, source };
+		GLuint shader = glCreateShader(type);
+		if (prefix) glShaderSource(shader, 2, sources, nullptr);
+		else glShaderSource(shader, 1, &source, nullptr);
+		glCompileShader(shader);
+
+		GLint compiled = GL_FALSE;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+		if (compiled != GL_TRUE) {
+			GLint logLength = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+			std::string log(static_cast<size_t>(std::max(logLength, 1)), '\0');
+			glGetShaderInfoLog(shader, logLength, nullptr, &log[0]);
+
+			std::cerr << "Error: tessellated surface " << name << " shader failed to compile:\n" << log.c_str() << std::endl;
+			glDeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+}
+
+/******************************************
+ * TessellatedSurfaceParams Factories
+ ******************************************/
+
+TessellatedSurfaceParams TessellatedSurfaceParams::Sphere(float radius)
+{
+	TessellatedSurfaceParams surface;
+	surface.shape = TessellatedShape::Sphere;
+	surface.params[0] = radius;
+	surface.params[1] = 1.0f;
+	return surface;
+}
+
+TessellatedSurfaceParams TessellatedSurfaceParams::Hemisphere(float radius)
+{
+	TessellatedSurfaceParams surface = Sphere(radius);
+	surface.params[1] = 0.5f;
+	return surface;
+}
+
+TessellatedSurfaceParams TessellatedSurfaceParams::Torus(float mainRadius, float tubeRadius)
+{
+	TessellatedSurfaceParams surface;
+	surface.shape = TessellatedShape::Torus;
+	surface.params[0] = mainRadius;
+	surface.params[1] = std::max(0.01f, tubeRadius);
+	return surface;
+}
+
+TessellatedSurfaceParams TessellatedSurfaceParams::Superellipsoid(float scaleX, float scaleY, float scaleZ,
+	float verticalExponent, float horizontalExponent)
+{
+	TessellatedSurfaceParams surface;
+	surface.shape = TessellatedShape::Superellipsoid;
+	surface.params[0] = scaleX > 0.0f ? scaleX : 0.1f;
+	surface.params[1] = scaleY > 0.0f ? scaleY : 0.1f;
+	surface.params[2] = scaleZ > 0.0f ? scaleZ : 0.1f;
+	surface.params[3] = verticalExponent > 0.0f ? verticalExponent : 0.1f;
+	surface.params[4] = horizontalExponent > 0.0f ? horizontalExponent : 0.1f;
+	return surface;
+}
+
+/******************************************
+ * TessellatedSurfaceUniforms
+ ******************************************/
+
+bool TessellatedSurfaceUniforms::Locate(GLuint program)
+{
+	shape = glGetUniformLocation(program, "surfaceShape");
+	params = glGetUniformLocation(program, "surfaceParams");
+	viewport = glGetUniformLocation(program, "tessViewport");
+	edgePixels = glGetUniformLocation(program, "tessEdgePixels");
+	maxLevel = glGetUniformLocation(program, "tessMaxLevel");
+
+	if (!IsValid()) {
+		std::cerr << "Error: program " << program << " has no tessellated surface uniforms; "
+			<< "link it with TessellatedSurface::AttachShaders()." << std::endl;
+		return false;
+	}
+	return true;
+}
+
+void TessellatedSurfaceUniforms::Apply(const TessellatedSurfaceParams& surface) const
+{
+	glUniform1i(shape, static_cast<GLint>(surface.shape));
+	glUniform4fv(params, 2, surface.params);
+}
+
+void TessellatedSurfaceUniforms::ApplyDetail(float pixelsPerEdge, float viewportWidth, float viewportHeight, float maxTessLevel) const
+{
+	glUniform2f(viewport, viewportWidth, viewportHeight);
+	glUniform1f(edgePixels, std::max(pixelsPerEdge, 0.5f));
+	glUniform1f(maxLevel, std::max(maxTessLevel, 1.0f));
+}
+
+/******************************************
+ * IsSupported / FillPatchVertices /
+ * AttachShaders
+ ******************************************/
+
+bool TessellatedSurface::IsSupported()
+{
+	return GLEW_VERSION_4_0 || GLEW_ARB_tessellation_shader;
+}
+
+void TessellatedSurface::FillPatchVertices(GLfloat* st)
+{
+	const GLfloat step = 1.0f / PatchGrid;
+
+	for (uint32_t row = 0; row < PatchGrid; ++row) {
+		for (uint32_t col = 0; col < PatchGrid; ++col) {
+			// The last row and column end at exactly 1.0, as the seam does.
+			const GLfloat s0 = col * step;
+			const GLfloat s1 = col + 1 == PatchGrid ? 1.0f : (col + 1) * step;
+			const GLfloat t0 = row * step;
+			const GLfloat t1 = row + 1 == PatchGrid ? 1.0f : (row + 1) * step;
+
+			const GLfloat corners[8] = { s0, t0, s1, t0, s1, t1, s0, t1 };
+			st = std::copy(corners, corners + 8, st);
+		}
+	}
+}
+
+bool TessellatedSurface::AttachShaders(GLuint program)
+{
+	GLuint vertex = CompileStage(GL_VERTEX_SHADER, nullptr, PatchVertexShader, "vertex");
+	GLuint control = CompileStage(GL_TESS_CONTROL_SHADER, SurfaceCommon, PatchControlShader, "control");
+	GLuint evaluation = CompileStage(GL_TESS_EVALUATION_SHADER, SurfaceCommon, PatchEvaluationShader, "evaluation");
+
+	const bool compiled = vertex != 0 && control != 0 && evaluation != 0;
+	for (GLuint shader : { vertex, control, evaluation }) {
+		if (shader == 0) continue;
+		if (compiled) glAttachShader(program, shader);
+		glDeleteShader(shader);     // freed with the program once attached
+	}
+	return compiled;
+}
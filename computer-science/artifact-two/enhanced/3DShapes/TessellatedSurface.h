@@ -0,0 +1,139 @@
+/******************************************
+ * TessellatedSurface
+ * ---------------------------------------
+ * Hardware tessellation for the smooth
+ * primitives: sphere, hemisphere, torus and
+ * superellipsoid. Every shape starts from the
+ * same coarse patch mesh, an 8 x 8 grid of
+ * quad patches over the unit (s, t) square
+ * held in one small vertex buffer. The
+ * control shader picks each patch edge's
+ * tessellation level from its length on
+ * screen, and the evaluation shader places
+ * every generated vertex on the exact
+ * parametric surface, so the silhouette stays
+ * smooth up close while a distant shape costs
+ * a handful of triangles.
+ *
+ * The parameterization is that of
+ * ProceduralGrid.h (s runs along a grid row,
+ * t down the rows), so position, normal and
+ * UV at a grid vertex match GenerateXMesh.
+ * An edge's level depends only on its two end
+ * points and midpoint, which neighbouring
+ * patches share, so the surface has no
+ * cracks.
+ *
+ * Needs OpenGL 4.0 or ARB_tessellation_shader;
+ * see IsSupported(). The TessellatedSurface
+ * case of ShapeMeshesCheck.cpp checks the
+ * output headlessly.
+ ******************************************/
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Values of the surfaceShape uniform; the hemisphere is a sphere over half the rows.
+enum class TessellatedShape : GLint {
+    Sphere = 0,
+    Torus = 1,
+    Superellipsoid = 2
+};
+
+/******************************************
+ * TessellatedSurfaceParams
+ * ---------------------------------------
+ * One tessellated draw: the shape and its
+ * parameters packed the way the evaluation
+ * shader reads them. There is no resolution;
+ * that is chosen per patch edge on the GPU.
+ *
+ * The factories take the shape parameters of
+ * the LoadXMesh/DrawXMesh function of the same
+ * shape and clamp them as its generator does.
+ ******************************************/
+
+struct TessellatedSurfaceParams {
+    TessellatedShape shape = TessellatedShape::Sphere;
+    GLfloat params[8] = {};     // surfaceParams[2] in the shaders
+
+    static TessellatedSurfaceParams Sphere(float radius);
+    static TessellatedSurfaceParams Hemisphere(float radius);
+    static TessellatedSurfaceParams Torus(float mainRadius, float tubeRadius);
+    static TessellatedSurfaceParams Superellipsoid(float scaleX, float scaleY, float scaleZ,
+        float verticalExponent, float horizontalExponent);
+};
+
+/******************************************
+ * TessellatedSurfaceUniforms
+ * ---------------------------------------
+ * Locations of the surface uniforms in a
+ * program linked with
+ * TessellatedSurface::AttachShaders().
+ *
+ * - Locate(program): Looks them up. Returns
+ *   false if the program does not have them.
+ * - Apply(surface): Sets the shape uniforms on
+ *   the program currently in use.
+ * - ApplyDetail(...): Sets the target edge
+ *   length in pixels, the viewport size it is
+ *   measured in, and the largest level used.
+ ******************************************/
+
+struct TessellatedSurfaceUniforms {
+    GLint shape = -1;
+    GLint params = -1;
+    GLint viewport = -1;
+    GLint edgePixels = -1;
+    GLint maxLevel = -1;
+
+    bool Locate(GLuint program);
+    bool IsValid() const { return shape >= 0 && params >= 0 && viewport >= 0 && edgePixels >= 0 && maxLevel >= 0; }
+    void Apply(const TessellatedSurfaceParams& surface) const;
+    void ApplyDetail(float pixelsPerEdge, float viewportWidth, float viewportHeight, float maxTessLevel) const;
+};
+
+namespace TessellatedSurface
+{
+    // Patches per side of the coarse patch mesh, and its vertex count (4 per patch).
+    constexpr uint32_t PatchGrid = 8;
+    constexpr size_t PatchVertexCount = static_cast<size_t>(PatchGrid) * PatchGrid * 4;
+
+    // True when the context has tessellation shaders.
+    bool IsSupported();
+
+    /******************************************
+     * FillPatchVertices
+     * ---------------------------------------
+     * Writes the coarse patch mesh: for each
+     * patch, its four (s, t) corners in the
+     * order the control shader expects, as
+     * 2 * PatchVertexCount floats. Read as
+     * attribute 0 (vec2).
+     ******************************************/
+
+    void FillPatchVertices(GLfloat* st);
+
+    /******************************************
+     * AttachShaders
+     * ---------------------------------------
+     * Compiles the vertex, tessellation control
+     * and tessellation evaluation shaders and
+     * attaches them to program, which is then
+     * linked with the scene's fragment shader.
+     * They use the scene's model, view and
+     * projection uniforms and write
+     * fragmentPosition, fragmentVertexNormal and
+     * fragmentTextureCoordinate.
+     *
+     * Returns false, after printing the compile
+     * log, if a stage fails; nothing is attached
+     * then.
+     ******************************************/
+
+    bool AttachShaders(GLuint program);
+}